@@ -0,0 +1,41 @@
+/******************************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PICmicro(r) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PICmicro Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+********************************************************************/
+
+#if !defined (_CRYPTO_SW_CONFIG_H)
+#define _CRYPTO_SW_CONFIG_H
+ 
+/****************************************************************************************************************************/
+/* Block Cipher Configuration options (AES, TDES, XTEA)                                                                     */
+/****************************************************************************************************************************/
+// Defines the largest block size used by the ciphers you are using with the block cipher modes of operation
+#define CRYPTO_CONFIG_SW_BLOCK_MAX_SIZE      16ul
+
+// Defines the maximum number of block cipher handles
+#define CRYPTO_CONFIG_SW_BLOCK_HANDLE_MAXIMUM  10u
+
+// GHASH multiplication method used by the GCM mode.  The benchmark is normally built once per
+// option by passing -DCRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT or -DCRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT
+// on the compiler command line.
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT         // 256-byte table per context, 32 bytes of constant data
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT         // 4096-byte table per context, 512 bytes of constant data
+
+#endif      // _CRYPTO_SW_CONFIG_H
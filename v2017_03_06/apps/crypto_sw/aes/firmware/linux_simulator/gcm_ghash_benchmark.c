@@ -0,0 +1,188 @@
+/******************************************************************************
+ Software License Agreement:
+
+ The software supplied herewith by Microchip Technology Incorporated
+ (the "Company") for its PICmicro(r) Microcontroller is intended and
+ supplied to you, the Company's customer, for use solely and
+ exclusively on Microchip PICmicro Microcontroller products. The
+ software is owned by the Company and/or its supplier, and is
+ protected under applicable copyright laws. All rights are reserved.
+ Any use in violation of the foregoing restrictions may subject the
+ user to criminal sanctions under applicable laws, as well as to
+ civil liability for the breach of the terms and conditions of this
+ license.
+
+ THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+ WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+ TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+ IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+ CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+********************************************************************/
+
+/*******************************************************************************
+  Host (Linux) benchmark of the GHASH step of the software GCM mode.  It times
+  the bit-serial BLOCK_CIPHER_SW_GCM_GaloisMultiply against the GHASH path
+  selected in crypto_sw_config.h and reports cycles per byte for each.  Build
+  from the firmware directory once per GHASH option, for example:
+
+    gcc -O2 [-DCRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT | -DCRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT] \
+        -Ilinux_simulator -I../../../../framework \
+        linux_simulator/gcm_ghash_benchmark.c \
+        ../../../../framework/crypto_sw/src/block_cipher/block_cipher_sw.c \
+        ../../../../framework/crypto_sw/src/block_cipher/block_cipher_sw_gcm.c \
+        -o gcm_ghash_benchmark
+
+  The AES module is only available for 16-bit targets, so the GCM context is
+  initialized with a stand-in cipher that returns the hash subkey of the
+  all-zero AES-128 key.  Only the authentication (GHASH) path is exercised.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "system_config.h"
+#include "crypto_sw/crypto_sw.h"
+
+// Number of bytes hashed by each timed pass
+#define BENCHMARK_BYTES             (16ul * 1024ul * 1024ul)
+// Size of the data buffer that is hashed repeatedly
+#define BENCHMARK_BUFFER_SIZE       4096u
+
+void BLOCK_CIPHER_SW_GCM_GaloisMultiply (uint8_t * result, uint8_t * a, uint8_t * b);
+
+// AES-128 encryption of the zero block under the all-zero key (GCM specification, test case 2)
+static const uint8_t hashSubKey[16] = {0x66,0xe9,0x4b,0xd4,0xef,0x8a,0x2c,0x3b,0x88,0x4c,0xfa,0x59,0xca,0x34,0x2b,0x2e};
+// Ciphertext of test case 2 and its product with the hash subkey (X1 in the specification)
+static const uint8_t cipherText2[16] = {0x03,0x88,0xda,0xce,0x60,0xb6,0xa3,0x92,0xf3,0x28,0xc2,0xb9,0x71,0xb2,0xfe,0x78};
+static const uint8_t ghashX1[16] = {0x5e,0x2e,0xc7,0x46,0x91,0x70,0x62,0x88,0x2c,0x85,0xb0,0x68,0x53,0x53,0xde,0xb7};
+
+static const uint8_t ivValue[12] = {0xca,0xfe,0xba,0xbe,0xfa,0xce,0xdb,0xad,0xde,0xca,0xf8,0x88};
+
+static uint8_t dataBuffer[BENCHMARK_BUFFER_SIZE];
+static uint8_t keyStream[16 * 4];
+static BLOCK_CIPHER_SW_GCM_CONTEXT context;
+
+// Stand-in block cipher: "encrypts" every block to the hash subkey passed as the key
+static void BENCHMARK_Encrypt (BLOCK_CIPHER_SW_HANDLE handle, void * cipherText, void * plainText, void * key)
+{
+    memcpy (cipherText, key, 16);
+}
+
+static void BENCHMARK_Decrypt (BLOCK_CIPHER_SW_HANDLE handle, void * plainText, void * cipherText, void * key)
+{
+    memcpy (plainText, key, 16);
+}
+
+static uint64_t BENCHMARK_CyclesGet (void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    // No cycle counter available; report nanoseconds instead
+    clock_gettime (CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ull) + now.tv_nsec;
+#endif
+}
+
+static void BENCHMARK_ContextInitialize (BLOCK_CIPHER_SW_HANDLE handle)
+{
+    BLOCK_CIPHER_SW_GCM_Initialize (handle, &context, BENCHMARK_Encrypt, BENCHMARK_Decrypt, 16, (uint8_t *)ivValue, 12, keyStream, sizeof(keyStream), (void *)hashSubKey, CRYPTO_SW_KEY_SOFTWARE_EXPANDED);
+}
+
+int main (void)
+{
+    SYS_MODULE_OBJ sysObject;
+    BLOCK_CIPHER_SW_HANDLE handle;
+    uint8_t reference[16];
+    uint8_t h[16];
+    uint64_t start, serialCycles, configuredCycles;
+    uint32_t i, j, bytes;
+
+    sysObject = BLOCK_CIPHER_SW_Initialize (BLOCK_CIPHER_SW_INDEX, NULL);
+    if (sysObject != SYS_MODULE_OBJ_STATIC)
+    {
+        return EXIT_FAILURE;
+    }
+
+    handle = BLOCK_CIPHER_SW_Open (BLOCK_CIPHER_SW_INDEX, DRV_IO_INTENT_EXCLUSIVE);
+    if (handle == BLOCK_CIPHER_SW_HANDLE_INVALID)
+    {
+        return EXIT_FAILURE;
+    }
+
+    srand (1);
+    for (i = 0; i < BENCHMARK_BUFFER_SIZE; i++)
+    {
+        dataBuffer[i] = (uint8_t)rand();
+    }
+    memcpy (h, hashSubKey, 16);
+
+    // Known answer: one block of test case 2 through the configured GHASH path
+    BENCHMARK_ContextInitialize (handle);
+    BLOCK_CIPHER_SW_GCM_Encrypt (handle, NULL, NULL, (uint8_t *)cipherText2, 16, NULL, 0, BLOCK_CIPHER_SW_OPTION_AUTHENTICATE_ONLY);
+    if (memcmp (context.authTag, ghashX1, 16) != 0)
+    {
+        printf ("GHASH known answer test failed\n");
+        return EXIT_FAILURE;
+    }
+
+    // Bit-serial reference
+    memset (reference, 0x00, 16);
+    start = BENCHMARK_CyclesGet();
+    for (bytes = 0; bytes < BENCHMARK_BYTES; bytes += BENCHMARK_BUFFER_SIZE)
+    {
+        for (i = 0; i < BENCHMARK_BUFFER_SIZE; i += 16)
+        {
+            for (j = 0; j < 16; j++)
+            {
+                reference[j] ^= dataBuffer[i + j];
+            }
+            BLOCK_CIPHER_SW_GCM_GaloisMultiply (reference, reference, h);
+        }
+    }
+    serialCycles = BENCHMARK_CyclesGet() - start;
+
+    // Configured GHASH path, driven through the public API
+    BENCHMARK_ContextInitialize (handle);
+    start = BENCHMARK_CyclesGet();
+    for (bytes = 0; bytes < BENCHMARK_BYTES; bytes += BENCHMARK_BUFFER_SIZE)
+    {
+        BLOCK_CIPHER_SW_GCM_Encrypt (handle, NULL, NULL, dataBuffer, BENCHMARK_BUFFER_SIZE, NULL, 0, BLOCK_CIPHER_SW_OPTION_AUTHENTICATE_ONLY);
+    }
+    configuredCycles = BENCHMARK_CyclesGet() - start;
+
+    if (memcmp (context.authTag, reference, 16) != 0)
+    {
+        printf ("GHASH result does not match the bit-serial reference\n");
+        return EXIT_FAILURE;
+    }
+
+#if defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT)
+    printf ("GHASH path:          8-bit table (%u byte context)\n", (unsigned)sizeof(context));
+#elif defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT)
+    printf ("GHASH path:          4-bit table (%u byte context)\n", (unsigned)sizeof(context));
+#else
+    printf ("GHASH path:          bit-serial (%u byte context)\n", (unsigned)sizeof(context));
+#endif
+#if defined(__i386__) || defined(__x86_64__)
+    printf ("Bit-serial:          %.2f cycles/byte\n", (double)serialCycles / BENCHMARK_BYTES);
+    printf ("Configured:          %.2f cycles/byte\n", (double)configuredCycles / BENCHMARK_BYTES);
+#else
+    printf ("Bit-serial:          %.2f ns/byte\n", (double)serialCycles / BENCHMARK_BYTES);
+    printf ("Configured:          %.2f ns/byte\n", (double)configuredCycles / BENCHMARK_BYTES);
+#endif
+    printf ("Speedup:             %.1fx\n", (double)serialCycles / configuredCycles);
+
+    BLOCK_CIPHER_SW_Close (handle);
+    BLOCK_CIPHER_SW_Deinitialize (sysObject);
+
+    return EXIT_SUCCESS;
+}
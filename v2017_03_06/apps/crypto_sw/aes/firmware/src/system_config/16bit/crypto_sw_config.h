@@ -31,6 +31,12 @@
 
 // Defines the maximum number of block cipher handles
 #define CRYPTO_CONFIG_SW_BLOCK_HANDLE_MAXIMUM  10u
+
+// GHASH multiplication method used by the GCM mode.  Define at most one of these; with neither
+// defined, GCM uses a bit-serial multiply that needs no table.  The table is stored in each
+// BLOCK_CIPHER_SW_GCM_CONTEXT and is built from the hash subkey by BLOCK_CIPHER_SW_GCM_Initialize.
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT         // 256-byte table per context, 32 bytes of constant data
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT         // 4096-byte table per context, 512 bytes of constant data
  
 /****************************************************************************************************************************/
 /* AES Configuration options                                                                                                */
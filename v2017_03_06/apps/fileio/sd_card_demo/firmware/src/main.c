@@ -60,6 +60,8 @@ const FILEIO_DRIVE_CONFIG gSdDrive =
     (FILEIO_DRIVER_SectorRead)FILEIO_SD_SectorRead,                         // Function to read a sector from the media.
     (FILEIO_DRIVER_SectorWrite)FILEIO_SD_SectorWrite,                       // Function to write a sector to the media.
     (FILEIO_DRIVER_WriteProtectStateGet)FILEIO_SD_WriteProtectStateGet,     // Function to determine if the media is write-protected.
+    (FILEIO_DRIVER_MultipleSectorRead)FILEIO_SD_MultipleSectorRead,         // Function to read several consecutive sectors from the media.
+    (FILEIO_DRIVER_MultipleSectorWrite)FILEIO_SD_MultipleSectorWrite,       // Function to write several consecutive sectors to the media.
 };
 
 // Declare a state machine for our device
@@ -0,0 +1,44 @@
+/******************************************************************************
+*
+*                    File I/O SD Card Demo Simulator Configuration
+*
+******************************************************************************
+* FileName:           fileio_config.h
+* Processor:          Host (Linux) simulator
+* Compiler:           GCC
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+#ifndef _FS_SIMULATOR_DEF_
+#define _FS_SIMULATOR_DEF_
+
+// The simulator uses the demo's configuration, with a small sector cache so
+// the test in sector_cache_test.c can fill it and force evictions.
+#include "../../fileio_config.h"
+
+#if !defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE)
+    #define FILEIO_CONFIG_SECTOR_CACHE_SIZE     4
+#endif
+
+#endif
@@ -0,0 +1,196 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           free_cluster_test.c
+* Dependencies:       fileio.h
+* Processor:          Host (Linux) simulator
+* Compiler:           GCC
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+/*******************************************************************************
+  Host (Linux) test of free cluster allocation.  A FAT16 and a FAT32 volume are
+  built in RAM with their first TEST_USED_CLUSTERS data clusters in use, and the
+  FAT32 FSInfo sector pointing past them.  Build and run from the firmware
+  directory; __XC32__ is defined so the library packs its boot sector
+  structures as it does on PIC32:
+
+    gcc -O2 -D__XC32__ -Isrc/system_config/linux_simulator -I../../../../framework/fileio/inc \
+        src/system_config/linux_simulator/free_cluster_test.c \
+        src/system_config/linux_simulator/ram_disk.c \
+        ../../../../framework/fileio/src/fileio.c -o free_cluster_test
+    ./free_cluster_test
+
+  For each volume the test reports the sectors read at mount time and the FAT
+  entries read to allocate the clusters of a file, and checks that:
+    - Only FAT32 reads a sector at mount time for the free cluster hint, and
+      its first allocation starts at the hint instead of cluster 2.
+    - The hint is written to the FSInfo sector on unmount and loaded again
+      on the next mount.
+    - FILEIO_DriveUnmount reports a failure when the hint cannot be written,
+      and still releases the drive.
+  The program returns 0 when every check passes.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "fileio.h"
+#include "ram_disk.h"
+
+// Data clusters that are already in use on the test volumes
+#define TEST_USED_CLUSTERS          1000ul
+// Clusters written to each test file
+#define TEST_FILE_CLUSTERS          8u
+// Offset of the next free cluster field in the FSInfo sector
+#define TEST_FSINFO_NEXT_FREE       492u
+
+static uint8_t fileData[TEST_FILE_CLUSTERS * 4 * RAM_DISK_SECTOR_SIZE];
+static unsigned int failures;
+
+static void TEST_Check (const char * description, bool passed)
+{
+    printf ("  %-56s: %s\n", description, passed ? "pass" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+static uint32_t TEST_FsInfoNextFreeGet (void)
+{
+    uint8_t * fsInfo = RAM_DISK_SectorGet (1);
+
+    return fsInfo[TEST_FSINFO_NEXT_FREE] | ((uint32_t)fsInfo[TEST_FSINFO_NEXT_FREE + 1] << 8) |
+            ((uint32_t)fsInfo[TEST_FSINFO_NEXT_FREE + 2] << 16) | ((uint32_t)fsInfo[TEST_FSINFO_NEXT_FREE + 3] << 24);
+}
+
+static bool TEST_FileWrite (const char * name, uint32_t length)
+{
+    FILEIO_OBJECT file;
+    bool passed;
+
+    if (FILEIO_Open (&file, name, FILEIO_OPEN_WRITE | FILEIO_OPEN_CREATE) != FILEIO_RESULT_SUCCESS)
+    {
+        return false;
+    }
+    passed = (FILEIO_Write (fileData, 1, length, &file) == length);
+    passed &= (FILEIO_Close (&file) == FILEIO_RESULT_SUCCESS);
+
+    return passed;
+}
+
+static void TEST_VolumeRun (const RAM_DISK_VOLUME * volume)
+{
+    FILEIO_FREE_CLUSTER_STATISTICS statistics;
+    uint32_t fileSize = TEST_FILE_CLUSTERS * volume->sectorsPerCluster * RAM_DISK_SECTOR_SIZE;
+    uint32_t firstFree = (volume->fat32 ? 3 : 2) + TEST_USED_CLUSTERS;
+    uint32_t readsBefore;
+    uint32_t hint;
+    bool passed;
+
+    printf ("%s volume, %lu clusters in use\n", volume->name, (unsigned long)TEST_USED_CLUSTERS);
+    RAM_DISK_VolumeCreate (volume, TEST_USED_CLUSTERS);
+
+    readsBefore = gRamDiskReads;
+    if (FILEIO_DriveMount ('A', &gRamDrive, NULL) != FILEIO_ERROR_NONE)
+    {
+        TEST_Check ("mount", false);
+        RAM_DISK_VolumeDelete ();
+        return;
+    }
+    FILEIO_FreeClusterStatisticsGet ('A', &statistics);
+    printf ("  media reads at mount %lu, of which for the free cluster hint %lu\n",
+            (unsigned long)(gRamDiskReads - readsBefore), (unsigned long)statistics.mountSectorReads);
+    TEST_Check ("mount time hint read only on FAT32", statistics.mountSectorReads == (volume->fat32 ? 1 : 0));
+    TEST_Check ("search starts at the FSInfo hint", statistics.nextFreeCluster == (volume->fat32 ? firstFree : 2));
+
+    TEST_Check ("file written", TEST_FileWrite ("F0.BIN", fileSize));
+    FILEIO_FreeClusterStatisticsGet ('A', &statistics);
+    printf ("  FAT entries read to allocate %u clusters: %lu\n", TEST_FILE_CLUSTERS, (unsigned long)statistics.clustersSearched);
+    if (volume->fat32)
+    {
+        TEST_Check ("allocation skipped the clusters in use", statistics.clustersSearched < TEST_USED_CLUSTERS);
+    }
+    hint = statistics.nextFreeCluster;
+
+    TEST_Check ("unmount", FILEIO_DriveUnmount ('A') == FILEIO_RESULT_SUCCESS);
+    passed = (FILEIO_DriveMount ('A', &gRamDrive, NULL) == FILEIO_ERROR_NONE);
+    passed = passed && (FILEIO_FreeClusterStatisticsGet ('A', &statistics) == FILEIO_RESULT_SUCCESS);
+    if (volume->fat32)
+    {
+        TEST_Check ("hint saved on unmount and loaded on mount", passed && (TEST_FsInfoNextFreeGet () == hint) && (statistics.nextFreeCluster == hint));
+    }
+    else
+    {
+        TEST_Check ("remount", passed);
+    }
+
+    // Every write to the media fails from here until the drive has been unmounted
+    TEST_Check ("file written", TEST_FileWrite ("F1.BIN", fileSize));
+    gRamDiskWriteFail = true;
+    if (volume->fat32)
+    {
+        TEST_Check ("unmount reports the failed hint write", FILEIO_DriveUnmount ('A') == FILEIO_RESULT_FAILURE);
+        TEST_Check ("hint on the media unchanged", TEST_FsInfoNextFreeGet () == hint);
+    }
+    else
+    {
+        TEST_Check ("unmount with nothing to write", FILEIO_DriveUnmount ('A') == FILEIO_RESULT_SUCCESS);
+    }
+    gRamDiskWriteFail = false;
+    TEST_Check ("drive released by unmount", FILEIO_FreeClusterStatisticsGet ('A', &statistics) == FILEIO_RESULT_FAILURE);
+    TEST_Check ("mount after unmount", FILEIO_DriveMount ('A', &gRamDrive, NULL) == FILEIO_ERROR_NONE);
+    FILEIO_DriveUnmount ('A');
+
+    RAM_DISK_VolumeDelete ();
+}
+
+int main (void)
+{
+    uint32_t i;
+
+    srand (1);
+    for (i = 0; i < sizeof (fileData); i++)
+    {
+        fileData[i] = (uint8_t)rand ();
+    }
+
+    if (!FILEIO_Initialize ())
+    {
+        printf ("FILEIO_Initialize failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < RAM_DISK_VOLUME_COUNT; i++)
+    {
+        TEST_VolumeRun (&gRamDiskVolumes[i]);
+    }
+
+    printf ("%u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
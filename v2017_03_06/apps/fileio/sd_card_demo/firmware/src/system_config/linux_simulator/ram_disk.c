@@ -0,0 +1,219 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           ram_disk.c
+* Processor:          Host (Linux) simulator
+* Compiler:           GCC
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "ram_disk.h"
+
+const RAM_DISK_VOLUME gRamDiskVolumes[RAM_DISK_VOLUME_COUNT] =
+{
+    {"FAT16", 32768ul, 4, 1, 512, 32, false},
+    {"FAT32", 70000ul, 1, 32, 0, 547, true},
+};
+
+uint32_t gRamDiskReads;
+uint32_t gRamDiskWrites;
+bool gRamDiskWriteFail;
+
+static uint8_t * media;
+static uint32_t mediaSectorCount;
+static FILEIO_MEDIA_INFORMATION mediaInformation;
+
+static bool RAM_DISK_MediaDetect (void * mediaConfig)
+{
+    return true;
+}
+
+static FILEIO_MEDIA_INFORMATION * RAM_DISK_MediaInitialize (void * mediaConfig)
+{
+    memset (&mediaInformation, 0, sizeof (mediaInformation));
+    mediaInformation.errorCode = MEDIA_NO_ERROR;
+    mediaInformation.validityFlags.bits.sectorSize = 1;
+    mediaInformation.sectorSize = RAM_DISK_SECTOR_SIZE;
+    return &mediaInformation;
+}
+
+static bool RAM_DISK_MediaDeinitialize (void * mediaConfig)
+{
+    return true;
+}
+
+static bool RAM_DISK_SectorRead (void * mediaConfig, uint32_t sector, uint8_t * buffer)
+{
+    if (sector >= mediaSectorCount)
+    {
+        return false;
+    }
+    memcpy (buffer, RAM_DISK_SectorGet (sector), RAM_DISK_SECTOR_SIZE);
+    gRamDiskReads++;
+    return true;
+}
+
+static uint8_t RAM_DISK_SectorWrite (void * mediaConfig, uint32_t sector, uint8_t * buffer, bool allowWriteToZero)
+{
+    if (gRamDiskWriteFail || (sector >= mediaSectorCount) || ((sector == 0) && !allowWriteToZero))
+    {
+        return false;
+    }
+    memcpy (RAM_DISK_SectorGet (sector), buffer, RAM_DISK_SECTOR_SIZE);
+    gRamDiskWrites++;
+    return true;
+}
+
+static bool RAM_DISK_WriteProtectStateGet (void * mediaConfig)
+{
+    return false;
+}
+
+const FILEIO_DRIVE_CONFIG gRamDrive =
+{
+    (FILEIO_DRIVER_IOInitialize)NULL,                                   // No I/O pins to set up.
+    (FILEIO_DRIVER_MediaDetect)RAM_DISK_MediaDetect,                    // Function to detect that the media is inserted.
+    (FILEIO_DRIVER_MediaInitialize)RAM_DISK_MediaInitialize,            // Function to initialize the media.
+    (FILEIO_DRIVER_MediaDeinitialize)RAM_DISK_MediaDeinitialize,        // Function to de-initialize the media.
+    (FILEIO_DRIVER_SectorRead)RAM_DISK_SectorRead,                      // Function to read a sector from the media.
+    (FILEIO_DRIVER_SectorWrite)RAM_DISK_SectorWrite,                    // Function to write a sector to the media.
+    (FILEIO_DRIVER_WriteProtectStateGet)RAM_DISK_WriteProtectStateGet,  // Function to determine if the media is write-protected.
+    (FILEIO_DRIVER_MultipleSectorRead)NULL,
+    (FILEIO_DRIVER_MultipleSectorWrite)NULL,
+};
+
+static void RAM_DISK_Put16 (uint8_t * p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void RAM_DISK_Put32 (uint8_t * p, uint32_t value)
+{
+    RAM_DISK_Put16 (p, (uint16_t)value);
+    RAM_DISK_Put16 (p + 2, (uint16_t)(value >> 16));
+}
+
+void RAM_DISK_VolumeCreate (const RAM_DISK_VOLUME * volume, uint32_t usedClusters)
+{
+    uint8_t * bootSector;
+    uint8_t * fat;
+    uint32_t cluster;
+    uint32_t firstFree;
+    uint8_t i;
+
+    mediaSectorCount = volume->totalSectors;
+    media = calloc (mediaSectorCount, RAM_DISK_SECTOR_SIZE);
+    if (media == NULL)
+    {
+        printf ("Out of memory\n");
+        exit (1);
+    }
+    gRamDiskReads = 0;
+    gRamDiskWrites = 0;
+    gRamDiskWriteFail = false;
+
+    // On FAT32 cluster 2 holds the root directory
+    firstFree = (volume->fat32 ? 3 : 2) + usedClusters;
+
+    bootSector = media;
+    bootSector[0] = 0xEB;
+    bootSector[1] = 0x58;
+    bootSector[2] = 0x90;
+    memcpy (bootSector + 3, "MSDOS5.0", 8);
+    RAM_DISK_Put16 (bootSector + 11, RAM_DISK_SECTOR_SIZE);
+    bootSector[13] = volume->sectorsPerCluster;
+    RAM_DISK_Put16 (bootSector + 14, volume->reservedSectors);
+    bootSector[16] = 2;
+    RAM_DISK_Put16 (bootSector + 17, volume->rootEntries);
+    bootSector[21] = 0xF8;
+    RAM_DISK_Put16 (bootSector + 24, 63);
+    RAM_DISK_Put16 (bootSector + 26, 255);
+    RAM_DISK_Put32 (bootSector + 32, volume->totalSectors);
+    if (volume->fat32)
+    {
+        RAM_DISK_Put32 (bootSector + 36, volume->fatSectors);
+        RAM_DISK_Put32 (bootSector + 44, 2);
+        RAM_DISK_Put16 (bootSector + 48, 1);
+        RAM_DISK_Put16 (bootSector + 50, 6);
+        bootSector[64] = 0x80;
+        bootSector[66] = 0x29;
+        memcpy (bootSector + 71, "NO NAME    FAT32   ", 19);
+
+        // FSInfo sector, with an unknown free count
+        RAM_DISK_Put32 (media + RAM_DISK_SECTOR_SIZE, 0x41615252);
+        RAM_DISK_Put32 (media + RAM_DISK_SECTOR_SIZE + 484, 0x61417272);
+        RAM_DISK_Put32 (media + RAM_DISK_SECTOR_SIZE + 488, 0xFFFFFFFF);
+        RAM_DISK_Put32 (media + RAM_DISK_SECTOR_SIZE + 492, firstFree);
+        RAM_DISK_Put32 (media + RAM_DISK_SECTOR_SIZE + 508, 0xAA550000);
+    }
+    else
+    {
+        RAM_DISK_Put16 (bootSector + 22, (uint16_t)volume->fatSectors);
+        bootSector[36] = 0x80;
+        bootSector[38] = 0x29;
+        memcpy (bootSector + 43, "NO NAME    FAT16   ", 19);
+    }
+    bootSector[510] = 0x55;
+    bootSector[511] = 0xAA;
+    if (volume->fat32)
+    {
+        memcpy (media + (6 * RAM_DISK_SECTOR_SIZE), bootSector, RAM_DISK_SECTOR_SIZE);
+    }
+
+    // Media descriptor and end of chain entries, then the clusters that are already in use
+    for (i = 0; i < 2; i++)
+    {
+        fat = media + ((volume->reservedSectors + (i * volume->fatSectors)) * RAM_DISK_SECTOR_SIZE);
+        for (cluster = 0; cluster < firstFree; cluster++)
+        {
+            if (volume->fat32)
+            {
+                RAM_DISK_Put32 (fat + (cluster * 4), (cluster == 0) ? 0x0FFFFFF8 : 0x0FFFFFFF);
+            }
+            else
+            {
+                RAM_DISK_Put16 (fat + (cluster * 2), (cluster == 0) ? 0xFFF8 : 0xFFFF);
+            }
+        }
+    }
+}
+
+void RAM_DISK_VolumeDelete (void)
+{
+    free (media);
+    media = NULL;
+    mediaSectorCount = 0;
+}
+
+uint8_t * RAM_DISK_SectorGet (uint32_t sector)
+{
+    return media + (sector * RAM_DISK_SECTOR_SIZE);
+}
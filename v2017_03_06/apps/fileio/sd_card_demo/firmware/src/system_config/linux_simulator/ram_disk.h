@@ -0,0 +1,75 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           ram_disk.h
+* Processor:          Host (Linux) simulator
+* Compiler:           GCC
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+#ifndef _RAM_DISK_H
+#define _RAM_DISK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "fileio.h"
+
+#define RAM_DISK_SECTOR_SIZE        512u
+
+// Layout of a volume built by RAM_DISK_VolumeCreate.  The root directory starts right after the FATs.
+typedef struct
+{
+    const char * name;
+    uint32_t totalSectors;
+    uint8_t sectorsPerCluster;
+    uint16_t reservedSectors;
+    uint16_t rootEntries;
+    uint32_t fatSectors;
+    bool fat32;
+} RAM_DISK_VOLUME;
+
+// A FAT16 and a FAT32 volume
+#define RAM_DISK_VOLUME_COUNT       2
+extern const RAM_DISK_VOLUME gRamDiskVolumes[RAM_DISK_VOLUME_COUNT];
+
+// Drive functions for the RAM disk.  The multiple sector functions are left out, so all file data
+// passes through the FILEIO buffers and sector cache.
+extern const FILEIO_DRIVE_CONFIG gRamDrive;
+
+// Media access counters, and a switch that makes every sector write fail
+extern uint32_t gRamDiskReads;
+extern uint32_t gRamDiskWrites;
+extern bool gRamDiskWriteFail;
+
+// Builds an empty, unpartitioned volume.  The first usedClusters data clusters (after the FAT32 root
+// directory) are marked as allocated, and on FAT32 the FSInfo next free cluster is set past them.
+void RAM_DISK_VolumeCreate (const RAM_DISK_VOLUME * volume, uint32_t usedClusters);
+void RAM_DISK_VolumeDelete (void);
+
+// Returns the media copy of a sector
+uint8_t * RAM_DISK_SectorGet (uint32_t sector);
+
+#endif
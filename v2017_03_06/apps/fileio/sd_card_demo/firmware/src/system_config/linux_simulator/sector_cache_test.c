@@ -0,0 +1,234 @@
+/******************************************************************************
+*
+*                        Microchip File I/O Library
+*
+******************************************************************************
+* FileName:           sector_cache_test.c
+* Dependencies:       fileio.h
+* Processor:          Host (Linux) simulator
+* Compiler:           GCC
+* Company:            Microchip Technology, Inc.
+*
+* Software License Agreement
+*
+* The software supplied herewith by Microchip Technology Incorporated
+* (the "Company") for its PICmicro(R) Microcontroller is intended and
+* supplied to you, the Company's customer, for use solely and
+* exclusively on Microchip PICmicro Microcontroller products. The
+* software is owned by the Company and/or its supplier, and is
+* protected under applicable copyright laws. All rights are reserved.
+* Any use in violation of the foregoing restrictions may subject the
+* user to criminal sanctions under applicable laws, as well as to
+* civil liability for the breach of the terms and conditions of this
+* license.
+*
+* THIS SOFTWARE IS PROVIDED IN AN "AS IS" CONDITION. NO WARRANTIES,
+* WHETHER EXPRESS, IMPLIED OR STATUTORY, INCLUDING, BUT NOT LIMITED
+* TO, IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+* PARTICULAR PURPOSE APPLY TO THIS SOFTWARE. THE COMPANY SHALL NOT,
+* IN ANY CIRCUMSTANCES, BE LIABLE FOR SPECIAL, INCIDENTAL OR
+* CONSEQUENTIAL DAMAGES, FOR ANY REASON WHATSOEVER.
+*
+********************************************************************/
+
+/*******************************************************************************
+  Host (Linux) test of the FILEIO sector cache.  A FAT16 and a FAT32 volume are
+  built in RAM and used through the library with the cache size set in
+  fileio_config.h.  Build and run from the firmware directory; __XC32__ is
+  defined so the library packs its boot sector structures as it does on PIC32:
+
+    gcc -O2 -D__XC32__ -Isrc/system_config/linux_simulator -I../../../../framework/fileio/inc \
+        src/system_config/linux_simulator/sector_cache_test.c \
+        src/system_config/linux_simulator/ram_disk.c \
+        ../../../../framework/fileio/src/fileio.c -o sector_cache_test
+    ./sector_cache_test
+
+  For each volume the test checks that:
+    - Writing more sectors than the cache holds sends the least recently used
+      ones to the media before the files are closed, and the files read back
+      correctly after the drive is remounted.
+    - The directory and FAT changes that FILEIO_Remove leaves in the cache do
+      not reach the media until the drive is unmounted, and do reach it then.
+  The program returns 0 when every check passes.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "fileio.h"
+#include "ram_disk.h"
+
+// FILEIO_Remove changes a directory sector and a FAT sector, which must both fit in the cache
+#if !defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) || (FILEIO_CONFIG_SECTOR_CACHE_SIZE < 2)
+    #error "The sector cache test needs FILEIO_CONFIG_SECTOR_CACHE_SIZE of 2 or more in fileio_config.h."
+#endif
+
+// Number of files written at the same time, and the size of each
+#define TEST_FILE_COUNT             3
+#define TEST_FILE_SIZE              20000u
+// Largest piece handed to FILEIO_Write; smaller than a sector so every write goes through the cache
+#define TEST_WRITE_SIZE_MAX         700u
+
+static uint8_t fileData[TEST_FILE_COUNT][TEST_FILE_SIZE];
+static uint8_t readData[TEST_FILE_SIZE];
+static unsigned int failures;
+
+static void TEST_Check (const char * description, bool passed)
+{
+    printf ("  %-56s: %s\n", description, passed ? "pass" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+// Returns the first byte of the media copy of the root directory entry whose name ends in the
+// given 10 characters (the first character is replaced when an entry is deleted), or 0 if none.
+static uint8_t TEST_RootEntryState (const RAM_DISK_VOLUME * volume, const char * nameTail)
+{
+    uint8_t * entry = RAM_DISK_SectorGet (volume->reservedSectors + (2 * volume->fatSectors));
+    uint8_t i;
+
+    for (i = 0; i < (RAM_DISK_SECTOR_SIZE / 32); i++, entry += 32)
+    {
+        if ((entry[0] != 0) && (memcmp (entry + 1, nameTail, 10) == 0))
+        {
+            return entry[0];
+        }
+    }
+
+    return 0;
+}
+
+static bool TEST_FileCompare (const char * name, const uint8_t * expected)
+{
+    FILEIO_OBJECT file;
+    bool matches;
+
+    if (FILEIO_Open (&file, name, FILEIO_OPEN_READ) != FILEIO_RESULT_SUCCESS)
+    {
+        return false;
+    }
+    matches = (FILEIO_Read (readData, 1, TEST_FILE_SIZE, &file) == TEST_FILE_SIZE) && (memcmp (readData, expected, TEST_FILE_SIZE) == 0);
+    FILEIO_Close (&file);
+
+    return matches;
+}
+
+static void TEST_VolumeRun (const RAM_DISK_VOLUME * volume)
+{
+    FILEIO_CACHE_STATISTICS before;
+    FILEIO_CACHE_STATISTICS after;
+    FILEIO_OBJECT file[TEST_FILE_COUNT];
+    uint32_t written[TEST_FILE_COUNT];
+    uint32_t total;
+    uint32_t writesBefore;
+    uint32_t sectorsDirtied;
+    uint32_t length;
+    char name[8];
+    bool passed;
+    uint8_t k;
+
+    printf ("%s volume, %u sector cache\n", volume->name, FILEIO_CONFIG_SECTOR_CACHE_SIZE);
+    RAM_DISK_VolumeCreate (volume, 0);
+
+    if (FILEIO_DriveMount ('A', &gRamDrive, NULL) != FILEIO_ERROR_NONE)
+    {
+        TEST_Check ("mount", false);
+        RAM_DISK_VolumeDelete ();
+        return;
+    }
+
+    // Eviction: write the files a piece at a time, interleaved, so each sector is dirtied in the cache
+    FILEIO_CacheStatisticsGet (&before);
+    passed = true;
+    for (k = 0; k < TEST_FILE_COUNT; k++)
+    {
+        sprintf (name, "F%u.BIN", k);
+        passed &= (FILEIO_Open (&file[k], name, FILEIO_OPEN_WRITE | FILEIO_OPEN_CREATE) == FILEIO_RESULT_SUCCESS);
+        written[k] = 0;
+    }
+    for (total = 0; passed && (total < (TEST_FILE_COUNT * TEST_FILE_SIZE)); )
+    {
+        for (k = 0; k < TEST_FILE_COUNT; k++)
+        {
+            length = 1 + (rand () % TEST_WRITE_SIZE_MAX);
+            if (length > (TEST_FILE_SIZE - written[k]))
+            {
+                length = TEST_FILE_SIZE - written[k];
+            }
+            passed &= (FILEIO_Write (fileData[k] + written[k], 1, length, &file[k]) == length);
+            written[k] += length;
+            total += length;
+        }
+    }
+    TEST_Check ("files written", passed);
+
+    // Only the cache and the data buffer can still hold sectors that have not reached the media
+    FILEIO_CacheStatisticsGet (&after);
+    sectorsDirtied = TEST_FILE_COUNT * ((TEST_FILE_SIZE + RAM_DISK_SECTOR_SIZE - 1) / RAM_DISK_SECTOR_SIZE);
+    printf ("  file sectors written %lu, write-backs before close %lu\n",
+            (unsigned long)sectorsDirtied, (unsigned long)(after.writeBacks - before.writeBacks));
+    TEST_Check ("least recently used sectors written back before close", (after.writeBacks - before.writeBacks) >= (sectorsDirtied - FILEIO_CONFIG_SECTOR_CACHE_SIZE - 1));
+
+    passed = true;
+    for (k = 0; k < TEST_FILE_COUNT; k++)
+    {
+        passed &= (FILEIO_Close (&file[k]) == FILEIO_RESULT_SUCCESS);
+    }
+    TEST_Check ("files closed", passed);
+    TEST_Check ("unmount", FILEIO_DriveUnmount ('A') == FILEIO_RESULT_SUCCESS);
+
+    passed = (FILEIO_DriveMount ('A', &gRamDrive, NULL) == FILEIO_ERROR_NONE);
+    for (k = 0; passed && (k < TEST_FILE_COUNT); k++)
+    {
+        sprintf (name, "F%u.BIN", k);
+        passed = TEST_FileCompare (name, fileData[k]);
+    }
+    TEST_Check ("files read back after remount", passed);
+
+    // Flush on unmount: nothing below reaches the media until the drive is unmounted
+    writesBefore = gRamDiskWrites;
+    TEST_Check ("remove", FILEIO_Remove ("F1.BIN") == FILEIO_RESULT_SUCCESS);
+    TEST_Check ("removal held in the cache", (gRamDiskWrites == writesBefore) && (TEST_RootEntryState (volume, "1      BIN") == 'F'));
+    TEST_Check ("unmount", FILEIO_DriveUnmount ('A') == FILEIO_RESULT_SUCCESS);
+    TEST_Check ("removal written to the media on unmount", (gRamDiskWrites != writesBefore) && (TEST_RootEntryState (volume, "1      BIN") == 0xE5));
+
+    passed = (FILEIO_DriveMount ('A', &gRamDrive, NULL) == FILEIO_ERROR_NONE);
+    passed = passed && (FILEIO_Open (&file[1], "F1.BIN", FILEIO_OPEN_READ) != FILEIO_RESULT_SUCCESS);
+    passed = passed && TEST_FileCompare ("F0.BIN", fileData[0]) && TEST_FileCompare ("F2.BIN", fileData[2]);
+    TEST_Check ("other files intact after remount", passed);
+    FILEIO_DriveUnmount ('A');
+
+    RAM_DISK_VolumeDelete ();
+}
+
+int main (void)
+{
+    uint8_t i;
+    uint32_t j;
+
+    srand (1);
+    for (i = 0; i < TEST_FILE_COUNT; i++)
+    {
+        for (j = 0; j < TEST_FILE_SIZE; j++)
+        {
+            fileData[i][j] = (uint8_t)rand ();
+        }
+    }
+
+    if (!FILEIO_Initialize ())
+    {
+        printf ("FILEIO_Initialize failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < RAM_DISK_VOLUME_COUNT; i++)
+    {
+        TEST_VolumeRun (&gRamDiskVolumes[i]);
+    }
+
+    printf ("%u failures\n", failures);
+    return (failures == 0) ? 0 : 1;
+}
@@ -543,7 +543,7 @@ void APP_initKeys(void)
         pKeyNames[item + adj] = pVarLbl[randomVal];
 
         // adjust the list of available pointers
-        while(randomVal < (MAXENTRY - item + 1))
+        while(randomVal < (MAXENTRY - item))
         {
             pVarLbl[randomVal] = pVarLbl[randomVal + 1];
             randomVal++;
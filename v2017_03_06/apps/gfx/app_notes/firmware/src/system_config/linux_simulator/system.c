@@ -0,0 +1,638 @@
+/*******************************************************************************
+  System Specific Initializations
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system.c
+
+  Summary:
+    System level initializations for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*******************************************************************************
+  Host (Linux) build of the application notes demo against the simulated
+  display (framework/driver/gfx/src/drv_gfx_sim.c).  Build from the src
+  directory with, for example:
+
+    gcc -O2 -fgnu89-inline -Isystem_config/linux_simulator -I. \
+        -I../../../../../framework -I../../../../../bsp/linux_simulator \
+        main.c an1136_demo.c an1182_demo.c an1227_demo.c an1246_demo.c \
+        internal_resource_main_reference.c \
+        internal_resource_an1136_reference.c \
+        internal_resource_an1182_reference.c \
+        external_resource_main_reference.c \
+        system_config/linux_simulator/system.c \
+        ../../../../../framework/gfx/src/gfx_primitive.c \
+        ../../../../../framework/gfx/src/gfx_gol.c \
+        ../../../../../framework/gfx/src/gfx_gol_button.c \
+        ../../../../../framework/gfx/src/gfx_gol_group_box.c \
+        ../../../../../framework/gfx/src/gfx_gol_scroll_bar.c \
+        ../../../../../framework/gfx/src/gfx_gol_static_text.c \
+        ../../../../../framework/gfx/src/gfx_gol_text_entry.c \
+        ../../../../../framework/driver/gfx/src/drv_gfx_sim.c \
+        -o app_notes_sim
+
+  -fgnu89-inline keeps the extern inline functions of the library headers
+  from being emitted in every translation unit.
+
+  The touch screen driver is replaced by a replay of the screen touches
+  and side button presses that select the internal resources, then open
+  every application note from the main menu, work its controls and go
+  back.  Set GFX_SIM_DUMP_PREFIX in the environment (for example to
+  /tmp/screen_) to write the screen to a numbered PNG file at the end
+  of every replay stage.
+*******************************************************************************/
+
+// *****************************************************************************
+// Section: Includes
+// *****************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "system.h"
+#include "driver/gfx/drv_gfx_display.h"
+#include "driver/gfx/drv_gfx_sim.h"
+#include "main.h"
+#include "an1246_demo.h"
+#include "internal_resource_an1136.h"
+#include "internal_resource_an1182.h"
+
+// *****************************************************************************
+// Section: Resource Data
+// *****************************************************************************
+// The image and font data referenced by the internal resource files is
+// produced by the Graphics Resource Converter for the PIC program memory
+// and is not part of the host build.  Stand-in data of the same geometry
+// is generated into these arrays by SYSTEM_BoardInitialize().
+uint8_t __MCHPFolderFile_8bpp_72x72[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 8)] __attribute__((aligned(2)));
+uint8_t __MCHPFolderEmpty_8bpp_72x72[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 8)] __attribute__((aligned(2)));
+uint8_t __background_abstract_light_weave_4bpp_480x272[DRV_GFX_SIM_IMAGE_DATA_SIZE(480, 272, 4)] __attribute__((aligned(2)));
+uint8_t __shifted_green_left_arrow[DRV_GFX_SIM_IMAGE_DATA_SIZE(117, 39, 8)] __attribute__((aligned(2)));
+uint8_t __shifted_green_right_arrow[DRV_GFX_SIM_IMAGE_DATA_SIZE(117, 39, 4)] __attribute__((aligned(2)));
+uint8_t __redLArrow[DRV_GFX_SIM_IMAGE_DATA_SIZE(45, 40, 4)] __attribute__((aligned(2)));
+uint8_t __redRArrow[DRV_GFX_SIM_IMAGE_DATA_SIZE(45, 40, 4)] __attribute__((aligned(2)));
+uint8_t __DroidSans_Bold_14[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x3D, 17, 2)] __attribute__((aligned(2)));
+uint8_t __Gentium27[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x7E, 27, 1)] __attribute__((aligned(2)));
+uint8_t __ChineseFont[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x24, 22, 2)] __attribute__((aligned(2)));
+uint8_t __JapaneseFont[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x28, 25, 2)] __attribute__((aligned(2)));
+uint8_t __HindiFont[DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE(0x20, 0x29, 31, 2)] __attribute__((aligned(4)));
+uint8_t __ThaiFont[DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE(0x20, 0x2A, 29, 2)] __attribute__((aligned(4)));
+
+typedef struct
+{
+    const GFX_RESOURCE_HDR  *pResource;
+    uint8_t                 *pData;
+    uint32_t                size;
+} SYSTEM_RESOURCE_DATA;
+
+static const SYSTEM_RESOURCE_DATA resourceData[] =
+{
+    { &MCHPFolderFile_8bpp_72x72,   __MCHPFolderFile_8bpp_72x72,    sizeof(__MCHPFolderFile_8bpp_72x72)     },
+    { &MCHPFolderEmpty_8bpp_72x72,  __MCHPFolderEmpty_8bpp_72x72,   sizeof(__MCHPFolderEmpty_8bpp_72x72)    },
+    { &background_abstract_light_weave_4bpp_480x272,
+                                    __background_abstract_light_weave_4bpp_480x272,
+                                    sizeof(__background_abstract_light_weave_4bpp_480x272)                  },
+    { &shifted_green_left_arrow,    __shifted_green_left_arrow,     sizeof(__shifted_green_left_arrow)      },
+    { &shifted_green_right_arrow,   __shifted_green_right_arrow,    sizeof(__shifted_green_right_arrow)     },
+    { &redLArrow,                   __redLArrow,                    sizeof(__redLArrow)                     },
+    { &redRArrow,                   __redRArrow,                    sizeof(__redRArrow)                     },
+    { &DroidSans_Bold_14,           __DroidSans_Bold_14,            sizeof(__DroidSans_Bold_14)             },
+    { &Gentium27,                   __Gentium27,                    sizeof(__Gentium27)                     },
+    { &ChineseFont,                 __ChineseFont,                  sizeof(__ChineseFont)                   },
+    { &JapaneseFont,                __JapaneseFont,                 sizeof(__JapaneseFont)                  },
+    { &HindiFont,                   __HindiFont,                    sizeof(__HindiFont)                     },
+    { &ThaiFont,                    __ThaiFont,                     sizeof(__ThaiFont)                      },
+};
+
+// *****************************************************************************
+// Section: Replay
+// *****************************************************************************
+typedef enum
+{
+    SYSTEM_STAGE_SELECT_MENU = 0,
+    SYSTEM_STAGE_MAIN_MENU,
+    SYSTEM_STAGE_AN1136,
+    SYSTEM_STAGE_AN1182,
+    SYSTEM_STAGE_AN1227,
+    SYSTEM_STAGE_AN1246,
+    SYSTEM_STAGE_COUNT
+} SYSTEM_STAGE;
+
+// One step of the replay: the touch position (-1 when the screen is
+// not touched) and the side buttons held down for a number of passes
+// of the main loop.
+typedef struct
+{
+    SYSTEM_STAGE    stage;
+    int16_t         x, y;
+    uint8_t         buttons;
+    uint16_t        passes;
+} SYSTEM_REPLAY_STEP;
+
+// Passes of the main loop given to the demo to finish drawing after
+// an input, and to the demo timeouts of 'ticks' ticks.
+#define SYSTEM_SETTLE_PASSES            (10)
+#define SYSTEM_TIMEOUT_PASSES(ticks)    (((ticks) / SYSTEM_TICKS_PER_PASS) + SYSTEM_SETTLE_PASSES)
+
+#define SYSTEM_REPLAY_IDLE(stage, passes)                               \
+            { (stage), -1, -1, 0, (passes) }
+#define SYSTEM_REPLAY_TAP(stage, x, y)                                  \
+            { (stage), (x), (y), 0, 2 },                                \
+            SYSTEM_REPLAY_IDLE((stage), SYSTEM_SETTLE_PASSES)
+#define SYSTEM_REPLAY_DRAG(stage, x, y)                                 \
+            { (stage), (x), (y), 0, 1 }
+#define SYSTEM_REPLAY_BUTTON(stage, buttons)                            \
+            { (stage), -1, -1, (buttons), 2 },                          \
+            SYSTEM_REPLAY_IDLE((stage), SYSTEM_SETTLE_PASSES)
+
+// Centers of the 4 x 4 keys of the AN1246 key pad below the text area.
+#define SYSTEM_AN1246_KEY(stage, row, column)                           \
+            SYSTEM_REPLAY_TAP((stage), 40 + ((column) * 79), 60 + ((row) * 51))
+
+// The startup selection screen: run the demo with the internal resources.
+static const SYSTEM_REPLAY_STEP replayStartup[] =
+{
+    SYSTEM_REPLAY_IDLE(SYSTEM_STAGE_SELECT_MENU, SYSTEM_SETTLE_PASSES),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_SELECT_MENU, 159, 44),
+    SYSTEM_REPLAY_IDLE(SYSTEM_STAGE_SELECT_MENU, SYSTEM_TIMEOUT_PASSES(APP_SS_TIMEOUT >> 1)),
+};
+
+// One round trip from the main menu through every application note.
+static const SYSTEM_REPLAY_STEP replayDemos[] =
+{
+    // AN1136: step the slider with both buttons, drag its thumb across
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_MAIN_MENU, 91, 65),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 229, 181),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 229, 181),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 229, 181),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 90, 181),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 90, 181),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 90, 181),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 159, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 190, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 220, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 250, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 280, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 220, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 160, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 100, 127),
+    SYSTEM_REPLAY_DRAG(SYSTEM_STAGE_AN1136, 40, 127),
+    SYSTEM_REPLAY_IDLE(SYSTEM_STAGE_AN1136, SYSTEM_SETTLE_PASSES),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1136, 45, 23),
+
+    // AN1182: go once around the languages and back two
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_MAIN_MENU, 225, 65),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 253, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 65, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 65, 154),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1182, 45, 23),
+
+    // AN1227: touch the buttons, then move the focus and press the
+    // focused button with the side buttons
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_MAIN_MENU, 91, 173),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1227, 159, 65),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1227, 159, 125),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1227, 159, 185),
+    SYSTEM_REPLAY_BUTTON(SYSTEM_STAGE_AN1227, SYSTEM_HW_BUTTON_FOCUS),
+    SYSTEM_REPLAY_BUTTON(SYSTEM_STAGE_AN1227, SYSTEM_HW_BUTTON_CR),
+    SYSTEM_REPLAY_BUTTON(SYSTEM_STAGE_AN1227, SYSTEM_HW_BUTTON_FOCUS),
+    SYSTEM_REPLAY_BUTTON(SYSTEM_STAGE_AN1227, SYSTEM_HW_BUTTON_CR),
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_AN1227, 45, 23),
+
+    // AN1246: enter a code and wait for the result, hide the echo,
+    // type and clear, then leave with the exit key
+    SYSTEM_REPLAY_TAP(SYSTEM_STAGE_MAIN_MENU, 225, 173),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 0, 0),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 0, 1),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 0, 2),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 1, 0),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 2, 3),
+    SYSTEM_REPLAY_IDLE(SYSTEM_STAGE_AN1246, SYSTEM_TIMEOUT_PASSES(CHECKDELAY)),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 3, 0),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 1, 1),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 1, 2),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 3, 2),
+    SYSTEM_AN1246_KEY(SYSTEM_STAGE_AN1246, 3, 3),
+};
+
+typedef struct
+{
+    uint32_t    passes;
+    uint32_t    frames;
+    uint64_t    renderTime;             // ns spent in the passes that drew
+    uint64_t    pixelWrites;
+} SYSTEM_STAGE_STATISTICS;
+
+// *****************************************************************************
+// Section: Variables
+// *****************************************************************************
+uint32_t tick, prevTick;                // tick counter of the demo
+
+static const SYSTEM_REPLAY_STEP *pStep;
+static uint16_t stepPasses;
+static uint16_t replayCount;
+static uint8_t  buttonsDown;
+
+static const char *dumpPrefix;
+static uint32_t screenCount;
+
+static struct timespec passStart;
+static SYSTEM_STAGE passStage;
+static uint64_t passPixelWrites;
+static uint64_t frameTimeMax;
+static SYSTEM_STAGE_STATISTICS stageStatistics[SYSTEM_STAGE_COUNT];
+
+static void SYSTEM_ReplayAdvance(void);
+static void SYSTEM_PassMeasure(void);
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to);
+static void SYSTEM_BenchmarkReport(void);
+
+// *****************************************************************************
+// void SYSTEM_BoardInitialize(void)
+// *****************************************************************************
+void SYSTEM_BoardInitialize(void)
+{
+    const SYSTEM_RESOURCE_DATA *pEntry;
+    bool generated;
+
+    for (pEntry = resourceData; pEntry < &resourceData[sizeof(resourceData) / sizeof(resourceData[0])]; pEntry++)
+    {
+        if ((pEntry->pResource->type & GFX_TYPE_MASK) == GFX_RESOURCE_TYPE_FONT)
+            generated = DRV_GFX_SIM_FontDataGenerate(pEntry->pResource, pEntry->pData, pEntry->size);
+        else
+            generated = DRV_GFX_SIM_ImageDataGenerate(pEntry->pResource, pEntry->pData, pEntry->size);
+
+        if (generated == false)
+        {
+            fprintf(stderr, "cannot generate resource data %u\n", (unsigned)(pEntry - resourceData));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    dumpPrefix = getenv("GFX_SIM_DUMP_PREFIX");
+
+    // ---------------------------------------------------------
+    // Initialize the Display Driver
+    // ---------------------------------------------------------
+    DRV_GFX_Initialize();
+
+    pStep = replayStartup;
+    stepPasses = 0;
+    passStage = pStep->stage;
+
+    clock_gettime(CLOCK_MONOTONIC, &passStart);
+}
+
+// *****************************************************************************
+/*  Function:
+    void SYSTEM_ProgramExternalMemory(void)
+
+    Summary:
+        Routine that programs the external memory used by the
+        application.
+
+    Description:
+        There is no external memory programmer on the simulator, so
+        the demo stops here.  The replay never selects this option.
+
+*/
+// *****************************************************************************
+void SYSTEM_ProgramExternalMemory()
+{
+    fprintf(stderr, "external memory programming is not simulated\n");
+    exit(EXIT_FAILURE);
+}
+
+// *****************************************************************************
+// void SYSTEM_ExternalMemoryRead(uint32_t address, uint8_t *pData, uint16_t nCount)
+// *****************************************************************************
+void SYSTEM_ExternalMemoryRead(uint32_t address, uint8_t *pData, uint16_t nCount)
+{
+    memset(pData, 0xFF, nCount);
+}
+
+// *****************************************************************************
+// HW_BUTTON_STATE SYSTEM_HWButtonGet(uint8_t button)
+// *****************************************************************************
+HW_BUTTON_STATE SYSTEM_HWButtonGet(uint8_t button)
+{
+    return ((buttonsDown & button) ? HW_BUTTON_PRESS : HW_BUTTON_RELEASE);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ExternalResourceCallback(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void     *pBuffer)
+
+    Summary:
+        This function performs data fetch from external memory.
+
+    Description:
+        Reads the resource data from the simulated SPI flash.  The
+        replay runs the demo with the internal resources, so this is
+        only called if the external resources are selected.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ExternalResourceCallback(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void     *pBuffer)
+{
+    uint32_t addr;
+
+    // get the proper address
+    switch (pResource->type)
+    {
+        case GFX_RESOURCE_FONT_EXTERNAL_NONE:
+            addr = pResource->resource.font.location.extAddress;
+            break;
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_RLE:
+        case GFX_RESOURCE_MCHP_MBITMAP_EXTERNAL_NONE:
+            addr = pResource->resource.image.location.extAddress;
+            break;
+        default:
+            // type is incorrect
+            return (GFX_STATUS_FAILURE);
+    }
+
+    NVMRead(addr + offset, (uint8_t *)pBuffer, nCount);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    void TouchGetMsg(GFX_GOL_MESSAGE *pMsg)
+
+    Summary:
+        Populates the GOL message structure from the replay.
+
+    Description:
+        main.c reads one touch screen message per pass of its main loop,
+        after the screen has been drawn.  Each call ends the measurement
+        of a pass, advances the tick counter and the replay by one pass
+        and translates the replayed touch position into a message the
+        same way as the touch screen driver
+        (framework/driver/touch_screen/src/drv_touch_screen.c).
+
+*/
+// *****************************************************************************
+void TouchGetMsg(GFX_GOL_MESSAGE *pMsg)
+{
+    static int16_t    prevX = -1;
+    static int16_t    prevY = -1;
+
+    int16_t           x, y;
+
+    SYSTEM_PassMeasure();
+
+    tick += SYSTEM_TICKS_PER_PASS;
+    SYSTEM_ReplayAdvance();
+
+    // the next pass starts with the processing of this message
+    clock_gettime(CLOCK_MONOTONIC, &passStart);
+
+    x = pStep->x;
+    y = pStep->y;
+    buttonsDown = pStep->buttons;
+    pMsg->type = TYPE_TOUCHSCREEN;
+    pMsg->uiEvent = EVENT_INVALID;
+
+    if((prevX == x) && (prevY == y) && (x != -1) && (y != -1))
+    {
+        pMsg->uiEvent = EVENT_STILLPRESS;
+        pMsg->param1 = x;
+        pMsg->param2 = y;
+        return;
+    }
+
+    if((prevX != -1) || (prevY != -1))
+    {
+        if((x != -1) && (y != -1))
+        {
+            // Move
+            pMsg->uiEvent = EVENT_MOVE;
+        }
+        else
+        {
+            // Released
+            pMsg->uiEvent = EVENT_RELEASE;
+            pMsg->param1 = prevX;
+            pMsg->param2 = prevY;
+            prevX = x;
+            prevY = y;
+            return;
+        }
+    }
+    else
+    {
+        if((x != -1) && (y != -1))
+        {
+            // Pressed
+            pMsg->uiEvent = EVENT_PRESS;
+        }
+    }
+
+    pMsg->param1 = x;
+    pMsg->param2 = y;
+    prevX = x;
+    prevY = y;
+}
+
+// *****************************************************************************
+// static void SYSTEM_ReplayAdvance(void)
+// *****************************************************************************
+static void SYSTEM_ReplayAdvance(void)
+{
+    SYSTEM_STAGE stage = pStep->stage;
+    char fileName[256];
+
+    if (++stepPasses <= pStep->passes)
+        return;
+
+    stepPasses = 1;
+    pStep++;
+
+    if (pStep == &replayStartup[sizeof(replayStartup) / sizeof(replayStartup[0])])
+        pStep = replayDemos;
+
+    if (pStep == &replayDemos[sizeof(replayDemos) / sizeof(replayDemos[0])])
+    {
+        replayCount++;
+        pStep = replayDemos;
+    }
+
+    // the screen is complete when the replay moves to the next stage
+    if (pStep->stage != stage)
+    {
+        if (dumpPrefix != NULL)
+        {
+            snprintf(fileName, sizeof(fileName), "%s%03lu.png", dumpPrefix, (unsigned long)screenCount);
+            if (DRV_GFX_SIM_PNGWrite(fileName) == false)
+            {
+                fprintf(stderr, "cannot write %s\n", fileName);
+            }
+        }
+        screenCount++;
+    }
+
+    if (replayCount >= SYSTEM_BENCHMARK_REPLAYS)
+    {
+        SYSTEM_BenchmarkReport();
+        exit(EXIT_SUCCESS);
+    }
+}
+
+// *****************************************************************************
+// static void SYSTEM_PassMeasure(void)
+// *****************************************************************************
+static void SYSTEM_PassMeasure(void)
+{
+    SYSTEM_STAGE_STATISTICS *pStatistics = &stageStatistics[passStage];
+    struct timespec now;
+    uint64_t passTime;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    // the pass drew the response to the input of the previous pass
+    pStatistics->passes++;
+    if (drvGfxSimStatistics.pixelWrites != passPixelWrites)
+    {
+        passTime = SYSTEM_TimeDifference(&passStart, &now);
+
+        pStatistics->frames++;
+        pStatistics->renderTime += passTime;
+        pStatistics->pixelWrites += drvGfxSimStatistics.pixelWrites - passPixelWrites;
+        if (passTime > frameTimeMax)
+            frameTimeMax = passTime;
+
+        passPixelWrites = drvGfxSimStatistics.pixelWrites;
+    }
+
+    passStage = pStep->stage;
+}
+
+// *****************************************************************************
+// static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+// *****************************************************************************
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+{
+    return ((uint64_t)(to->tv_sec - from->tv_sec) * 1000000000ull)
+            + (uint64_t)to->tv_nsec - (uint64_t)from->tv_nsec;
+}
+
+// *****************************************************************************
+// static void SYSTEM_BenchmarkReport(void)
+// *****************************************************************************
+static void SYSTEM_BenchmarkReport(void)
+{
+    static const char *functionNames[DRV_GFX_SIM_FUNCTION_COUNT] =
+    {
+        "GFX_PixelPut",
+        "GFX_PixelGet",
+        "GFX_PixelArrayPut",
+        "GFX_PixelArrayGet",
+        "GFX_BarDraw",
+        "GFX_ScreenClear",
+    };
+    static const char *stageNames[SYSTEM_STAGE_COUNT] =
+    {
+        "select menu",
+        "main menu",
+        "AN1136",
+        "AN1182",
+        "AN1227",
+        "AN1246",
+    };
+    SYSTEM_STAGE_STATISTICS total;
+    const SYSTEM_STAGE_STATISTICS *pStatistics;
+    double seconds;
+    uint8_t i;
+
+    memset(&total, 0, sizeof(total));
+    for (i = 0; i < SYSTEM_STAGE_COUNT; i++)
+    {
+        total.passes      += stageStatistics[i].passes;
+        total.frames      += stageStatistics[i].frames;
+        total.renderTime  += stageStatistics[i].renderTime;
+        total.pixelWrites += stageStatistics[i].pixelWrites;
+    }
+    seconds = (double)total.renderTime / 1e9;
+
+    printf("replays                  : %lu (%lu complete screens)\n", (unsigned long)replayCount, (unsigned long)screenCount);
+    printf("main loop passes         : %lu (%lu drew)\n", (unsigned long)total.passes, (unsigned long)total.frames);
+    printf("render time              : %.3f ms\n", seconds * 1e3);
+    printf("frames per second        : %.1f\n", (double)total.frames / seconds);
+    printf("longest frame            : %.3f ms\n", (double)frameTimeMax / 1e6);
+    printf("pixels written per frame : %.1f\n", (double)drvGfxSimStatistics.pixelWrites / total.frames);
+    printf("pixels read per frame    : %.1f\n", (double)drvGfxSimStatistics.pixelReads / total.frames);
+    printf("pixels clipped per frame : %.1f\n", (double)drvGfxSimStatistics.pixelsClipped / total.frames);
+    printf("bus transactions / frame : %.1f\n", (double)drvGfxSimStatistics.transactions / total.frames);
+    printf("bus transactions / pixel : %.2f\n", (double)drvGfxSimStatistics.transactions /
+                                                (double)(drvGfxSimStatistics.pixelWrites + drvGfxSimStatistics.pixelReads));
+
+    printf("\n%-24s %10s %10s %12s %14s\n", "replay stage", "frames", "frames/s", "ms/frame", "px/frame");
+    for (i = 0; i < SYSTEM_STAGE_COUNT; i++)
+    {
+        pStatistics = &stageStatistics[i];
+        if (pStatistics->frames == 0)
+            continue;
+
+        printf("%-24s %10lu %10.1f %12.3f %14.1f\n", stageNames[i],
+                (unsigned long)pStatistics->frames,
+                (double)pStatistics->frames * 1e9 / (double)pStatistics->renderTime,
+                (double)pStatistics->renderTime / 1e6 / pStatistics->frames,
+                (double)pStatistics->pixelWrites / pStatistics->frames);
+    }
+
+    printf("\n%-24s %12s %14s %10s\n", "driver function", "calls", "pixels", "px/call");
+    for (i = 0; i < DRV_GFX_SIM_FUNCTION_COUNT; i++)
+    {
+        printf("%-24s %12lu %14llu %10.1f\n", functionNames[i],
+                (unsigned long)drvGfxSimStatistics.calls[i],
+                (unsigned long long)drvGfxSimStatistics.pixels[i],
+                drvGfxSimStatistics.calls[i] ? (double)drvGfxSimStatistics.pixels[i] / drvGfxSimStatistics.calls[i] : 0.0);
+    }
+}
@@ -0,0 +1,142 @@
+/*******************************************************************************
+  System Specific Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system.h
+
+  Summary:
+    System level definitions for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef __SYSTEM_H
+#define __SYSTEM_H
+
+/*********************************************************************
+* Host build includes.  <xc.h> is the stand-in from bsp/linux_simulator.
+*********************************************************************/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <xc.h>
+#include "system_config.h"
+#include "gfx/gfx.h"
+#include "driver/touch_screen/drv_touch_screen.h"
+#include "internal_resource_main.h"
+
+/*********************************************************************
+* Macro: #define	SYS_CLK_FrequencySystemGet()
+*
+* Overview: This macro returns the system clock frequency in Hertz.
+*			* value is the clock of the PIC24 boards so delay and
+*			  timing calculations in the demo keep their values.
+*
+********************************************************************/
+#define SYS_CLK_FrequencySystemGet()    (32000000ul)
+#define SYS_CLK_FrequencyPeripheralGet()    (SYS_CLK_FrequencySystemGet() / 2)
+#define SYS_CLK_FrequencyInstructionGet()   (SYS_CLK_FrequencySystemGet() / 2)
+
+/*********************************************************************
+* Macro: #define	__delay_ms(d)
+*
+* Overview: No time is spent waiting on the simulator.  The demo
+*			timeouts run from the tick counter, see SYSTEM_TICKS_PER_PASS.
+*
+********************************************************************/
+#define __delay_ms(d)
+
+/*********************************************************************
+* Macro: #define	asm(instruction)
+*
+* Overview: main.c resets the device with asm("reset") after the
+*			external memory has been programmed.  The simulator cannot
+*			program the external memory and SYSTEM_ProgramExternalMemory()
+*			does not return, so the instruction is dropped.
+*
+********************************************************************/
+#define asm(instruction)
+
+/*********************************************************************
+* Board initialization
+*********************************************************************/
+void SYSTEM_BoardInitialize(void);
+
+/*********************************************************************
+* External Memory Programming
+*********************************************************************/
+void SYSTEM_ProgramExternalMemory();
+
+typedef enum
+{
+    ANSEL_DIGITAL = 0,
+    ANSEL_ANALOG = 1
+}ANSEL_BIT_STATE;
+
+typedef enum
+{
+    HW_BUTTON_PRESS = 0,
+    HW_BUTTON_RELEASE = 1
+}HW_BUTTON_STATE;
+
+/*********************************************************************
+* Function: void SYSTEM_ExternalMemoryRead(uint32_t address, uint8_t *pData, uint16_t nCount)
+*
+* Overview: Reads the simulated SPI flash.  The flash is erased, so
+*			the demo finds no valid external resources and runs with
+*			the internal ones.
+*
+* PreCondition: None
+*
+* Input: address - the flash address, pData - receives the data,
+*		 nCount - the number of bytes to read
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_ExternalMemoryRead(uint32_t address, uint8_t *pData, uint16_t nCount);
+
+/*********************************************************************
+* Function: HW_BUTTON_STATE SYSTEM_HWButtonGet(uint8_t button)
+*
+* Overview: Returns the state of a side button in the replay.
+*
+* PreCondition: None
+*
+* Input: button - SYSTEM_HW_BUTTON_CR or SYSTEM_HW_BUTTON_FOCUS
+*
+* Output: HW_BUTTON_PRESS or HW_BUTTON_RELEASE
+*
+********************************************************************/
+#define SYSTEM_HW_BUTTON_CR             (0x01)
+#define SYSTEM_HW_BUTTON_FOCUS          (0x02)
+
+HW_BUTTON_STATE SYSTEM_HWButtonGet(uint8_t button);
+
+#endif
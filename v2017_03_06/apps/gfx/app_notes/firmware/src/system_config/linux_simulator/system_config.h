@@ -0,0 +1,140 @@
+/*******************************************************************************
+  System Specific Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system_config.h
+
+  Summary:
+    System level definitions for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef __SYSTEM_CONFIG_H
+#define __SYSTEM_CONFIG_H
+
+/*********************************************************************
+* Host build includes.  <xc.h> is the stand-in from bsp/linux_simulator,
+* included here because the Graphics Library sources include only this
+* file.
+*********************************************************************/
+#include <xc.h>
+#include "gfx_config.h"
+
+/*********************************************************************
+ This system config builds the demo with a host compiler against the
+ simulated display (framework/driver/gfx/src/drv_gfx_sim.c), so that
+ the Graphics Library can be profiled without hardware.  The display
+ geometry matches the Displaytech EMB028TFTDEV (Ilitek ILI9341) boards.
+ Touch screen and side button input is replayed from a script and the
+ SPI flash is simulated as erased.  See system.c for the build command.
+*********************************************************************/
+
+#define GFX_USE_DISPLAY_CONTROLLER_SIMULATOR
+
+// -----------------------------------
+// For Smart GLASS
+// -----------------------------------
+// Simulating Ilitek 9341 Smart Glass
+#define DISP_ORIENTATION    90
+#define DISP_HOR_RESOLUTION 240
+#define DISP_VER_RESOLUTION 320
+
+// -----------------------------------
+// Default font to be used in the demo
+// -----------------------------------
+#define APP_DEMO_FONT Gentium27
+
+/*********************************************************************
+* HARDWARE PROFILE FOR DISPLAY CONTROLLER INTERFACE
+*********************************************************************/
+// The simulated display has no control signals.
+#define DisplayResetConfig()
+#define DisplayResetEnable()
+#define DisplayResetDisable()
+
+#define DisplayCmdDataConfig()
+#define DisplaySetCommand()
+#define DisplaySetData()
+
+#define DisplayConfig()
+#define DisplayEnable()
+#define DisplayDisable()
+
+#define DisplayFlashConfig()
+#define DisplayFlashEnable()
+#define DisplayFlashDisable()
+
+#define DisplayPowerConfig()
+#define DisplayPowerOn()
+#define DisplayPowerOff()
+
+#define DisplayBacklightConfig()
+#define DisplayBacklightOn()
+#define DisplayBacklightOff()
+
+/*********************************************************************
+* External Flash Memory
+*********************************************************************/
+#define NVMRead                         SYSTEM_ExternalMemoryRead
+
+// touch screen font definition
+#define DRV_TOUCHSCREEN_FONT            Gentium27
+
+/*********************************************************************
+* IOS FOR THE SWITCHES (SIDE BUTTONS)
+*********************************************************************/
+// buttons
+#define HardwareButtonInit()
+#define GetHWButtonCR()                     (SYSTEM_HWButtonGet(SYSTEM_HW_BUTTON_CR))
+#define GetHWButtonFocus()                  (SYSTEM_HWButtonGet(SYSTEM_HW_BUTTON_FOCUS))
+
+/*********************************************************************
+* Macro for the background image stored in the internal flash
+*********************************************************************/
+#define APP_INTERNAL_FLASH_BACKGROUND_IMAGE (&background_abstract_light_weave_4bpp_480x272)
+
+/*********************************************************************
+* BENCHMARK
+*********************************************************************/
+// Every pass of the main loop reads one touch screen message.  The
+// replay advances by one pass at a time and the tick counter advances
+// by SYSTEM_TICKS_PER_PASS per pass, which is a 12.5 ms main loop with
+// the 125 us tick timer of the PIC24 boards.
+#define SYSTEM_TICKS_PER_PASS               (100)
+
+// Number of times the touch screen replay is run before the benchmark
+// prints its report and exits.  One replay visits every application
+// note and returns to the main menu.
+#if !defined(SYSTEM_BENCHMARK_REPLAYS)
+    #define SYSTEM_BENCHMARK_REPLAYS        (5)
+#endif
+
+#endif
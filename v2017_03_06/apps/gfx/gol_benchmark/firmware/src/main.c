@@ -0,0 +1,262 @@
+/*******************************************************************************
+ Microchip Graphics Library Benchmark
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    main.c
+
+  Summary:
+    Touch and redraw latency of the Graphics Object Layer versus the
+    number of objects on the screen.
+
+  Description:
+    This benchmark fills the screen with keypads of increasing size and
+    measures the time GFX_GOL_ObjectMessage() takes to dispatch touch
+    screen messages and the time GFX_GOL_ObjectRectangleRedraw() takes
+    to mark the objects under a rectangle. It is built for the host
+    against the simulated display:
+
+    gcc -O2 -fgnu89-inline -Isystem_config/linux_simulator -I. \
+        -I../../../../../framework -I../../../../../bsp/linux_simulator \
+        main.c \
+        ../../../../../framework/gfx/src/gfx_gol.c \
+        ../../../../../framework/gfx/src/gfx_gol_button.c \
+        ../../../../../framework/gfx/src/gfx_primitive.c \
+        ../../../../../framework/driver/gfx/src/drv_gfx_sim.c \
+        -o gol_benchmark
+
+    Add -DAPP_LIST_WALK to build without the spatial index (see
+    gfx_config.h). Both builds print the same action and redraw counts.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// Section: Includes
+// *****************************************************************************
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "system.h"
+#include "gfx/gfx.h"
+#include "driver/gfx/drv_gfx_display.h"
+
+// *****************************************************************************
+// Section: Defines
+// *****************************************************************************
+// Each touch sequence is a press, two moves and a release.
+#define APP_TOUCH_SEQUENCES         (20000)
+#define APP_REDRAW_REQUESTS         (20000)
+
+// Redraw requests after which the marked objects are counted.
+#define APP_REDRAW_CHECKS           (1000)
+
+// *****************************************************************************
+// Section: Variables
+// *****************************************************************************
+static const uint16_t appKeypadColumns[] = { 4, 8, 16, 24, 32 };
+
+static GFX_GOL_OBJ_SCHEME appScheme;
+static uint32_t appActionCount;
+
+// *****************************************************************************
+// Section: Function Prototypes
+// *****************************************************************************
+static bool APP_MessageCallback(
+                                GFX_GOL_TRANSLATED_ACTION objMsg,
+                                GFX_GOL_OBJ_HEADER *pObj,
+                                GFX_GOL_MESSAGE *pMsg);
+static void APP_KeypadCreate(uint16_t columns, uint16_t rows);
+static uint64_t APP_TimeGet(void);
+
+// *****************************************************************************
+// int main(void)
+// *****************************************************************************
+int main(void)
+{
+    GFX_GOL_MESSAGE     msg;
+    GFX_GOL_OBJ_HEADER  *pObject;
+    uint16_t            columns, rows, objects, i;
+    uint16_t            width, height;
+    uint32_t            n, redrawCount;
+    uint64_t            start, createTime, touchTime, redrawTime;
+
+    DRV_GFX_Initialize();
+    GFX_Initialize();
+    GFX_GOL_MessageCallbackSet(APP_MessageCallback);
+
+#ifdef APP_LIST_WALK
+    printf("GOL benchmark, list walk\n");
+#else
+    printf("GOL benchmark, %d x %d spatial index\n",
+            GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS, GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS);
+#endif
+    printf("objects  create us  touch us/msg  redraw us/call   actions  redrawn\n");
+
+    for(i = 0; i < sizeof(appKeypadColumns) / sizeof(appKeypadColumns[0]); i++)
+    {
+        columns = appKeypadColumns[i];
+        rows    = columns;
+        objects = columns * rows;
+        width   = (GFX_MaxXGet() + 1) / columns;
+        height  = (GFX_MaxYGet() + 1) / rows;
+
+        srand(1);
+
+        start = APP_TimeGet();
+        APP_KeypadCreate(columns, rows);
+        createTime = APP_TimeGet() - start;
+
+        // touch a random point, move within the key and off it, release
+        appActionCount = 0;
+        msg.type = TYPE_TOUCHSCREEN;
+        start = APP_TimeGet();
+        for(n = 0; n < APP_TOUCH_SEQUENCES; n++)
+        {
+            msg.uiEvent = EVENT_PRESS;
+            msg.param1  = rand() % (GFX_MaxXGet() + 1);
+            msg.param2  = rand() % (GFX_MaxYGet() + 1);
+            GFX_GOL_ObjectMessage(&msg);
+
+            msg.uiEvent = EVENT_MOVE;
+            msg.param1 += 1;
+            GFX_GOL_ObjectMessage(&msg);
+
+            msg.param1 += width;
+            GFX_GOL_ObjectMessage(&msg);
+
+            msg.uiEvent = EVENT_RELEASE;
+            GFX_GOL_ObjectMessage(&msg);
+        }
+        touchTime = APP_TimeGet() - start;
+
+        // clear the redraw requests made by the touch actions
+        for(pObject = GFX_GOL_ObjectListGet(); pObject != NULL; pObject = pObject->pNxtObj)
+            GFX_GOL_ObjectDrawDisable(pObject);
+
+        // invalidate a key sized area at a random position
+        start = APP_TimeGet();
+        for(n = 0; n < APP_REDRAW_REQUESTS; n++)
+        {
+            uint16_t left = rand() % (GFX_MaxXGet() + 1);
+            uint16_t top  = rand() % (GFX_MaxYGet() + 1);
+
+            GFX_GOL_ObjectRectangleRedraw(left, top, left + width - 1, top + height - 1);
+        }
+        redrawTime = APP_TimeGet() - start;
+
+        // count the objects marked by a few requests, one at a time
+        redrawCount = 0;
+        for(n = 0; n < APP_REDRAW_CHECKS; n++)
+        {
+            uint16_t left = rand() % (GFX_MaxXGet() + 1);
+            uint16_t top  = rand() % (GFX_MaxYGet() + 1);
+
+            GFX_GOL_ObjectRectangleRedraw(left, top, left + width - 1, top + height - 1);
+
+            for(pObject = GFX_GOL_ObjectListGet(); pObject != NULL; pObject = pObject->pNxtObj)
+            {
+                if(GFX_GOL_ObjectIsRedrawSet(pObject) == true)
+                    redrawCount++;
+                GFX_GOL_ObjectDrawDisable(pObject);
+            }
+        }
+
+        printf("%7u  %9.1f  %12.3f  %14.3f  %8lu  %7lu\n",
+                (unsigned)objects,
+                createTime / 1000.0,
+                touchTime / 1000.0 / (APP_TOUCH_SEQUENCES * 4),
+                redrawTime / 1000.0 / APP_REDRAW_REQUESTS,
+                (unsigned long)appActionCount,
+                (unsigned long)redrawCount);
+
+        GFX_GOL_ObjectListFree();
+    }
+
+    return (EXIT_SUCCESS);
+}
+
+// *****************************************************************************
+// static void APP_KeypadCreate(uint16_t columns, uint16_t rows)
+// *****************************************************************************
+static void APP_KeypadCreate(uint16_t columns, uint16_t rows)
+{
+    uint16_t column, row, width, height;
+
+    width  = (GFX_MaxXGet() + 1) / columns;
+    height = (GFX_MaxYGet() + 1) / rows;
+
+    for(row = 0; row < rows; row++)
+    {
+        for(column = 0; column < columns; column++)
+        {
+            if(GFX_GOL_ButtonCreate(
+                    (row * columns) + column,
+                    column * width,
+                    row * height,
+                    (column * width) + width - 1,
+                    (row * height) + height - 1,
+                    0,
+                    GFX_GOL_BUTTON_DRAW_STATE,
+                    NULL,
+                    NULL,
+                    NULL,
+                    GFX_ALIGN_CENTER,
+                    &appScheme) == NULL)
+            {
+                fprintf(stderr, "cannot create button\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+}
+
+// *****************************************************************************
+// static bool APP_MessageCallback(...)
+// *****************************************************************************
+static bool APP_MessageCallback(
+                                GFX_GOL_TRANSLATED_ACTION objMsg,
+                                GFX_GOL_OBJ_HEADER *pObj,
+                                GFX_GOL_MESSAGE *pMsg)
+{
+    // count the actions and let the buttons change state
+    appActionCount++;
+    return (true);
+}
+
+// *****************************************************************************
+// static uint64_t APP_TimeGet(void)
+// *****************************************************************************
+static uint64_t APP_TimeGet(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (((uint64_t)now.tv_sec * 1000000000ull) + now.tv_nsec);
+}
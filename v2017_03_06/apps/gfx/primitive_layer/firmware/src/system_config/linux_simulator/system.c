@@ -0,0 +1,242 @@
+/*******************************************************************************
+  System Specific Initializations
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system.c
+
+  Summary:
+    System level initializations for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*******************************************************************************
+  Host (Linux) build of the primitive layer demo against the simulated
+  display (framework/driver/gfx/src/drv_gfx_sim.c).  Build from the src
+  directory with, for example:
+
+    gcc -O2 -fgnu89-inline -Isystem_config/linux_simulator -I. \
+        -I../../../../../framework -I../../../../../bsp/linux_simulator \
+        main.c internal_resource_reference.c \
+        system_config/linux_simulator/system.c \
+        ../../../../../framework/gfx/src/gfx_primitive.c \
+        ../../../../../framework/driver/gfx/src/drv_gfx_sim.c \
+        -o primitive_layer_sim
+
+  -fgnu89-inline keeps the extern inline functions of the library headers
+  from being emitted in every translation unit.
+
+  Set GFX_SIM_DUMP_PREFIX in the environment (for example to /tmp/screen_)
+  to write every completed screen to a numbered PNG file.
+*******************************************************************************/
+
+// *****************************************************************************
+// Section: Includes
+// *****************************************************************************
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "system.h"
+#include "driver/gfx/drv_gfx_display.h"
+#include "driver/gfx/drv_gfx_sim.h"
+#include "internal_resource.h"
+
+// *****************************************************************************
+// Section: Resource Data
+// *****************************************************************************
+// The image and font data referenced by internal_resource_reference.c is
+// produced by the Graphics Resource Converter for the PIC program memory
+// and is not part of the host build.  Stand-in data of the same geometry
+// is generated into these arrays by SYSTEM_BoardInitialize().
+uint8_t __flower1bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(85, 113, 1)] __attribute__((aligned(2)));
+uint8_t __flower4bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(85, 113, 4)] __attribute__((aligned(2)));
+uint8_t __flower8bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(85, 113, 8)] __attribute__((aligned(2)));
+uint8_t __flower16bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(85, 113, 16)] __attribute__((aligned(2)));
+uint8_t __Sun8bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 8)] __attribute__((aligned(2)));
+uint8_t __Sun8bit_RLE[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 8)] __attribute__((aligned(2)));
+uint8_t __Gaming4bit[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 4)] __attribute__((aligned(2)));
+uint8_t __Gaming4bit_RLE[DRV_GFX_SIM_IMAGE_DATA_SIZE(72, 72, 4)] __attribute__((aligned(2)));
+uint8_t __Font25[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x7E, 27, 1)] __attribute__((aligned(2)));
+uint8_t __Font33[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x7E, 33, 1)] __attribute__((aligned(2)));
+uint8_t __Font33_Antialiased[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x27, 33, 2)] __attribute__((aligned(2)));
+
+typedef struct
+{
+    const GFX_RESOURCE_HDR  *pResource;
+    uint8_t                 *pData;
+    uint32_t                size;
+} SYSTEM_RESOURCE_DATA;
+
+static const SYSTEM_RESOURCE_DATA resourceData[] =
+{
+    { &flower1bit,          __flower1bit,           sizeof(__flower1bit)            },
+    { &flower4bit,          __flower4bit,           sizeof(__flower4bit)            },
+    { &flower8bit,          __flower8bit,           sizeof(__flower8bit)            },
+    { &flower16bit,         __flower16bit,          sizeof(__flower16bit)           },
+    { &Sun8bit,             __Sun8bit,              sizeof(__Sun8bit)               },
+    { &Sun8bit_RLE,         __Sun8bit_RLE,          sizeof(__Sun8bit_RLE)           },
+    { &Gaming4bit,          __Gaming4bit,           sizeof(__Gaming4bit)            },
+    { &Gaming4bit_RLE,      __Gaming4bit_RLE,       sizeof(__Gaming4bit_RLE)        },
+    { &Font25,              __Font25,               sizeof(__Font25)                },
+    { &Font33,              __Font33,               sizeof(__Font33)                },
+    { &Font33_Antialiased,  __Font33_Antialiased,   sizeof(__Font33_Antialiased)    },
+};
+
+// *****************************************************************************
+// Section: Variables
+// *****************************************************************************
+static const char *dumpPrefix;
+static uint32_t frameCount, screenCount;
+
+static struct timespec frameStart;
+static uint64_t renderTime;             // ns spent outside of SYSTEM_DelayMs()
+static uint64_t frameTimeMax;
+
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to);
+static void SYSTEM_BenchmarkReport(void);
+
+// *****************************************************************************
+// void SYSTEM_BoardInitialize(void)
+// *****************************************************************************
+void SYSTEM_BoardInitialize(void)
+{
+    const SYSTEM_RESOURCE_DATA *pEntry;
+    bool generated;
+
+    for (pEntry = resourceData; pEntry < &resourceData[sizeof(resourceData) / sizeof(resourceData[0])]; pEntry++)
+    {
+        if ((pEntry->pResource->type & GFX_TYPE_MASK) == GFX_RESOURCE_TYPE_FONT)
+            generated = DRV_GFX_SIM_FontDataGenerate(pEntry->pResource, pEntry->pData, pEntry->size);
+        else
+            generated = DRV_GFX_SIM_ImageDataGenerate(pEntry->pResource, pEntry->pData, pEntry->size);
+
+        if (generated == false)
+        {
+            fprintf(stderr, "cannot generate resource data %u\n", (unsigned)(pEntry - resourceData));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    dumpPrefix = getenv("GFX_SIM_DUMP_PREFIX");
+
+    // ---------------------------------------------------------
+    // Initialize the Display Driver
+    // ---------------------------------------------------------
+    DRV_GFX_Initialize();
+
+    clock_gettime(CLOCK_MONOTONIC, &frameStart);
+}
+
+// *****************************************************************************
+// void SYSTEM_DelayMs(uint32_t delay)
+// *****************************************************************************
+void SYSTEM_DelayMs(uint32_t delay)
+{
+    struct timespec now;
+    uint64_t frameTime;
+    char fileName[256];
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    frameTime = SYSTEM_TimeDifference(&frameStart, &now);
+    renderTime += frameTime;
+    if (frameTime > frameTimeMax)
+        frameTimeMax = frameTime;
+    frameCount++;
+
+    if (delay >= SYSTEM_SCREEN_DELAY_MS)
+    {
+        if (dumpPrefix != NULL)
+        {
+            snprintf(fileName, sizeof(fileName), "%s%03lu.png", dumpPrefix, (unsigned long)screenCount);
+            if (DRV_GFX_SIM_PNGWrite(fileName) == false)
+            {
+                fprintf(stderr, "cannot write %s\n", fileName);
+            }
+        }
+        screenCount++;
+    }
+
+    if (screenCount >= SYSTEM_BENCHMARK_SCREENS)
+    {
+        SYSTEM_BenchmarkReport();
+        exit(EXIT_SUCCESS);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &frameStart);
+}
+
+// *****************************************************************************
+// static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+// *****************************************************************************
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+{
+    return ((uint64_t)(to->tv_sec - from->tv_sec) * 1000000000ull)
+            + (uint64_t)to->tv_nsec - (uint64_t)from->tv_nsec;
+}
+
+// *****************************************************************************
+// static void SYSTEM_BenchmarkReport(void)
+// *****************************************************************************
+static void SYSTEM_BenchmarkReport(void)
+{
+    static const char *functionNames[DRV_GFX_SIM_FUNCTION_COUNT] =
+    {
+        "GFX_PixelPut",
+        "GFX_PixelGet",
+        "GFX_PixelArrayPut",
+        "GFX_PixelArrayGet",
+        "GFX_BarDraw",
+        "GFX_ScreenClear",
+    };
+    double seconds = (double)renderTime / 1e9;
+    uint8_t i;
+
+    printf("frames                   : %lu (%lu complete screens)\n", (unsigned long)frameCount, (unsigned long)screenCount);
+    printf("render time              : %.3f ms\n", seconds * 1e3);
+    printf("frames per second        : %.1f\n", (double)frameCount / seconds);
+    printf("longest frame            : %.3f ms\n", (double)frameTimeMax / 1e6);
+    printf("screens per second       : %.1f\n", (double)screenCount / seconds);
+    printf("pixels written per frame : %.1f\n", (double)drvGfxSimStatistics.pixelWrites / frameCount);
+    printf("pixels read per frame    : %.1f\n", (double)drvGfxSimStatistics.pixelReads / frameCount);
+    printf("pixels clipped per frame : %.1f\n", (double)drvGfxSimStatistics.pixelsClipped / frameCount);
+    printf("bus transactions / frame : %.1f\n", (double)drvGfxSimStatistics.transactions / frameCount);
+    printf("pixels written / screen  : %.0f\n", (double)drvGfxSimStatistics.pixelWrites / screenCount);
+    printf("bus transactions / pixel : %.2f\n", (double)drvGfxSimStatistics.transactions /
+                                                (double)(drvGfxSimStatistics.pixelWrites + drvGfxSimStatistics.pixelReads));
+    printf("\n%-24s %12s %14s %10s\n", "driver function", "calls", "pixels", "px/call");
+    for (i = 0; i < DRV_GFX_SIM_FUNCTION_COUNT; i++)
+    {
+        printf("%-24s %12lu %14llu %10.1f\n", functionNames[i],
+                (unsigned long)drvGfxSimStatistics.calls[i],
+                (unsigned long long)drvGfxSimStatistics.pixels[i],
+                drvGfxSimStatistics.calls[i] ? (double)drvGfxSimStatistics.pixels[i] / drvGfxSimStatistics.calls[i] : 0.0);
+    }
+}
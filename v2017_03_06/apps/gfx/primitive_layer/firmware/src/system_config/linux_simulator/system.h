@@ -0,0 +1,95 @@
+/*******************************************************************************
+  System Specific Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system.h
+
+  Summary:
+    System level definitions for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef __SYSTEM_H
+#define __SYSTEM_H
+
+/*********************************************************************
+* Host build includes.  <xc.h> is the stand-in from bsp/linux_simulator.
+*********************************************************************/
+#include <xc.h>
+#include <stdint.h>
+#include "system_config.h"
+
+/*********************************************************************
+* Macro: #define	SYS_CLK_FrequencySystemGet()
+*
+* Overview: This macro returns the system clock frequency in Hertz.
+*			* value is the clock of the PIC24 boards so delay and
+*			  timing calculations in the demo keep their values.
+*
+********************************************************************/
+#define SYS_CLK_FrequencySystemGet()    (32000000ul)
+#define SYS_CLK_FrequencyPeripheralGet()    (SYS_CLK_FrequencySystemGet() / 2)
+#define SYS_CLK_FrequencyInstructionGet()   (SYS_CLK_FrequencySystemGet() / 2)
+
+/*********************************************************************
+* Macro: #define	__delay_ms(d)
+*
+* Overview: The demo pauses with __delay_ms() after each screen is
+*			complete, so the delay is where the simulator measures
+*			frames.  No time is actually spent waiting.
+*
+********************************************************************/
+#define __delay_ms(d)                   SYSTEM_DelayMs(d)
+
+/*********************************************************************
+* Board initialization
+*********************************************************************/
+void SYSTEM_BoardInitialize(void);
+
+/*********************************************************************
+* Function: void SYSTEM_DelayMs(uint32_t delay)
+*
+* Overview: Ends the current benchmark frame.  Records the time spent
+*			rendering since the previous delay and the display driver
+*			statistics of the frame, optionally writes the screen to a
+*			PNG file, and prints the report and exits once
+*			SYSTEM_BENCHMARK_SCREENS screens have been rendered.
+*
+* PreCondition: SYSTEM_BoardInitialize() has been called
+*
+* Input: delay - the pause requested by the application in ms
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_DelayMs(uint32_t delay);
+
+#endif
@@ -0,0 +1,112 @@
+/*******************************************************************************
+  System Specific Definitions
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system_config.h
+
+  Summary:
+    System level definitions for the host (Linux) build of the demo.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef __SYSTEM_CONFIG_H
+#define __SYSTEM_CONFIG_H
+
+/*********************************************************************
+* Host build includes.  <xc.h> is the stand-in from bsp/linux_simulator,
+* included here because the Graphics Library sources include only this
+* file.
+*********************************************************************/
+#include <xc.h>
+#include "gfx_config.h"
+
+/*********************************************************************
+ This system config builds the demo with a host compiler against the
+ simulated display (framework/driver/gfx/src/drv_gfx_sim.c), so that
+ the Graphics Library can be profiled without hardware.  The display
+ geometry matches the Displaytech EMB028TFTDEV (Ilitek ILI9341) boards.
+ See system.c for the build command.
+*********************************************************************/
+
+#define GFX_USE_DISPLAY_CONTROLLER_SIMULATOR
+
+// -----------------------------------
+// For Smart GLASS
+// -----------------------------------
+// Simulating Ilitek 9341 Smart Glass
+#define DISP_ORIENTATION    90
+#define DISP_HOR_RESOLUTION 240
+#define DISP_VER_RESOLUTION 320
+
+/*********************************************************************
+* HARDWARE PROFILE FOR DISPLAY CONTROLLER INTERFACE
+*********************************************************************/
+// The simulated display has no control signals.
+#define DisplayResetConfig()
+#define DisplayResetEnable()
+#define DisplayResetDisable()
+
+#define DisplayCmdDataConfig()
+#define DisplaySetCommand()
+#define DisplaySetData()
+
+#define DisplayConfig()
+#define DisplayEnable()
+#define DisplayDisable()
+
+#define DisplayFlashConfig()
+#define DisplayFlashEnable()
+#define DisplayFlashDisable()
+
+#define DisplayPowerConfig()
+#define DisplayPowerOn()
+#define DisplayPowerOff()
+
+#define DisplayBacklightConfig()
+#define DisplayBacklightOn()
+#define DisplayBacklightOff()
+
+/*********************************************************************
+* BENCHMARK
+*********************************************************************/
+// Every __delay_ms() of the demo ends a frame.  Pauses of at least
+// SYSTEM_SCREEN_DELAY_MS mark a completed screen; shorter ones are
+// animation steps.  Only complete screens are written to PNG files
+// when GFX_SIM_DUMP_PREFIX is set in the environment.
+#define SYSTEM_SCREEN_DELAY_MS              (1000)
+
+// Number of complete screens rendered before the benchmark prints its
+// report and exits.  One pass of the demo is 20 screens.
+#if !defined(SYSTEM_BENCHMARK_SCREENS)
+    #define SYSTEM_BENCHMARK_SCREENS        (40)
+#endif
+
+#endif
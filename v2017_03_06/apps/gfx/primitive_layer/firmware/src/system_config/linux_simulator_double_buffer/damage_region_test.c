@@ -0,0 +1,242 @@
+/*******************************************************************************
+  Damage Region Test
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    damage_region_test.c
+
+  Summary:
+    Host (Linux) test of the double buffering damage region.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*******************************************************************************
+  Host (Linux) test of the areas that GFX_DoubleBufferAreaMark() keeps for
+  double buffer synchronization, against the simulated display
+  (framework/driver/gfx/src/drv_gfx_sim.c) with double buffering enabled.
+  Build and run from the src directory with, for example:
+
+    gcc -O2 -fgnu89-inline -Isystem_config/linux_simulator_double_buffer -I. \
+        -I../../../../../framework -I../../../../../bsp/linux_simulator \
+        system_config/linux_simulator_double_buffer/damage_region_test.c \
+        ../../../../../framework/gfx/src/gfx_primitive.c \
+        ../../../../../framework/driver/gfx/src/drv_gfx_sim.c \
+        -o damage_region_test
+    ./damage_region_test
+
+  The test checks that:
+    - Marking the four quarters of the screen ends in one full screen copy.
+    - Two overlapping areas whose bounding rectangle is smaller than the sum
+      of their sizes are copied as that rectangle.
+    - For TEST_TRIAL_COUNT frames of 1 to TEST_AREAS_MAX random bars, each
+      drawn and then marked, the draw and frame buffers are the same after
+      synchronization, so every damaged pixel was copied.  Up to
+      GFX_MAX_INVALIDATE_AREAS bars, no more pixels are copied than the sum
+      of the bar sizes.
+  It prints the pixels copied compared with copying each marked area, or
+  the whole screen once more than GFX_MAX_INVALIDATE_AREAS areas are marked,
+  as the library did before the areas were merged.  The program returns 0
+  when every check passes.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "gfx/gfx.h"
+#include "driver/gfx/drv_gfx_sim.h"
+
+// Number of random frames, and the most bars drawn in one frame
+#define TEST_TRIAL_COUNT                2000
+#define TEST_AREAS_MAX                  12
+#define TEST_SCREEN_PIXELS              ((uint32_t)DISP_HOR_RESOLUTION * DISP_VER_RESOLUTION)
+
+static uint32_t randomState = 0x2545F491;
+static unsigned int failures;
+
+// *****************************************************************************
+// static void TEST_Check(const char *description, bool passed)
+// *****************************************************************************
+static void TEST_Check(const char *description, bool passed)
+{
+    printf("  %-56s: %s\n", description, passed ? "pass" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+// *****************************************************************************
+// static uint16_t TEST_RandomGet(uint16_t range)
+// *****************************************************************************
+// Returns a value from 0 to range - 1.  A local generator keeps the
+// figures the same on every host.
+static uint16_t TEST_RandomGet(uint16_t range)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return ((uint16_t)(randomState % range));
+}
+
+// *****************************************************************************
+// static bool TEST_BuffersMatch(void)
+// *****************************************************************************
+static bool TEST_BuffersMatch(void)
+{
+    return (memcmp(DRV_GFX_SIM_FrameBufferGet(), DRV_GFX_SIM_DrawBufferGet(),
+                   TEST_SCREEN_PIXELS * sizeof(GFX_COLOR)) == 0);
+}
+
+// *****************************************************************************
+// static uint32_t TEST_SynchronizedPixelsGet(void)
+// *****************************************************************************
+// Synchronizes the buffers and returns the number of pixels copied.
+static uint32_t TEST_SynchronizedPixelsGet(void)
+{
+    uint64_t before = drvGfxSimStatistics.pixelsSynchronized;
+
+    GFX_DoubleBufferSynchronize();
+    return ((uint32_t)(drvGfxSimStatistics.pixelsSynchronized - before));
+}
+
+// *****************************************************************************
+// static void TEST_BarDraw(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom)
+// *****************************************************************************
+static void TEST_BarDraw(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom)
+{
+    GFX_ColorSet((GFX_COLOR)(TEST_RandomGet(0xFFFF) + 1));
+    while (GFX_BarDraw(left, top, right, bottom) != GFX_STATUS_SUCCESS);
+    GFX_DoubleBufferAreaMark(left, top, right, bottom);
+}
+
+// *****************************************************************************
+// static void TEST_FixedAreasRun(void)
+// *****************************************************************************
+static void TEST_FixedAreasRun(void)
+{
+    uint16_t halfX = (GFX_MaxXGet() + 1) / 2;
+    uint16_t halfY = (GFX_MaxYGet() + 1) / 2;
+    uint32_t copied;
+
+    printf("Fixed areas\n");
+
+    TEST_BarDraw(0, 0, halfX - 1, halfY - 1);
+    TEST_BarDraw(halfX, 0, GFX_MaxXGet(), halfY - 1);
+    TEST_BarDraw(0, halfY, halfX - 1, GFX_MaxYGet());
+    TEST_BarDraw(halfX, halfY, GFX_MaxXGet(), GFX_MaxYGet());
+    TEST_Check("four quarters of the screen need a full copy",
+               GFX_DoubleBufferSyncAllStatusGet() == GFX_FEATURE_ENABLED);
+    copied = TEST_SynchronizedPixelsGet();
+    TEST_Check("four quarters are copied once", (copied == TEST_SCREEN_PIXELS) && TEST_BuffersMatch());
+
+    // 2 areas of 40 x 40 overlapping by 30 x 30: 3200 pixels, bounding rectangle 50 x 50
+    TEST_BarDraw(10, 10, 49, 49);
+    TEST_BarDraw(20, 20, 59, 59);
+    TEST_Check("overlapping areas are merged", GFX_DoubleBufferSyncAreaCountGet() == 1);
+    copied = TEST_SynchronizedPixelsGet();
+    TEST_Check("overlapping areas are copied as their bounding rectangle", (copied == 50 * 50) && TEST_BuffersMatch());
+}
+
+// *****************************************************************************
+// static void TEST_RandomAreasRun(void)
+// *****************************************************************************
+static void TEST_RandomAreasRun(void)
+{
+    static bool damaged[TEST_SCREEN_PIXELS];
+    uint64_t totalCopied = 0, totalPrevious = 0, totalDamaged = 0;
+    uint32_t copied, marked, previous, z;
+    uint16_t trial, count, i, left, top, width, height, x, y;
+    bool matches = true, bounded = true;
+
+    printf("%d frames of 1 to %d random bars, %d areas listed\n",
+            TEST_TRIAL_COUNT, TEST_AREAS_MAX, GFX_MAX_INVALIDATE_AREAS);
+
+    for (trial = 0; trial < TEST_TRIAL_COUNT; trial++)
+    {
+        memset(damaged, 0, sizeof(damaged));
+        count = 1 + TEST_RandomGet(TEST_AREAS_MAX);
+        marked = 0;
+
+        for (i = 0; i < count; i++)
+        {
+            // widget sized bars, anywhere on the screen
+            width  = 8 + TEST_RandomGet(120);
+            height = 8 + TEST_RandomGet(90);
+            left   = TEST_RandomGet(GFX_MaxXGet() + 2 - width);
+            top    = TEST_RandomGet(GFX_MaxYGet() + 2 - height);
+
+            TEST_BarDraw(left, top, left + width - 1, top + height - 1);
+            marked += (uint32_t)width * height;
+
+            for (y = top; y < top + height; y++)
+                for (x = left; x < left + width; x++)
+                    damaged[((uint32_t)y * (GFX_MaxXGet() + 1)) + x] = true;
+        }
+
+        copied = TEST_SynchronizedPixelsGet();
+        matches = matches && TEST_BuffersMatch();
+        if ((count <= GFX_MAX_INVALIDATE_AREAS) && (copied > marked))
+            bounded = false;
+
+        // each area copied separately, or the whole screen when the list overflowed
+        previous = (count > GFX_MAX_INVALIDATE_AREAS) ? TEST_SCREEN_PIXELS : marked;
+
+        totalCopied   += copied;
+        totalPrevious += previous;
+        for (z = 0; z < TEST_SCREEN_PIXELS; z++)
+            totalDamaged += damaged[z];
+    }
+
+    printf("  pixels copied: %llu, %llu when copying each area or the whole screen (%.1f%% less)\n",
+            (unsigned long long)totalCopied, (unsigned long long)totalPrevious,
+            100.0 * (double)(totalPrevious - totalCopied) / (double)totalPrevious);
+    printf("  pixels damaged: %llu, %.2f copies per damaged pixel\n",
+            (unsigned long long)totalDamaged, (double)totalCopied / (double)totalDamaged);
+
+    TEST_Check("synchronized buffers match after every frame", matches);
+    TEST_Check("up to the list size, no more than the marked pixels", bounded);
+}
+
+// *****************************************************************************
+// int main(void)
+// *****************************************************************************
+int main(void)
+{
+    DRV_GFX_Initialize();
+    GFX_Initialize();
+    GFX_DoubleBufferEnable();
+
+    TEST_FixedAreasRun();
+    TEST_RandomAreasRun();
+
+    printf("%u failure(s)\n", failures);
+    return ((failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
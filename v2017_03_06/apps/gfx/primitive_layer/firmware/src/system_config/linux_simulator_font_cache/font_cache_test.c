@@ -0,0 +1,354 @@
+/*******************************************************************************
+  Font Cache Test
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    font_cache_test.c
+
+  Summary:
+    Host (Linux) test of the glyph and width caches of external fonts.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+/*******************************************************************************
+  Host (Linux) test of the glyph and width caches of fonts sourced from
+  external memory, against the simulated display
+  (framework/driver/gfx/src/drv_gfx_sim.c).  Build and run from the src
+  directory with, for example:
+
+    gcc -O2 -fgnu89-inline -Isystem_config/linux_simulator_font_cache -I. \
+        -I../../../../../framework -I../../../../../bsp/linux_simulator \
+        system_config/linux_simulator_font_cache/font_cache_test.c \
+        ../../../../../framework/gfx/src/gfx_primitive.c \
+        ../../../../../framework/driver/gfx/src/drv_gfx_sim.c \
+        -o font_cache_test
+    ./font_cache_test
+
+  Add -DGFX_CONFIG_FONT_GLYPH_CACHE_SIZE=4 -DGFX_CONFIG_FONT_WIDTH_CACHE_SIZE=4
+  to test with caches that keep replacing entries, or set both to 0 to
+  count the external memory reads without the caches.
+
+  The same font data is used from flash and from external memory, with
+  normal and with extended glyph entries.  For each font the test checks
+  that:
+    - Every one of TEST_REDRAW_COUNT redraws of a screen of centered labels
+      from external memory matches the screen rendered from flash.
+    - Redraws after the first do not read external memory when the caches
+      hold all the characters of the screen.
+    - After a redraw where every third external memory read fails, the next
+      redraw still matches, so glyphs and widths that failed to load are not
+      served from the caches.
+  The program prints the external memory reads and cache counters, and
+  returns 0 when every check passes.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "gfx/gfx.h"
+#include "gfx/gfx_colors_x11.h"
+#include "driver/gfx/drv_gfx_sim.h"
+
+// Number of times the screen is redrawn from external memory
+#define TEST_REDRAW_COUNT               20
+// Every n-th external memory read fails in the failure test
+#define TEST_READ_FAIL_INTERVAL         3
+#define TEST_SCREEN_PIXELS              ((uint32_t)DISP_HOR_RESOLUTION * DISP_VER_RESOLUTION)
+
+#if defined(GFX_CONFIG_FONT_GLYPH_CACHE_SIZE)
+    #define TEST_GLYPH_CACHE_SIZE       GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+#else
+    #define TEST_GLYPH_CACHE_SIZE       0
+#endif
+#if defined(GFX_CONFIG_FONT_WIDTH_CACHE_SIZE)
+    #define TEST_WIDTH_CACHE_SIZE       GFX_CONFIG_FONT_WIDTH_CACHE_SIZE
+#else
+    #define TEST_WIDTH_CACHE_SIZE       0
+#endif
+
+// Font data generated by the simulated display, read directly as a font in
+// flash and through GFX_ExternalResourceCallback() as a font in external memory
+static uint8_t fontData[DRV_GFX_SIM_FONT_DATA_SIZE(0x20, 0x7E, 27, 1)] __attribute__((aligned(2)));
+static uint8_t fontExtendedData[DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE(0x20, 0x7E, 27, 1)] __attribute__((aligned(2)));
+
+#define TEST_FONT_HEADER(extended)                                      \
+    .resource.font.header.fontID = 0,                                   \
+    .resource.font.header.extendedGlyphEntry = (extended),              \
+    .resource.font.header.bpp = 0,                                      \
+    .resource.font.header.firstChar = 0x0020,                           \
+    .resource.font.header.lastChar = 0x007E,                            \
+    .resource.font.header.height = 27
+
+static GFX_RESOURCE_HDR flashFont =
+{
+    .type = GFX_RESOURCE_FONT_FLASH_NONE,
+    .resource.font.location.progByteAddress = (GFX_FONT_SPACE char *) fontData,
+    TEST_FONT_HEADER(0)
+};
+static GFX_RESOURCE_HDR flashFontExtended =
+{
+    .type = GFX_RESOURCE_FONT_FLASH_NONE,
+    .resource.font.location.progByteAddress = (GFX_FONT_SPACE char *) fontExtendedData,
+    TEST_FONT_HEADER(1)
+};
+static GFX_RESOURCE_HDR externalFont =
+{
+    .type = GFX_RESOURCE_FONT_EXTERNAL_NONE,
+    .resource.font.location.extAddress = 0,
+    TEST_FONT_HEADER(0)
+};
+static GFX_RESOURCE_HDR externalFontExtended =
+{
+    .type = GFX_RESOURCE_FONT_EXTERNAL_NONE,
+    .resource.font.location.extAddress = 0,
+    TEST_FONT_HEADER(1)
+};
+
+typedef struct
+{
+    const char          *name;
+    GFX_RESOURCE_HDR    *pFlashFont;
+    GFX_RESOURCE_HDR    *pExternalFont;
+    uint8_t             *pData;
+    uint32_t            size;
+} TEST_FONT;
+
+static const TEST_FONT testFonts[] =
+{
+    { "normal glyph entries",   &flashFont,         &externalFont,          fontData,           sizeof(fontData)            },
+    { "extended glyph entries", &flashFontExtended, &externalFontExtended,  fontExtendedData,   sizeof(fontExtendedData)    },
+};
+
+static const char * const labels[] =
+{
+    "Temperature",
+    "21.5 C",
+    "Pressure",
+    "1013 hPa",
+    "Humidity 45%",
+    "Wind NNE",
+    "Status: OK",
+    "[Settings]",
+};
+
+static const TEST_FONT *pExternalFontData;  // font read by GFX_ExternalResourceCallback()
+static uint32_t externalReads;
+static uint32_t externalReadFailures;
+static uint32_t readFailInterval;           // 0 when no read fails
+static GFX_COLOR referenceScreen[TEST_SCREEN_PIXELS];
+static unsigned int failures;
+
+// *****************************************************************************
+// GFX_STATUS GFX_ExternalResourceCallback(GFX_RESOURCE_HDR *pResource, uint32_t offset, uint16_t nCount, void *pBuffer)
+// *****************************************************************************
+GFX_STATUS GFX_ExternalResourceCallback(
+                                GFX_RESOURCE_HDR *pResource,
+                                uint32_t offset,
+                                uint16_t nCount,
+                                void     *pBuffer)
+{
+    externalReads++;
+
+    if ((pExternalFontData == NULL) || (pResource != pExternalFontData->pExternalFont) ||
+        ((offset + nCount) > pExternalFontData->size))
+    {
+        fprintf(stderr, "unexpected external memory read at %lu\n", (unsigned long)offset);
+        exit(EXIT_FAILURE);
+    }
+
+    // a failed read leaves the buffer partly written
+    if ((readFailInterval != 0) && ((externalReads % readFailInterval) == 0))
+    {
+        externalReadFailures++;
+        memset(pBuffer, 0xA5, nCount);
+        return (GFX_STATUS_FAILURE);
+    }
+
+    memcpy(pBuffer, pExternalFontData->pData + offset, nCount);
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+// static void TEST_Check(const char *description, bool passed)
+// *****************************************************************************
+static void TEST_Check(const char *description, bool passed)
+{
+    printf("  %-56s: %s\n", description, passed ? "pass" : "FAIL");
+    if (!passed)
+    {
+        failures++;
+    }
+}
+
+// *****************************************************************************
+// static void TEST_ScreenDraw(GFX_RESOURCE_HDR *pFont)
+// *****************************************************************************
+static void TEST_ScreenDraw(GFX_RESOURCE_HDR *pFont)
+{
+    static const GFX_COLOR colors[] = { GFX_X11_WHITE, GFX_X11_YELLOW, GFX_X11_CYAN, GFX_X11_GREEN };
+    uint16_t width, x, i;
+
+    GFX_ColorSet(GFX_X11_BLACK);
+    GFX_ScreenClear();
+    GFX_FontSet(pFont);
+
+    // the labels are centered, so each one is measured before it is drawn
+    for (i = 0; i < (sizeof(labels) / sizeof(labels[0])); i++)
+    {
+        width = GFX_TextStringWidthGet((GFX_XCHAR *)labels[i], pFont);
+        x = (width < GFX_MaxXGet()) ? ((GFX_MaxXGet() + 1 - width) / 2) : 0;
+
+        GFX_ColorSet(colors[i % (sizeof(colors) / sizeof(colors[0]))]);
+        while (GFX_TextStringDraw(x, i * 29, (GFX_XCHAR *)labels[i], 0) != GFX_STATUS_SUCCESS);
+    }
+}
+
+// *****************************************************************************
+// static bool TEST_ScreenMatches(void)
+// *****************************************************************************
+static bool TEST_ScreenMatches(void)
+{
+    return (memcmp(DRV_GFX_SIM_FrameBufferGet(), referenceScreen, sizeof(referenceScreen)) == 0);
+}
+
+// *****************************************************************************
+// static uint16_t TEST_DistinctCharactersGet(void)
+// *****************************************************************************
+static uint16_t TEST_DistinctCharactersGet(void)
+{
+    bool used[256] = { false };
+    const char *pChar;
+    uint16_t count = 0, i;
+
+    for (i = 0; i < (sizeof(labels) / sizeof(labels[0])); i++)
+    {
+        for (pChar = labels[i]; *pChar != '\0'; pChar++)
+        {
+            if (used[(uint8_t)*pChar] == false)
+            {
+                used[(uint8_t)*pChar] = true;
+                count++;
+            }
+        }
+    }
+
+    return (count);
+}
+
+// *****************************************************************************
+// static void TEST_FontRun(const TEST_FONT *pFont)
+// *****************************************************************************
+static void TEST_FontRun(const TEST_FONT *pFont)
+{
+    GFX_FONT_CACHE_STATISTICS statistics;
+    uint32_t firstReads;
+    uint16_t distinct;
+    bool matches;
+    int redraw;
+
+    printf("Font with %s, %u glyph and %u width cache entries\n", pFont->name,
+            TEST_GLYPH_CACHE_SIZE, TEST_WIDTH_CACHE_SIZE);
+
+    if (DRV_GFX_SIM_FontDataGenerate(pFont->pFlashFont, pFont->pData, pFont->size) == false)
+    {
+        TEST_Check("generate font data", false);
+        return;
+    }
+
+    TEST_ScreenDraw(pFont->pFlashFont);
+    memcpy(referenceScreen, DRV_GFX_SIM_FrameBufferGet(), sizeof(referenceScreen));
+
+    pExternalFontData = pFont;
+    GFX_FontCacheFlush();
+    GFX_FontCacheStatisticsClear();
+    externalReads = 0;
+    firstReads = 0;
+    matches = true;
+
+    for (redraw = 0; redraw < TEST_REDRAW_COUNT; redraw++)
+    {
+        TEST_ScreenDraw(pFont->pExternalFont);
+        matches = matches && TEST_ScreenMatches();
+        if (redraw == 0)
+        {
+            firstReads = externalReads;
+        }
+    }
+
+    GFX_FontCacheStatisticsGet(&statistics);
+    printf("  external memory reads: %lu in the first redraw, %lu in the next %d\n",
+            (unsigned long)firstReads, (unsigned long)(externalReads - firstReads), TEST_REDRAW_COUNT - 1);
+    printf("  glyph cache: %lu hits, %lu misses; width cache: %lu hits, %lu misses\n",
+            (unsigned long)statistics.glyphHits, (unsigned long)statistics.glyphMisses,
+            (unsigned long)statistics.widthHits, (unsigned long)statistics.widthMisses);
+
+    TEST_Check("redraws from external memory match flash", matches);
+
+    distinct = TEST_DistinctCharactersGet();
+    if ((distinct <= TEST_GLYPH_CACHE_SIZE) && (distinct <= TEST_WIDTH_CACHE_SIZE))
+    {
+        TEST_Check("redraws after the first read no external memory", externalReads == firstReads);
+    }
+
+    // a redraw with failing reads may be wrong, the one after it must not be
+    GFX_FontCacheFlush();
+    externalReads = 0;
+    externalReadFailures = 0;
+    readFailInterval = TEST_READ_FAIL_INTERVAL;
+    TEST_ScreenDraw(pFont->pExternalFont);
+    readFailInterval = 0;
+    printf("  %lu of %lu external memory reads failed\n",
+            (unsigned long)externalReadFailures, (unsigned long)externalReads);
+
+    TEST_ScreenDraw(pFont->pExternalFont);
+    TEST_Check("redraw after failed reads matches flash", TEST_ScreenMatches());
+
+    pExternalFontData = NULL;
+}
+
+// *****************************************************************************
+// int main(void)
+// *****************************************************************************
+int main(void)
+{
+    uint16_t i;
+
+    DRV_GFX_Initialize();
+    GFX_Initialize();
+
+    for (i = 0; i < (sizeof(testFonts) / sizeof(testFonts[0])); i++)
+    {
+        TEST_FontRun(&testFonts[i]);
+    }
+
+    printf("%u failure(s)\n", failures);
+    return ((failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
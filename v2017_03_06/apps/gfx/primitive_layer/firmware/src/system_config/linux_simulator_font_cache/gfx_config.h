@@ -0,0 +1,69 @@
+/*******************************************************************************
+  Graphics Library Configuration
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    gfx_config.h
+
+  Summary:
+    Graphics Library configuration for the host (Linux) font cache test.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _GRAPHICS_CONFIG_H_FONT_CACHE
+#define _GRAPHICS_CONFIG_H_FONT_CACHE
+
+// The test uses the demo's configuration, with fonts in external memory
+// and the glyph and width caches enabled.  The cache sizes can be set on
+// the command line, for example to 4 to test replacement of entries.
+#include "../../gfx_config.h"
+
+#undef GFX_CONFIG_FONT_EXTERNAL_DISABLE
+
+// The test fonts are 27 pixels high, with glyphs up to 27 pixels wide.
+#define GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE    (27 * 4)
+
+#if !defined(GFX_CONFIG_FONT_GLYPH_CACHE_SIZE)
+    #define GFX_CONFIG_FONT_GLYPH_CACHE_SIZE    64
+#endif
+#if !defined(GFX_CONFIG_FONT_WIDTH_CACHE_SIZE)
+    #define GFX_CONFIG_FONT_WIDTH_CACHE_SIZE    96
+#endif
+
+// A size of 0 builds the test without that cache, to compare the number
+// of external memory reads.
+#if (GFX_CONFIG_FONT_GLYPH_CACHE_SIZE == 0)
+    #undef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+#endif
+#if (GFX_CONFIG_FONT_WIDTH_CACHE_SIZE == 0)
+    #undef GFX_CONFIG_FONT_WIDTH_CACHE_SIZE
+#endif
+
+#endif
@@ -0,0 +1,101 @@
+/*******************************************************************************
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    system_config.h
+
+  Summary:
+    System level definitions for the host (Linux) build of the TCP link simulation.
+
+  Description:
+    System Specific Definitions
+
+ *******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) <2014> released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+ *******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef __SYSTEM_CONFIG_H_
+#define __SYSTEM_CONFIG_H_
+
+#include <stdio.h>
+#include <string.h>
+
+#include "system.h"
+
+#include "tcpip_config.h"
+
+#define MRF24WG
+
+// ====================================================
+//   Hardware mappings
+// ====================================================
+
+//----------------------------
+// MRF24WG0MA/B WiFi I/O pins
+//----------------------------
+
+// Selects the MRF24W MAC RAM layout for the TCP socket buffers.  The module
+// itself is replaced by the simulated link in tcp_link_simulator.c, so the
+// pins are never accessed.  The stack still includes the demo's
+// drv_wifi_config.h, so the src directory must be on the include path.
+#define WF_CS_TRIS
+
+// ====================================================
+//   End of Hardware mappings
+// ====================================================
+
+
+// ====================================================
+//   Compiler Information
+// ====================================================
+
+// Base RAM and ROM pointer types for given architecture
+#define PTR_BASE        unsigned long
+#define ROM_PTR_BASE    unsigned long
+
+// Definitions that apply to all except Microchip MPLAB C Compiler for PIC18 MCUs (C18)
+#define memcmppgm2ram(a,b,c)    memcmp(a,b,c)
+#define strcmppgm2ram(a,b)      strcmp(a,b)
+#define memcpypgm2ram(a,b,c)    memcpy(a,b,c)
+#define strcpypgm2ram(a,b)      strcpy(a,b)
+#define strncpypgm2ram(a,b,c)   strncpy(a,b,c)
+#define strstrrampgm(a,b)       strstr(a,b)
+#define strlenpgm(a)            strlen(a)
+#define strchrpgm(a,b)          strchr(a,b)
+#define strcatpgm2ram(a,b)      strcat(a,b)
+
+// Definitions that apply to all 16-bit and 32-bit products
+#define ROM    const
+
+#define far
+#define FAR
+
+// ====================================================
+//   End of Compiler Information
+// ====================================================
+
+#endif /* __SYSTEM_CONFIG_H_ */
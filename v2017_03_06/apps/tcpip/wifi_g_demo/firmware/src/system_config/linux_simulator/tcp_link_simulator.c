@@ -0,0 +1,647 @@
+/*******************************************************************************
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    tcp_link_simulator.c
+
+  Summary:
+    Host (Linux) simulation of a bulk TCP upload over a slow, lossy link.
+
+  Description:
+    Runs the stack's TCP module (framework/tcpip/src/tcp.c) against a
+    simulated MAC, IP layer and remote peer so the sender's congestion
+    control, fast retransmit and fast recovery can be measured without
+    hardware.  Build from the src directory, for example:
+
+      gcc -O2 -I. -Isystem_config/linux_simulator -I../../../../../framework \
+          system_config/linux_simulator/tcp_link_simulator.c \
+          ../../../../../framework/tcpip/src/tcp.c \
+          -o tcp_link_simulator
+
+    Add -DTCP_LINK_SIM_TX_FIFO_SIZE=30000 to enlarge the socket's TX FIFO
+    (8000 bytes by default).  To compare against another version of the
+    TCP module, point the last -I option and tcp.c at that tree instead.
+    Run with
+
+      ./tcp_link_simulator [one way delay ms] [rate bytes/ms] [loss %] [bytes]
+
+    The defaults are a 50 ms one way delay (100 ms RTT), 125 bytes/ms
+    (1 Mbit/s), 1% loss and a 1 MB upload.
+
+    The link model:
+      - Segments leave through a bottleneck of the given rate with a 16 KB
+        drop-tail queue, then take the one way delay to reach the peer.
+      - Segments are lost with the given probability.  Losses come from a
+        hash of the sequence number and the segment count, so every run
+        with the same arguments is identical.
+      - The peer keeps out of order data and returns a cumulative ACK for
+        every segment after another one way delay.  Its receive window is
+        fixed at 16 KB.
+      - Checksums, IP, ARP and the MAC hardware are not modelled.
+
+    Each retransmission is classed by what caused it: a third duplicate
+    ACK (fast retransmit), any other ACK (fast recovery resending the next
+    hole after a partial ACK) or TCPTick(), which runs the retransmission
+    timer.
+ *******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) <2014> released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+ *******************************************************************************/
+//DOM-IGNORE-END
+
+#include <stdlib.h>
+
+#include "tcpip/tcpip.h"
+
+// Simulated time advanced per main loop pass, in ticks (0.1 ms)
+#define SIM_TICKS_PER_MS            ((uint32_t)(TICK_SECOND / 1000u))
+#define SIM_TICKS_PER_PASS          (SIM_TICKS_PER_MS / 10u)
+
+// Bottleneck queue and peer receive window, in bytes
+#define SIM_QUEUE_SIZE              (16384u)
+#define SIM_PEER_WINDOW             (16384u)
+// Ethernet, IP and TCP header bytes added to each segment on the link
+#define SIM_SEGMENT_OVERHEAD        (54u)
+// Largest upload the peer can reassemble
+#define SIM_MAX_UPLOAD              (4ul * 1024ul * 1024ul)
+// Segments that can be on the link in each direction at one time
+#define SIM_LINK_SLOTS              (8192u)
+// Give up when a run has not finished after this much simulated time
+#define SIM_TIME_LIMIT_SECONDS      (3600u)
+
+#define SIM_LOCAL_PORT_UNKNOWN      (0u)
+#define SIM_PEER_PORT               (80u)
+#define SIM_PEER_ADDRESS            (0x0A000009ul)
+#define SIM_PEER_ISS                (1000ul)
+#define SIM_PEER_MSS                (1460u)
+
+// TCP header layout (RFC 793).  TCP_HEADER is private to tcp.c.
+#define SIM_TCP_HEADER_SIZE         (20u)
+#define SIM_TCP_SOURCE_PORT         (0u)
+#define SIM_TCP_DEST_PORT           (2u)
+#define SIM_TCP_SEQ_NUMBER          (4u)
+#define SIM_TCP_ACK_NUMBER          (8u)
+#define SIM_TCP_DATA_OFFSET         (12u)
+#define SIM_TCP_FLAGS               (13u)
+#define SIM_TCP_WINDOW              (14u)
+#define SIM_TCP_SYN                 (0x02u)
+#define SIM_TCP_ACK                 (0x10u)
+
+// A segment on its way to the peer, or the peer's reply on its way back
+typedef struct
+{
+    uint32_t dwDue;             // Tick at which it arrives
+    uint32_t dwOffset;          // Data: offset in the upload; reply: acknowledgement offset
+    uint16_t wLength;           // Data bytes
+    uint8_t  vFlags;            // TCP flags of a reply
+} SIM_SEGMENT;
+
+typedef struct
+{
+    SIM_SEGMENT slot[SIM_LINK_SLOTS];
+    uint32_t head;
+    uint32_t tail;
+} SIM_LINK;
+
+// Stand-in for the MAC RAM.  RX data is placed at RXSTART; the TX buffer,
+// TCBs and socket FIFOs follow the MRF24W layout from mac.h.
+static uint8_t macRam[BASE_TCB_ADDR + TCP_ETH_RAM_SIZE];
+static PTR_BASE readPtr, writePtr;
+static uint16_t wTxLength;
+
+// Normally declared in main.c
+APP_CONFIG AppConfig;
+
+static uint32_t dwNow;
+static uint32_t dwRandom = 1;
+
+// Link parameters
+static uint32_t dwDelay;            // One way delay, in ticks
+static uint32_t dwRate;             // Bottleneck rate, in bytes per ms
+static uint32_t dwLossPercent;
+static uint32_t dwUploadSize;
+static uint32_t dwUplinkFree;       // Tick at which the bottleneck finishes its current segment
+
+static SIM_LINK uplink, downlink;
+
+// Local connection state as seen by the peer
+static uint16_t wLocalPort = SIM_LOCAL_PORT_UNKNOWN;
+static uint32_t dwLocalISS;
+static uint32_t dwAckOffset;        // Cumulative acknowledgement, as an upload offset
+static uint8_t received[SIM_MAX_UPLOAD];
+
+// Statistics
+static uint32_t dwSegmentsSent, dwBytesSent, dwHighestOffset;
+static uint32_t dwQueueDrops, dwLinkLosses;
+static uint32_t dwDupAcks, dwConsecutiveDupAcks, dwLastAckDelivered;
+static uint32_t dwFastRetransmits, dwRecoveryRetransmits, dwTimerRetransmits;
+static bool bInTCPProcess;
+
+static uint16_t SIM_Get16(const uint8_t *p);
+static uint32_t SIM_Get32(const uint8_t *p);
+static void SIM_Put16(uint8_t *p, uint16_t v);
+static void SIM_Put32(uint8_t *p, uint32_t v);
+static uint32_t SIM_Hash(uint32_t a, uint32_t b);
+static bool SIM_LinkPut(SIM_LINK *link, const SIM_SEGMENT *segment);
+static SIM_SEGMENT *SIM_LinkPeek(SIM_LINK *link);
+static void SIM_LinkRemove(SIM_LINK *link);
+static void SIM_PeerReply(uint8_t vFlags, uint32_t dwAck, uint32_t dwDue);
+static void SIM_PeerReceive(const SIM_SEGMENT *segment);
+static void SIM_LocalReceive(const SIM_SEGMENT *segment);
+static void SIM_CountRetransmission(void);
+
+/****************************************************************************
+  Section:
+    Stack Stand-ins
+  ***************************************************************************/
+
+uint32_t TickGet(void)
+{
+    return dwNow;
+}
+
+uint32_t TickGetDiv256(void)
+{
+    return dwNow >> 8;
+}
+
+uint16_t LFSRRand(void)
+{
+    dwRandom = dwRandom * 1103515245ul + 12345ul;
+    return (uint16_t)(dwRandom >> 8);
+}
+
+uint32_t GenerateRandomDWORD(void)
+{
+    return (uint32_t)LFSRRand() * 251ul;
+}
+
+uint16_t WFGetTCBSize(void)
+{
+    return TCP_ETH_RAM_SIZE;
+}
+
+uint16_t swaps(uint16_t v)
+{
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+uint32_t swapl(uint32_t v)
+{
+    return ((v & 0x000000FFul) << 24) | ((v & 0x0000FF00ul) << 8) |
+           ((v & 0x00FF0000ul) >> 8) | ((v & 0xFF000000ul) >> 24);
+}
+
+// Checksums are not modelled.  The peer ignores them, and TCPProcess()
+// accepts every segment because the buffer checksum always matches the
+// complemented pseudo header checksum.
+uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t len)
+{
+    return 0;
+}
+
+uint16_t CalcIPBufferChecksum(uint16_t len)
+{
+    return 0xFFFF;
+}
+
+void ChecksumBegin(IP_CHECKSUM *cs)
+{
+}
+
+void ChecksumAdd(IP_CHECKSUM *cs, const void *buffer, uint16_t len)
+{
+}
+
+void ChecksumMerge(IP_CHECKSUM *cs, IP_CHECKSUM *next)
+{
+}
+
+uint16_t ChecksumFinish(IP_CHECKSUM *cs)
+{
+    return 0;
+}
+
+void ARPResolve(IP_ADDR *IPAddr)
+{
+}
+
+bool ARPIsResolved(IP_ADDR *IPAddr, MAC_ADDR *MACAddr)
+{
+    return true;
+}
+
+void IPSetRxBuffer(uint16_t Offset)
+{
+    readPtr = RXSTART + Offset;
+}
+
+uint16_t IPPutHeader(NODE_INFO *remote, uint8_t protocol, uint16_t len)
+{
+    wTxLength = len;
+    writePtr = BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER);
+    return 0;
+}
+
+PTR_BASE MACSetReadPtr(PTR_BASE address)
+{
+    PTR_BASE oldAddress = readPtr;
+
+    readPtr = address;
+    return oldAddress;
+}
+
+PTR_BASE MACSetWritePtr(PTR_BASE address)
+{
+    PTR_BASE oldAddress = writePtr;
+
+    writePtr = address;
+    return oldAddress;
+}
+
+uint8_t MACGet(void)
+{
+    return macRam[readPtr++];
+}
+
+uint16_t MACGetArray(uint8_t *val, uint16_t len)
+{
+    if (val)
+        memcpy(val, &macRam[readPtr], len);
+    readPtr += len;
+    return len;
+}
+
+void MACPutArray(uint8_t *val, uint16_t len)
+{
+    memcpy(&macRam[writePtr], val, len);
+    writePtr += len;
+}
+
+void MACMemCopyAsync(PTR_BASE destAddr, PTR_BASE sourceAddr, uint16_t len)
+{
+    PTR_BASE dest = (destAddr == (PTR_BASE) - 1) ? writePtr : destAddr;
+    PTR_BASE source = (sourceAddr == (PTR_BASE) - 1) ? readPtr : sourceAddr;
+
+    memmove(&macRam[dest], &macRam[source], len);
+    if (destAddr == (PTR_BASE) - 1)
+        writePtr += len;
+    if (sourceAddr == (PTR_BASE) - 1)
+        readPtr += len;
+}
+
+bool MACIsMemCopyDone(void)
+{
+    return true;
+}
+
+bool MACIsTxReady(void)
+{
+    return true;
+}
+
+uint16_t MACGetFreeRxSize(void)
+{
+    return RXSIZE;
+}
+
+void MACDiscardRx(void)
+{
+}
+
+/*****************************************************************************
+  Function:
+    void MACFlush(void)
+
+  Summary:
+    Puts the segment in the TX buffer on the simulated link.
+
+  Description:
+    A SYN is answered straight away.  Data segments are counted, queued
+    behind the bottleneck (or dropped when the queue is full), may be lost,
+    and otherwise reach the peer one delay after they leave the queue.
+    Pure ACKs are not carried, as the peer does not need them.
+
+  Precondition:
+    IPPutHeader() and the TCP header and data have been written.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+  ***************************************************************************/
+void MACFlush(void)
+{
+    const uint8_t *header = &macRam[BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER)];
+    SIM_SEGMENT segment;
+    uint16_t wDataLength;
+    uint32_t dwSeq;
+    uint32_t dwStart;
+
+    wDataLength = wTxLength - (header[SIM_TCP_DATA_OFFSET] >> 4) * 4u;
+    wLocalPort = SIM_Get16(&header[SIM_TCP_SOURCE_PORT]);
+    dwSeq = SIM_Get32(&header[SIM_TCP_SEQ_NUMBER]);
+
+    if ((header[SIM_TCP_FLAGS] & (SIM_TCP_SYN | SIM_TCP_ACK)) == SIM_TCP_SYN)
+    {
+        dwLocalISS = dwSeq;
+        SIM_PeerReply(SIM_TCP_SYN | SIM_TCP_ACK, 0, dwNow + dwDelay);
+        return;
+    }
+
+    if (wDataLength == 0u)
+        return;
+
+    segment.dwOffset = dwSeq - dwLocalISS - 1u;
+    segment.wLength = wDataLength;
+    segment.vFlags = 0;
+
+    dwSegmentsSent++;
+    dwBytesSent += wDataLength;
+    if (segment.dwOffset < dwHighestOffset)
+        SIM_CountRetransmission();
+    if (segment.dwOffset + wDataLength > dwHighestOffset)
+        dwHighestOffset = segment.dwOffset + wDataLength;
+
+    // Serialize behind whatever is already queued at the bottleneck
+    dwStart = ((int32_t) (dwUplinkFree - dwNow) > 0) ? dwUplinkFree : dwNow;
+    if (dwStart - dwNow > SIM_QUEUE_SIZE * SIM_TICKS_PER_MS / dwRate)
+    {
+        dwQueueDrops++;
+        return;
+    }
+    dwUplinkFree = dwStart + (wDataLength + SIM_SEGMENT_OVERHEAD) * SIM_TICKS_PER_MS / dwRate;
+
+    if (SIM_Hash(dwSeq, dwSegmentsSent) % 100u < dwLossPercent)
+    {
+        dwLinkLosses++;
+        return;
+    }
+
+    segment.dwDue = dwUplinkFree + dwDelay;
+    if (!SIM_LinkPut(&uplink, &segment))
+    {
+        fprintf(stderr, "Uplink overflow\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/****************************************************************************
+  Section:
+    Simulated Peer
+  ***************************************************************************/
+
+static uint16_t SIM_Get16(const uint8_t *p)
+{
+    return ((uint16_t) p[0] << 8) | p[1];
+}
+
+static uint32_t SIM_Get32(const uint8_t *p)
+{
+    return ((uint32_t) SIM_Get16(p) << 16) | SIM_Get16(p + 2);
+}
+
+static void SIM_Put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t) (v >> 8);
+    p[1] = (uint8_t) v;
+}
+
+static void SIM_Put32(uint8_t *p, uint32_t v)
+{
+    SIM_Put16(p, (uint16_t) (v >> 16));
+    SIM_Put16(p + 2, (uint16_t) v);
+}
+
+static uint32_t SIM_Hash(uint32_t a, uint32_t b)
+{
+    uint32_t h;
+
+    h = (a * 0x9E3779B1ul) ^ ((b + 0x7F4A7C15ul) * 0x85EBCA77ul);
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Dul;
+    h ^= h >> 12;
+    return h;
+}
+
+static bool SIM_LinkPut(SIM_LINK *link, const SIM_SEGMENT *segment)
+{
+    if (link->head - link->tail >= SIM_LINK_SLOTS)
+        return false;
+    link->slot[link->head++ % SIM_LINK_SLOTS] = *segment;
+    return true;
+}
+
+// Segments are put on each link in the order they arrive, so only the
+// oldest one can be due
+static SIM_SEGMENT *SIM_LinkPeek(SIM_LINK *link)
+{
+    SIM_SEGMENT *segment;
+
+    if (link->head == link->tail)
+        return NULL;
+    segment = &link->slot[link->tail % SIM_LINK_SLOTS];
+    if ((int32_t) (dwNow - segment->dwDue) < 0)
+        return NULL;
+    return segment;
+}
+
+static void SIM_LinkRemove(SIM_LINK *link)
+{
+    link->tail++;
+}
+
+static void SIM_PeerReply(uint8_t vFlags, uint32_t dwAck, uint32_t dwDue)
+{
+    SIM_SEGMENT reply;
+
+    reply.dwDue = dwDue;
+    reply.dwOffset = dwAck;
+    reply.wLength = 0;
+    reply.vFlags = vFlags;
+    if (!SIM_LinkPut(&downlink, &reply))
+    {
+        fprintf(stderr, "Downlink overflow\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Stores a data segment and acknowledges everything received in order
+static void SIM_PeerReceive(const SIM_SEGMENT *segment)
+{
+    uint32_t i;
+
+    for (i = segment->dwOffset; i < segment->dwOffset + segment->wLength && i < SIM_MAX_UPLOAD; i++)
+        received[i] = 1;
+    while (dwAckOffset < SIM_MAX_UPLOAD && received[dwAckOffset])
+        dwAckOffset++;
+
+    SIM_PeerReply(SIM_TCP_ACK, dwAckOffset, dwNow + dwDelay);
+}
+
+// Hands one of the peer's replies to TCPProcess()
+static void SIM_LocalReceive(const SIM_SEGMENT *segment)
+{
+    uint8_t *header = &macRam[RXSTART];
+    NODE_INFO remote;
+    IP_ADDR localIP;
+    uint16_t wHeaderLength = SIM_TCP_HEADER_SIZE;
+
+    memset(header, 0, SIM_TCP_HEADER_SIZE);
+    SIM_Put16(&header[SIM_TCP_SOURCE_PORT], SIM_PEER_PORT);
+    SIM_Put16(&header[SIM_TCP_DEST_PORT], wLocalPort);
+    SIM_Put32(&header[SIM_TCP_ACK_NUMBER], dwLocalISS + 1u + segment->dwOffset);
+    SIM_Put16(&header[SIM_TCP_WINDOW], SIM_PEER_WINDOW);
+    header[SIM_TCP_FLAGS] = segment->vFlags;
+    if (segment->vFlags & SIM_TCP_SYN)
+    {
+        // Advertise the peer's MSS in the SYN+ACK
+        SIM_Put32(&header[SIM_TCP_SEQ_NUMBER], SIM_PEER_ISS);
+        header[SIM_TCP_HEADER_SIZE + 0] = 2;
+        header[SIM_TCP_HEADER_SIZE + 1] = 4;
+        SIM_Put16(&header[SIM_TCP_HEADER_SIZE + 2], SIM_PEER_MSS);
+        wHeaderLength += 4u;
+    }
+    else
+    {
+        SIM_Put32(&header[SIM_TCP_SEQ_NUMBER], SIM_PEER_ISS + 1u);
+
+        if (segment->dwOffset == dwLastAckDelivered)
+        {
+            dwDupAcks++;
+            dwConsecutiveDupAcks++;
+        }
+        else
+        {
+            dwConsecutiveDupAcks = 0;
+        }
+        dwLastAckDelivered = segment->dwOffset;
+    }
+    header[SIM_TCP_DATA_OFFSET] = (uint8_t) ((wHeaderLength / 4u) << 4);
+
+    memset(&remote, 0, sizeof (remote));
+    remote.IPAddr.Val = SIM_PEER_ADDRESS;
+    localIP.Val = 0;
+
+    bInTCPProcess = true;
+    TCPProcess(&remote, &localIP, wHeaderLength);
+    bInTCPProcess = false;
+}
+
+static void SIM_CountRetransmission(void)
+{
+    if (!bInTCPProcess)
+        dwTimerRetransmits++;
+    else if (dwConsecutiveDupAcks >= 3u)
+        dwFastRetransmits++;
+    else
+        dwRecoveryRetransmits++;
+}
+
+/****************************************************************************
+  Section:
+    Simulation
+  ***************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    static uint8_t data[4096];
+    TCP_SOCKET hSocket;
+    SIM_SEGMENT *segment;
+    uint32_t dwPut = 0;
+    uint32_t dwDelayMs = (argc > 1) ? strtoul(argv[1], NULL, 0) : 50u;
+    uint16_t w;
+    double seconds;
+
+    dwRate = (argc > 2) ? strtoul(argv[2], NULL, 0) : 125u;
+    dwLossPercent = (argc > 3) ? strtoul(argv[3], NULL, 0) : 1u;
+    dwUploadSize = (argc > 4) ? strtoul(argv[4], NULL, 0) : 1000000ul;
+    if (dwRate == 0u || dwUploadSize > SIM_MAX_UPLOAD)
+    {
+        fprintf(stderr, "usage: %s [delay ms] [rate bytes/ms] [loss %%] [bytes <= %lu]\n", argv[0], SIM_MAX_UPLOAD);
+        return EXIT_FAILURE;
+    }
+    dwDelay = dwDelayMs * SIM_TICKS_PER_MS;
+    memset(data, 'x', sizeof (data));
+
+    TCPInit();
+    hSocket = TCPOpen(SIM_PEER_ADDRESS, TCP_OPEN_IP_ADDRESS, SIM_PEER_PORT, TCP_PURPOSE_GENERIC_TCP_CLIENT);
+    if (hSocket == INVALID_SOCKET)
+    {
+        fprintf(stderr, "No TCP_PURPOSE_GENERIC_TCP_CLIENT socket\n");
+        return EXIT_FAILURE;
+    }
+
+    while (dwAckOffset < dwUploadSize)
+    {
+        dwNow += SIM_TICKS_PER_PASS;
+        if (dwNow / TICK_SECOND >= SIM_TIME_LIMIT_SECONDS)
+        {
+            fprintf(stderr, "Upload did not finish\n");
+            return EXIT_FAILURE;
+        }
+
+        while ((segment = SIM_LinkPeek(&uplink)) != NULL)
+        {
+            SIM_PeerReceive(segment);
+            SIM_LinkRemove(&uplink);
+        }
+        while ((segment = SIM_LinkPeek(&downlink)) != NULL)
+        {
+            SIM_LocalReceive(segment);
+            SIM_LinkRemove(&downlink);
+        }
+
+        TCPTick();
+
+        if (TCPIsConnected(hSocket) && dwPut < dwUploadSize)
+        {
+            w = TCPIsPutReady(hSocket);
+            if (w > sizeof (data))
+                w = sizeof (data);
+            if (w > dwUploadSize - dwPut)
+                w = dwUploadSize - dwPut;
+            if (w)
+                dwPut += TCPPutArray(hSocket, data, w);
+        }
+    }
+
+    seconds = (double) dwNow / TICK_SECOND;
+    printf("RTT %lu ms, %lu bytes/ms, %lu%% loss, TX FIFO %u bytes\n",
+           (unsigned long) (2u * dwDelayMs), (unsigned long) dwRate, (unsigned long) dwLossPercent, TCP_LINK_SIM_TX_FIFO_SIZE);
+    printf("upload                   : %lu bytes in %.2f s, %.1f kB/s\n",
+           (unsigned long) dwUploadSize, seconds, dwUploadSize / 1000.0 / seconds);
+    printf("segments sent            : %lu (%lu bytes average)\n",
+           (unsigned long) dwSegmentsSent, (unsigned long) (dwBytesSent / dwSegmentsSent));
+    printf("dropped at queue / lost  : %lu / %lu\n", (unsigned long) dwQueueDrops, (unsigned long) dwLinkLosses);
+    printf("duplicate ACKs received  : %lu\n", (unsigned long) dwDupAcks);
+    printf("retransmitted segments   : %lu\n",
+           (unsigned long) (dwFastRetransmits + dwRecoveryRetransmits + dwTimerRetransmits));
+    printf("  on third duplicate ACK : %lu\n", (unsigned long) dwFastRetransmits);
+    printf("  on other ACKs          : %lu\n", (unsigned long) dwRecoveryRetransmits);
+    printf("  from TCPTick()         : %lu\n", (unsigned long) dwTimerRetransmits);
+    return EXIT_SUCCESS;
+}
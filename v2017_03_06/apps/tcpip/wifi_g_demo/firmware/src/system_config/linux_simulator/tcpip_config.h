@@ -0,0 +1,123 @@
+/*******************************************************************************
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    tcpip_config.h
+
+  Summary:
+
+
+  Description:
+    TCP/IP Stack Configuration Header for the host (Linux) TCP link simulation
+
+ *******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) <2014> released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+ *******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef __TCPIP_CONFIG_H_
+#define __TCPIP_CONFIG_H_
+
+#include <stdint.h>
+
+// =======================================================================
+//   Transport Layer Options
+// =======================================================================
+
+/* Transport Layer Configuration
+ *   Only TCP is built.  The simulated link in tcp_link_simulator.c
+ *   stands in for IP, ARP and the MAC.
+ */
+#define STACK_USE_TCP
+
+/* Client Mode Configuration
+ *   The simulation opens a client socket to the simulated peer.
+ */
+#define STACK_CLIENT_MODE
+
+/* Simulated TCP TX FIFO Size
+ *   Size of the client socket's TX FIFO, which bounds the data the sender
+ *   can keep in flight.  Override on the compiler command line to compare
+ *   FIFO sizes.
+ */
+#if !defined(TCP_LINK_SIM_TX_FIFO_SIZE)
+#define TCP_LINK_SIM_TX_FIFO_SIZE           (8000u)
+#endif
+
+/* TCP Socket Memory Allocation
+ *   TCP needs memory to buffer incoming and outgoing data.  The
+ *   amount and medium of storage can be allocated on a per-socket
+ *   basis using the example below as a guide.
+ */
+// Allocate how much total RAM (in bytes) you want to allocate
+// for use by your TCP TCBs, RX FIFOs, and TX FIFOs.
+#define TCP_ETH_RAM_SIZE                    (32768ul)
+#define TCP_PIC_RAM_SIZE                    (0ul)
+#define TCP_SPI_RAM_SIZE                    (0ul)
+#define TCP_SPI_RAM_BASE_ADDRESS            (0x00)
+
+/* UDP Socket Configuration
+ *   UDP is not built, but the stack requires at least one socket.
+ */
+#define MAX_UDP_SOCKETS     (1u)
+
+/* HTTP2 Server Configuration
+ *   HTTP is not built, but the stack requires at least one connection.
+ */
+#define MAX_HTTP_CONNECTIONS    (1u)
+
+// Define names of socket types
+#define TCP_SOCKET_TYPES
+#define TCP_PURPOSE_GENERIC_TCP_CLIENT 0
+#define END_OF_TCP_SOCKET_TYPES
+
+#if defined(__TCP_C_)
+// Define what types of sockets are needed, how many of
+// each to include, where their TCB, TX FIFO, and RX FIFO
+// should be stored, and how big the RX and TX FIFOs should
+// be.  Making this initializer bigger or smaller defines
+// how many total TCP sockets are available.
+//
+// Each socket requires up to 56 bytes of PIC RAM and
+// 48+(TX FIFO size)+(RX FIFO size) bytes of TCP_*_RAM each.
+//
+// Note: The RX FIFO must be at least 1 byte in order to
+// receive SYN and FIN messages required by TCP.  The TX
+// FIFO can be zero if desired.
+#define TCP_CONFIGURATION
+
+const struct {
+    uint8_t vSocketPurpose;
+    uint8_t vMemoryMedium;
+    uint16_t wTXBufferSize;
+    uint16_t wRXBufferSize;
+} TCPSocketInitializer[] = {
+    {TCP_PURPOSE_GENERIC_TCP_CLIENT, TCP_ETH_RAM, TCP_LINK_SIM_TX_FIFO_SIZE, 20},
+};
+#define END_OF_TCP_CONFIGURATION
+#endif
+
+#endif /* __TCPIP_CONFIG_H_ */
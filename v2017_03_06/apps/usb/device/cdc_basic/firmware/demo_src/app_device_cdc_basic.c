@@ -85,7 +85,7 @@ void APP_DeviceCDCBasicDemoTasks()
             case 0x0A:
             case 0x0D:
                 memcpy(tmp, writeBuf, 3);
-                memcpy(tmp + 3, '\0', 1);
+                tmp[3] = '\0';
                 int cpuUsage = atoi(tmp);
                 meter_set_cpuusage(cpuUsage);
                 writeData(writeBuf, writeBufPos);
@@ -0,0 +1,48 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+/*********************************************************************
+ * Two port configuration of the CDC basic demo for the linux_simulator
+ * build.  Everything but the port count comes from the demo's own
+ * usb_config.h.  Put this directory in front of demo_src on the include
+ * path and build usb_descriptors.c from this directory in place of the
+ * demo's, which describes a single port.
+ ********************************************************************/
+
+#ifndef DUAL_CDC_USB_CONFIG_H
+#define DUAL_CDC_USB_CONFIG_H
+
+#include "../../demo_src/usb_config.h"
+
+#undef USB_MAX_NUM_INT
+#define USB_MAX_NUM_INT         4   //Two interfaces for each port
+#undef USB_MAX_EP_NUMBER
+#define USB_MAX_EP_NUMBER       4
+
+/* Second CDC port */
+#define CDC2_COMM_INTF_ID       0x02
+#define CDC2_COMM_EP            3
+#define CDC2_DATA_INTF_ID       0x03
+#define CDC2_DATA_EP            4
+
+#define USB_MAX_CDC_INSTANCES       2
+#define USB_CDC_INSTANCE_BINDINGS   {CDC_COMM_INTF_ID, CDC_DATA_INTF_ID, CDC_COMM_EP, CDC_DATA_EP}, \
+                                    {CDC2_COMM_INTF_ID, CDC2_DATA_INTF_ID, CDC2_COMM_EP, CDC2_DATA_EP}
+
+#endif //DUAL_CDC_USB_CONFIG_H
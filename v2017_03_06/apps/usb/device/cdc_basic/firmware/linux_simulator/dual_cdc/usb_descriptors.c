@@ -0,0 +1,204 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+/*********************************************************************
+ * Descriptors of the two port configuration of the CDC basic demo for
+ * the linux_simulator build (see usb_config.h in this directory).  Each
+ * port is the demo's single port function, grouped with an interface
+ * association descriptor so a host binds one driver to each pair.
+ ********************************************************************/
+#ifndef __USB_DESCRIPTORS_C
+#define __USB_DESCRIPTORS_C
+ 
+/** INCLUDES *******************************************************/
+#include "usb.h"
+#include "usb_device_cdc.h"
+
+/** CONSTANTS ******************************************************/
+
+//Interface association descriptor type and the device class triple that
+//tells the host to look for them.
+#define DUAL_CDC_DESCRIPTOR_IAD     0x0B
+#define DUAL_CDC_MISC_DEVICE        0xEF
+#define DUAL_CDC_COMMON_CLASS       0x02
+#define DUAL_CDC_IAD_PROTOCOL       0x01
+
+/* Device Descriptor */
+const USB_DEVICE_DESCRIPTOR device_dsc=
+{
+    0x12,                   // Size of this descriptor in bytes
+    USB_DESCRIPTOR_DEVICE,  // DEVICE descriptor type
+    0x0200,                 // USB Spec Release Number in BCD format
+    DUAL_CDC_MISC_DEVICE,   // Class Code
+    DUAL_CDC_COMMON_CLASS,  // Subclass code
+    DUAL_CDC_IAD_PROTOCOL,  // Protocol code
+    USB_EP0_BUFF_SIZE,      // Max packet size for EP0, see usb_config.h
+    0x04D8,                 // Vendor ID
+    0x000A,                 // Product ID: CDC RS-232 Emulation Demo
+    0x0100,                 // Device release number in BCD format
+    0x01,                   // Manufacturer string index
+    0x02,                   // Product string index
+    0x00,                   // Device serial number string index
+    0x01                    // Number of possible configurations
+};
+
+//The descriptors of one port: interface association, communication
+//interface with its notification endpoint, data interface with its bulk
+//endpoints.
+#define DUAL_CDC_PORT_DESCRIPTORS(commIntf, dataIntf, commEP, dataEP)       \
+    /* Interface Association Descriptor */                                  \
+    8,                                                                      \
+    DUAL_CDC_DESCRIPTOR_IAD,                                                \
+    commIntf,               /* First interface */                           \
+    2,                      /* Interface count */                           \
+    COMM_INTF,              /* Function class */                            \
+    ABSTRACT_CONTROL_MODEL, /* Function subclass */                         \
+    V25TER,                 /* Function protocol */                         \
+    0,                      /* Function string index */                     \
+                                                                            \
+    /* Interface Descriptor */                                              \
+    9,                                                                      \
+    USB_DESCRIPTOR_INTERFACE,                                               \
+    commIntf,               /* Interface Number */                          \
+    0,                      /* Alternate Setting Number */                  \
+    1,                      /* Number of endpoints in this intf */          \
+    COMM_INTF,                                                              \
+    ABSTRACT_CONTROL_MODEL,                                                 \
+    V25TER,                                                                 \
+    0,                                                                      \
+                                                                            \
+    /* CDC Class-Specific Descriptors */                                    \
+    sizeof(USB_CDC_HEADER_FN_DSC),                                          \
+    CS_INTERFACE,                                                           \
+    DSC_FN_HEADER,                                                          \
+    0x10,0x01,                                                              \
+                                                                            \
+    sizeof(USB_CDC_ACM_FN_DSC),                                             \
+    CS_INTERFACE,                                                           \
+    DSC_FN_ACM,                                                             \
+    USB_CDC_ACM_FN_DSC_VAL,                                                 \
+                                                                            \
+    sizeof(USB_CDC_UNION_FN_DSC),                                           \
+    CS_INTERFACE,                                                           \
+    DSC_FN_UNION,                                                           \
+    commIntf,                                                               \
+    dataIntf,                                                               \
+                                                                            \
+    sizeof(USB_CDC_CALL_MGT_FN_DSC),                                        \
+    CS_INTERFACE,                                                           \
+    DSC_FN_CALL_MGT,                                                        \
+    0x00,                                                                   \
+    dataIntf,                                                               \
+                                                                            \
+    /* Endpoint Descriptor */                                               \
+    0x07,                                                                   \
+    USB_DESCRIPTOR_ENDPOINT,                                                \
+    0x80 | (commEP),        /* EndpointAddress */                           \
+    _INTERRUPT,                                                             \
+    0x08,0x00,                                                              \
+    0x02,                                                                   \
+                                                                            \
+    /* Interface Descriptor */                                              \
+    9,                                                                      \
+    USB_DESCRIPTOR_INTERFACE,                                               \
+    dataIntf,               /* Interface Number */                          \
+    0,                      /* Alternate Setting Number */                  \
+    2,                      /* Number of endpoints in this intf */          \
+    DATA_INTF,                                                              \
+    0,                                                                      \
+    NO_PROTOCOL,                                                            \
+    0,                                                                      \
+                                                                            \
+    /* Endpoint Descriptor */                                               \
+    0x07,                                                                   \
+    USB_DESCRIPTOR_ENDPOINT,                                                \
+    (dataEP),               /* EndpointAddress (OUT) */                     \
+    _BULK,                                                                  \
+    0x40,0x00,                                                              \
+    0x00,                                                                   \
+                                                                            \
+    /* Endpoint Descriptor */                                               \
+    0x07,                                                                   \
+    USB_DESCRIPTOR_ENDPOINT,                                                \
+    0x80 | (dataEP),        /* EndpointAddress (IN) */                      \
+    _BULK,                                                                  \
+    0x40,0x00,                                                              \
+    0x00
+
+/* Configuration 1 Descriptor */
+const uint8_t configDescriptor1[]={
+    /* Configuration Descriptor */
+    0x09,//sizeof(USB_CFG_DSC),    // Size of this descriptor in bytes
+    USB_DESCRIPTOR_CONFIGURATION,                // CONFIGURATION descriptor type
+    141,0,                  // Total length of data for this cfg
+    4,                      // Number of interfaces in this cfg
+    1,                      // Index value of this configuration
+    0,                      // Configuration string index
+    _DEFAULT | _SELF,               // Attributes, see usb_device.h
+    50,                     // Max power consumption (2X mA)
+
+    DUAL_CDC_PORT_DESCRIPTORS(CDC_COMM_INTF_ID, CDC_DATA_INTF_ID, CDC_COMM_EP, CDC_DATA_EP),
+    DUAL_CDC_PORT_DESCRIPTORS(CDC2_COMM_INTF_ID, CDC2_DATA_INTF_ID, CDC2_COMM_EP, CDC2_DATA_EP)
+};
+
+//Language code string descriptor
+const struct{uint8_t bLength;uint8_t bDscType;uint16_t string[1];}sd000={
+sizeof(sd000),USB_DESCRIPTOR_STRING,{0x0409}};
+
+//Manufacturer string descriptor
+const struct{uint8_t bLength;uint8_t bDscType;uint16_t string[25];}sd001={
+sizeof(sd001),USB_DESCRIPTOR_STRING,
+{'M','i','c','r','o','c','h','i','p',' ',
+'T','e','c','h','n','o','l','o','g','y',' ','I','n','c','.'
+}};
+
+//Product string descriptor
+const struct{uint8_t bLength;uint8_t bDscType;uint16_t string[25];}sd002={
+sizeof(sd002),USB_DESCRIPTOR_STRING,
+{'C','D','C',' ','R','S','-','2','3','2',' ',
+'E','m','u','l','a','t','i','o','n',' ','D','e','m','o'}
+};
+
+//Serial number string descriptor.  If a serial number string is implemented, 
+//it should be unique for every single device coming off the production assembly 
+//line.  Plugging two devices with the same serial number into a computer 
+//simultaneously will cause problems (in extreme cases BSOD).
+//Note: Common OSes put restrictions on the possible values that are allowed.
+//For best OS compatibility, the serial number string should only consist
+//of UNICODE encoded numbers 0 through 9 and capital letters A through F.
+//ROM struct{BYTE bLength;BYTE bDscType;WORD string[10];}sd003={
+//sizeof(sd003),USB_DESCRIPTOR_STRING,
+//{'0','1','2','3','4','5','6','7','8','9'}};
+
+//Array of configuration descriptors
+const uint8_t *const USB_CD_Ptr[]=
+{
+    (const uint8_t *const)&configDescriptor1
+};
+//Array of string descriptors
+const uint8_t *const USB_SD_Ptr[USB_NUM_STRING_DESCRIPTORS]=
+{
+    (const uint8_t *const)&sd000,
+    (const uint8_t *const)&sd001,
+    (const uint8_t *const)&sd002
+    //(const uint8_t *const)&sd003  //uncomment if implementing a serial number string descriptor named sd003
+};
+
+#endif
+/** EOF usb_descriptors.c ****************************************************/
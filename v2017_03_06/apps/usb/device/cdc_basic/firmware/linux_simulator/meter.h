@@ -0,0 +1,49 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef METER_H
+#define METER_H
+
+#include <stdint.h>
+
+//Timer 0 reload register.  On the PIC18 board Timer 0 times the meter
+//pulses; here it is only a variable the demo writes to.
+extern volatile uint16_t TMR0;
+
+//Last CPU usage passed to meter_set_cpuusage(), in percent.
+extern int meterCpuUsage;
+
+/*********************************************************************
+* Function: void meter_enable(void)
+*
+* Overview: Starts the meter output.  Nothing to do on the simulator.
+*
+********************************************************************/
+void meter_enable(void);
+
+/*********************************************************************
+* Function: void meter_set_cpuusage(int percent)
+*
+* Overview: Sets the CPU usage the meter shows.  The simulator records
+*           it in meterCpuUsage.
+*
+********************************************************************/
+void meter_set_cpuusage(int percent);
+
+#endif //METER_H
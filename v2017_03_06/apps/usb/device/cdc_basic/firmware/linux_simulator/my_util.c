@@ -0,0 +1,92 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#include "system.h"
+#include "app_device_cdc_basic.h"
+#include "my_util.h"
+
+static int essentialCheck(void);
+
+/*********************************************************************
+* Function: int readData(char *buffer)
+*
+* Overview: Reads one packet from the CDC data OUT endpoint.  See
+*           my_util.h.
+*
+********************************************************************/
+int readData(char *buffer)
+{
+    if(essentialCheck() != 0)
+    {
+        return -1;
+    }
+
+    return getsUSBUSART((uint8_t*)buffer, CDC_DATA_OUT_EP_SIZE);
+}
+
+/*********************************************************************
+* Function: int writeData(char *buffer, int numBytes)
+*
+* Overview: Starts sending numBytes bytes with putUSBUSART().  See
+*           my_util.h.
+*
+********************************************************************/
+int writeData(char *buffer, int numBytes)
+{
+    if(essentialCheck() != 0)
+    {
+        return -1;
+    }
+
+    putUSBUSART((uint8_t*)buffer, numBytes);
+    return 0;
+}
+
+/*********************************************************************
+* Function: static int essentialCheck(void)
+*
+* Overview: Checks that the device is configured, not suspended and
+*           ready to send.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: 0 if data can be exchanged with the host, otherwise -1
+*
+********************************************************************/
+static int essentialCheck(void)
+{
+    if(USBGetDeviceState() < CONFIGURED_STATE)
+    {
+        return -1;
+    }
+
+    if(USBIsDeviceSuspended() == true)
+    {
+        return -1;
+    }
+
+    if(USBUSARTIsTxTrfReady() != true)
+    {
+        return -1;
+    }
+
+    return 0;
+}
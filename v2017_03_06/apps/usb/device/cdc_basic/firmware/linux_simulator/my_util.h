@@ -0,0 +1,52 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef MYUTIL_H
+#define MYUTIL_H
+
+/*********************************************************************
+* Function: int readData(char *buffer)
+*
+* Overview: Reads one packet from the CDC data OUT endpoint.
+*
+* PreCondition: buffer holds at least CDC_DATA_OUT_EP_SIZE bytes
+*
+* Input: buffer - receives the packet
+*
+* Output: Number of bytes read, or -1 if the device is not configured,
+*         is suspended or is still sending
+*
+********************************************************************/
+int readData(char *buffer);
+
+/*********************************************************************
+* Function: int writeData(char *buffer, int numBytes)
+*
+* Overview: Starts sending numBytes bytes with putUSBUSART().
+*
+* PreCondition: None
+*
+* Input: buffer - data to send, numBytes - number of bytes
+*
+* Output: 0 if the transfer was started, otherwise -1
+*
+********************************************************************/
+int writeData(char *buffer, int numBytes);
+
+#endif //MYUTIL_H
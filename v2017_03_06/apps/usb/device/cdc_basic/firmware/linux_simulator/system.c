@@ -0,0 +1,571 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+/*******************************************************************************
+  Host (Linux) build of the CDC basic demo against the simulated USB module
+  (framework/usb/src/usb_hal_sim.c).  Build from the firmware directory with,
+  for example:
+
+    gcc -O2 -DUSB_HAL_SIMULATOR \
+        -Ilinux_simulator -Idemo_src -I../../../../../bsp/linux_simulator \
+        -I../../../../../framework/usb/inc \
+        demo_src/main.c demo_src/app_device_cdc_basic.c \
+        demo_src/app_led_usb_status.c demo_src/usb_descriptors.c \
+        demo_src/usb_events.c linux_simulator/system.c \
+        linux_simulator/my_util.c linux_simulator/meter.c \
+        ../../../../../bsp/linux_simulator/leds.c \
+        ../../../../../framework/usb/src/usb_device.c \
+        ../../../../../framework/usb/src/usb_device_cdc.c \
+        ../../../../../framework/usb/src/usb_hal_sim.c \
+        -o cdc_basic_sim
+
+  Add -DUSB_CDC_RX_ZERO_COPY to run getsUSBUSART() over the zero-copy
+  ping-pong receive path.  Add -DUSB_CDC_TX_BUFFER_SIZE=256 to follow the
+  echo workload with a CDC_TxWrite() stream that keeps the transmit ring
+  buffer full and wraps it many times over.
+
+  To run the same workload on two CDC ports at once, add
+  -Ilinux_simulator/dual_cdc in front of -Idemo_src and build
+  linux_simulator/dual_cdc/usb_descriptors.c in place of
+  demo_src/usb_descriptors.c.  The demo echoes the first port, and
+  SYSTEM_Tasks() echoes the second one through the CDCInstance API.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "system.h"
+#include "usb_device.h"
+#include "usb_device_cdc.h"
+#include "meter.h"
+
+//Number of main loop passes that make up one simulated 1ms frame.
+#define SYSTEM_PASSES_PER_FRAME         19
+
+//Lines the simulated host sends before it waits for their echoes.
+#define SYSTEM_LINES_IN_FLIGHT          2
+
+//Each line fills one OUT packet: a three digit CPU usage, text and a
+//carriage return.  The demo echoes everything but the carriage return.
+#define SYSTEM_LINE_SIZE                CDC_DATA_OUT_EP_SIZE
+#define SYSTEM_ECHO_SIZE                (SYSTEM_LINE_SIZE - 1)
+
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+//Bytes written with CDC_TxWrite() after the echo workload.  The chunks are
+//an odd size so the copies in and out of the ring straddle its end, and
+//more chunks are written per pass than the host reads so the ring fills.
+#define SYSTEM_RING_BYTES               (64ul * USB_CDC_TX_BUFFER_SIZE)
+#define SYSTEM_RING_CHUNK_SIZE          37
+#define SYSTEM_RING_CHUNKS_PER_PASS     2
+#endif
+
+typedef enum
+{
+    SYSTEM_HOST_ENUMERATING,
+    SYSTEM_HOST_STREAMING,
+    SYSTEM_HOST_RING
+} SYSTEM_HOST_STATE;
+
+//Interface and endpoint numbers of each CDC port, as the driver uses them.
+#if !defined(USB_CDC_INSTANCE_BINDINGS)
+    #define USB_CDC_INSTANCE_BINDINGS {CDC_COMM_INTF_ID, CDC_DATA_INTF_ID, CDC_COMM_EP, CDC_DATA_EP}
+#endif
+
+static const CDC_INSTANCE_BINDING portBinding[USB_MAX_CDC_INSTANCES] = { USB_CDC_INSTANCE_BINDINGS };
+
+static SYSTEM_HOST_STATE hostState = SYSTEM_HOST_ENUMERATING;
+static uint16_t framePasses;
+static uint32_t linesSent[USB_MAX_CDC_INSTANCES];
+static uint32_t linesEchoed[USB_MAX_CDC_INSTANCES];
+static uint32_t echoErrors;
+
+static struct timespec deviceStart;
+static uint64_t deviceTime;             //ns spent outside of the simulated host
+static USB_SIM_STATISTICS startStatistics;
+static USB_SIM_STATISTICS endStatistics;
+
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+static uint32_t ringBytesWritten;
+static uint32_t ringBytesRead;
+static uint32_t ringErrors;
+static uint32_t ringFull;
+#endif
+
+static void SYSTEM_LineGet(uint8_t port, uint32_t line, uint8_t *data);
+static void SYSTEM_PortTasks(uint8_t port);
+static bool SYSTEM_LinesInFlight(void);
+#if (USB_MAX_CDC_INSTANCES > 1)
+static void SYSTEM_PortEchoTasks(void);
+#endif
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+static void SYSTEM_RingTasks(void);
+static uint8_t SYSTEM_RingByteGet(uint32_t offset);
+#endif
+static void SYSTEM_HostTasks(void);
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to);
+static void SYSTEM_BenchmarkReport(void);
+
+/*********************************************************************
+* Function: void SYSTEM_Initialize( SYSTEM_STATE state )
+*
+* Overview: Initializes the system.
+*
+* PreCondition: None
+*
+* Input:  SYSTEM_STATE - the state to initialize the system into
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Initialize( SYSTEM_STATE state )
+{
+    switch(state)
+    {
+        case SYSTEM_STATE_USB_START:
+            LED_Enable(LED_USB_DEVICE_STATE);
+            meter_enable();
+            break;
+
+        case SYSTEM_STATE_USB_SUSPEND:
+        case SYSTEM_STATE_USB_RESUME:
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+* Function: void SYSTEM_Tasks(void)
+*
+* Overview: Plays the part of the USB host and of the USB interrupt.
+*           See system.h.
+*
+* PreCondition: System has been initalized with SYSTEM_Initialize()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Tasks(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if(hostState == SYSTEM_HOST_STREAMING)
+    {
+        deviceTime += SYSTEM_TimeDifference(&deviceStart, &now);
+    }
+
+    SYSTEM_HostTasks();
+
+    clock_gettime(CLOCK_MONOTONIC, &deviceStart);
+
+#if (USB_MAX_CDC_INSTANCES > 1)
+    if(USBGetDeviceState() == CONFIGURED_STATE)
+    {
+        SYSTEM_PortEchoTasks();
+    }
+#endif
+
+#if defined(USB_INTERRUPT)
+    //The USB interrupt is level sensitive, so the stack runs for as long as
+    //an enabled flag is set, as it would from the interrupt vector.  The
+    //simulated SIE does not raise the bus idle interrupt that moves the
+    //stack out of ATTACHED_STATE, so the interrupt is also taken then.
+    if(((U1IR & U1IE) != 0) || ((U1EIR & U1EIE) != 0) || ((U1OTGIR & U1OTGIE) != 0)
+        || (USBGetDeviceState() == ATTACHED_STATE))
+    {
+        USBDeviceTasks();
+    }
+#endif
+}
+
+/*********************************************************************
+* Function: static void SYSTEM_HostTasks(void)
+*
+* Overview: Issues the next tokens of the simulated host.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_HostTasks(void)
+{
+    uint8_t port;
+
+    switch(hostState)
+    {
+        case SYSTEM_HOST_ENUMERATING:
+            if(USBSimEnumerateTasks(1) == false)
+            {
+                break;
+            }
+
+            //The device is configured; everything from here on is the
+            //steady state echo workload.
+            startStatistics = USBSimStatistics;
+            deviceTime = 0;
+            hostState = SYSTEM_HOST_STREAMING;
+            break;
+
+        case SYSTEM_HOST_STREAMING:
+            if(((USBSimStatistics.bytesOut - startStatistics.bytesOut) >= SYSTEM_BENCHMARK_BYTES)
+                && (SYSTEM_LinesInFlight() == false))
+            {
+                endStatistics = USBSimStatistics;
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+                hostState = SYSTEM_HOST_RING;
+                break;
+#else
+                SYSTEM_BenchmarkReport();
+                exit((echoErrors == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+#endif
+            }
+
+            for(port = 0; port < USB_MAX_CDC_INSTANCES; port++)
+            {
+                SYSTEM_PortTasks(port);
+            }
+
+            if(++framePasses >= SYSTEM_PASSES_PER_FRAME)
+            {
+                framePasses = 0;
+                USBSimStartOfFrame();
+            }
+            break;
+
+        case SYSTEM_HOST_RING:
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+            SYSTEM_RingTasks();
+#endif
+            break;
+    }
+}
+
+/*********************************************************************
+* Function: static void SYSTEM_PortTasks(uint8_t port)
+*
+* Overview: Sends the next line to one CDC port and checks the echo of
+*           the oldest line in flight, as the host.
+*
+* PreCondition: The device is configured
+*
+* Input: port - the CDC instance
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_PortTasks(uint8_t port)
+{
+    uint8_t line[SYSTEM_LINE_SIZE];
+    uint8_t echo[CDC_DATA_IN_EP_SIZE];
+    uint16_t length;
+
+    if(((USBSimStatistics.bytesOut - startStatistics.bytesOut) < SYSTEM_BENCHMARK_BYTES)
+        && ((linesSent[port] - linesEchoed[port]) < SYSTEM_LINES_IN_FLIGHT))
+    {
+        SYSTEM_LineGet(port, linesSent[port], line);
+        if(USBSimOutToken(portBinding[port].dataEP, line, sizeof(line)) == USB_SIM_ACK)
+        {
+            linesSent[port]++;
+        }
+    }
+
+    if((linesEchoed[port] != linesSent[port])
+        && (USBSimInToken(portBinding[port].dataEP, echo, &length) == USB_SIM_ACK))
+    {
+        SYSTEM_LineGet(port, linesEchoed[port], line);
+        if((length != SYSTEM_ECHO_SIZE) || (memcmp(echo, line, SYSTEM_ECHO_SIZE) != 0))
+        {
+            echoErrors++;
+        }
+        linesEchoed[port]++;
+    }
+}
+
+/*********************************************************************
+* Function: static bool SYSTEM_LinesInFlight(void)
+*
+* Overview: Returns true while a line sent to any port has not been
+*           echoed yet.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: true if an echo is outstanding
+*
+********************************************************************/
+static bool SYSTEM_LinesInFlight(void)
+{
+    uint8_t port;
+
+    for(port = 0; port < USB_MAX_CDC_INSTANCES; port++)
+    {
+        if(linesEchoed[port] != linesSent[port])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#if (USB_MAX_CDC_INSTANCES > 1)
+/*********************************************************************
+* Function: static void SYSTEM_PortEchoTasks(void)
+*
+* Overview: The application on the ports after the first.  Echoes each
+*           line received through the CDCInstance API, without its
+*           carriage return, the same way the demo does on port 0.  The
+*           driver sends from the buffer after CDCInstancePut() returns,
+*           so each port keeps its own until the transfer is done.
+*
+* PreCondition: The device is configured
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_PortEchoTasks(void)
+{
+    static uint8_t buffer[USB_MAX_CDC_INSTANCES][CDC_DATA_OUT_EP_SIZE];
+    uint8_t length;
+    uint8_t port;
+
+    for(port = 1; port < USB_MAX_CDC_INSTANCES; port++)
+    {
+        if(CDCInstanceIsTxTrfReady(port) == false)
+        {
+            continue;
+        }
+
+        length = CDCInstanceGets(port, buffer[port], sizeof(buffer[port]));
+        if((length != 0) && (buffer[port][length - 1] == '\r'))
+        {
+            length--;
+        }
+        if(length != 0)
+        {
+            CDCInstancePut(port, buffer[port], length);
+        }
+    }
+}
+#endif
+
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+/*********************************************************************
+* Function: static void SYSTEM_RingTasks(void)
+*
+* Overview: Queues the next chunks of the ring stream with CDC_TxWrite(),
+*           as the application would, then reads one packet of it back as
+*           the host and checks it.  Prints the results and exits once
+*           SYSTEM_RING_BYTES have been read back.
+*
+* PreCondition: The echo workload is complete
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_RingTasks(void)
+{
+    uint8_t chunk[SYSTEM_RING_CHUNK_SIZE];
+    uint8_t packet[CDC_DATA_IN_EP_SIZE];
+    uint16_t length;
+    size_t freeSpace;
+    size_t size;
+    size_t accepted;
+    uint8_t i;
+
+    if((ringBytesRead >= SYSTEM_RING_BYTES) && (ringBytesRead == ringBytesWritten))
+    {
+        SYSTEM_BenchmarkReport();
+        exit(((echoErrors == 0) && (ringErrors == 0) && (ringFull != 0)) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    for(i = 0; (i < SYSTEM_RING_CHUNKS_PER_PASS) && (ringBytesWritten < SYSTEM_RING_BYTES); i++)
+    {
+        size = SYSTEM_RING_BYTES - ringBytesWritten;
+        if(size > sizeof(chunk))
+        {
+            size = sizeof(chunk);
+        }
+        for(length = 0; length < size; length++)
+        {
+            chunk[length] = SYSTEM_RingByteGet(ringBytesWritten + length);
+        }
+
+        //A full ring must take part of a chunk, or none of it, and report
+        //exactly the space it had.
+        freeSpace = CDC_TxFreeSpaceGet();
+        accepted = CDC_TxWrite(chunk, size);
+        if(accepted != ((freeSpace < size) ? freeSpace : size))
+        {
+            ringErrors++;
+        }
+        if(accepted < size)
+        {
+            ringFull++;
+        }
+        ringBytesWritten += accepted;
+    }
+
+    if(USBSimInToken(CDC_DATA_EP, packet, &length) == USB_SIM_ACK)
+    {
+        for(i = 0; i < length; i++)
+        {
+            if(packet[i] != SYSTEM_RingByteGet(ringBytesRead + i))
+            {
+                ringErrors++;
+                break;
+            }
+        }
+        ringBytesRead += length;
+    }
+
+    if(++framePasses >= SYSTEM_PASSES_PER_FRAME)
+    {
+        framePasses = 0;
+        USBSimStartOfFrame();
+    }
+}
+
+/*********************************************************************
+* Function: static uint8_t SYSTEM_RingByteGet(uint32_t offset)
+*
+* Overview: Returns the byte at 'offset' in the ring stream.  The period
+*           of 251 bytes is prime, so it never lines up with the ring or
+*           the packets.
+*
+* PreCondition: None
+*
+* Input: offset - position in the ring stream
+*
+* Output: The byte at that position
+*
+********************************************************************/
+static uint8_t SYSTEM_RingByteGet(uint32_t offset)
+{
+    return (uint8_t)(offset % 251u);
+}
+#endif
+
+/*********************************************************************
+* Function: static void SYSTEM_LineGet(uint8_t port, uint32_t line, uint8_t *data)
+*
+* Overview: Builds line number 'line' of the host workload for a port.
+*           The text differs between ports, so crossed echoes are caught.
+*
+* PreCondition: None
+*
+* Input: port - the CDC instance, line - the line number,
+*        data - receives SYSTEM_LINE_SIZE bytes
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_LineGet(uint8_t port, uint32_t line, uint8_t *data)
+{
+    uint8_t i;
+
+    data[0] = '0' + ((line / 100) % 10);
+    data[1] = '0' + ((line / 10) % 10);
+    data[2] = '0' + (line % 10);
+    for(i = 3; i < SYSTEM_ECHO_SIZE; i++)
+    {
+        data[i] = 'A' + ((line + i + (port * 13u)) % 26);
+    }
+    data[SYSTEM_ECHO_SIZE] = '\r';
+}
+
+/*********************************************************************
+* Function: static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+*
+* Overview: Returns the number of nanoseconds between two timestamps.
+*
+* PreCondition: None
+*
+* Input: from - the earlier timestamp, to - the later timestamp
+*
+* Output: Elapsed time in ns
+*
+********************************************************************/
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+{
+    return ((uint64_t)(to->tv_sec - from->tv_sec) * 1000000000ull)
+            + (uint64_t)to->tv_nsec - (uint64_t)from->tv_nsec;
+}
+
+/*********************************************************************
+* Function: static void SYSTEM_BenchmarkReport(void)
+*
+* Overview: Prints the device side throughput figures for the echo
+*           workload, and the results of the ring stream.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_BenchmarkReport(void)
+{
+    uint64_t bytesOut = endStatistics.bytesOut - startStatistics.bytesOut;
+    uint64_t bytesIn = endStatistics.bytesIn - startStatistics.bytesIn;
+    uint32_t transactions = endStatistics.transactions - startStatistics.transactions;
+    uint32_t calls = endStatistics.deviceTasksCalls - startStatistics.deviceTasksCalls;
+    uint32_t naks = endStatistics.naks - startStatistics.naks;
+    double seconds = (double)deviceTime / 1e9;
+    uint32_t echoed = 0;
+    uint8_t port;
+
+    for(port = 0; port < USB_MAX_CDC_INSTANCES; port++)
+    {
+        echoed += linesEchoed[port];
+    }
+
+    printf("lines echoed             : %lu (%lu wrong)\n", (unsigned long)echoed, (unsigned long)echoErrors);
+#if (USB_MAX_CDC_INSTANCES > 1)
+    for(port = 0; port < USB_MAX_CDC_INSTANCES; port++)
+    {
+        printf("  on port %u              : %lu\n", port, (unsigned long)linesEchoed[port]);
+    }
+#endif
+    printf("bytes out / in           : %llu / %llu\n", (unsigned long long)bytesOut, (unsigned long long)bytesIn);
+    printf("transactions             : %lu (%lu NAKed)\n", (unsigned long)transactions, (unsigned long)naks);
+    printf("device time              : %.3f ms\n", seconds * 1e3);
+    printf("throughput               : %.0f bytes/s\n", (double)(bytesOut + bytesIn) / seconds);
+    printf("ns per transaction       : %.1f\n", (double)deviceTime / (double)transactions);
+    printf("USBDeviceTasks() calls   : %lu\n", (unsigned long)calls);
+    printf("packets per tasks call   : %.3f\n", (double)transactions / (double)calls);
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+    printf("TX ring bytes            : %lu (%lu wrong)\n", (unsigned long)ringBytesRead, (unsigned long)ringErrors);
+    printf("TX ring full / wrapped   : %lu / %lu times\n", (unsigned long)ringFull,
+            (unsigned long)(ringBytesWritten / USB_CDC_TX_BUFFER_SIZE));
+#endif
+}
@@ -0,0 +1,83 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+#ifndef SYSTEM_H
+#define SYSTEM_H
+
+#include <xc.h>
+#include <stdbool.h>
+
+#include "leds.h"
+
+#include "io_mapping.h"
+#include "usb_config.h"
+
+#define MAIN_RETURN int
+
+//Total number of bytes the simulated host sends to the device before the
+//benchmark reports its results and exits.
+#if !defined(SYSTEM_BENCHMARK_BYTES)
+    #define SYSTEM_BENCHMARK_BYTES      (16ul * 1024ul * 1024ul)
+#endif
+
+/*** System States **************************************************/
+typedef enum
+{
+    SYSTEM_STATE_USB_START,
+    SYSTEM_STATE_USB_SUSPEND,
+    SYSTEM_STATE_USB_RESUME
+} SYSTEM_STATE;
+
+/*********************************************************************
+* Function: void SYSTEM_Initialize( SYSTEM_STATE state )
+*
+* Overview: Initializes the system.
+*
+* PreCondition: None
+*
+* Input:  SYSTEM_STATE - the state to initialize the system into
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Initialize( SYSTEM_STATE state );
+
+/*********************************************************************
+* Function: void SYSTEM_Tasks(void)
+*
+* Overview: Plays the part of the USB host.  Enumerates the device on the
+*           simulated bus, then sends full size lines to the CDC data OUT
+*           endpoint, reads the echoed lines back from the data IN
+*           endpoint and checks them.  Also stands in for the USB
+*           interrupt, calling USBDeviceTasks() when USB_INTERRUPT is
+*           selected.  Prints the results and exits once
+*           SYSTEM_BENCHMARK_BYTES have been sent, or, when
+*           USB_CDC_TX_BUFFER_SIZE is defined, after it has streamed
+*           data queued with CDC_TxWrite() through the transmit ring.
+*
+* PreCondition: System has been initalized with SYSTEM_Initialize()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Tasks(void);
+
+#endif //SYSTEM_H
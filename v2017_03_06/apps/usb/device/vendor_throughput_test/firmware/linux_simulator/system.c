@@ -0,0 +1,209 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license), 
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+
+/*******************************************************************************
+  Host (Linux) build of the vendor throughput test against the simulated USB
+  module (framework/usb/src/usb_hal_sim.c).  Build from the firmware directory
+  with, for example:
+
+    gcc -O2 -DUSB_HAL_SIMULATOR \
+        -Ilinux_simulator -Idemo_src -I../../../../../bsp/linux_simulator \
+        -I../../../../../framework/usb/inc \
+        demo_src/main.c demo_src/app_device_vendor_throughput_test.c \
+        demo_src/app_led_usb_status.c demo_src/usb_descriptors.c \
+        demo_src/usb_events.c linux_simulator/system.c \
+        ../../../../../bsp/linux_simulator/leds.c \
+        ../../../../../framework/usb/src/usb_device.c \
+        ../../../../../framework/usb/src/usb_device_generic.c \
+        ../../../../../framework/usb/src/usb_hal_sim.c \
+        -o vendor_throughput_test_sim
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "system.h"
+#include "usb_device.h"
+
+//Number of main loop passes that make up one simulated 1ms frame.  A full
+//speed host can schedule at most 19 x 64 byte bulk packets per frame.
+#define SYSTEM_PASSES_PER_FRAME         19
+
+//Endpoints the simulated host streams bulk OUT data to.
+#define SYSTEM_FIRST_BULK_EP            1
+#define SYSTEM_LAST_BULK_EP             3
+
+typedef enum
+{
+    SYSTEM_HOST_ENUMERATING,
+    SYSTEM_HOST_STREAMING
+} SYSTEM_HOST_STATE;
+
+static SYSTEM_HOST_STATE hostState = SYSTEM_HOST_ENUMERATING;
+static uint8_t hostPacket[64];
+static uint16_t framePasses;
+
+static struct timespec deviceStart;
+static uint64_t deviceTime;             //ns spent outside of SYSTEM_Tasks()
+static USB_SIM_STATISTICS startStatistics;
+
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to);
+static void SYSTEM_BenchmarkReport(void);
+
+/*********************************************************************
+* Function: void SYSTEM_Initialize( SYSTEM_STATE state )
+*
+* Overview: Initializes the system.
+*
+* PreCondition: None
+*
+* Input:  SYSTEM_STATE - the state to initialize the system into
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Initialize( SYSTEM_STATE state )
+{
+    uint8_t i;
+
+    switch(state)
+    {
+        case SYSTEM_STATE_USB_START:
+            LED_Enable(LED_USB_DEVICE_STATE);
+
+            for(i = 0; i < sizeof(hostPacket); i++)
+            {
+                hostPacket[i] = i;
+            }
+            break;
+
+        case SYSTEM_STATE_USB_SUSPEND:
+        case SYSTEM_STATE_USB_RESUME:
+        default:
+            break;
+    }
+}
+
+/*********************************************************************
+* Function: void SYSTEM_Tasks(void)
+*
+* Overview: Plays the part of the USB host.  See system.h.
+*
+* PreCondition: System has been initalized with SYSTEM_Initialize()
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void SYSTEM_Tasks(void)
+{
+    struct timespec now;
+    uint8_t ep;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    switch(hostState)
+    {
+        case SYSTEM_HOST_ENUMERATING:
+            if(USBSimEnumerateTasks(1) == false)
+            {
+                break;
+            }
+
+            //The device is configured; everything from here on is the
+            //steady state bulk workload.
+            startStatistics = USBSimStatistics;
+            deviceTime = 0;
+            hostState = SYSTEM_HOST_STREAMING;
+            break;
+
+        case SYSTEM_HOST_STREAMING:
+            deviceTime += SYSTEM_TimeDifference(&deviceStart, &now);
+
+            if((USBSimStatistics.bytesOut - startStatistics.bytesOut) >= SYSTEM_BENCHMARK_BYTES)
+            {
+                SYSTEM_BenchmarkReport();
+                exit(EXIT_SUCCESS);
+            }
+
+            for(ep = SYSTEM_FIRST_BULK_EP; ep <= SYSTEM_LAST_BULK_EP; ep++)
+            {
+                USBSimOutToken(ep, hostPacket, sizeof(hostPacket));
+            }
+
+            if(++framePasses >= SYSTEM_PASSES_PER_FRAME)
+            {
+                framePasses = 0;
+                USBSimStartOfFrame();
+            }
+            break;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deviceStart);
+}
+
+/*********************************************************************
+* Function: static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+*
+* Overview: Returns the number of nanoseconds between two timestamps.
+*
+* PreCondition: None
+*
+* Input: from - the earlier timestamp, to - the later timestamp
+*
+* Output: Elapsed time in ns
+*
+********************************************************************/
+static uint64_t SYSTEM_TimeDifference(const struct timespec *from, const struct timespec *to)
+{
+    return ((uint64_t)(to->tv_sec - from->tv_sec) * 1000000000ull)
+            + (uint64_t)to->tv_nsec - (uint64_t)from->tv_nsec;
+}
+
+/*********************************************************************
+* Function: static void SYSTEM_BenchmarkReport(void)
+*
+* Overview: Prints the device side throughput figures for the run.
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+static void SYSTEM_BenchmarkReport(void)
+{
+    uint64_t bytes = USBSimStatistics.bytesOut - startStatistics.bytesOut;
+    uint32_t transactions = USBSimStatistics.transactions - startStatistics.transactions;
+    uint32_t calls = USBSimStatistics.deviceTasksCalls - startStatistics.deviceTasksCalls;
+    uint32_t naks = USBSimStatistics.naks - startStatistics.naks;
+    double seconds = (double)deviceTime / 1e9;
+
+    printf("bytes transferred        : %llu\n", (unsigned long long)bytes);
+    printf("transactions             : %lu (%lu NAKed)\n", (unsigned long)transactions, (unsigned long)naks);
+    printf("device time              : %.3f ms\n", seconds * 1e3);
+    printf("throughput               : %.2f MB/s\n", ((double)bytes / seconds) / 1e6);
+    printf("ns per transaction       : %.1f\n", (double)deviceTime / (double)transactions);
+    printf("USBDeviceTasks() calls   : %lu\n", (unsigned long)calls);
+    printf("packets per tasks call   : %.3f\n", (double)transactions / (double)calls);
+}
@@ -0,0 +1,46 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*******************************************************************************/
+
+#include <stdbool.h>
+
+#include "leds.h"
+
+static bool led_state[LED_COUNT + 1];
+
+void LED_On(LED led)
+{
+    led_state[led] = true;
+}
+
+void LED_Off(LED led)
+{
+    led_state[led] = false;
+}
+
+void LED_Toggle(LED led)
+{
+    led_state[led] = !led_state[led];
+}
+
+bool LED_Get(LED led)
+{
+    return led_state[led];
+}
+
+void LED_Enable(LED led)
+{
+    led_state[led] = false;
+}
@@ -0,0 +1,101 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*******************************************************************************/
+
+#ifndef LEDS_H
+#define LEDS_H
+
+#include <stdbool.h>
+
+/** Type definitions *********************************/
+typedef enum
+{
+    LED_NONE,
+    LED_D1
+} LED;
+
+#define LED_COUNT 1
+
+/*********************************************************************
+* Function: void LED_On(LED led);
+*
+* Overview: Turns requested LED on.  The simulator only records the state.
+*
+* PreCondition: LED configured via LED_Enable()
+*
+* Input: LED led - enumeration of the LEDs available in this demo.
+*
+* Output: none
+*
+********************************************************************/
+void LED_On(LED led);
+
+/*********************************************************************
+* Function: void LED_Off(LED led);
+*
+* Overview: Turns requested LED off.  The simulator only records the state.
+*
+* PreCondition: LED configured via LED_Enable()
+*
+* Input: LED led - enumeration of the LEDs available in this demo.
+*
+* Output: none
+*
+********************************************************************/
+void LED_Off(LED led);
+
+/*********************************************************************
+* Function: void LED_Toggle(LED led);
+*
+* Overview: Toggles the state of the requested LED
+*
+* PreCondition: LED configured via LED_Enable()
+*
+* Input: LED led - enumeration of the LEDs available in this demo.
+*
+* Output: none
+*
+********************************************************************/
+void LED_Toggle(LED led);
+
+/*********************************************************************
+* Function: bool LED_Get(LED led);
+*
+* Overview: Returns the current state of the requested LED
+*
+* PreCondition: LED configured via LED_Enable()
+*
+* Input: LED led - enumeration of the LEDs available in this demo.
+*
+* Output: true if on, false if off
+*
+********************************************************************/
+bool LED_Get(LED led);
+
+/*********************************************************************
+* Function: void LED_Enable(LED led);
+*
+* Overview: Configures the LED for use by the other LED API
+*
+* PreCondition: none
+*
+* Input: LED led - enumeration of the LEDs available in this demo.
+*
+* Output: none
+*
+********************************************************************/
+void LED_Enable(LED led);
+
+#endif //LEDS_H
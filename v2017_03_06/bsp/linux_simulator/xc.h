@@ -0,0 +1,37 @@
+/*******************************************************************************
+Copyright 2016 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+*******************************************************************************/
+
+//Stand-in for the compiler supplied <xc.h> when the USB stack is built with
+//a host compiler against the simulated USB module (USB_HAL_SIMULATOR).  The
+//USB module registers themselves are provided by usb_hal_sim.h.  The
+//graphics library uses it the same way with the simulated display
+//(GFX_USE_DISPLAY_CONTROLLER_SIMULATOR).
+
+#ifndef XC_H
+#define XC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define __PACKED    __attribute__((packed))
+
+#define Nop()
+#define ClrWdt()
+
+//Constant data that the PIC24 compilers place in program memory
+#define __prog__    const
+
+#endif //XC_H
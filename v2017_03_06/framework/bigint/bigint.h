@@ -411,6 +411,115 @@ int  BIGINT_Magnitude(BIGINT_DATA *n);
 
 int  BIGINT_Compare(BIGINT_DATA *a, BIGINT_DATA *b);
 
+/*******************************************************************************
+Function:
+
+uint16_t BIGINT_MontgomeryFactor(BIGINT_DATA *n);
+
+Summary:
+Computes the Montgomery reduction factor for a modulus.
+
+Description:
+This function returns n' = -n^-1 mod 2^16, the per-word factor used by
+BIGINT_MontgomeryMultiply and BIGINT_MontgomeryReduce.  It only needs to be
+computed once for each modulus.
+
+Precondition:
+n must be odd.
+
+Parameters:
+Pointer to the modulus.
+
+Returns:
+The Montgomery reduction factor for n.
+
+Example:
+<code>
+uint16_t nPrime = BIGINT_MontgomeryFactor(n);
+</code>
+
+Remarks:
+Only Little Endianness is supported.
+ *****************************************************************************/
+
+uint16_t BIGINT_MontgomeryFactor(BIGINT_DATA *n);
+
+/*******************************************************************************
+Function:
+
+BIGINT_RESULT BIGINT_MontgomeryMultiply(BIGINT_DATA *result, BIGINT_DATA *a,
+    BIGINT_DATA *b, BIGINT_DATA *n, uint16_t nPrime);
+
+Summary:
+Big Integer Montgomery multiplication routine.
+
+Description:
+This function computes result = a * b * R^-1 mod n, where R = 2^(8 * n->bLength),
+using interleaved multiplication and reduction (CIOS).  If a and b are in
+Montgomery form (x * R mod n) the result is also in Montgomery form, so a
+chain of modular multiplications needs no long division.
+
+Precondition:
+n must be odd and nPrime must be BIGINT_MontgomeryFactor(n).
+a and b must be less than n and at least n->bLength bytes long; only the
+low n->bLength bytes of each are used.
+result->bLength must be at least n->bLength + 4 bytes.  On return the
+product occupies the low n->bLength bytes and the remainder is zero.
+Result cannot overlap with memory pointed by either a or b.
+
+Parameters:
+Pointers to the result, the operands and the modulus, and the factor for n.
+
+Returns:
+BIGINT_RESULT_RESULT_BUFFER_LENGTH_INSUFFICIENT if result is too short,
+BIGINT_RESULT_OK otherwise.
+
+Example:
+<code>
+BIGINT_MontgomeryMultiply(tmp, x, y, n, nPrime);
+</code>
+
+Remarks:
+Only Little Endianness is supported.If the operands are not in the Little Endian format,
+They need to be changed to Little-Endianness format.
+ *****************************************************************************/
+
+BIGINT_RESULT BIGINT_MontgomeryMultiply(BIGINT_DATA *result, BIGINT_DATA *a, BIGINT_DATA *b, BIGINT_DATA *n, uint16_t nPrime);
+
+/*******************************************************************************
+Function:
+
+BIGINT_RESULT BIGINT_MontgomeryReduce(BIGINT_DATA *result, BIGINT_DATA *a,
+    BIGINT_DATA *n, uint16_t nPrime);
+
+Summary:
+Converts a value out of Montgomery form.
+
+Description:
+This function computes result = a * R^-1 mod n.  It is equivalent to
+BIGINT_MontgomeryMultiply with b equal to one.
+
+Precondition:
+Same as BIGINT_MontgomeryMultiply.
+
+Parameters:
+Pointers to the result, the operand and the modulus, and the factor for n.
+
+Returns:
+BIGINT_RESULT_RESULT_BUFFER_LENGTH_INSUFFICIENT if result is too short,
+BIGINT_RESULT_OK otherwise.
+
+Example:
+<code>
+BIGINT_MontgomeryReduce(tmp, xR, n, nPrime);
+</code>
+
+Remarks:
+Only Little Endianness is supported.
+ *****************************************************************************/
+
+BIGINT_RESULT BIGINT_MontgomeryReduce(BIGINT_DATA *result, BIGINT_DATA *a, BIGINT_DATA *n, uint16_t nPrime);
+
 
 #endif  // __BIGINT_H_
 
@@ -688,6 +688,230 @@ BIGINT_RESULT BIGINT_Mod(BIGINT_DATA *result, BIGINT_DATA *a, BIGINT_DATA *b)
     return BIGINT_RESULT_OK;
 }
 
+/*********************************************************************
+ * Function:        static void BigIntMontgomery(BIGINT_DATA_TYPE *t,
+ *                      BIGINT_DATA_TYPE *a, BIGINT_DATA_TYPE *b,
+ *                      BIGINT_DATA_TYPE *n, uint32_t s,
+ *                      BIGINT_DATA_TYPE nPrime)
+ *
+ * PreCondition:    t has room for s + 2 words and doesn't overlap a or b
+ *
+ * Input:           *a, *b: s-word operands, both less than n
+ *                  *n: s-word odd modulus
+ *                  nPrime: -n^-1 mod 2^16
+ *                  b == NULL is treated as the value one
+ *
+ * Output:          t[0..s-1] = a * b * 2^(-16s) mod n, t[s..s+1] = 0
+ *
+ * Side Effects:    None
+ *
+ * Overview:        Coarsely integrated operand scanning (CIOS) Montgomery
+ *                  multiplication.  Each pass adds one word of b times a
+ *                  and then the multiple of n that clears the low word, so
+ *                  the accumulator never grows past s + 2 words.
+ *
+ * Note:            None
+ ********************************************************************/
+static void BigIntMontgomery(BIGINT_DATA_TYPE *t, BIGINT_DATA_TYPE *a, BIGINT_DATA_TYPE *b, BIGINT_DATA_TYPE *n, uint32_t s, BIGINT_DATA_TYPE nPrime)
+{
+    BIGINT_DATA_TYPE_2 c;
+    BIGINT_DATA_TYPE bi, m;
+    uint32_t i, j;
+
+    memset (t, 0x00, (s + 2) * BIGINT_DATA_SIZE);
+
+    for (i = 0; i < s; i++)
+    {
+        // t = t + a * b[i]
+        if (b != NULL)
+        {
+            bi = b[i];
+        }
+        else
+        {
+            bi = (i == 0) ? 1 : 0;
+        }
+
+        c = 0;
+        if (bi != 0)
+        {
+            for (j = 0; j < s; j++)
+            {
+                c += (BIGINT_DATA_TYPE_2)a[j] * bi + t[j];
+                t[j] = (BIGINT_DATA_TYPE)c;
+                c >>= 16;
+            }
+        }
+        c += t[s];
+        t[s] = (BIGINT_DATA_TYPE)c;
+        t[s + 1] = (BIGINT_DATA_TYPE)(c >> 16);
+
+        // t = (t + m * n) / 2^16, with m chosen so the low word becomes zero
+        m = (BIGINT_DATA_TYPE)((BIGINT_DATA_TYPE_2)t[0] * nPrime);
+        c = ((BIGINT_DATA_TYPE_2)m * n[0] + t[0]) >> 16;
+        for (j = 1; j < s; j++)
+        {
+            c += (BIGINT_DATA_TYPE_2)m * n[j] + t[j];
+            t[j - 1] = (BIGINT_DATA_TYPE)c;
+            c >>= 16;
+        }
+        c += t[s];
+        t[s - 1] = (BIGINT_DATA_TYPE)c;
+        t[s] = t[s + 1] + (BIGINT_DATA_TYPE)(c >> 16);
+        t[s + 1] = 0;
+    }
+
+    // t < 2n here; one conditional subtraction brings it into range
+    if (t[s] == 0)
+    {
+        j = s;
+        while ((j != 0) && (t[j - 1] == n[j - 1]))
+        {
+            j--;
+        }
+        if ((j != 0) && (t[j - 1] < n[j - 1]))
+        {
+            return;
+        }
+    }
+
+    c = 0;
+    for (j = 0; j < s; j++)
+    {
+        c = (BIGINT_DATA_TYPE_2)t[j] - n[j] - c;
+        t[j] = (BIGINT_DATA_TYPE)c;
+        c = (c >> 16) & 0x01;
+    }
+    t[s] = 0;
+}
+
+/*******************************************************************************
+  Function:
+   
+   uint16_t BIGINT_MontgomeryFactor(BIGINT_DATA *n)
+
+  Summary:
+   Computes the Montgomery reduction factor for a modulus.
+
+  Description:
+    Returns n' = -n^-1 mod 2^16.  Each Newton iteration x = x * (2 - n * x)
+    doubles the number of correct low bits of the inverse; n * n == 1 mod 8
+    for any odd n, so three iterations are enough for 16 bits.
+
+  Precondition:
+   n is odd.
+
+  Parameters:
+   Pointer to the modulus.
+
+  Returns:
+   The Montgomery reduction factor for n.
+
+  Example:
+    <code>
+    nPrime = BIGINT_MontgomeryFactor(n);
+    </code>
+
+  Remarks:
+  Only Little Endianness is supported.
+ *****************************************************************************/
+uint16_t BIGINT_MontgomeryFactor(BIGINT_DATA *n)
+{
+    BIGINT_DATA_TYPE n0 = *(BIGINT_DATA_TYPE *)n->startAddress;
+    BIGINT_DATA_TYPE x = n0;
+
+    x = (BIGINT_DATA_TYPE)((BIGINT_DATA_TYPE_2)x * (2 - (BIGINT_DATA_TYPE_2)n0 * x));
+    x = (BIGINT_DATA_TYPE)((BIGINT_DATA_TYPE_2)x * (2 - (BIGINT_DATA_TYPE_2)n0 * x));
+    x = (BIGINT_DATA_TYPE)((BIGINT_DATA_TYPE_2)x * (2 - (BIGINT_DATA_TYPE_2)n0 * x));
+
+    return (BIGINT_DATA_TYPE)(0 - x);
+}
+
+/*******************************************************************************
+  Function:
+   
+   BIGINT_RESULT BIGINT_MontgomeryMultiply(BIGINT_DATA *result, BIGINT_DATA *a,
+        BIGINT_DATA *b, BIGINT_DATA *n, uint16_t nPrime)
+
+  Summary:
+   Big Integer Montgomery multiplication routine.
+
+  Description:
+    result = a * b * R^-1 mod n, where R = 2^(8 * n->bLength).
+
+  Precondition:
+   a, b < n.  result is at least n->bLength + 4 bytes long and does not
+   overlap a or b.
+
+  Parameters:
+   Pointers to the result, operands and modulus, and the factor for n.
+
+  Returns:
+   BIGINT_RESULT
+
+  Example:
+    <code>
+    BIGINT_MontgomeryMultiply(tmp, x, y, n, nPrime);
+    </code>
+
+  Remarks:
+  Only Little Endianness is supported.If the operands are not in the Little Endian format,
+  They need to be changed to Little-Endianness format.
+ *****************************************************************************/
+BIGINT_RESULT BIGINT_MontgomeryMultiply(BIGINT_DATA *result, BIGINT_DATA *a, BIGINT_DATA *b, BIGINT_DATA *n, uint16_t nPrime)
+{
+    uint32_t s = n->bLength / BIGINT_DATA_SIZE;
+
+    if (result->bLength < ((s + 2) * BIGINT_DATA_SIZE))
+        return BIGINT_RESULT_RESULT_BUFFER_LENGTH_INSUFFICIENT;
+
+    BigIntMontgomery(result->startAddress, a->startAddress, b->startAddress, n->startAddress, s, nPrime);
+
+    return BIGINT_RESULT_OK;
+}
+
+/*******************************************************************************
+  Function:
+   
+   BIGINT_RESULT BIGINT_MontgomeryReduce(BIGINT_DATA *result, BIGINT_DATA *a,
+        BIGINT_DATA *n, uint16_t nPrime)
+
+  Summary:
+   Converts a value out of Montgomery form.
+
+  Description:
+    result = a * R^-1 mod n, where R = 2^(8 * n->bLength).
+
+  Precondition:
+   a < n.  result is at least n->bLength + 4 bytes long and does not
+   overlap a.
+
+  Parameters:
+   Pointers to the result, operand and modulus, and the factor for n.
+
+  Returns:
+   BIGINT_RESULT
+
+  Example:
+    <code>
+    BIGINT_MontgomeryReduce(tmp, xR, n, nPrime);
+    </code>
+
+  Remarks:
+  Only Little Endianness is supported.
+ *****************************************************************************/
+BIGINT_RESULT BIGINT_MontgomeryReduce(BIGINT_DATA *result, BIGINT_DATA *a, BIGINT_DATA *n, uint16_t nPrime)
+{
+    uint32_t s = n->bLength / BIGINT_DATA_SIZE;
+
+    if (result->bLength < ((s + 2) * BIGINT_DATA_SIZE))
+        return BIGINT_RESULT_RESULT_BUFFER_LENGTH_INSUFFICIENT;
+
+    BigIntMontgomery(result->startAddress, a->startAddress, NULL, n->startAddress, s, nPrime);
+
+    return BIGINT_RESULT_OK;
+}
+
 /*********************************************************************
  * Function:        CHAR BIGINT_Compare(BIGINTGINT *a, BIGINTGINT *b)
  *
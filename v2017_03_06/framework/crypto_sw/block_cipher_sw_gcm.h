@@ -27,6 +27,15 @@
 #include <stdbool.h>
 #include "system_config.h"
 
+// Number of hash subkey multiples stored in the GCM context for the table-driven GHASH.
+// Selected with CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT or CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT;
+// with neither defined the bit-serial multiply is used and no table is stored.
+#if defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT)
+    #define BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE    256u
+#elif defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT)
+    #define BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE    16u
+#endif
+
 // Context structure for the Galois counter operation
 typedef struct
 {
@@ -35,6 +44,9 @@ typedef struct
     uint8_t __attribute__((aligned)) hashSubKey[CRYPTO_CONFIG_SW_BLOCK_MAX_SIZE];            // Buffer containing the calculated hash subkey
     uint8_t __attribute__((aligned)) authTag[CRYPTO_CONFIG_SW_BLOCK_MAX_SIZE];               // Buffer containing the current authentication tag
     uint8_t __attribute__((aligned)) authBuffer[CRYPTO_CONFIG_SW_BLOCK_MAX_SIZE];            // Buffer containing data that has been encrypted but has not been authenticated
+#if defined(BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE)
+    uint32_t hashTable[BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE][4];            // Precomputed multiples of the hash subkey, as big-endian 32-bit words
+#endif
     BLOCK_CIPHER_SW_FunctionEncrypt encrypt;                                   // Encrypt function for the algorithm being used with the block cipher mode module
     BLOCK_CIPHER_SW_FunctionDecrypt decrypt;                                   // Decrypt function for the algorithm being used with the block cipher mode module
     void * keyStream;                                                       // Pointer to the key stream.  Must be a multiple of the cipher's block size, but smaller than 2^25 bytes.
@@ -140,6 +152,12 @@ typedef struct
         // error
     }
     </code>
+
+  Remarks:
+    If CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT or CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT
+    is defined, this function also builds the GHASH multiplication table
+    (256 or 4096 bytes) in the context from the hash subkey.  The context must
+    be re-initialized whenever the key changes.
 */
 BLOCK_CIPHER_SW_ERRORS BLOCK_CIPHER_SW_GCM_Initialize (BLOCK_CIPHER_SW_HANDLE handle, BLOCK_CIPHER_SW_GCM_CONTEXT * context, BLOCK_CIPHER_SW_FunctionEncrypt encryptFunction, BLOCK_CIPHER_SW_FunctionDecrypt decryptFunction, uint32_t blockSize, uint8_t * initializationVector, uint32_t initializationVectorLen, void * keyStream, uint32_t keyStreamSize, void * key, CRYPTO_SW_KEY_TYPE keyType);
 
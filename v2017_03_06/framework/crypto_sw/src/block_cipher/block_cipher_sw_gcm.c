@@ -27,12 +27,64 @@
 
 void BLOCK_CIPHER_SW_GCM_GaloisMultiply (uint8_t * result, uint8_t * a, uint8_t * b);
 void BLOCK_CIPHER_SW_GCM_GHash (BLOCK_CIPHER_SW_GCM_CONTEXT * context);
+#if defined(BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE)
+void BLOCK_CIPHER_SW_GCM_TableCreate (BLOCK_CIPHER_SW_GCM_CONTEXT * context);
+void BLOCK_CIPHER_SW_GCM_TableMultiply (BLOCK_CIPHER_SW_GCM_CONTEXT * context);
+#endif
 
 typedef union {
   uint32_t ui32;
   uint8_t  ui8_arr[4];
 } ff_int32_t;
 
+#if defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT)
+// Reduction of the eight bits shifted out of the product by one table step, XORed
+// into the top 16 bits of the product.
+static const uint16_t ghashReduce[256] =
+{
+    0x0000, 0x01C2, 0x0384, 0x0246, 0x0708, 0x06CA, 0x048C, 0x054E,
+    0x0E10, 0x0FD2, 0x0D94, 0x0C56, 0x0918, 0x08DA, 0x0A9C, 0x0B5E,
+    0x1C20, 0x1DE2, 0x1FA4, 0x1E66, 0x1B28, 0x1AEA, 0x18AC, 0x196E,
+    0x1230, 0x13F2, 0x11B4, 0x1076, 0x1538, 0x14FA, 0x16BC, 0x177E,
+    0x3840, 0x3982, 0x3BC4, 0x3A06, 0x3F48, 0x3E8A, 0x3CCC, 0x3D0E,
+    0x3650, 0x3792, 0x35D4, 0x3416, 0x3158, 0x309A, 0x32DC, 0x331E,
+    0x2460, 0x25A2, 0x27E4, 0x2626, 0x2368, 0x22AA, 0x20EC, 0x212E,
+    0x2A70, 0x2BB2, 0x29F4, 0x2836, 0x2D78, 0x2CBA, 0x2EFC, 0x2F3E,
+    0x7080, 0x7142, 0x7304, 0x72C6, 0x7788, 0x764A, 0x740C, 0x75CE,
+    0x7E90, 0x7F52, 0x7D14, 0x7CD6, 0x7998, 0x785A, 0x7A1C, 0x7BDE,
+    0x6CA0, 0x6D62, 0x6F24, 0x6EE6, 0x6BA8, 0x6A6A, 0x682C, 0x69EE,
+    0x62B0, 0x6372, 0x6134, 0x60F6, 0x65B8, 0x647A, 0x663C, 0x67FE,
+    0x48C0, 0x4902, 0x4B44, 0x4A86, 0x4FC8, 0x4E0A, 0x4C4C, 0x4D8E,
+    0x46D0, 0x4712, 0x4554, 0x4496, 0x41D8, 0x401A, 0x425C, 0x439E,
+    0x54E0, 0x5522, 0x5764, 0x56A6, 0x53E8, 0x522A, 0x506C, 0x51AE,
+    0x5AF0, 0x5B32, 0x5974, 0x58B6, 0x5DF8, 0x5C3A, 0x5E7C, 0x5FBE,
+    0xE100, 0xE0C2, 0xE284, 0xE346, 0xE608, 0xE7CA, 0xE58C, 0xE44E,
+    0xEF10, 0xEED2, 0xEC94, 0xED56, 0xE818, 0xE9DA, 0xEB9C, 0xEA5E,
+    0xFD20, 0xFCE2, 0xFEA4, 0xFF66, 0xFA28, 0xFBEA, 0xF9AC, 0xF86E,
+    0xF330, 0xF2F2, 0xF0B4, 0xF176, 0xF438, 0xF5FA, 0xF7BC, 0xF67E,
+    0xD940, 0xD882, 0xDAC4, 0xDB06, 0xDE48, 0xDF8A, 0xDDCC, 0xDC0E,
+    0xD750, 0xD692, 0xD4D4, 0xD516, 0xD058, 0xD19A, 0xD3DC, 0xD21E,
+    0xC560, 0xC4A2, 0xC6E4, 0xC726, 0xC268, 0xC3AA, 0xC1EC, 0xC02E,
+    0xCB70, 0xCAB2, 0xC8F4, 0xC936, 0xCC78, 0xCDBA, 0xCFFC, 0xCE3E,
+    0x9180, 0x9042, 0x9204, 0x93C6, 0x9688, 0x974A, 0x950C, 0x94CE,
+    0x9F90, 0x9E52, 0x9C14, 0x9DD6, 0x9898, 0x995A, 0x9B1C, 0x9ADE,
+    0x8DA0, 0x8C62, 0x8E24, 0x8FE6, 0x8AA8, 0x8B6A, 0x892C, 0x88EE,
+    0x83B0, 0x8272, 0x8034, 0x81F6, 0x84B8, 0x857A, 0x873C, 0x86FE,
+    0xA9C0, 0xA802, 0xAA44, 0xAB86, 0xAEC8, 0xAF0A, 0xAD4C, 0xAC8E,
+    0xA7D0, 0xA612, 0xA454, 0xA596, 0xA0D8, 0xA11A, 0xA35C, 0xA29E,
+    0xB5E0, 0xB422, 0xB664, 0xB7A6, 0xB2E8, 0xB32A, 0xB16C, 0xB0AE,
+    0xBBF0, 0xBA32, 0xB874, 0xB9B6, 0xBCF8, 0xBD3A, 0xBF7C, 0xBEBE
+};
+#elif defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT)
+// Reduction of the four bits shifted out of the product by one table step, XORed
+// into the top 16 bits of the product.
+static const uint16_t ghashReduce[16] =
+{
+    0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+    0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+};
+#endif
+
 BLOCK_CIPHER_SW_ERRORS BLOCK_CIPHER_SW_GCM_Initialize (BLOCK_CIPHER_SW_HANDLE handle, BLOCK_CIPHER_SW_GCM_CONTEXT * context, BLOCK_CIPHER_SW_FunctionEncrypt encryptFunction, BLOCK_CIPHER_SW_FunctionDecrypt decryptFunction, uint32_t blockSize, uint8_t * initializationVector, uint32_t initializationVectorLen, void * keyStream, uint32_t keyStreamSize, void * key, CRYPTO_SW_KEY_TYPE keyType)
 {
     if ((keyType != CRYPTO_SW_KEY_SOFTWARE_EXPANDED) && (keyType != CRYPTO_SW_KEY_SOFTWARE))
@@ -68,6 +120,11 @@ BLOCK_CIPHER_SW_ERRORS BLOCK_CIPHER_SW_GCM_Initialize (BLOCK_CIPHER_SW_HANDLE ha
     // Initialize the hash sub-key
     (*context->encrypt)(handle, context->hashSubKey, context->hashSubKey, key);
 
+#if defined(BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE)
+    // Build the GHASH multiplication table before any data (including a long IV) is hashed
+    BLOCK_CIPHER_SW_GCM_TableCreate (context);
+#endif
+
     if (initializationVectorLen == 12)
     {
         // Set up the initialization vector from the vector passed in by the user
@@ -472,7 +529,11 @@ void BLOCK_CIPHER_SW_GCM_GHash (BLOCK_CIPHER_SW_GCM_CONTEXT * context)
     }
 
     // Compute the finite field multiplication of that XOR and the hash subkey
+#if defined(BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE)
+    BLOCK_CIPHER_SW_GCM_TableMultiply (context);
+#else
     BLOCK_CIPHER_SW_GCM_GaloisMultiply (context->authTag, context->authTag, context->hashSubKey);
+#endif
 
     context->authBufferLen = 0;
 }
@@ -548,6 +609,146 @@ void BLOCK_CIPHER_SW_GCM_GaloisMultiply (uint8_t * result, uint8_t * a, uint8_t
     }
 }
 
+#if defined(BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE)
+void BLOCK_CIPHER_SW_GCM_TableCreate (BLOCK_CIPHER_SW_GCM_CONTEXT * context)
+{
+    uint32_t (*table)[4] = context->hashTable;
+    uint8_t * h = context->hashSubKey;
+    uint32_t v[4];
+    uint16_t i, j;
+    bool lsbSet;
+
+    // Load the hash subkey as big-endian words
+    for (i = 0; i < 4; i++)
+    {
+        v[i] = ((uint32_t)h[0] << 24) | ((uint32_t)h[1] << 16) | ((uint32_t)h[2] << 8) | h[3];
+        h += 4;
+    }
 
+    // The most significant index bit holds the hash subkey itself; each lower bit
+    // holds the previous entry multiplied by x.
+    i = BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE >> 1;
+    memcpy (table[i], v, 16);
+    while ((i >>= 1) != 0)
+    {
+        lsbSet = (v[3] & 0x01) != 0;
+        v[3] = (v[3] >> 1) | (v[2] << 31);
+        v[2] = (v[2] >> 1) | (v[1] << 31);
+        v[1] = (v[1] >> 1) | (v[0] << 31);
+        v[0] = (v[0] >> 1);
+        if (lsbSet)
+        {
+            v[0] ^= 0xE1000000;
+        }
+        memcpy (table[i], v, 16);
+    }
 
+    // Every other entry is the sum (XOR) of the single-bit entries that make up its index
+    memset (table[0], 0x00, 16);
+    for (i = 2; i < BLOCK_CIPHER_SW_GCM_GHASH_TABLE_SIZE; i <<= 1)
+    {
+        for (j = 1; j < i; j++)
+        {
+            table[i + j][0] = table[i][0] ^ table[j][0];
+            table[i + j][1] = table[i][1] ^ table[j][1];
+            table[i + j][2] = table[i][2] ^ table[j][2];
+            table[i + j][3] = table[i][3] ^ table[j][3];
+        }
+    }
+}
+
+// Multiplies the authentication tag by the hash subkey using the precomputed table.
+// The tag is consumed from its last byte to its first; after each table lookup the
+// partial product is multiplied by x^4 (or x^8) and the bits shifted off the end are
+// folded back in through ghashReduce.
+void BLOCK_CIPHER_SW_GCM_TableMultiply (BLOCK_CIPHER_SW_GCM_CONTEXT * context)
+{
+    uint32_t (*table)[4] = context->hashTable;
+    uint8_t * x = context->authTag;
+    uint32_t * m;
+    uint32_t z0, z1, z2, z3;
+    uint8_t i, rem;
+
+#if defined(CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT)
+    m = table[x[15]];
+    z0 = m[0];
+    z1 = m[1];
+    z2 = m[2];
+    z3 = m[3];
+
+    for (i = 15; i-- != 0;)
+    {
+        rem = (uint8_t)z3;
+        z3 = (z3 >> 8) | (z2 << 24);
+        z2 = (z2 >> 8) | (z1 << 24);
+        z1 = (z1 >> 8) | (z0 << 24);
+        z0 = (z0 >> 8) ^ ((uint32_t)ghashReduce[rem] << 16);
+
+        m = table[x[i]];
+        z0 ^= m[0];
+        z1 ^= m[1];
+        z2 ^= m[2];
+        z3 ^= m[3];
+    }
+#else
+    m = table[x[15] & 0x0F];
+    z0 = m[0];
+    z1 = m[1];
+    z2 = m[2];
+    z3 = m[3];
+
+    i = 15;
+    while (1)
+    {
+        rem = (uint8_t)z3 & 0x0F;
+        z3 = (z3 >> 4) | (z2 << 28);
+        z2 = (z2 >> 4) | (z1 << 28);
+        z1 = (z1 >> 4) | (z0 << 28);
+        z0 = (z0 >> 4) ^ ((uint32_t)ghashReduce[rem] << 16);
+
+        m = table[x[i] >> 4];
+        z0 ^= m[0];
+        z1 ^= m[1];
+        z2 ^= m[2];
+        z3 ^= m[3];
+
+        if (i == 0)
+        {
+            break;
+        }
+        i--;
+
+        rem = (uint8_t)z3 & 0x0F;
+        z3 = (z3 >> 4) | (z2 << 28);
+        z2 = (z2 >> 4) | (z1 << 28);
+        z1 = (z1 >> 4) | (z0 << 28);
+        z0 = (z0 >> 4) ^ ((uint32_t)ghashReduce[rem] << 16);
+
+        m = table[x[i] & 0x0F];
+        z0 ^= m[0];
+        z1 ^= m[1];
+        z2 ^= m[2];
+        z3 ^= m[3];
+    }
+#endif
+
+    // Copy the product back to the authentication tag
+    x[0] = (uint8_t)(z0 >> 24);
+    x[1] = (uint8_t)(z0 >> 16);
+    x[2] = (uint8_t)(z0 >> 8);
+    x[3] = (uint8_t)z0;
+    x[4] = (uint8_t)(z1 >> 24);
+    x[5] = (uint8_t)(z1 >> 16);
+    x[6] = (uint8_t)(z1 >> 8);
+    x[7] = (uint8_t)z1;
+    x[8] = (uint8_t)(z2 >> 24);
+    x[9] = (uint8_t)(z2 >> 16);
+    x[10] = (uint8_t)(z2 >> 8);
+    x[11] = (uint8_t)z2;
+    x[12] = (uint8_t)(z3 >> 24);
+    x[13] = (uint8_t)(z3 >> 16);
+    x[14] = (uint8_t)(z3 >> 8);
+    x[15] = (uint8_t)z3;
+}
+#endif
 
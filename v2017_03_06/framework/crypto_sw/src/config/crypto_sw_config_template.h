@@ -31,6 +31,12 @@
 
 // Defines the maximum number of block cipher handles
 #define CRYPTO_CONFIG_SW_BLOCK_HANDLE_MAXIMUM  10u
+
+// GHASH multiplication method used by the GCM mode.  Define at most one of these; with neither
+// defined, GCM uses a bit-serial multiply that needs no table.  The table is stored in each
+// BLOCK_CIPHER_SW_GCM_CONTEXT and is built from the hash subkey by BLOCK_CIPHER_SW_GCM_Initialize.
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_4BIT         // 256-byte table per context, 32 bytes of constant data
+//#define CRYPTO_CONFIG_SW_GCM_GHASH_TABLE_8BIT         // 4096-byte table per context, 512 bytes of constant data
  
 /****************************************************************************************************************************/
 /* AES Configuration options                                                                                                */
@@ -43,4 +49,15 @@
 #define CRYPTO_CONFIG_SW_AES_KEY_192_ENABLE           // Use 192-bit key lengths
 #define CRYPTO_CONFIG_SW_AES_KEY_256_ENABLE           // Use 256-bit key lengths.  Enabling this will actually enable CRYPTO_CONFIG_SW_AES_KEY_DYNAMIC_ENABLE
 
+/****************************************************************************************************************************/
+/* RSA Configuration options                                                                                                */
+/****************************************************************************************************************************/
+
+// Largest RSA key size, in bits, that will be used.  Sizes the exponentiation window table.
+#define CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS       2048u
+
+// Largest exponent window width, in bits (1-6).  The window table uses (2^bits - 1) * MAX_KEY_BITS / 16 bytes
+// of RAM (1920 bytes for 4-bit windows and 2048-bit keys); 1 uses plain square-and-multiply and the smallest table.
+#define CRYPTO_CONFIG_SW_RSA_WINDOW_BITS        4u
+
 #endif      // _CRYPTO_SW_CONFIG_H
@@ -40,18 +40,28 @@ typedef enum
     DECRYPTION_STATE_FINISH
 } STATE_DECRYPTION;
 
+// State of the current modular exponentiation
+typedef enum
+{
+    MODEXP_STATE_START = 0,
+    MODEXP_STATE_BUILD_TABLE,
+    MODEXP_STATE_EXPONENTIATE
+} STATE_MODEXP;
+
 
 // This struct is for internal use by the DRV_RSA library. It is not exposed to the client. 
 typedef struct {
     uint8_t *xBuffer;
     uint8_t *yBuffer;
-    uint8_t * pe;
-    uint8_t * pend;
     uint32_t length;
+    uint32_t expBitsLeft;
     uint16_t * msgSize;
     uint16_t xLen;
     uint16_t yLen;
-    uint8_t startBit;
+    uint16_t nPrime;
+    uint8_t windowBits;
+    uint8_t tableEntries;
+    STATE_MODEXP modExpState;
     STATE_DECRYPTION decryptionState;
     RSA_SW_RandomGet randFunc;
     RSA_SW_PAD_TYPE padType;
@@ -71,6 +81,9 @@ typedef struct {
 
 static RSA_SW_DESC rsaDesc0;
 
+// Powers of the base, in Montgomery form, for the fixed-window exponentiation
+static uint32_t rsaWindowTable[RSA_SW_WINDOW_TABLE_SIZE / sizeof (uint32_t)];
+
 __inline static bool is_aligned(void *p)
 {
     return (int)p % sizeof (int) == 0;
@@ -116,8 +129,7 @@ SYS_MODULE_OBJ RSA_SW_Initialize(const SYS_MODULE_INDEX index, const SYS_MODULE_
     rsaDesc0.runType = DRV_IO_INTENT_EXCLUSIVE;
     rsaDesc0.status = RSA_SW_STATUS_INIT;
     rsaDesc0.op = RSA_SW_OPERATION_MODE_NONE;
-    rsaDesc0.pe = 0x00;
-    rsaDesc0.pend = 0x00;
+    rsaDesc0.modExpState = MODEXP_STATE_START;
 
     return SYS_MODULE_OBJ_STATIC;
 }
@@ -377,6 +389,11 @@ RSA_SW_STATUS RSA_SW_Encrypt (DRV_HANDLE handle, uint8_t *cipherText, uint8_t *p
         return RSA_SW_STATUS_ERROR;
     }
 
+    if (publicKey->nLen > (CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS / 8))
+    {
+        return RSA_SW_STATUS_ERROR;
+    }
+
     if (((publicKey->n[0] & 0x01) != 0x01) || ((publicKey->n[publicKey->nLen - 1] & 0x80) != 0x80))
     {
         return RSA_SW_STATUS_BAD_PARAM;
@@ -406,6 +423,7 @@ RSA_SW_STATUS RSA_SW_Encrypt (DRV_HANDLE handle, uint8_t *cipherText, uint8_t *p
     }
 
     rsaDesc0.op = RSA_SW_OPERATION_MODE_ENCRYPT;
+    rsaDesc0.modExpState = MODEXP_STATE_START;
     rsaDesc0.status = RSA_SW_STATUS_BUSY;
     rsaDesc0.length = (uint16_t)publicKey->nLen;
     
@@ -495,6 +513,11 @@ RSA_SW_STATUS RSA_SW_Decrypt (DRV_HANDLE handle, uint8_t *plainText, uint8_t *ci
         return RSA_SW_STATUS_ERROR;
     }
 
+    if (privateKey->nLen > (CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS / 8))
+    {
+        return RSA_SW_STATUS_ERROR;
+    }
+
     if (((privateKey->P[0] & 0x01) != 0x01) || ((privateKey->P[(privateKey->nLen >> 1) - 1] & 0x80) != 0x80))
     {
         return RSA_SW_STATUS_BAD_PARAM;
@@ -507,6 +530,7 @@ RSA_SW_STATUS RSA_SW_Decrypt (DRV_HANDLE handle, uint8_t *plainText, uint8_t *ci
 
     rsaDesc0.status = RSA_SW_STATUS_BUSY;
     rsaDesc0.op = RSA_SW_OPERATION_MODE_DECRYPT;
+    rsaDesc0.modExpState = MODEXP_STATE_START;
     rsaDesc0.length = privateKey->nLen;
 
     memcpy (rsaDesc0.yBuffer, cipherText, rsaDesc0.length);
@@ -794,135 +818,166 @@ void RSA_SW_Tasks(SYS_MODULE_OBJ object)
     return;
 }
 
+// Returns the bitCount exponent bits starting at bit bitPos (bit 0 is the LSb of e), MSb first
+static uint8_t RSAExponentWindowGet (BIGINT_DATA * e, uint32_t bitPos, uint8_t bitCount)
+{
+    uint8_t * ptr = (uint8_t *)e->startAddress;
+    uint8_t window = 0;
+    uint32_t bit;
+
+    while (bitCount--)
+    {
+        bit = bitPos + bitCount;
+        window <<= 1;
+        if (ptr[bit >> 3] & (1u << (bit & 0x07)))
+        {
+            window |= 0x01;
+        }
+    }
+
+    return window;
+}
+
+// Computes result = data^e mod n with Montgomery multiplication and fixed-window
+// exponent processing.  Each call performs one bounded step (the conversion of data
+// into Montgomery form, one window table entry, or one exponent window) and returns
+// true once the result is complete, so RSA_SW_Tasks can run it cooperatively.
 bool RSAModExp(BIGINT_DATA * result, BIGINT_DATA * data, BIGINT_DATA * e, BIGINT_DATA *n )
 {
     BIGINT_DATA *tmp,t;
+    BIGINT_DATA entry;
+    BIGINT_DATA base;
+    uint8_t * table = (uint8_t *)rsaWindowTable;
+    uint8_t * ptr;
+    uint8_t window;
+    uint8_t i;
+
     tmp=&t;
     tmp->startAddress = rsaDesc0.xBuffer;
     tmp->bLength = rsaDesc0.length * 2;
 
-    // This macro processes a single bit, either with or without debug output.
-    // The C preprocessor will optimize this without the overhead of a function call.
-      #define doBit(a)      BIGINT_Multiply(tmp,result,result); \
-                            BIGINT_Mod(tmp,tmp, n); \
-                            memcpy (result->startAddress, tmp->startAddress, result->bLength); \
-                            if(*rsaDesc0.pe & a) \
-                            { \
-                                BIGINT_Multiply(tmp,result, data); \
-                                BIGINT_Mod(tmp,tmp, n); \
-                                memcpy (result->startAddress, tmp->startAddress, result->bLength); \
-                            }
+    // Table entry k holds data^(k+1) in Montgomery form
+    base.startAddress = table;
+    base.bLength = n->bLength;
+    entry.bLength = n->bLength;
 
-    // Determine if this is a new computation
-    if(rsaDesc0.pe == rsaDesc0.pend)
-    {// Yes, so set up the calculation
-
-        // Set up *pe to point to the MSB in e, *pend to stop byte
-        rsaDesc0.pe = (uint8_t*)e->startAddress+ e->bLength-1;
-        rsaDesc0.pend = ((uint8_t*)e->startAddress) -1;
-        while(*rsaDesc0.pe == 0x00u)
-        {
-            rsaDesc0.pe--;
+    switch (rsaDesc0.modExpState)
+    {
+        case MODEXP_STATE_START:
+            // Count the significant bits in e
+            ptr = (uint8_t*)e->startAddress + e->bLength - 1;
+            while ((ptr >= (uint8_t*)e->startAddress) && (*ptr == 0x00u))
+            {
+                ptr--;
+            }
 
             // Handle special case where e is zero and n >= 2 (result y should be 1).
             // If n = 1, then y should be zero, but this really special case isn't
             // normally useful, so we shall not implement it and will return 1
             // instead.
-            if(rsaDesc0.pe == rsaDesc0.pend)
+            if (ptr < (uint8_t*)e->startAddress)
             {
                 BIGINT_Set(result,0x00);
                 *(uint8_t *)(result->startAddress) = 0x01;
                 return true;
             }
-        }
 
-        // Start at the bit following the MSbit
-        rsaDesc0.startBit = *rsaDesc0.pe;
-        if(rsaDesc0.startBit & 0x80)
-            rsaDesc0.startBit = 0x40;
-        else if(rsaDesc0.startBit & 0x40)
-            rsaDesc0.startBit = 0x20;
-        else if(rsaDesc0.startBit & 0x20)
-            rsaDesc0.startBit = 0x10;
-        else if(rsaDesc0.startBit & 0x10)
-            rsaDesc0.startBit = 0x08;
-        else if(rsaDesc0.startBit & 0x08)
-            rsaDesc0.startBit = 0x04;
-        else if(rsaDesc0.startBit & 0x04)
-            rsaDesc0.startBit = 0x02;
-        else if(rsaDesc0.startBit & 0x02)
-            rsaDesc0.startBit = 0x01;
-        else
-        {
-            rsaDesc0.pe--;
-            rsaDesc0.startBit = 0x80;
-        }
+            rsaDesc0.expBitsLeft = (uint32_t)(ptr - (uint8_t*)e->startAddress) * 8;
+            for (window = *ptr; window != 0; window >>= 1)
+            {
+                rsaDesc0.expBitsLeft++;
+            }
 
-        // Process that second bit now to save memory in Y
-        // (first round squares the message (X).  Subsequent rounds square Y,
-        // which is at most half that size when running the CRT.)
-        BIGINT_Multiply(tmp,data,data);
-        BIGINT_Mod(tmp,tmp, n);
-        memcpy (result->startAddress, tmp->startAddress, result->bLength);
+            // Pick the window width that minimizes the number of multiplications for
+            // this exponent length, limited by the configuration and the table size
+            if (rsaDesc0.expBitsLeft > 671)
+                rsaDesc0.windowBits = 6;
+            else if (rsaDesc0.expBitsLeft > 239)
+                rsaDesc0.windowBits = 5;
+            else if (rsaDesc0.expBitsLeft > 79)
+                rsaDesc0.windowBits = 4;
+            else if (rsaDesc0.expBitsLeft > 23)
+                rsaDesc0.windowBits = 3;
+            else
+                rsaDesc0.windowBits = 1;
+
+            if (rsaDesc0.windowBits > CRYPTO_CONFIG_SW_RSA_WINDOW_BITS)
+            {
+                rsaDesc0.windowBits = CRYPTO_CONFIG_SW_RSA_WINDOW_BITS;
+            }
+            while ((rsaDesc0.windowBits > 1) && ((((1u << rsaDesc0.windowBits) - 1) * n->bLength) > sizeof (rsaWindowTable)))
+            {
+                rsaDesc0.windowBits--;
+            }
 
-        if(*rsaDesc0.pe & rsaDesc0.startBit)
-        {// If bit is '1'
-            BIGINT_Multiply(tmp,result, data);
+            rsaDesc0.nPrime = BIGINT_MontgomeryFactor(n);
+
+            // Convert data to Montgomery form (data * R mod n) with a single long
+            // division.  tmp is large enough for data shifted up by the length of n.
+            memset (tmp->startAddress, 0x00, tmp->bLength);
+            memcpy ((uint8_t *)tmp->startAddress + n->bLength, data->startAddress, data->bLength);
             BIGINT_Mod(tmp, tmp, n);
-            memcpy (result->startAddress, tmp->startAddress, result->bLength);
-        }
+            memcpy (table, tmp->startAddress, n->bLength);
 
-        // Move to the next bit as the startBit
-        rsaDesc0.startBit >>= 1;
-        if(!rsaDesc0.startBit)
-        {
-            rsaDesc0.pe--;
-            rsaDesc0.startBit = 0x80;
-        }
+            rsaDesc0.tableEntries = 1;
+            rsaDesc0.modExpState = MODEXP_STATE_BUILD_TABLE;
+            return false;
 
-        // We are finished if e has only one or two set bits total, ex: e = 3
-        if(rsaDesc0.pe == rsaDesc0.pend)
-          return true;
+        case MODEXP_STATE_BUILD_TABLE:
+            if (rsaDesc0.tableEntries < ((1u << rsaDesc0.windowBits) - 1))
+            {
+                // entry[k] = entry[k - 1] * data
+                entry.startAddress = table + ((rsaDesc0.tableEntries - 1) * n->bLength);
+                BIGINT_MontgomeryMultiply(tmp, &entry, &base, n, rsaDesc0.nPrime);
+                memcpy (table + (rsaDesc0.tableEntries * n->bLength), tmp->startAddress, n->bLength);
+                rsaDesc0.tableEntries++;
+                return false;
+            }
 
-    }
+            // The first window may be shorter than the others so that every
+            // later window is exactly windowBits wide.  It is never zero.
+            i = rsaDesc0.expBitsLeft % rsaDesc0.windowBits;
+            if (i == 0)
+            {
+                i = rsaDesc0.windowBits;
+            }
+            rsaDesc0.expBitsLeft -= i;
+            window = RSAExponentWindowGet (e, rsaDesc0.expBitsLeft, i);
+            memcpy (result->startAddress, table + ((window - 1) * n->bLength), n->bLength);
 
-    // Process remaining bits in current byte
-    switch(rsaDesc0.startBit)
-    {
-        case 0x80:
-            doBit(0x80);
-            rsaDesc0.startBit >>= 1;
-        case 0x40:
-            doBit(0x40);
-            rsaDesc0.startBit >>= 1;
-            break;
-        case 0x20:
-            doBit(0x20);
-            rsaDesc0.startBit >>= 1;
-        case 0x10:
-            doBit(0x10);
-            rsaDesc0.startBit >>= 1;
+            rsaDesc0.modExpState = MODEXP_STATE_EXPONENTIATE;
             break;
-        case 0x08:
-            doBit(0x08);
-            rsaDesc0.startBit >>= 1;
-        case 0x04:
-            doBit(0x04);
-            rsaDesc0.startBit >>= 1;
+
+        case MODEXP_STATE_EXPONENTIATE:
+            rsaDesc0.expBitsLeft -= rsaDesc0.windowBits;
+            window = RSAExponentWindowGet (e, rsaDesc0.expBitsLeft, rsaDesc0.windowBits);
+
+            for (i = 0; i < rsaDesc0.windowBits; i++)
+            {
+                BIGINT_MontgomeryMultiply(tmp, result, result, n, rsaDesc0.nPrime);
+                memcpy (result->startAddress, tmp->startAddress, n->bLength);
+            }
+
+            if (window != 0)
+            {
+                entry.startAddress = table + ((window - 1) * n->bLength);
+                BIGINT_MontgomeryMultiply(tmp, result, &entry, n, rsaDesc0.nPrime);
+                memcpy (result->startAddress, tmp->startAddress, n->bLength);
+            }
             break;
-        case 0x02:
-            doBit(0x02);
-            rsaDesc0.startBit >>= 1;
-        case 0x01:
-            doBit(0x01);
-            rsaDesc0.startBit = 0x80;
-            rsaDesc0.pe--;
-            if(rsaDesc0.pe == rsaDesc0.pend)
-                return true;
     }
 
-    return false;
+    if (rsaDesc0.expBitsLeft != 0)
+    {
+        return false;
+    }
+
+    // Convert the result out of Montgomery form
+    BIGINT_MontgomeryReduce(tmp, result, n, rsaDesc0.nPrime);
+    memcpy (result->startAddress, tmp->startAddress, n->bLength);
 
+    rsaDesc0.modExpState = MODEXP_STATE_START;
+    return true;
 }
 
 
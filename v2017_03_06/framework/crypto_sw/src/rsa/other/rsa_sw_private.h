@@ -29,6 +29,24 @@
 #include "crypto_sw/rsa_sw.h"
 
 #include "bigint/bigint.h"
+#include "system_config.h"
+
+// Largest key size, in bits, that the exponentiation window table is sized for
+#if !defined(CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS)
+    #define CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS       2048u
+#endif
+
+// Largest exponent window width, in bits (1-6).  A window of w bits needs 2^w - 1
+// table entries the size of the modulus; 1 disables the table.
+#if !defined(CRYPTO_CONFIG_SW_RSA_WINDOW_BITS)
+    #define CRYPTO_CONFIG_SW_RSA_WINDOW_BITS        4u
+#endif
+
+#define RSA_SW_WINDOW_TABLE_ENTRIES     ((1u << CRYPTO_CONFIG_SW_RSA_WINDOW_BITS) - 1u)
+
+// Size of the window table, in bytes.  Entries are sized for the CRT half-length moduli
+// used by decryption; the table is always large enough for a single full-length entry.
+#define RSA_SW_WINDOW_TABLE_SIZE        (((RSA_SW_WINDOW_TABLE_ENTRIES < 2u) ? 2u : RSA_SW_WINDOW_TABLE_ENTRIES) * (CRYPTO_CONFIG_SW_RSA_MAX_KEY_BITS / 16u))
 
 bool RSAModExp(BIGINT_DATA  * result, BIGINT_DATA  * data, BIGINT_DATA  * n, BIGINT_DATA  * e);
 
@@ -264,7 +264,7 @@ typedef enum _SYS_TASKS_PRIORITIES
     stdint.h.
 */
 
-#ifndef uintptr_t
+#if !defined(uintptr_t) && !defined(UINTPTR_MAX)
     typedef void * uintptr_t;
 #endif
 
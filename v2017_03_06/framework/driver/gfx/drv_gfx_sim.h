@@ -0,0 +1,277 @@
+/*******************************************************************************
+ Display Driver for Microchip Graphics Library - Display Driver Layer
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_gfx_sim.h
+
+  Summary:
+    Display Driver header file for the host (Linux) display simulator.
+
+  Description:
+    This module implements a display driver that renders into a frame
+    buffer in host RAM, so the Graphics Library and applications can be
+    built with a host compiler and profiled without display hardware.
+    The driver counts pixel accesses and the bus transactions a smart
+    glass controller on a parallel bus (such as the Ilitek ILI9341) would
+    need for the same calls, and can write the frame buffer to a PNG file.
+    When double buffering is enabled, it keeps a draw buffer and a frame
+    buffer, and counts the pixels copied when they are synchronized.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef _DRV_GFX_SIM_H
+    #define _DRV_GFX_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system_config.h"
+#include "gfx/gfx_types_macros.h"
+#include "gfx/gfx_types_resource.h"
+
+/*********************************************************************
+* Error Checking
+*********************************************************************/
+    #ifndef DISP_HOR_RESOLUTION
+        #error DISP_HOR_RESOLUTION must be defined in system.h
+    #endif
+    #ifndef DISP_VER_RESOLUTION
+        #error DISP_VER_RESOLUTION must be defined in system.h
+    #endif
+    #ifndef DISP_ORIENTATION
+        #error DISP_ORIENTATION must be defined in system.h
+    #endif
+    #ifndef GFX_CONFIG_COLOR_DEPTH
+        #error GFX_CONFIG_COLOR_DEPTH must be defined in gfx_config.h
+    #endif
+
+/*********************************************************************
+* Overview: Color depth.
+*********************************************************************/
+    #if (GFX_CONFIG_COLOR_DEPTH != 16)
+        #error This driver support 16 BPP color depth only.
+    #endif
+
+/*********************************************************************
+* Overview: Modelled bus cost.  Every access to a new location in the
+*           display RAM costs an address window set up (column and page
+*           address commands with 4 parameters each, then the memory
+*           write or read command).  Each pixel then costs one data
+*           transfer on the 16 bit bus.
+*********************************************************************/
+#define DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS    (11)
+
+// *****************************************************************************
+/*  Enumeration:
+    DRV_GFX_SIM_FUNCTION
+
+    Summary:
+        Driver entry points for which statistics are kept.
+
+*/
+// *****************************************************************************
+typedef enum
+{
+    DRV_GFX_SIM_PIXEL_PUT = 0,          // GFX_PixelPut()
+    DRV_GFX_SIM_PIXEL_GET,              // GFX_PixelGet()
+    DRV_GFX_SIM_PIXEL_ARRAY_PUT,        // GFX_PixelArrayPut()
+    DRV_GFX_SIM_PIXEL_ARRAY_GET,        // GFX_PixelArrayGet()
+    DRV_GFX_SIM_BAR_DRAW,               // GFX_BarDraw()
+    DRV_GFX_SIM_SCREEN_CLEAR,           // GFX_ScreenClear()
+    DRV_GFX_SIM_FUNCTION_COUNT
+} DRV_GFX_SIM_FUNCTION;
+
+// *****************************************************************************
+/*  Structure:
+    DRV_GFX_SIM_STATISTICS
+
+    Summary:
+        Counters kept by the simulated display.
+
+    Description:
+        All counters run from DRV_GFX_Initialize() or the last call to
+        DRV_GFX_SIM_StatisticsReset().  Per function pixel counts include
+        pixels skipped because of the transparent color, since the
+        caller still had to supply them.
+
+*/
+// *****************************************************************************
+typedef struct
+{
+    uint64_t pixelWrites;               // Pixels written to the frame buffer
+    uint64_t pixelReads;                // Pixels read from the frame buffer
+    uint64_t pixelsClipped;             // Pixels dropped because they are off the screen
+    uint64_t transactions;              // Modelled bus transactions
+    uint32_t synchronizations;          // Double buffer synchronizations
+    uint64_t pixelsSynchronized;        // Pixels copied by double buffer synchronizations
+    uint32_t calls[DRV_GFX_SIM_FUNCTION_COUNT];     // Calls to each entry point
+    uint64_t pixels[DRV_GFX_SIM_FUNCTION_COUNT];    // Pixels passed to each entry point
+} DRV_GFX_SIM_STATISTICS;
+
+extern DRV_GFX_SIM_STATISTICS drvGfxSimStatistics;
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_SIM_StatisticsReset(void)
+
+    Summary:
+        Clears all the counters in drvGfxSimStatistics.
+
+*/
+// *****************************************************************************
+void DRV_GFX_SIM_StatisticsReset(void);
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR *DRV_GFX_SIM_FrameBufferGet(void)
+
+    Summary:
+        Returns the simulated display RAM.
+
+    Description:
+        The frame buffer holds DISP_VER_RESOLUTION lines of
+        DISP_HOR_RESOLUTION RGB565 pixels in the native orientation of
+        the display.  When double buffering is enabled, this is the
+        buffer that is displayed.
+
+*/
+// *****************************************************************************
+GFX_COLOR *DRV_GFX_SIM_FrameBufferGet(void);
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR *DRV_GFX_SIM_DrawBufferGet(void)
+
+    Summary:
+        Returns the buffer that the driver renders into.
+
+    Description:
+        The layout is the same as for DRV_GFX_SIM_FrameBufferGet().
+        Without double buffering, the draw buffer is the frame buffer.
+
+*/
+// *****************************************************************************
+GFX_COLOR *DRV_GFX_SIM_DrawBufferGet(void);
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_PNGWrite(const char *pFileName)
+
+    Summary:
+        Writes the current screen contents to a PNG file.
+
+    Description:
+        The image is written as seen by the application, that is with
+        DISP_ORIENTATION applied, as 24 bit RGB with uncompressed
+        deflate blocks so no compression library is needed.
+        Returns false if the file could not be written.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_PNGWrite(const char *pFileName);
+
+/*********************************************************************
+* Overview: Worst case sizes of the data generated by
+*           DRV_GFX_SIM_ImageDataGenerate() and
+*           DRV_GFX_SIM_FontDataGenerate().  colorDepth and
+*           bitsPerPixel are in bits (1, 2, 4, 8 or 16).  Generated
+*           glyphs are never wider than the font height.  Use
+*           DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE() for fonts with
+*           extended glyph entries.
+*********************************************************************/
+#define DRV_GFX_SIM_IMAGE_DATA_SIZE(width, height, colorDepth)          \
+            ((((colorDepth) < 16) ? (2ul << (colorDepth)) : 0ul) + (2ul * (width) * (height)))
+
+#define DRV_GFX_SIM_FONT_DATA_SIZE(firstChar, lastChar, height, bitsPerPixel) \
+            (sizeof(GFX_FONT_HEADER) +                                  \
+             (((uint32_t)(lastChar) - (firstChar) + 1) *                \
+              (sizeof(GFX_FONT_GLYPH_ENTRY) + ((uint32_t)(height) * ((((height) * (bitsPerPixel)) + 7) / 8)))))
+
+#define DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE(firstChar, lastChar, height, bitsPerPixel) \
+            (sizeof(GFX_FONT_HEADER) +                                  \
+             (((uint32_t)(lastChar) - (firstChar) + 1) *                \
+              (sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED) + ((uint32_t)(height) * ((((height) * (bitsPerPixel)) + 7) / 8)))))
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_ImageDataGenerate(
+                                const GFX_RESOURCE_HDR *pImage,
+                                uint8_t *pData,
+                                uint32_t size)
+
+    Summary:
+        Generates stand-in data for an image resource in flash.
+
+    Description:
+        The bitmap and font data produced by the Graphics Resource
+        Converter is compiled for the PIC program memory, so host builds
+        of the demos generate data of the same geometry instead.  This
+        function fills pData with a palette (for 1, 4 and 8 bpp images)
+        and a pattern of concentric rings in the format, color depth and
+        compression (none or RLE) given by the image header.  pData is
+        normally the array that the header location points to.
+        Returns false if the image type is not supported or size is less
+        than DRV_GFX_SIM_IMAGE_DATA_SIZE() for the image.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_ImageDataGenerate(
+                                const GFX_RESOURCE_HDR *pImage,
+                                uint8_t *pData,
+                                uint32_t size);
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_FontDataGenerate(
+                                const GFX_RESOURCE_HDR *pFont,
+                                uint8_t *pData,
+                                uint32_t size)
+
+    Summary:
+        Generates stand-in data for a font resource in flash.
+
+    Description:
+        Fills pData with a font header, glyph table and glyph bitmaps
+        for the character range, height and color depth (1 or 2 bpp)
+        given by the font header.  Glyph widths vary with the character
+        so that string widths are not all the same.  Extended glyph
+        entries advance the cursor by the glyph width and have no
+        adjustments.
+        Returns false if the font is not supported or size is less than
+        DRV_GFX_SIM_FONT_DATA_SIZE() (or
+        DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE()) for the font.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_FontDataGenerate(
+                                const GFX_RESOURCE_HDR *pFont,
+                                uint8_t *pData,
+                                uint32_t size);
+
+#endif // _DRV_GFX_SIM_H
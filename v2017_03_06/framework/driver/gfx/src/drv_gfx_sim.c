@@ -0,0 +1,1281 @@
+/*******************************************************************************
+ Display Driver for Microchip Graphics Library - Display Driver Layer
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    drv_gfx_sim.c
+
+  Summary:
+    Display Driver for use with the Microchip Graphics Library on a host.
+
+  Description:
+    This module implements a display driver that renders into a frame
+    buffer in host RAM instead of display hardware.  It is selected with
+    GFX_USE_DISPLAY_CONTROLLER_SIMULATOR and is built with a host compiler
+    (see the linux_simulator system configurations of the graphics demos).
+
+    Besides the basic Display Driver Layer API, the driver keeps
+    statistics on the number of pixels written and read, the number of
+    calls to each entry point and an estimate of the bus transactions a
+    smart glass controller (Ilitek ILI9341 on a 16 bit parallel bus, see
+    drv_gfx_tft003.c) would need for the same calls.  The frame buffer
+    can be saved as a PNG file with DRV_GFX_SIM_PNGWrite().
+
+    When double buffering is enabled, the driver renders into a draw
+    buffer and displays a separate frame buffer.  Synchronization swaps
+    them and copies the areas marked with GFX_DoubleBufferAreaMark(), as
+    drv_gfx_da210.c does, and counts the copied pixels.
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright (c) 2016 released Microchip Technology Inc.  All rights reserved.
+
+Microchip licenses to you the right to use, modify, copy and distribute
+Software only when embedded on a Microchip microcontroller or digital signal
+controller that is integrated into your product or third party product
+(pursuant to the sublicense terms in the accompanying license agreement).
+
+You should refer to the license agreement accompanying this Software for
+additional information regarding your rights and obligations.
+
+SOFTWARE AND DOCUMENTATION ARE PROVIDED "AS IS" WITHOUT WARRANTY OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF
+MERCHANTABILITY, TITLE, NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE.
+IN NO EVENT SHALL MICROCHIP OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER
+CONTRACT, NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR
+OTHER LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE OR
+CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT OF
+SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+(INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "system.h"
+#include <stdint.h>
+
+#if defined (GFX_USE_DISPLAY_CONTROLLER_SIMULATOR)
+
+#include <stdio.h>
+#include <string.h>
+#include "driver/gfx/drv_gfx_display.h"
+#include "driver/gfx/drv_gfx_sim.h"
+#include "gfx/gfx_primitive.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Helper Macros and Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// Offset in the frame buffer of the pixel at x, y as seen by the
+// application, and the offset to add to get to the pixel at x + 1.
+// The mapping follows the orientation adjust macros of drv_gfx_da210.c.
+#if (DISP_ORIENTATION == 0)
+    #define DRV_GFX_SIM_Offset(x, y)    ((uint32_t)(y) * DISP_HOR_RESOLUTION + (x))
+    #define DRV_GFX_SIM_X_STEP          (1)
+#elif (DISP_ORIENTATION == 90)
+    #define DRV_GFX_SIM_Offset(x, y)    ((uint32_t)(GFX_MaxXGet() - (x)) * DISP_HOR_RESOLUTION + (y))
+    #define DRV_GFX_SIM_X_STEP          (-DISP_HOR_RESOLUTION)
+#elif (DISP_ORIENTATION == 180)
+    #define DRV_GFX_SIM_Offset(x, y)    ((uint32_t)(GFX_MaxYGet() - (y)) * DISP_HOR_RESOLUTION + (GFX_MaxXGet() - (x)))
+    #define DRV_GFX_SIM_X_STEP          (-1)
+#elif (DISP_ORIENTATION == 270)
+    #define DRV_GFX_SIM_Offset(x, y)    ((uint32_t)(x) * DISP_HOR_RESOLUTION + (GFX_MaxYGet() - (y)))
+    #define DRV_GFX_SIM_X_STEP          (DISP_HOR_RESOLUTION)
+#else
+    #error Unsupported DISP_ORIENTATION.
+#endif
+
+// The Graphics Library may pass positions outside of the screen (for
+// example for shapes touching the screen edge).  A display controller
+// ignores such accesses, so the simulator drops them as well.
+#define DRV_GFX_SIM_OnScreen(x, y)  (((x) <= GFX_MaxXGet()) && ((y) <= GFX_MaxYGet()))
+
+// Number of pixels of a line of numPixels starting at x, y that are on
+// the screen.
+#define DRV_GFX_SIM_VisibleGet(x, y, numPixels)                         \
+            (DRV_GFX_SIM_OnScreen(x, y) ?                               \
+                (((uint32_t)(x) + (numPixels) > (uint32_t)GFX_MaxXGet() + 1) ? \
+                    (uint16_t)(GFX_MaxXGet() + 1 - (x)) : (numPixels))  \
+                : 0)
+
+// Accounts for one call to a driver entry point.
+#define DRV_GFX_SIM_CallCount(function, count)                          \
+                                    {                                   \
+                                        drvGfxSimStatistics.calls[function]++; \
+                                        drvGfxSimStatistics.pixels[function] += (count); \
+                                    }
+
+// The simulated display RAM.  With double buffering, rendering goes to
+// the draw buffer while the frame buffer is displayed.  Without it, both
+// are buffer 0.
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    #define DRV_GFX_SIM_BUFFER_COUNT    (2)
+#else
+    #define DRV_GFX_SIM_BUFFER_COUNT    (1)
+#endif
+
+static GFX_COLOR drvGfxSimBuffers[DRV_GFX_SIM_BUFFER_COUNT][(uint32_t)DISP_HOR_RESOLUTION * DISP_VER_RESOLUTION];
+static GFX_COLOR *drvGfxSimDrawBuffer = drvGfxSimBuffers[0];
+static uint16_t  drvGfxSimDrawBufferIndex;
+static uint16_t  drvGfxSimFrameBufferIndex;
+
+DRV_GFX_SIM_STATISTICS drvGfxSimStatistics;
+
+static void DRV_GFX_SIM_PNGChunkWrite(
+                                FILE *pFile,
+                                const char *pType,
+                                const uint8_t *pData,
+                                uint32_t length,
+                                uint32_t crc);
+static uint32_t DRV_GFX_SIM_CRC32Update(uint32_t crc, const uint8_t *pData, uint32_t length);
+static void DRV_GFX_SIM_BigEndianPut(uint8_t *pData, uint32_t value);
+static uint8_t DRV_GFX_SIM_RingIndexGet(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t colors);
+static uint8_t DRV_GFX_SIM_GlyphPixelGet(GFX_XCHAR ch, int16_t x, int16_t y, int16_t width, int16_t height);
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_DisplayBrightness(uint16_t level)
+
+    Summary:
+        This function sets the display brightness.
+
+    Description:
+        The simulated display has no backlight; the call is passed on to
+        the board so it can show the state if it wants to.
+
+*/
+// *****************************************************************************
+void DRV_GFX_DisplayBrightness(uint16_t level)
+{
+    if (level > 0)
+    {
+        DisplayBacklightOn();
+    }
+    else if (level == 0)
+    {
+        DisplayBacklightOff();
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_Initialize(void)
+
+    Summary:
+        Initialize the graphics display driver.
+
+    Description:
+        This function clears the simulated display RAM and the
+        statistics.  This function will be called by the application.
+
+*/
+// *****************************************************************************
+void DRV_GFX_Initialize(void)
+{
+    memset(drvGfxSimBuffers, 0, sizeof(drvGfxSimBuffers));
+    drvGfxSimDrawBufferIndex  = 0;
+    drvGfxSimFrameBufferIndex = 0;
+    drvGfxSimDrawBuffer       = drvGfxSimBuffers[0];
+    DRV_GFX_SIM_StatisticsReset();
+}
+
+// *****************************************************************************
+/*  Function:
+    void DRV_GFX_SIM_StatisticsReset(void)
+
+    Summary:
+        Clears all the counters in drvGfxSimStatistics.
+
+*/
+// *****************************************************************************
+void DRV_GFX_SIM_StatisticsReset(void)
+{
+    memset(&drvGfxSimStatistics, 0, sizeof(drvGfxSimStatistics));
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR *DRV_GFX_SIM_FrameBufferGet(void)
+
+    Summary:
+        Returns the simulated display RAM.
+
+*/
+// *****************************************************************************
+GFX_COLOR *DRV_GFX_SIM_FrameBufferGet(void)
+{
+    return (drvGfxSimBuffers[drvGfxSimFrameBufferIndex]);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR *DRV_GFX_SIM_DrawBufferGet(void)
+
+    Summary:
+        Returns the buffer that the driver renders into.
+
+*/
+// *****************************************************************************
+GFX_COLOR *DRV_GFX_SIM_DrawBufferGet(void)
+{
+    return (drvGfxSimDrawBuffer);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_PixelPut(
+                    uint16_t    x,
+                    uint16_t    y)
+
+    Summary:
+        Draw the pixel on the given position.
+
+    Description:
+        This routine draws the pixel on the given position.
+        The color used is the color set by the last call to
+        GFX_ColorSet().
+
+        If position is not on the frame buffer, the pixel is
+        dropped. If color is not set, before this function
+        is called, the output is undefined.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_PixelPut(uint16_t x, uint16_t y)
+{
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_PIXEL_PUT, 1);
+
+    if (DRV_GFX_SIM_OnScreen(x, y))
+    {
+        drvGfxSimDrawBuffer[DRV_GFX_SIM_Offset(x, y)] = GFX_ColorGet();
+        drvGfxSimStatistics.pixelWrites++;
+    }
+    else
+    {
+        drvGfxSimStatistics.pixelsClipped++;
+    }
+    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS + 1;
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_PixelGet(
+                    uint16_t    x,
+                    uint16_t    y)
+
+    Summary:
+        Gets color of the pixel on the given position.
+
+    Description:
+        This routine gets the pixel on the given position.
+
+        If position is not on the frame buffer, 0 is returned.
+
+*/
+// *****************************************************************************
+GFX_COLOR GFX_PixelGet(uint16_t x, uint16_t y)
+{
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_PIXEL_GET, 1);
+
+    // address set, memory read command, dummy read and the pixel
+    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS + 2;
+
+    if (!DRV_GFX_SIM_OnScreen(x, y))
+    {
+        drvGfxSimStatistics.pixelsClipped++;
+        return (0);
+    }
+
+    drvGfxSimStatistics.pixelReads++;
+
+    return (drvGfxSimDrawBuffer[DRV_GFX_SIM_Offset(x, y)]);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_PixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+
+    Summary:
+        Renders an array of pixels to the frame buffer.
+
+    Description:
+        This renders an array of pixels starting from the
+        location defined by x and y with the length
+        defined by numPixels. The rendering will be performed
+        in the increasing x direction.
+
+        This function also supports transparent color feature.
+        When the feature is enabled the pixel with the transparent
+        color will not be rendered and will be skipped.  As in
+        drv_gfx_tft003.c, a new address window is counted each time
+        rendering resumes after a run of transparent pixels.
+        Pixels that fall outside of the display buffer are dropped.
+
+*/
+// *****************************************************************************
+uint16_t GFX_PixelArrayPut(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+{
+    GFX_COLOR   *pDest;
+    uint16_t    z, visible;
+
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_PIXEL_ARRAY_PUT, numPixels);
+
+    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS;
+
+    visible = DRV_GFX_SIM_VisibleGet(x, y, numPixels);
+    drvGfxSimStatistics.pixelsClipped += numPixels - visible;
+    if (visible == 0)
+        return 1;
+
+    pDest = &drvGfxSimDrawBuffer[DRV_GFX_SIM_Offset(x, y)];
+
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    if (GFX_TransparentColorStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_COLOR transparentColor = GFX_TransparentColorGet();
+
+        for(z = 0; z < visible; z++)
+        {
+            if (*pPixel == transparentColor)
+            {
+                if (((z + 1) < visible) && (*(pPixel + 1) != transparentColor))
+                {
+                    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS;
+                }
+            }
+            else
+            {
+                *pDest = *pPixel;
+                drvGfxSimStatistics.pixelWrites++;
+                drvGfxSimStatistics.transactions++;
+            }
+            pPixel++;
+            pDest += DRV_GFX_SIM_X_STEP;
+        }
+    }
+    else
+#endif
+    {
+        for(z = 0; z < visible; z++)
+        {
+            *pDest = *pPixel++;
+            pDest += DRV_GFX_SIM_X_STEP;
+        }
+        drvGfxSimStatistics.pixelWrites += visible;
+        drvGfxSimStatistics.transactions += visible;
+    }
+
+    return 1;
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_PixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+
+    Summary:
+        Retrieves an array of pixels from the frame buffer.
+
+    Description:
+        This retrieves an array of pixels from the display buffer
+        starting from the location defined by x and y with
+        the length defined by numPixels. Pixels outside of the
+        display buffer are returned as 0.
+
+*/
+// *****************************************************************************
+uint16_t GFX_PixelArrayGet(
+                                uint16_t x,
+                                uint16_t y,
+                                GFX_COLOR *pPixel,
+                                uint16_t numPixels)
+{
+    GFX_COLOR   *pSource;
+    uint16_t    z, visible;
+
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_PIXEL_ARRAY_GET, numPixels);
+
+    visible = DRV_GFX_SIM_VisibleGet(x, y, numPixels);
+    pSource = &drvGfxSimDrawBuffer[visible ? DRV_GFX_SIM_Offset(x, y) : 0];
+
+    for(z = 0; z < numPixels; z++)
+    {
+        if (z < visible)
+        {
+            *pPixel++ = *pSource;
+            pSource += DRV_GFX_SIM_X_STEP;
+        }
+        else
+        {
+            *pPixel++ = 0;
+        }
+    }
+
+    drvGfxSimStatistics.pixelReads += visible;
+    drvGfxSimStatistics.pixelsClipped += numPixels - visible;
+    // address set, memory read command, dummy read and the pixels
+    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS + 1 + numPixels;
+
+    return (z);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_BarDraw(
+                                uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+
+    Summary:
+        This function renders a bar shape using the currently set fill
+        style and color.
+
+    Description:
+        This function renders a bar shape with the currently set
+        fill style (See GFX_FillStyleGet() and GFX_FillStyleSet() for
+        details of fill style):
+        - solid color - when the fill style is set to
+                        GFX_FILL_STYLE_COLOR
+        - alpha blended fill - when the fill style is set to
+                        GFX_FILL_STYLE_ALPHA_COLOR.
+
+        Any other selected fill style will be ignored and will assume
+        a solid color fill will be used. The parameters left, top, right
+        bottom will define the shape dimension.
+
+        The parts of the bar outside of the frame buffer are dropped.
+        The rendering of this shape becomes undefined when any one of the
+        following is true:
+        - Colors are not set before this function is called.
+        - When right < left
+        - When bottom < top
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_BarDraw(         uint16_t left,
+                                uint16_t top,
+                                uint16_t right,
+                                uint16_t bottom)
+{
+    GFX_COLOR   *pDest;
+    GFX_COLOR   color;
+    uint32_t    count;
+    uint16_t    x, y;
+    int16_t     l, t, r, b;
+
+#ifndef GFX_CONFIG_ALPHABLEND_DISABLE
+    if (GFX_FillStyleGet() == GFX_FILL_STYLE_ALPHA_COLOR)
+    {
+        if(GFX_AlphaBlendingValueGet() != 100)
+        {
+            if (GFX_BarAlphaDraw(left,top,right,bottom))
+                return (GFX_STATUS_SUCCESS);
+            else
+                return (GFX_STATUS_FAILURE);
+        }
+    }
+#endif
+
+    color = GFX_ColorGet();
+
+    // the callers pass signed coordinates, clip the bar to the screen
+    l = (int16_t)left;
+    t = (int16_t)top;
+    r = (int16_t)right;
+    b = (int16_t)bottom;
+    count = ((r >= l) && (b >= t)) ? (uint32_t)(r - l + 1) * (b - t + 1) : 0;
+
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_BAR_DRAW, count);
+
+    if (l < 0)
+        l = 0;
+    if (t < 0)
+        t = 0;
+    if (r > GFX_MaxXGet())
+        r = GFX_MaxXGet();
+    if (b > GFX_MaxYGet())
+        b = GFX_MaxYGet();
+
+    if ((r < l) || (b < t))
+    {
+        drvGfxSimStatistics.pixelsClipped += count;
+        return (GFX_STATUS_SUCCESS);
+    }
+
+    left   = l;
+    top    = t;
+    right  = r;
+    bottom = b;
+
+    drvGfxSimStatistics.pixelsClipped += count;
+    count = (uint32_t)(right - left + 1) * (bottom - top + 1);
+    drvGfxSimStatistics.pixelsClipped -= count;
+
+    for(y = top; y <= bottom; y++)
+    {
+        pDest = &drvGfxSimDrawBuffer[DRV_GFX_SIM_Offset(left, y)];
+        for(x = left; x <= right; x++)
+        {
+            *pDest = color;
+            pDest += DRV_GFX_SIM_X_STEP;
+        }
+    }
+
+    drvGfxSimStatistics.pixelWrites += count;
+    // the area window is set for the bar and then set back to full screen
+    drvGfxSimStatistics.transactions += (2 * DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS) + count;
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_ScreenClear(void)
+
+    Summary:
+        Clears the screen to the currently set color (GFX_ColorSet()).
+
+    Description:
+        This function clears the screen with the current color and sets
+        the line cursor position to (0, 0).
+
+        If color is not set, before this function is called, the output
+        is undefined.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_ScreenClear(void)
+{
+    uint32_t   counter, z;
+    GFX_COLOR  color;
+
+    counter = (uint32_t) (GFX_MaxXGet() + 1) * (GFX_MaxYGet() + 1);
+    color = GFX_ColorGet();
+
+    DRV_GFX_SIM_CallCount(DRV_GFX_SIM_SCREEN_CLEAR, counter);
+
+    for(z = 0; z < counter; z++)
+    {
+        drvGfxSimDrawBuffer[z] = color;
+    }
+
+    drvGfxSimStatistics.pixelWrites += counter;
+    drvGfxSimStatistics.transactions += DRV_GFX_SIM_ADDRESS_SET_TRANSACTIONS + counter;
+
+    GFX_LinePositionSet(0, 0);
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_RenderStatusGet()
+
+    Summary:
+        This function returns the driver's status on rendering.
+
+    Description:
+        Rendering to the simulated display is always finished when the
+        call returns, so this function always returns
+        GFX_STATUS_READY_BIT.
+
+*/
+// *****************************************************************************
+GFX_STATUS_BIT GFX_RenderStatusGet(void)
+{
+    return (GFX_STATUS_READY_BIT);
+}
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DrawBufferSet(uint16_t index)
+
+    Summary:
+        This function sets the draw buffer with the given index number.
+
+    Description:
+        This function sets the draw buffer with the given index number.
+        This is the buffer that the driver renders into.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_DrawBufferSet(uint16_t index)
+{
+    drvGfxSimDrawBufferIndex = index;
+    drvGfxSimDrawBuffer = drvGfxSimBuffers[index];
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_DrawBufferGet(void)
+
+    Summary:
+        This function returns the index of the current draw buffer.
+
+*/
+// *****************************************************************************
+uint16_t GFX_DrawBufferGet(void)
+{
+    return (drvGfxSimDrawBufferIndex);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FrameBufferSet(uint16_t index)
+
+    Summary:
+        This function sets the frame buffer with the given index number.
+
+    Description:
+        This function sets the frame buffer with the given index number.
+        This is the buffer that is displayed, and written by
+        DRV_GFX_SIM_PNGWrite().
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FrameBufferSet(uint16_t index)
+{
+    drvGfxSimFrameBufferIndex = index;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    uint16_t GFX_FrameBufferGet(void)
+
+    Summary:
+        This function returns the index of the current frame buffer.
+
+*/
+// *****************************************************************************
+uint16_t GFX_FrameBufferGet(void)
+{
+    return (drvGfxSimFrameBufferIndex);
+}
+
+// *****************************************************************************
+/*  Function:
+    void GFX_DRV_DoubleBufferDisable(void)
+
+    Summary:
+        This function is the driver specific double buffering disabling
+        steps.
+
+    Description:
+        The Graphics Library has already set the draw buffer to the
+        frame buffer, so the simulator has nothing else to do.
+
+*/
+// *****************************************************************************
+void GFX_DRV_DoubleBufferDisable(void)
+{
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronize(void)
+
+    Summary:
+        This function synchronizes the frame buffer and the draw buffer
+        contents when double buffering feature is enabled.
+
+    Description:
+        The draw buffer is displayed and the frame buffer becomes the
+        new draw buffer.  The areas marked since the last
+        synchronization (or the whole screen) are then copied into it,
+        so both buffers are the same after the function exits.  The
+        copied pixels are counted in drvGfxSimStatistics.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_DoubleBufferSynchronize(void)
+{
+    GFX_RECTANGULAR_AREA    *pArea;
+    GFX_COLOR               *pSource;
+    uint32_t                offset;
+    uint16_t                count, x, y;
+
+    // check if feature is enabled
+    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_DISABLED)
+    {
+        return (GFX_STATUS_SUCCESS);
+    }
+
+    // swap the two buffers (draw becomes frame and frame becomes draw)
+    count = drvGfxSimDrawBufferIndex;
+    GFX_DrawBufferSet(drvGfxSimFrameBufferIndex);
+    GFX_FrameBufferSet(count);
+    pSource = drvGfxSimBuffers[drvGfxSimFrameBufferIndex];
+
+    drvGfxSimStatistics.synchronizations++;
+
+    if ((GFX_DoubleBufferSyncAllStatusGet() == GFX_FEATURE_ENABLED) ||
+        (GFX_DoubleBufferSyncAreaCountGet() > GFX_MAX_INVALIDATE_AREAS))
+    {
+        memcpy(drvGfxSimDrawBuffer, pSource, sizeof(drvGfxSimBuffers[0]));
+        drvGfxSimStatistics.pixelsSynchronized += (uint32_t)DISP_HOR_RESOLUTION * DISP_VER_RESOLUTION;
+        GFX_DoubleBufferSyncAllStatusClear();
+    }
+    else
+    {
+        for (count = GFX_DoubleBufferSyncAreaCountGet(); count > 0; count--)
+        {
+            pArea = GFX_DoubleBufferAreaGet(count);
+
+            for (y = pArea->top; y <= pArea->bottom; y++)
+            {
+                for (x = pArea->left; x <= pArea->right; x++)
+                {
+                    offset = DRV_GFX_SIM_Offset(x, y);
+                    drvGfxSimDrawBuffer[offset] = pSource[offset];
+                }
+            }
+            drvGfxSimStatistics.pixelsSynchronized +=
+                    (uint32_t)(pArea->right - pArea->left + 1) * (pArea->bottom - pArea->top + 1);
+        }
+    }
+
+    GFX_DoubleBufferSyncAreaCountSet(0);
+
+    // reset the synchronize flag
+    GFX_DoubleBufferSynchronizeCancel();
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_DoubleBufferSynchronizeRequest(void)
+
+    Summary:
+        This function requests synchronization of the contents
+        of the draw and frame buffer on the display driver layer.
+
+    Description:
+        The simulated display has no vertical blanking period to wait
+        for, so the buffers are synchronized immediately.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_DoubleBufferSynchronizeRequest(void)
+{
+    if (GFX_DoubleBufferStatusGet() == GFX_FEATURE_ENABLED)
+    {
+        GFX_DoubleBufferSynchronize();
+    }
+    return (GFX_STATUS_SUCCESS);
+}
+
+#endif // #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_PNGWrite(const char *pFileName)
+
+    Summary:
+        Writes the current screen contents to a PNG file.
+
+    Description:
+        The image data is stored in uncompressed deflate blocks of one
+        image line each, so that no compression library is needed.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_PNGWrite(const char *pFileName)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    static const uint8_t zlibHeader[2] = {0x78, 0x01};
+
+    // filter type byte followed by the RGB pixels of one line
+    uint8_t     line[1 + ((GFX_MaxXGet() + 1) * 3)];
+    uint8_t     header[13], block[5], adler[4];
+    FILE        *pFile;
+    GFX_COLOR   color;
+    uint32_t    crc, adlerA, adlerB, z, length;
+    uint16_t    x, y;
+
+    pFile = fopen(pFileName, "wb");
+    if (pFile == NULL)
+        return (false);
+
+    fwrite(signature, 1, sizeof(signature), pFile);
+
+    DRV_GFX_SIM_BigEndianPut(&header[0], GFX_MaxXGet() + 1);
+    DRV_GFX_SIM_BigEndianPut(&header[4], GFX_MaxYGet() + 1);
+    header[8]  = 8;                     // bit depth
+    header[9]  = 2;                     // color type: RGB
+    header[10] = 0;                     // compression: deflate
+    header[11] = 0;                     // filter method
+    header[12] = 0;                     // no interlace
+    DRV_GFX_SIM_PNGChunkWrite(pFile, "IHDR", header, sizeof(header), 0);
+
+    // The IDAT chunk is written in one piece, so its CRC is calculated
+    // as the data is produced.
+    length = sizeof(zlibHeader) + ((GFX_MaxYGet() + 1) * (sizeof(block) + sizeof(line))) + sizeof(adler);
+    DRV_GFX_SIM_BigEndianPut(header, length);
+    fwrite(header, 1, 4, pFile);
+    fwrite("IDAT", 1, 4, pFile);
+    crc = DRV_GFX_SIM_CRC32Update(0xFFFFFFFFul, (const uint8_t *)"IDAT", 4);
+
+    fwrite(zlibHeader, 1, sizeof(zlibHeader), pFile);
+    crc = DRV_GFX_SIM_CRC32Update(crc, zlibHeader, sizeof(zlibHeader));
+
+    adlerA = 1;
+    adlerB = 0;
+    for(y = 0; y <= GFX_MaxYGet(); y++)
+    {
+        line[0] = 0;                    // filter type: none
+        for(x = 0; x <= GFX_MaxXGet(); x++)
+        {
+            // widen the 5 and 6 bit components to the full 8 bit range
+            color = drvGfxSimBuffers[drvGfxSimFrameBufferIndex][DRV_GFX_SIM_Offset(x, y)];
+            line[1 + (x * 3)] = (uint8_t)(GFX_ComponentRedGet(color)   | (GFX_ComponentRedGet(color)   >> 5));
+            line[2 + (x * 3)] = (uint8_t)(GFX_ComponentGreenGet(color) | (GFX_ComponentGreenGet(color) >> 6));
+            line[3 + (x * 3)] = (uint8_t)(GFX_ComponentBlueGet(color)  | (GFX_ComponentBlueGet(color)  >> 5));
+        }
+
+        // stored block header: last block flag, length and its complement
+        block[0] = (y == GFX_MaxYGet()) ? 1 : 0;
+        block[1] = (uint8_t)(sizeof(line));
+        block[2] = (uint8_t)(sizeof(line) >> 8);
+        block[3] = (uint8_t)~block[1];
+        block[4] = (uint8_t)~block[2];
+
+        fwrite(block, 1, sizeof(block), pFile);
+        fwrite(line, 1, sizeof(line), pFile);
+        crc = DRV_GFX_SIM_CRC32Update(crc, block, sizeof(block));
+        crc = DRV_GFX_SIM_CRC32Update(crc, line, sizeof(line));
+
+        for(z = 0; z < sizeof(line); z++)
+        {
+            adlerA = (adlerA + line[z]) % 65521ul;
+            adlerB = (adlerB + adlerA) % 65521ul;
+        }
+    }
+
+    DRV_GFX_SIM_BigEndianPut(adler, (adlerB << 16) | adlerA);
+    fwrite(adler, 1, sizeof(adler), pFile);
+    crc = DRV_GFX_SIM_CRC32Update(crc, adler, sizeof(adler));
+
+    DRV_GFX_SIM_BigEndianPut(header, crc ^ 0xFFFFFFFFul);
+    fwrite(header, 1, 4, pFile);
+
+    DRV_GFX_SIM_PNGChunkWrite(pFile, "IEND", NULL, 0, 0);
+
+    return (fclose(pFile) == 0);
+}
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_ImageDataGenerate(
+                                const GFX_RESOURCE_HDR *pImage,
+                                uint8_t *pData,
+                                uint32_t size)
+
+    Summary:
+        Generates stand-in data for an image resource in flash.
+
+    Description:
+        The data layout is the one read by the GFX_ImageFlashxBPPDraw()
+        functions: the palette (for color depths below 16) followed by
+        the lines of pixels, each starting on a byte boundary.  RLE
+        images are encoded per line with repeat codes only.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_ImageDataGenerate(
+                                const GFX_RESOURCE_HDR *pImage,
+                                uint8_t *pData,
+                                uint32_t size)
+{
+    uint16_t    width, height, colors, x, y, run;
+    uint8_t     colorDepth, index, next;
+    GFX_COLOR   color;
+    bool        rle;
+
+    width      = pImage->resource.image.width;
+    height     = pImage->resource.image.height;
+    colorDepth = pImage->resource.image.colorDepth;
+    rle        = ((pImage->type & GFX_COMP_MASK) == GFX_RESOURCE_COMP_RLE);
+
+    if (((pImage->type & GFX_TYPE_MASK) != GFX_RESOURCE_TYPE_MCHP_MBITMAP) ||
+        (size < DRV_GFX_SIM_IMAGE_DATA_SIZE(width, height, colorDepth)))
+        return (false);
+
+    switch (colorDepth)
+    {
+        case 1:
+        case 4:
+        case 8:
+            break;
+        case 16:
+            if (rle)
+                return (false);
+            break;
+        default:
+            return (false);
+    }
+    if (rle && (colorDepth == 1))
+        return (false);
+
+    colors = (colorDepth < 16) ? (1 << colorDepth) : 64;
+
+    if (colorDepth < 16)
+    {
+        // palette running from dark blue through green to yellow
+        for (index = 0; ; index++)
+        {
+            color = GFX_RGBConvert( (index * 255) / (colors - 1),
+                                    (colors > 2) ? ((index * 127) / (colors - 1)) + 128 : (index * 255),
+                                    255 - ((index * 255) / (colors - 1)));
+            *pData++ = (uint8_t)color;
+            *pData++ = (uint8_t)(color >> 8);
+
+            if (index == (colors - 1))
+                break;
+        }
+    }
+
+    for (y = 0; y < height; y++)
+    {
+        if (rle)
+        {
+            for (x = 0; x < width; x += run)
+            {
+                index = DRV_GFX_SIM_RingIndexGet(x, y, width, height, colors);
+                for (run = 1; ((x + run) < width) && (run < 255); run++)
+                {
+                    next = DRV_GFX_SIM_RingIndexGet(x + run, y, width, height, colors);
+                    if (next != index)
+                        break;
+                }
+
+                *pData++ = (uint8_t)run;
+                *pData++ = (colorDepth == 4) ? (uint8_t)((index << 4) | index) : index;
+            }
+            continue;
+        }
+
+        for (x = 0; x < width; x++)
+        {
+            index = DRV_GFX_SIM_RingIndexGet(x, y, width, height, colors);
+
+            switch (colorDepth)
+            {
+                case 1:
+                    if ((x & 0x07) == 0)
+                        *pData = 0;
+                    *pData |= index << (x & 0x07);
+                    if (((x & 0x07) == 0x07) || (x == (width - 1)))
+                        pData++;
+                    break;
+
+                case 4:
+                    if ((x & 0x01) == 0)
+                        *pData = index;
+                    else
+                        *pData++ |= index << 4;
+                    if (((x & 0x01) == 0) && (x == (width - 1)))
+                        pData++;
+                    break;
+
+                case 8:
+                    *pData++ = index;
+                    break;
+
+                default:
+                    color = GFX_RGBConvert(index << 2, (x * 255) / width, 255 - (index << 2));
+                    *pData++ = (uint8_t)color;
+                    *pData++ = (uint8_t)(color >> 8);
+                    break;
+            }
+        }
+    }
+
+    return (true);
+}
+
+// *****************************************************************************
+/*  Function:
+    bool DRV_GFX_SIM_FontDataGenerate(
+                                const GFX_RESOURCE_HDR *pFont,
+                                uint8_t *pData,
+                                uint32_t size)
+
+    Summary:
+        Generates stand-in data for a font resource in flash.
+
+    Description:
+        The data layout is the one read by GFX_TextCharInfoFlashGet():
+        the font header, one GFX_FONT_GLYPH_ENTRY (or
+        GFX_FONT_GLYPH_ENTRY_EXTENDED) per character and the glyph
+        bitmaps, with the offsets of the glyph entries relative to the
+        start of the font.  Each glyph line starts on a byte boundary
+        and the first pixel is in the least significant bits.
+
+*/
+// *****************************************************************************
+bool DRV_GFX_SIM_FontDataGenerate(
+                                const GFX_RESOURCE_HDR *pFont,
+                                uint8_t *pData,
+                                uint32_t size)
+{
+    const GFX_FONT_HEADER           *pHeader = &pFont->resource.font.header;
+    GFX_FONT_GLYPH_ENTRY            *pGlyph;
+    GFX_FONT_GLYPH_ENTRY_EXTENDED   *pGlyphExtended;
+    uint8_t                         *pBitmap;
+    uint32_t                        offset, required;
+    uint16_t                        ch;
+    int16_t                         width, height, x, y;
+    uint8_t                         bpp, shift;
+
+    height = pHeader->height;
+    bpp    = 1 << pHeader->bpp;
+
+    if (pHeader->extendedGlyphEntry)
+        required = DRV_GFX_SIM_FONT_EXTENDED_DATA_SIZE(pHeader->firstChar, pHeader->lastChar, height, bpp);
+    else
+        required = DRV_GFX_SIM_FONT_DATA_SIZE(pHeader->firstChar, pHeader->lastChar, height, bpp);
+
+    if (((pFont->type & GFX_TYPE_MASK) != GFX_RESOURCE_TYPE_FONT) ||
+        (bpp > 2) || (pHeader->lastChar < pHeader->firstChar) ||
+        (size < required))
+        return (false);
+
+    memcpy(pData, pHeader, sizeof(GFX_FONT_HEADER));
+
+    pGlyph         = (GFX_FONT_GLYPH_ENTRY *)(pData + sizeof(GFX_FONT_HEADER));
+    pGlyphExtended = (GFX_FONT_GLYPH_ENTRY_EXTENDED *)(pData + sizeof(GFX_FONT_HEADER));
+    offset = sizeof(GFX_FONT_HEADER) +
+             ((uint32_t)(pHeader->lastChar - pHeader->firstChar + 1) *
+              (pHeader->extendedGlyphEntry ? sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED) : sizeof(GFX_FONT_GLYPH_ENTRY)));
+
+    for (ch = pHeader->firstChar; ch <= pHeader->lastChar; ch++, pGlyph++, pGlyphExtended++)
+    {
+        // a quarter of the height for the space, about half the height
+        // for other characters
+        width = (ch == ' ') ? (height >> 2) : (height >> 1) + (ch & 0x03);
+        if (width > height)
+            width = height;
+
+        if (pHeader->extendedGlyphEntry)
+        {
+            pGlyphExtended->offset        = offset;
+            pGlyphExtended->cursorAdvance = (uint16_t)width;
+            pGlyphExtended->glyphWidth    = (uint16_t)width;
+            pGlyphExtended->xAdjust       = 0;
+            pGlyphExtended->yAdjust       = 0;
+        }
+        else
+        {
+            pGlyph->width     = (uint8_t)width;
+            pGlyph->offsetLSB = (uint8_t)offset;
+            pGlyph->offsetMSB = (uint16_t)(offset >> 8);
+        }
+
+        pBitmap = pData + offset;
+        for (y = 0; y < height; y++)
+        {
+            shift = 8;
+            for (x = 0; x < width; x++)
+            {
+                if (shift == 8)
+                {
+                    *pBitmap++ = 0;
+                    shift = 0;
+                }
+
+                if (bpp == 1)
+                {
+                    *(pBitmap - 1) |= (DRV_GFX_SIM_GlyphPixelGet(ch, x, y, width, height) ? 1 : 0) << shift;
+                }
+                else
+                {
+                    *(pBitmap - 1) |= DRV_GFX_SIM_GlyphPixelGet(ch, x, y, width, height) << shift;
+                }
+                shift += bpp;
+            }
+        }
+        offset = (uint32_t)(pBitmap - pData);
+    }
+
+    return (true);
+}
+
+// *****************************************************************************
+/*  Function:
+    static uint8_t DRV_GFX_SIM_RingIndexGet(
+                                int32_t x,
+                                int32_t y,
+                                int32_t width,
+                                int32_t height,
+                                uint16_t colors)
+
+    Summary:
+        Returns the color index of a pixel of a generated image.
+
+    Description:
+        The image is a set of concentric rings, about eight of them
+        from the center to the corners, so that RLE encoding gives runs
+        of the length seen in real artwork.
+
+*/
+// *****************************************************************************
+static uint8_t DRV_GFX_SIM_RingIndexGet(int32_t x, int32_t y, int32_t width, int32_t height, uint16_t colors)
+{
+    int32_t dx = (2 * x) - width, dy = (2 * y) - height;
+    int32_t ring = ((dx * dx) + (dy * dy)) * 64 / ((width * width) + (height * height) + 1);
+
+    return ((uint8_t)(ring % colors));
+}
+
+// *****************************************************************************
+/*  Function:
+    static uint8_t DRV_GFX_SIM_GlyphPixelGet(
+                                GFX_XCHAR ch,
+                                int16_t x,
+                                int16_t y,
+                                int16_t width,
+                                int16_t height)
+
+    Summary:
+        Returns the 2 bpp value of a pixel of a generated glyph.
+
+    Description:
+        Glyphs are a box outline between the x-height and the base line
+        with a cross bar or a diagonal depending on the character, and
+        an anti-aliasing edge to the right of each stroke.
+
+*/
+// *****************************************************************************
+static uint8_t DRV_GFX_SIM_GlyphPixelGet(GFX_XCHAR ch, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    int16_t top = height / 3, bottom = (height * 4) / 5, stroke = (height / 12) + 1;
+    int16_t right = width - 2, xPrev = x - 1;
+    bool    solid, edge;
+
+    if ((ch == ' ') || (y < top) || (y >= bottom) || (x < 1) || (x >= width - 1))
+        return (0);
+
+    solid = (x < 1 + stroke) || (x > right - stroke) || (y < top + stroke) || (y >= bottom - stroke);
+    if (ch & 0x01)
+        solid = solid || (((y - top) * (right - 1)) / (bottom - top) == x - 1);
+    if (ch & 0x02)
+        solid = solid || (((y - top) >= ((bottom - top) >> 1)) && ((y - top) < ((bottom - top) >> 1) + stroke));
+
+    if (solid)
+        return (3);
+
+    edge = (xPrev < 1 + stroke) || ((ch & 0x01) && (((y - top) * (right - 1)) / (bottom - top) == xPrev - 1));
+
+    return (edge ? 1 : 0);
+}
+
+// *****************************************************************************
+/*  Function:
+    static void DRV_GFX_SIM_PNGChunkWrite(
+                                FILE *pFile,
+                                const char *pType,
+                                const uint8_t *pData,
+                                uint32_t length,
+                                uint32_t crc)
+
+    Summary:
+        Writes a complete PNG chunk.
+
+*/
+// *****************************************************************************
+static void DRV_GFX_SIM_PNGChunkWrite(
+                                FILE *pFile,
+                                const char *pType,
+                                const uint8_t *pData,
+                                uint32_t length,
+                                uint32_t crc)
+{
+    uint8_t field[4];
+
+    DRV_GFX_SIM_BigEndianPut(field, length);
+    fwrite(field, 1, 4, pFile);
+    fwrite(pType, 1, 4, pFile);
+
+    crc = DRV_GFX_SIM_CRC32Update(0xFFFFFFFFul, (const uint8_t *)pType, 4);
+    if (length)
+    {
+        fwrite(pData, 1, length, pFile);
+        crc = DRV_GFX_SIM_CRC32Update(crc, pData, length);
+    }
+
+    DRV_GFX_SIM_BigEndianPut(field, crc ^ 0xFFFFFFFFul);
+    fwrite(field, 1, 4, pFile);
+}
+
+// *****************************************************************************
+/*  Function:
+    static uint32_t DRV_GFX_SIM_CRC32Update(uint32_t crc, const uint8_t *pData, uint32_t length)
+
+    Summary:
+        Updates the PNG (ISO 3309) CRC with the given bytes.
+
+*/
+// *****************************************************************************
+static uint32_t DRV_GFX_SIM_CRC32Update(uint32_t crc, const uint8_t *pData, uint32_t length)
+{
+    uint8_t bit;
+
+    while (length--)
+    {
+        crc ^= *pData++;
+        for(bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320ul & (0 - (crc & 1)));
+        }
+    }
+
+    return (crc);
+}
+
+// *****************************************************************************
+/*  Function:
+    static void DRV_GFX_SIM_BigEndianPut(uint8_t *pData, uint32_t value)
+
+    Summary:
+        Stores a 32 bit value in network byte order.
+
+*/
+// *****************************************************************************
+static void DRV_GFX_SIM_BigEndianPut(uint8_t *pData, uint32_t value)
+{
+    pData[0] = (uint8_t)(value >> 24);
+    pData[1] = (uint8_t)(value >> 16);
+    pData[2] = (uint8_t)(value >> 8);
+    pData[3] = (uint8_t)value;
+}
+
+#endif // #if defined (GFX_USE_DISPLAY_CONTROLLER_SIMULATOR)
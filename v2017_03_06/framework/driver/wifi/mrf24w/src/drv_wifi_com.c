@@ -738,6 +738,11 @@ void WFEintHandler(void)
 
     /* notify state machine that an interrupt occurred */
     s_ExIntNeedsServicing = true;
+
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    /* wake up StackTask() to service the interrupt */
+    StackPostEvent(STACK_EVENT_MAC);
+#endif
 }
 
 void ReenablePowerSaveMode(void)
@@ -919,6 +919,31 @@ static uint16_t MACIFService(void)
     return byteCount;
 }
 
+/******************************************************************************
+ * Function:        bool MACIsRxPending(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true: If the MRF24W has signalled a received data frame
+ *                        that MACGetHeader() has not fetched yet
+ *                  false: Otherwise
+ *
+ * Side Effects:    None
+ *
+ * Overview:        The external interrupt stays disabled while a data frame
+ *                  is waiting, so no further STACK_EVENT_MAC is posted for
+ *                  it.  StackTask() uses this to decide whether frames were
+ *                  left behind when its receive budget ran out.
+ *
+ * Note:            None
+ *****************************************************************************/
+bool MACIsRxPending(void)
+{
+    return g_HostRAWDataPacketReceived;
+}
+
 /******************************************************************************
  * Function:        bool MACGetHeader(MAC_ADDR *remote, uint8_t* type)
  *
@@ -1683,14 +1708,12 @@ void MACPutROMArray(ROM uint8_t *val, uint16_t len)
   ***************************************************************************/
 uint16_t CalcIPBufferChecksum(uint16_t len)
 {
-    TCPIP_UINT32_VAL Checksum;
+    IP_CHECKSUM Checksum;
 
-    uint8_t DataBuffer[20]; // Must be an even size
+    uint8_t DataBuffer[20];
     uint16_t ChunkLen;
-    uint16_t *DataPtr;
 
-    Checksum.w[0] = 0;
-    Checksum.w[1] = 0;
+    ChecksumBegin(&Checksum);
     while (len)
     {
         // Obtain a chunk of data (less SPI overhead compared
@@ -1699,33 +1722,12 @@ uint16_t CalcIPBufferChecksum(uint16_t len)
         MACGetArray(DataBuffer, ChunkLen);
         len -= ChunkLen;
 
-        // Take care of a last odd numbered data byte
-        if (((TCPIP_UINT16_VAL*)&ChunkLen)->bits.b0)
-        {
-            DataBuffer[ChunkLen] = 0x00;
-            ChunkLen++;
-        }
-
         // Calculate the checksum over this chunk
-        DataPtr = (uint16_t*)&DataBuffer[0];
-        while (ChunkLen)
-        {
-            Checksum.Val += *DataPtr++;
-            ChunkLen -= 2;
-        }
+        ChecksumAdd(&Checksum, DataBuffer, ChunkLen);
     }
 
-    // Do an end-around carry (one's complement arrithmatic)
-    Checksum.Val = (uint32_t)Checksum.w[0] + (uint32_t)Checksum.w[1];
-
-    // Do another end-around carry in case if the prior add
-    // caused a carry out
-    Checksum.w[0] += Checksum.w[1];
-
     // Return the resulting checksum
-    Checksum.w[0] = ~Checksum.w[0];
-
-    return Checksum.w[0];
+    return ChecksumFinish(&Checksum);
 }
 
 /******************************************************************************
@@ -1037,6 +1037,31 @@ static uint16_t MACIFService(void)
     return byteCount;
 }
 
+/******************************************************************************
+ * Function:        bool MACIsRxPending(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true: If the MRF24W has signalled a received data frame
+ *                        that MACGetHeader() has not fetched yet
+ *                  false: Otherwise
+ *
+ * Side Effects:    None
+ *
+ * Overview:        The external interrupt stays disabled while a data frame
+ *                  is waiting, so no further STACK_EVENT_MAC is posted for
+ *                  it.  StackTask() uses this to decide whether frames were
+ *                  left behind when its receive budget ran out.
+ *
+ * Note:            None
+ *****************************************************************************/
+bool MACIsRxPending(void)
+{
+    return g_HostRAWDataPacketReceived;
+}
+
 /******************************************************************************
  * Function:        bool MACGetHeader(MAC_ADDR *remote, uint8_t* type)
  *
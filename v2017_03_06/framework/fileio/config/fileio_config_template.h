@@ -84,4 +84,16 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // (defined by FILEIO_CONFIG_MAX_DRIVES).  If you are only using one drive in your application, this option has no effect.
 #define FILEIO_CONFIG_MULTIPLE_BUFFER_MODE_DISABLE
 
+// Define FILEIO_CONFIG_SECTOR_CACHE_SIZE to the number of sectors to keep in a shared, write-back sector cache below the
+// FAT, directory and data buffers.  Each entry uses FILEIO_CONFIG_MEDIA_SECTOR_SIZE bytes of RAM.  Modified sectors are
+// written to the media when they are replaced (least recently used first), when a file is flushed or closed, and when
+// the drive is unmounted.  Leave undefined (or 0) to access the media directly.
+//#define FILEIO_CONFIG_SECTOR_CACHE_SIZE         4
+
+// Define FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE to the number of bytes used to remember which ranges of the FAT have no
+// free clusters, so cluster allocation can skip them.  Each bit covers an equal share of the clusters on the drive.  The
+// map is built as the FAT is searched and costs no media access at mount time.  Leave undefined (or 0) to use only the
+// next-free-cluster hint (kept in the FSInfo sector on FAT32 drives).
+//#define FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE     16
+
 #endif
@@ -570,6 +570,54 @@ bool FILEIO_SD_SectorRead(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sectorAddres
     return false;
 }    
 
+
+bool FILEIO_SD_MultipleSectorRead(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t* buffer, uint16_t sectorCount)
+{
+    FILEIO_SD_ASYNC_IO info;
+    uint32_t totalBytes;
+    uint8_t status;
+
+    if(sectorCount == 0)
+    {
+        return true;
+    }
+
+    //Initialize info structure for a multi-block (CMD18) read of all of the
+    //requested sectors, one block per packet.
+    totalBytes = (uint32_t)sectorCount * FILEIO_SD_MEDIA_BLOCK_SIZE;
+    info.wNumBytes = FILEIO_SD_MEDIA_BLOCK_SIZE;
+    info.dwBytesRemaining = totalBytes;
+    info.pBuffer = buffer;
+    info.dwAddress = sectorAddress;
+    info.bStateVariable = FILEIO_SD_ASYNC_READ_QUEUED;
+
+    //Blocking loop, until the state machine finishes reading all of the
+    //sectors, or a timeout or other error occurs.
+    while(1)
+    {
+        //Point the state machine at the part of the user buffer that the next
+        //block belongs in.
+        if(info.bStateVariable == FILEIO_SD_ASYNC_READ_NEW_PACKET_READY)
+        {
+            info.pBuffer = buffer + (totalBytes - ioInfo.dwBytesRemaining);
+        }
+
+        status = FILEIO_SD_AsyncReadTasks(config, &info);
+        if(status == FILEIO_SD_ASYNC_READ_COMPLETE)
+        {
+            return true;
+        }
+        else if(status == FILEIO_SD_ASYNC_READ_ERROR)
+        {
+            return false;
+        }
+    }
+
+    //Impossible to get here, but we will return a value anyay to avoid possible
+    //compiler warnings.
+    return false;
+}
+
 /*****************************************************************************
   Function:
     uint8_t FILEIO_SD_AsyncReadTasks(FILEIO_SD_ASYNC_IO* info)
@@ -1278,6 +1326,59 @@ bool FILEIO_SD_SectorWrite(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sectorAddre
 }    
 
 
+bool FILEIO_SD_MultipleSectorWrite(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sectorAddress, uint8_t* buffer, uint16_t sectorCount, bool allowWriteToZero)
+{
+    FILEIO_SD_ASYNC_IO info;
+    uint32_t totalBytes;
+    uint8_t status;
+
+    if(allowWriteToZero == false)
+    {
+        if(sectorAddress == 0x00000000)
+        {
+            return false;
+        }
+    }
+
+    if(sectorCount == 0)
+    {
+        return true;
+    }
+
+    //Initialize structure for a multi-block (ACMD23 + CMD25) write of all of
+    //the requested sectors, one block per packet.
+    totalBytes = (uint32_t)sectorCount * FILEIO_SD_MEDIA_BLOCK_SIZE;
+    info.wNumBytes = FILEIO_SD_MEDIA_BLOCK_SIZE;
+    info.dwBytesRemaining = totalBytes;
+    info.pBuffer = buffer;
+    info.dwAddress = sectorAddress;
+    info.bStateVariable = FILEIO_SD_ASYNC_WRITE_QUEUED;
+
+    //Repeatedly call the write handler until the operation is complete (or a
+    //failure/timeout occurred).
+    while(1)
+    {
+        //Point the state machine at the part of the user buffer that holds the
+        //next block to send.
+        if(info.bStateVariable == FILEIO_SD_ASYNC_WRITE_TRANSMIT_PACKET)
+        {
+            info.pBuffer = buffer + (totalBytes - ioInfo.dwBytesRemaining);
+        }
+
+        status = FILEIO_SD_AsyncWriteTasks(config, &info);
+        if(status == FILEIO_SD_ASYNC_WRITE_COMPLETE)
+        {
+            return true;
+        }
+        else if(status == FILEIO_SD_ASYNC_WRITE_ERROR)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
 bool FILEIO_SD_WriteProtectStateGet(FILEIO_SD_DRIVE_CONFIG * config)
 {
     return (*config->wpFunc)();
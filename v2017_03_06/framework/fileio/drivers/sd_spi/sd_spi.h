@@ -454,6 +454,75 @@ bool FILEIO_SD_SectorRead(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sector_addr,
   ***************************************************************************************/
 bool FILEIO_SD_SectorWrite(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sector_addr, uint8_t * buffer, bool allowWriteToZero);
 
+/*****************************************************************************
+  Function:
+    bool FILEIO_SD_MultipleSectorRead (FILEIO_SD_DRIVE_CONFIG * config,
+        uint32_t sector_addr, uint8_t * buffer, uint16_t sectorCount)
+  Summary:
+    Reads several consecutive sectors of data from an SD card.
+  Conditions:
+    The FILEIO_DRIVER_MultipleSectorRead function pointer must be pointing
+    towards this function.
+  Input:
+    config - An SD Drive configuration structure pointer
+    sectorAddress - The address of the first sector on the card.
+    buffer -      The buffer where the retrieved data will be stored.  It
+                  must hold sectorCount * 512 bytes.
+    sectorCount - The number of sectors to read.
+  Return Values:
+    true -  The sectors were read successfully
+    false - The sectors could not be read
+  Side Effects:
+    None
+  Description:
+    The FILEIO_SD_MultipleSectorRead function reads sectorCount sectors
+    (512 bytes each) from the SD card starting at the sector address and
+    stores them in the location pointed to by 'buffer.'  More than one
+    sector is read with a single READ_MULTIPLE_BLOCK (CMD18) command
+    followed by STOP_TRANSMISSION (CMD12), so the command overhead and
+    the card's access time are paid once rather than once per sector.
+  Remarks:
+    This function performs a synchronous read operation using
+    FILEIO_SD_AsyncReadTasks().
+  ***************************************************************************************/
+bool FILEIO_SD_MultipleSectorRead(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sector_addr, uint8_t * buffer, uint16_t sectorCount);
+
+/*****************************************************************************
+  Function:
+    bool FILEIO_SD_MultipleSectorWrite (FILEIO_SD_DRIVE_CONFIG * config,
+        uint32_t sector_addr, uint8_t * buffer, uint16_t sectorCount,
+        bool allowWriteToZero)
+  Summary:
+    Writes several consecutive sectors of data to an SD card.
+  Conditions:
+    The FILEIO_DRIVER_MultipleSectorWrite function pointer must be pointing
+    to this function.
+  Input:
+    config - An SD Drive configuration structure pointer
+    sectorAddress -    The address of the first sector on the card.
+    buffer -           The buffer with the data to write.  It must hold
+                       sectorCount * 512 bytes.
+    sectorCount -      The number of sectors to write.
+    allowWriteToZero -
+                     - true -  Writes to the 0 sector (MBR) are allowed
+                     - false - Any write starting at the 0 sector will fail.
+  Return Values:
+    true -  The sectors were written successfully.
+    false - The sectors could not be written.
+  Side Effects:
+    None.
+  Description:
+    The FILEIO_SD_MultipleSectorWrite function writes sectorCount sectors
+    (512 bytes each) from the location pointed to by 'buffer' to the card,
+    starting at the specified sector.  More than one sector is written with
+    SET_WR_BLK_ERASE_COUNT (ACMD23) and a single WRITE_MULTIPLE_BLOCK
+    (CMD25) command terminated by a stop token.
+  Remarks:
+    This function performs a synchronous write operation using
+    FILEIO_SD_AsyncWriteTasks().
+  ***************************************************************************************/
+bool FILEIO_SD_MultipleSectorWrite(FILEIO_SD_DRIVE_CONFIG * config, uint32_t sector_addr, uint8_t * buffer, uint16_t sectorCount, bool allowWriteToZero);
+
 /*******************************************************************************
   Function:
     uint8_t FILEIO_SD_WriteProtectStateGet
@@ -358,6 +358,80 @@ typedef uint8_t (*FILEIO_DRIVER_SectorWrite)(void * mediaConfig, uint32_t sector
 ***************************************************************************/
 typedef bool (*FILEIO_DRIVER_WriteProtectStateGet)(void * mediaConfig);
 
+/***************************************************************************
+    Function:
+        bool (*FILEIO_DRIVER_MultipleSectorRead)(void * mediaConfig,
+            uint32_t sectorAddress, uint8_t * buffer, uint16_t sectorCount);
+
+    Summary:
+        Function pointer prototype for a driver function to read several
+        consecutive sectors of data from the device.
+
+    Description:
+        Function pointer prototype for a driver function to read several
+        consecutive sectors of data from the device in one transfer.  The
+        library uses this function to read whole sectors of file data
+        directly into the caller's buffer.
+
+    Precondition:
+        The device will be initialized.
+
+    Parameters:
+        mediaConfig - Pointer to a driver-defined config structure
+        sectorAddress - The address of the first sector to read.  This
+            address format depends on the media.
+        buffer - A buffer to store the data.  It must be large enough to
+            hold sectorCount sectors.
+        sectorCount - The number of sectors to read.
+
+    Returns:
+        If Success: true
+        If Failure: false
+
+    Remarks:
+        This function is optional.  If it is not provided the library will
+        read file data one sector at a time through the data buffer.
+***************************************************************************/
+typedef bool (*FILEIO_DRIVER_MultipleSectorRead)(void * mediaConfig, uint32_t sector_addr, uint8_t* buffer, uint16_t sectorCount);
+
+/***************************************************************************
+    Function:
+        bool (*FILEIO_DRIVER_MultipleSectorWrite)(void * mediaConfig,
+            uint32_t sectorAddress, uint8_t * buffer, uint16_t sectorCount,
+            bool allowWriteToZero);
+
+    Summary:
+        Function pointer prototype for a driver function to write several
+        consecutive sectors of data to the device.
+
+    Description:
+        Function pointer prototype for a driver function to write several
+        consecutive sectors of data to the device in one transfer.  The
+        library uses this function to write whole sectors of file data
+        directly from the caller's buffer.
+
+    Precondition:
+        The device will be initialized.
+
+    Parameters:
+        mediaConfig - Pointer to a driver-defined config structure
+        sectorAddress - The address of the first sector to write.  This
+            address format depends on the media.
+        buffer - A buffer containing sectorCount sectors of data to write.
+        sectorCount - The number of sectors to write.
+        allowWriteToZero - Check to prevent writing to the master boot
+            record.  See FILEIO_DRIVER_SectorWrite.
+
+    Returns:
+        If Success: true
+        If Failure: false
+
+    Remarks:
+        This function is optional.  If it is not provided the library will
+        write file data one sector at a time through the data buffer.
+***************************************************************************/
+typedef bool (*FILEIO_DRIVER_MultipleSectorWrite)(void * mediaConfig, uint32_t sector_addr, uint8_t* buffer, uint16_t sectorCount, bool allowWriteToZero);
+
 
 // Function pointer table that describes a drive being configured by the user
 typedef struct
@@ -369,6 +443,8 @@ typedef struct
     FILEIO_DRIVER_SectorRead funcSectorRead;                        // Function to read a sector of the media.
     FILEIO_DRIVER_SectorWrite funcSectorWrite;                      // Function to write a sector of the media.
     FILEIO_DRIVER_WriteProtectStateGet funcWriteProtectGet;         // Function to determine if the media is write-protected.
+    FILEIO_DRIVER_MultipleSectorRead funcMultipleSectorRead;        // Optional function to read several consecutive sectors of the media (or NULL).
+    FILEIO_DRIVER_MultipleSectorWrite funcMultipleSectorWrite;      // Optional function to write several consecutive sectors of the media (or NULL).
 } FILEIO_DRIVE_CONFIG;
 
 // Structure that contains the disk search information, intermediate values, and results
@@ -450,6 +526,22 @@ typedef struct
     char driveId;
 } FILEIO_SEARCH_RECORD;
 
+// Sector cache statistics (see FILEIO_CacheStatisticsGet)
+typedef struct
+{
+    uint32_t hits;                      // The number of sector reads and writes that were satisfied by a cached sector.
+    uint32_t misses;                    // The number of sector reads and writes that required a new cache entry.
+    uint32_t writeBacks;                // The number of modified sectors that were written from the cache to the media.
+} FILEIO_CACHE_STATISTICS;
+
+// Free cluster allocation statistics for a drive (see FILEIO_FreeClusterStatisticsGet)
+typedef struct
+{
+    uint32_t mountSectorReads;          // The number of sectors read when the drive was mounted to find where free cluster searches start.
+    uint32_t clustersSearched;          // The number of FAT entries read while searching for free clusters since the drive was mounted.
+    uint32_t nextFreeCluster;           // The cluster at which the next search for a free cluster will start.
+} FILEIO_FREE_CLUSTER_STATISTICS;
+
 /***************************************************************************
 * Prototypes                                                               *
 ***************************************************************************/
@@ -653,7 +745,9 @@ int FILEIO_Format (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, FILEIO_
     Unmounts a drive.
   Description:
     Unmounts a drive from the file system and writes any pending data to
-    the drive.
+    the drive.  If the FAT32 free cluster hint or the sector cache could
+    not be written, the drive is still unmounted, but
+    FILEIO_RESULT_FAILURE is returned.
   Conditions:
     FILEIO_DriveMount must have been called.
   Input:
@@ -1455,4 +1549,68 @@ FILEIO_FILE_SYSTEM_TYPE FILEIO_FileSystemTypeGet (char driveId);
   *********************************************************************************/
 void FILEIO_DrivePropertiesGet (FILEIO_DRIVE_PROPERTIES* properties, char driveId);
 
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+/***************************************************************************
+  Function:
+    void FILEIO_CacheStatisticsGet (FILEIO_CACHE_STATISTICS * statistics)
+
+  Summary:
+    Returns the hit/miss counters of the sector cache.
+
+  Description:
+    Copies the sector cache counters into the structure pointed to by
+    statistics.  The sector cache holds FILEIO_CONFIG_SECTOR_CACHE_SIZE
+    sectors, shared by all mounted drives, and sits below the FAT,
+    directory and file data buffers.  Modified sectors are written back to
+    the media when they are evicted (least recently used first), when a
+    file is flushed or closed, and when the drive is unmounted.
+
+    The counters are cleared by FILEIO_Initialize and are never reset
+    otherwise; an application that wants to measure a single operation
+    should take the difference of two snapshots.
+
+  Precondition:
+    FILEIO_CONFIG_SECTOR_CACHE_SIZE must be defined to a non-zero value in
+    fileio_config.h.  FILEIO_Initialize must have been called.
+
+  Parameters:
+    statistics - Pointer to a structure that will receive the counters.
+
+  Returns:
+    None
+  ***************************************************************************/
+void FILEIO_CacheStatisticsGet (FILEIO_CACHE_STATISTICS * statistics);
+#endif
+
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+/***************************************************************************
+  Function:
+    int FILEIO_FreeClusterStatisticsGet (char driveId, FILEIO_FREE_CLUSTER_STATISTICS * statistics)
+
+  Summary:
+    Returns the cost of free cluster allocation on a drive.
+
+  Description:
+    Copies the free cluster counters of a mounted drive into the structure
+    pointed to by statistics.  On FAT32 drives the search for a free
+    cluster starts at the next free cluster hint from the FSInfo sector,
+    which costs one sector read at mount time.  FAT12 and FAT16 drives
+    have no hint and read no sectors at mount time.
+
+    The counters are cleared when the drive is mounted.
+
+  Precondition:
+    The drive must have been mounted.
+
+  Parameters:
+    driveId - The character representation of the drive.
+    statistics - Pointer to a structure that will receive the counters.
+
+  Returns:
+    * If Success: FILEIO_RESULT_SUCCESS
+    * If Failure: FILEIO_RESULT_FAILURE (the drive is not mounted)
+  ***************************************************************************/
+int FILEIO_FreeClusterStatisticsGet (char driveId, FILEIO_FREE_CLUSTER_STATISTICS * statistics);
+#endif
+
 #endif
@@ -62,6 +62,17 @@ FILEIO_TimestampGet timestampGet;
     #endif
 #endif
 
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+    #if defined (__XC16__) || defined (__XC32__)
+        uint8_t __attribute__ ((aligned(4)))   gSectorCache[FILEIO_CONFIG_SECTOR_CACHE_SIZE][FILEIO_CONFIG_MEDIA_SECTOR_SIZE];   // The shared sector cache
+    #else
+        uint8_t gSectorCache[FILEIO_CONFIG_SECTOR_CACHE_SIZE][FILEIO_CONFIG_MEDIA_SECTOR_SIZE];   // The shared sector cache
+    #endif
+FILEIO_SECTOR_CACHE_ENTRY gSectorCacheEntry[FILEIO_CONFIG_SECTOR_CACHE_SIZE];     // Owner, sector number and state of each sector in the cache
+uint32_t gSectorCacheAccessCount;                                                 // Incremented on each cache access to order the entries for LRU replacement
+FILEIO_CACHE_STATISTICS gSectorCacheStatistics;
+#endif
+
 struct
 {
     FILEIO_DIRECTORY currentWorkingDirectory;
@@ -105,6 +116,18 @@ int FILEIO_Initialize (void)
     bufferStatus.dataBufferCachedSector = 0xFFFFFFFF;
     bufferStatus.fatBufferCachedSector = 0xFFFFFFFF;
 #endif
+
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        gSectorCacheEntry[i].drive = NULL;
+        gSectorCacheEntry[i].needsWrite = false;
+    }
+    gSectorCacheAccessCount = 0;
+    gSectorCacheStatistics.hits = 0;
+    gSectorCacheStatistics.misses = 0;
+    gSectorCacheStatistics.writeBacks = 0;
+#endif
     
     globalParameters.currentWorkingDirectory.drive = 0;
     globalParameters.currentWorkingDirectory.cluster = 0;
@@ -191,6 +214,7 @@ FILEIO_ERROR_TYPE FILEIO_DriveMount (char driveId, const FILEIO_DRIVE_CONFIG * d
     bufferStatus[i].dataBufferCachedSector = 0xFFFFFFFF;
     bufferStatus[i].fatBufferCachedSector = 0xFFFFFFFF;
 #endif
+    FILEIO_CacheInvalidate (drive, 0, 0xFFFFFFFF);
 
 #if defined (FILEIO_CONFIG_MULTIPLE_BUFFER_MODE_DISABLE)
     if (FILEIO_GetSingleBuffer (drive) != FILEIO_RESULT_SUCCESS)
@@ -233,6 +257,13 @@ FILEIO_ERROR_TYPE FILEIO_DriveMount (char driveId, const FILEIO_DRIVE_CONFIG * d
         }
     }
 
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+    if (error == FILEIO_ERROR_NONE)
+    {
+        FILEIO_FreeClusterHintLoad (drive);
+    }
+#endif
+
     if (error == FILEIO_ERROR_NONE)
     {
         // If this is the first drive we're mounting, set its root as the current working directory
@@ -527,11 +558,30 @@ FILEIO_ERROR_TYPE FILEIO_LoadBootSector (FILEIO_DRIVE * drive)
                             drive->firstRootCluster = ReadRam32bit (drive->dataBuffer, BSI_ROOTCLUS);
                         #endif
                         drive->firstDataSector = drive->firstRootSector + rootDirectorySectors;
+                        #if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+                            // Remember where the FSInfo sector is; it is validated when it is read
+                            #ifdef __XC8__
+                                drive->fsInfoSector = ptrBootSector->biosParameterBlock.fat32.fileSystemInformation;
+                            #else
+                                drive->fsInfoSector = ReadRam16bit (drive->dataBuffer, BSI_FSINFO);
+                            #endif
+                            if ((drive->fsInfoSector == 0) || (drive->fsInfoSector >= reservedSectorCount))
+                            {
+                                drive->fsInfoSector = 0;
+                            }
+                            else
+                            {
+                                drive->fsInfoSector += drive->firstPartitionSector;
+                            }
+                        #endif
                     }
                     else
                     {
                         drive->firstRootCluster = 0;
                         drive->firstDataSector = drive->firstRootSector + (drive->rootDirectoryEntryCount >> 4);
+                        #if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+                            drive->fsInfoSector = 0;
+                        #endif
                     }
 
                     if(bytesPerSector > FILEIO_CONFIG_MEDIA_SECTOR_SIZE)
@@ -608,6 +658,7 @@ FILEIO_ERROR_TYPE FILEIO_LoadBootSector (FILEIO_DRIVE * drive)
 int FILEIO_DriveUnmount (const char driveId)
 {
     FILEIO_DRIVE * drive;
+    int result = FILEIO_RESULT_SUCCESS;
     uint8_t i;
 
     drive = FILEIO_CharToDrive (driveId);
@@ -618,6 +669,13 @@ int FILEIO_DriveUnmount (const char driveId)
     }
     else
     {
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+        // The drive is released even if this fails, since the media may already be gone
+        if (FILEIO_FreeClusterHintSave (drive) != FILEIO_ERROR_NONE)
+        {
+            result = FILEIO_RESULT_FAILURE;
+        }
+#endif
 #if defined (FILEIO_CONFIG_MULTIPLE_BUFFER_MODE_DISABLE)
     #if !defined (FILEIO_CONFIG_WRITE_DISABLE)
         if (drive->bufferStatusPtr->driveOwner == drive)
@@ -632,6 +690,15 @@ int FILEIO_DriveUnmount (const char driveId)
         FILEIO_FlushBuffer (drive, FILEIO_BUFFER_FAT);
         FILEIO_FlushBuffer (drive, FILEIO_BUFFER_DATA);
     #endif
+#endif
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+    #if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+        if (!FILEIO_CacheFlush (drive))
+        {
+            result = FILEIO_RESULT_FAILURE;
+        }
+    #endif
+        FILEIO_CacheInvalidate (drive, 0, 0xFFFFFFFF);
 #endif
     }
 
@@ -655,7 +722,7 @@ int FILEIO_DriveUnmount (const char driveId)
         globalParameters.currentWorkingDirectory.drive = NULL;
     }
 
-    return FILEIO_RESULT_SUCCESS;
+    return result;
 }
 
 const uint8_t gShortFileNameCharacters[17] =
@@ -1712,64 +1779,245 @@ FILEIO_ERROR_TYPE FILEIO_ClusterAllocate (FILEIO_DRIVE * drive, uint32_t * clust
 #if !defined (FILEIO_CONFIG_WRITE_DISABLE)
 uint32_t FILEIO_FindEmptyCluster (FILEIO_DRIVE * drive, uint32_t baseCluster)
 {
-    uint32_t cluster = 0x0;
-    uint32_t currentCluster, endClusterLimit, clusterFailValue;
+    uint32_t cluster;
+    uint32_t currentCluster, clusterLimit, clusterFailValue, remaining, step;
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+    uint32_t region, regionRemaining;
+    bool regionFull, checkRegion;
+#endif
 
     /* Settings based on FAT type */
     switch (drive->type)
     {
         case FILEIO_FILE_SYSTEM_TYPE_FAT32:
-            endClusterLimit = FILEIO_CLUSTER_VALUE_FAT32_END;
             clusterFailValue = FILEIO_CLUSTER_VALUE_FAT32_FAIL;
             break;
         case FILEIO_FILE_SYSTEM_TYPE_FAT12:
-            endClusterLimit = FILEIO_CLUSTER_VALUE_FAT12_END;
-            clusterFailValue = FILEIO_CLUSTER_VALUE_FAT16_FAIL;
-            break;
         case FILEIO_FILE_SYSTEM_TYPE_FAT16:
         default:
-            endClusterLimit = FILEIO_CLUSTER_VALUE_FAT16_END;
             clusterFailValue = FILEIO_CLUSTER_VALUE_FAT16_FAIL;
             break;
     }
 
+    clusterLimit = drive->partitionClusterCount + 2;
+
     // just in case
     if(baseCluster < 2)
         baseCluster = 2;
 
-    currentCluster = baseCluster;
-
-    // sequentially scan through the FAT looking for an empty cluster
-    while(currentCluster)
+    // Check the base cluster and the one after it first, so a growing file stays contiguous
+    for (currentCluster = baseCluster; (currentCluster < (baseCluster + 2)) && (currentCluster < clusterLimit); currentCluster++)
     {
-        // look at its value
+        drive->clustersSearched++;
         if ((cluster = FILEIO_FATRead(drive, currentCluster)) == clusterFailValue)
         {
-            currentCluster = 0;
-            break;
+            return 0;
         }
 
-        // check if empty cluster found
         if (cluster == FILEIO_CLUSTER_VALUE_EMPTY)
-            break;
+        {
+            drive->fsInfoNeedsWrite = true;
+            return currentCluster;
+        }
+    }
+
+    // Otherwise continue the search where the last one ended, so the same allocated clusters aren't re-read on every call
+    currentCluster = drive->freeClusterHint;
+    if ((currentCluster < 2) || (currentCluster >= clusterLimit))
+    {
+        currentCluster = 2;
+    }
+
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+    region = (currentCluster - 2) / drive->clustersPerMapBit;
+    regionRemaining = drive->clustersPerMapBit - ((currentCluster - 2) % drive->clustersPerMapBit);
+    if (regionRemaining > (clusterLimit - currentCluster))
+    {
+        regionRemaining = clusterLimit - currentCluster;
+    }
+    // A range can only be marked as full if it was searched from its first cluster
+    regionFull = (regionRemaining == drive->clustersPerMapBit);
+    checkRegion = true;
+#endif
+
+    for (remaining = drive->partitionClusterCount; remaining != 0; remaining -= step)
+    {
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+        if (checkRegion && (drive->fullClusterMap[region >> 3] & (1 << (region & 0x07))))
+        {
+            // Every cluster in this range is in use; skip it without reading the FAT
+            step = (regionRemaining < remaining) ? regionRemaining : remaining;
+        }
+        else
+#endif
+        {
+            // look at its value
+            drive->clustersSearched++;
+            if ((cluster = FILEIO_FATRead(drive, currentCluster)) == clusterFailValue)
+            {
+                return 0;
+            }
+
+            // check if empty cluster found
+            if (cluster == FILEIO_CLUSTER_VALUE_EMPTY)
+            {
+                drive->freeClusterHint = currentCluster + 1;
+                drive->fsInfoNeedsWrite = true;
+                return currentCluster;
+            }
+            step = 1;
+        }
 
-        currentCluster++;    // check next cluster in FAT
+        currentCluster += step;
 
         // check if reached last cluster in FAT, re-start from top
-        if ((cluster == endClusterLimit) || (currentCluster >= (drive->partitionClusterCount + 2)))
+        if (currentCluster >= clusterLimit)
         {
             currentCluster = 2;
         }
 
-        // check if full circle done, disk full
-        if ( currentCluster == baseCluster)
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+        checkRegion = false;
+        regionRemaining -= step;
+        if ((regionRemaining == 0) || (currentCluster == 2))
         {
-            currentCluster = 0;
-            break;
+            // Reached the end of a range without finding a free cluster
+            if (regionFull)
+            {
+                drive->fullClusterMap[region >> 3] |= (1 << (region & 0x07));
+            }
+
+            region = (currentCluster == 2) ? 0 : region + 1;
+            regionRemaining = drive->clustersPerMapBit;
+            if (regionRemaining > (clusterLimit - currentCluster))
+            {
+                regionRemaining = clusterLimit - currentCluster;
+            }
+            regionFull = true;
+            checkRegion = true;
         }
-    }  // scanning for an empty cluster
+#endif
+    }
+
+    // Full circle done, disk full
+    return 0;
+}
+
+void FILEIO_FreeClusterHintLoad (FILEIO_DRIVE * drive)
+{
+    uint32_t nextFree;
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+    uint16_t i;
+
+    // Nothing is known about the FAT yet; ranges are marked as they are found to be full
+    for (i = 0; i < FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE; i++)
+    {
+        drive->fullClusterMap[i] = 0;
+    }
+    drive->clustersPerMapBit = (drive->partitionClusterCount + ((uint32_t)FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE * 8) - 1) / ((uint32_t)FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE * 8);
+    if (drive->clustersPerMapBit == 0)
+    {
+        drive->clustersPerMapBit = 1;
+    }
+#endif
+
+    drive->freeClusterHint = 2;
+    drive->fsInfoNeedsWrite = false;
+    drive->mountSectorReads = 0;
+    drive->clustersSearched = 0;
+
+    if (drive->fsInfoSector == 0)
+    {
+        return;
+    }
+
+    // Start searching at the FAT32 FSInfo next free cluster hint, if there is a valid one
+    drive->mountSectorReads++;
+    if (!FILEIO_FlushBuffer (drive, FILEIO_BUFFER_DATA) || !FILEIO_CacheSectorRead (drive, drive->fsInfoSector, drive->dataBuffer))
+    {
+        drive->bufferStatusPtr->dataBufferCachedSector = 0xFFFFFFFF;
+        drive->fsInfoSector = 0;
+        return;
+    }
+    drive->bufferStatusPtr->dataBufferCachedSector = drive->fsInfoSector;
+
+    if ((ReadRam32bit (drive->dataBuffer, FSI_LEADSIG) != FILEIO_FSINFO_LEAD_SIGNATURE) ||
+        (ReadRam32bit (drive->dataBuffer, FSI_STRUCSIG) != FILEIO_FSINFO_STRUCTURE_SIGNATURE) ||
+        (ReadRam32bit (drive->dataBuffer, FSI_TRAILSIG) != FILEIO_FSINFO_TRAIL_SIGNATURE))
+    {
+        drive->fsInfoSector = 0;
+        return;
+    }
+
+    nextFree = ReadRam32bit (drive->dataBuffer, FSI_NXT_FREE);
+    if ((nextFree >= 2) && (nextFree < (drive->partitionClusterCount + 2)))
+    {
+        drive->freeClusterHint = nextFree;
+    }
+}
+
+FILEIO_ERROR_TYPE FILEIO_FreeClusterHintSave (FILEIO_DRIVE * drive)
+{
+    uint8_t i;
+
+    if ((drive->fsInfoSector == 0) || !drive->fsInfoNeedsWrite)
+    {
+        return FILEIO_ERROR_NONE;
+    }
+
+#if defined (FILEIO_CONFIG_MULTIPLE_BUFFER_MODE_DISABLE)
+    if (FILEIO_GetSingleBuffer (drive) != FILEIO_RESULT_SUCCESS)
+    {
+        return FILEIO_ERROR_WRITE;
+    }
+#endif
+
+    if (drive->bufferStatusPtr->dataBufferCachedSector != drive->fsInfoSector)
+    {
+        if (!FILEIO_FlushBuffer (drive, FILEIO_BUFFER_DATA))
+        {
+            return FILEIO_ERROR_WRITE;
+        }
+
+        if (!FILEIO_CacheSectorRead (drive, drive->fsInfoSector, drive->dataBuffer))
+        {
+            drive->bufferStatusPtr->dataBufferCachedSector = 0xFFFFFFFF;
+            return FILEIO_ERROR_BAD_SECTOR_READ;
+        }
+        drive->bufferStatusPtr->dataBufferCachedSector = drive->fsInfoSector;
+    }
+
+    // Store the next free cluster hint.  The free cluster count isn't tracked, so mark it as unknown.
+    for (i = 0; i < 4; i++)
+    {
+        *(drive->dataBuffer + FSI_FREE_COUNT + i) = (uint8_t)(FILEIO_FSINFO_UNKNOWN >> (i * 8));
+        *(drive->dataBuffer + FSI_NXT_FREE + i) = (uint8_t)(drive->freeClusterHint >> (i * 8));
+    }
+    drive->bufferStatusPtr->flags.dataBufferNeedsWrite = true;
+
+    if (!FILEIO_FlushBuffer (drive, FILEIO_BUFFER_DATA))
+    {
+        return FILEIO_ERROR_WRITE;
+    }
 
-    return(currentCluster);
+    drive->fsInfoNeedsWrite = false;
+    return FILEIO_ERROR_NONE;
+}
+
+int FILEIO_FreeClusterStatisticsGet (char driveId, FILEIO_FREE_CLUSTER_STATISTICS * statistics)
+{
+    FILEIO_DRIVE * drive = FILEIO_CharToDrive (driveId);
+
+    if (drive == NULL)
+    {
+        return FILEIO_RESULT_FAILURE;
+    }
+
+    statistics->mountSectorReads = drive->mountSectorReads;
+    statistics->clustersSearched = drive->clustersSearched;
+    statistics->nextFreeCluster = drive->freeClusterHint;
+
+    return FILEIO_RESULT_SUCCESS;
 }
 #endif
 
@@ -1788,6 +2036,9 @@ FILEIO_ERROR_TYPE FILEIO_EraseCluster (FILEIO_DRIVE * drive, uint32_t cluster)
 
     memset (drive->dataBuffer, 0x00, drive->sectorSize);
 
+    // The cluster is written directly to the media; drop any cached copies of its sectors
+    FILEIO_CacheInvalidate (drive, sector, drive->sectorsPerCluster);
+
     for (i = 0; (i < drive->sectorsPerCluster) && (error == FILEIO_ERROR_NONE); i++)
     {
         if (!(*drive->driveConfig->funcSectorWrite)(drive->mediaParameters, sector++, drive->dataBuffer, false))
@@ -1877,7 +2128,7 @@ FILEIO_DIRECTORY_ENTRY * FILEIO_DirectoryEntryCache (FILEIO_DIRECTORY * director
             return NULL;
         }
 #endif
-        if ((*disk->driveConfig->funcSectorRead) (disk->mediaParameters, sector, disk->dataBuffer) != true)
+        if (FILEIO_CacheSectorRead (disk, sector, disk->dataBuffer) != true)
         {
             *error = FILEIO_ERROR_BAD_SECTOR_READ;
             return NULL;
@@ -1905,6 +2156,12 @@ FILEIO_ERROR_TYPE FILEIO_ForceRecache (FILEIO_DRIVE * disk)
     {
         return FILEIO_ERROR_WRITE;
     }
+
+    // Write back the sector cache so the sector can be re-read from the media itself
+    if (!FILEIO_CacheFlush (disk))
+    {
+        return FILEIO_ERROR_WRITE;
+    }
 #endif
     if ((*disk->driveConfig->funcSectorRead) (disk->mediaParameters, disk->bufferStatusPtr->dataBufferCachedSector, disk->dataBuffer) != true)
     {
@@ -1930,7 +2187,7 @@ bool FILEIO_FlushBuffer (FILEIO_DRIVE * disk, FILEIO_BUFFER_ID bufferId)
         case FILEIO_BUFFER_DATA:
             if (disk->bufferStatusPtr->flags.dataBufferNeedsWrite)
             {
-                if (!(*disk->driveConfig->funcSectorWrite)(disk->mediaParameters, disk->bufferStatusPtr->dataBufferCachedSector, disk->dataBuffer, false) )
+                if (!FILEIO_CacheSectorWrite (disk, disk->bufferStatusPtr->dataBufferCachedSector, disk->dataBuffer))
                 {
                     return false;
                 }
@@ -1944,7 +2201,7 @@ bool FILEIO_FlushBuffer (FILEIO_DRIVE * disk, FILEIO_BUFFER_ID bufferId)
                 uint8_t i;
                 for (i = 0; i < disk->fatCopyCount; i++, sector += disk->fatSectorCount)
                 {
-                    if (! (*disk->driveConfig->funcSectorWrite)(disk->mediaParameters, sector, disk->fatBuffer, false) )
+                    if (! FILEIO_CacheSectorWrite (disk, sector, disk->fatBuffer))
                     {
                         return false;
                     }
@@ -1957,6 +2214,179 @@ bool FILEIO_FlushBuffer (FILEIO_DRIVE * disk, FILEIO_BUFFER_ID bufferId)
 }
 #endif
 
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+FILEIO_SECTOR_CACHE_ENTRY * FILEIO_CacheEntryFind (FILEIO_DRIVE * drive, uint32_t sector)
+{
+    uint8_t i;
+
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        if ((gSectorCacheEntry[i].drive == drive) && (gSectorCacheEntry[i].sector == sector))
+        {
+            return &gSectorCacheEntry[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool FILEIO_CacheEntryWriteBack (FILEIO_SECTOR_CACHE_ENTRY * entry)
+{
+    FILEIO_DRIVE * drive = entry->drive;
+
+    if (entry->needsWrite)
+    {
+        if (!(*drive->driveConfig->funcSectorWrite)(drive->mediaParameters, entry->sector, gSectorCache[entry - gSectorCacheEntry], false))
+        {
+            return false;
+        }
+        entry->needsWrite = false;
+        gSectorCacheStatistics.writeBacks++;
+    }
+
+    return true;
+}
+
+FILEIO_SECTOR_CACHE_ENTRY * FILEIO_CacheEntryAllocate (void)
+{
+    FILEIO_SECTOR_CACHE_ENTRY * victim = &gSectorCacheEntry[0];
+    uint8_t i;
+
+    // Use a free entry if there is one, otherwise replace the least recently used sector
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        if (gSectorCacheEntry[i].drive == NULL)
+        {
+            return &gSectorCacheEntry[i];
+        }
+        if (gSectorCacheEntry[i].lastUse < victim->lastUse)
+        {
+            victim = &gSectorCacheEntry[i];
+        }
+    }
+
+    if (!FILEIO_CacheEntryWriteBack (victim))
+    {
+        return NULL;
+    }
+
+    victim->drive = NULL;
+    return victim;
+}
+
+bool FILEIO_CacheSectorRead (FILEIO_DRIVE * drive, uint32_t sector, uint8_t * buffer)
+{
+    FILEIO_SECTOR_CACHE_ENTRY * entry = FILEIO_CacheEntryFind (drive, sector);
+
+    if (entry != NULL)
+    {
+        gSectorCacheStatistics.hits++;
+        memcpy (buffer, gSectorCache[entry - gSectorCacheEntry], drive->sectorSize);
+        entry->lastUse = ++gSectorCacheAccessCount;
+        return true;
+    }
+
+    gSectorCacheStatistics.misses++;
+    if ((*drive->driveConfig->funcSectorRead) (drive->mediaParameters, sector, buffer) != true)
+    {
+        return false;
+    }
+
+    // Keep a copy of the sector.  If the entry being replaced can't be written back, leave the cache as it is.
+    entry = FILEIO_CacheEntryAllocate ();
+    if (entry != NULL)
+    {
+        memcpy (gSectorCache[entry - gSectorCacheEntry], buffer, drive->sectorSize);
+        entry->drive = drive;
+        entry->sector = sector;
+        entry->needsWrite = false;
+        entry->lastUse = ++gSectorCacheAccessCount;
+    }
+
+    return true;
+}
+
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+bool FILEIO_CacheSectorWrite (FILEIO_DRIVE * drive, uint32_t sector, uint8_t * buffer)
+{
+    FILEIO_SECTOR_CACHE_ENTRY * entry = FILEIO_CacheEntryFind (drive, sector);
+
+    if (entry != NULL)
+    {
+        gSectorCacheStatistics.hits++;
+    }
+    else
+    {
+        gSectorCacheStatistics.misses++;
+        entry = FILEIO_CacheEntryAllocate ();
+        if (entry == NULL)
+        {
+            // No entry could be freed; write the sector through to the media
+            return (*drive->driveConfig->funcSectorWrite)(drive->mediaParameters, sector, buffer, false);
+        }
+        entry->drive = drive;
+        entry->sector = sector;
+    }
+
+    memcpy (gSectorCache[entry - gSectorCacheEntry], buffer, drive->sectorSize);
+    entry->needsWrite = true;
+    entry->lastUse = ++gSectorCacheAccessCount;
+
+    return true;
+}
+
+bool FILEIO_CacheFlush (FILEIO_DRIVE * drive)
+{
+    uint8_t i;
+
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        if (gSectorCacheEntry[i].drive == drive)
+        {
+            if (!FILEIO_CacheEntryWriteBack (&gSectorCacheEntry[i]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
+void FILEIO_CacheInvalidate (FILEIO_DRIVE * drive, uint32_t firstSector, uint32_t sectorCount)
+{
+    uint8_t i;
+
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        if ((gSectorCacheEntry[i].drive == drive) && ((gSectorCacheEntry[i].sector - firstSector) < sectorCount))
+        {
+            gSectorCacheEntry[i].drive = NULL;
+            gSectorCacheEntry[i].needsWrite = false;
+        }
+    }
+}
+
+void FILEIO_CacheMerge (FILEIO_DRIVE * drive, uint32_t firstSector, uint16_t sectorCount, uint8_t * buffer)
+{
+    uint8_t i;
+
+    for (i = 0; i < FILEIO_CONFIG_SECTOR_CACHE_SIZE; i++)
+    {
+        if ((gSectorCacheEntry[i].drive == drive) && gSectorCacheEntry[i].needsWrite && ((gSectorCacheEntry[i].sector - firstSector) < sectorCount))
+        {
+            memcpy (buffer + ((gSectorCacheEntry[i].sector - firstSector) * drive->sectorSize), gSectorCache[i], drive->sectorSize);
+        }
+    }
+}
+
+void FILEIO_CacheStatisticsGet (FILEIO_CACHE_STATISTICS * statistics)
+{
+    *statistics = gSectorCacheStatistics;
+}
+#endif
+
 bool FILEIO_ShortFileNameCompare (uint8_t * fileName1, uint8_t * fileName2, uint8_t mode)
 {
     if ((mode & FILEIO_SEARCH_PARTIAL_STRING_SEARCH) == FILEIO_SEARCH_PARTIAL_STRING_SEARCH)
@@ -2095,7 +2525,7 @@ uint32_t FILEIO_FATRead (FILEIO_DRIVE * disk, uint32_t currentCluster)
                         return ClusterFailValue;
                     }
 #endif
-                    if (!(*disk->driveConfig->funcSectorRead) (disk->mediaParameters, l+1, disk->fatBuffer))
+                    if (!FILEIO_CacheSectorRead (disk, l+1, disk->fatBuffer))
                     {
                         disk->bufferStatusPtr->fatBufferCachedSector = 0xFFFFFFFF;
                         return ClusterFailValue;
@@ -2127,7 +2557,7 @@ uint32_t FILEIO_FATRead (FILEIO_DRIVE * disk, uint32_t currentCluster)
             return ClusterFailValue;
         }
 #endif
-        if (!(*disk->driveConfig->funcSectorRead) (disk->mediaParameters, l, disk->fatBuffer))
+        if (!FILEIO_CacheSectorRead (disk, l, disk->fatBuffer))
         {
             disk->bufferStatusPtr->fatBufferCachedSector = 0xFFFFFFFF;  // Note: It is Sector not Cluster.
             return ClusterFailValue;
@@ -2363,6 +2793,19 @@ uint32_t FILEIO_FATWrite (FILEIO_DRIVE *disk, uint32_t currentCluster, uint32_t
         return 0;
     }
 
+    if (value == FILEIO_CLUSTER_VALUE_EMPTY)
+    {
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+        // The range containing this cluster has a free cluster again
+        if ((currentCluster >= 2) && (currentCluster < (disk->partitionClusterCount + 2)))
+        {
+            p = (currentCluster - 2) / disk->clustersPerMapBit;
+            disk->fullClusterMap[p >> 3] &= ~(1 << (p & 0x07));
+        }
+#endif
+        disk->fsInfoNeedsWrite = true;
+    }
+
     /* Settings based on FAT type */
     switch (disk->type)
     {
@@ -2395,7 +2838,7 @@ uint32_t FILEIO_FATWrite (FILEIO_DRIVE *disk, uint32_t currentCluster, uint32_t
         }
 
         // Load the new sector
-        if (!(*disk->driveConfig->funcSectorRead) (disk->mediaParameters, l, disk->fatBuffer))
+        if (!FILEIO_CacheSectorRead (disk, l, disk->fatBuffer))
         {
             statusPtr->fatBufferCachedSector = 0xFFFFFFFF;
             return clusterFailValue;
@@ -2447,7 +2890,7 @@ uint32_t FILEIO_FATWrite (FILEIO_DRIVE *disk, uint32_t currentCluster, uint32_t
                 }
 
                 // Load the next sector
-                if (!(*disk->driveConfig->funcSectorRead) (disk->mediaParameters, l +1, disk->fatBuffer))
+                if (!FILEIO_CacheSectorRead (disk, l +1, disk->fatBuffer))
                 {
                     statusPtr->fatBufferCachedSector = 0xFFFFFFFF;
                     return clusterFailValue;
@@ -2779,7 +3222,7 @@ int FILEIO_Seek(FILEIO_OBJECT * filePtr, int32_t offset, int whence)
         numsector = filePtr->currentSector;
         temp += numsector;
 
-        if(!(*disk->driveConfig->funcSectorRead)(disk->mediaParameters, temp, disk->dataBuffer) )
+        if(!FILEIO_CacheSectorRead (disk, temp, disk->dataBuffer) )
         {
             disk->error = FILEIO_ERROR_BAD_CACHE_READ;
             return FILEIO_RESULT_FAILURE;   // Bad read
@@ -2799,8 +3242,10 @@ size_t FILEIO_Write (const void * buffer, size_t size, size_t count, FILEIO_OBJE
     uint8_t * data = (uint8_t *) buffer;
     FILEIO_DRIVE * disk = filePtr->disk;
     uint32_t currentSector;
+    uint32_t cachedSector;
     size_t dataWritten = 0;
-    uint16_t writeCount;
+    uint32_t writeCount;
+    uint16_t sectorCount;
     size_t length = size * count;
 
     if (!filePtr->flags.writeEnabled)
@@ -2858,6 +3303,39 @@ size_t FILEIO_Write (const void * buffer, size_t size, size_t count, FILEIO_OBJE
         currentSector = FILEIO_ClusterToSector (disk, filePtr->currentCluster);
         currentSector += filePtr->currentSector;
 
+        // Write whole sectors directly from the caller's buffer, up to the end of the current cluster
+        if ((filePtr->currentOffset == 0) && (length >= disk->sectorSize) && (disk->driveConfig->funcMultipleSectorWrite != NULL))
+        {
+            sectorCount = disk->sectorsPerCluster - filePtr->currentSector;
+            if ((length / disk->sectorSize) < sectorCount)
+            {
+                sectorCount = length / disk->sectorSize;
+            }
+
+            if (!(*disk->driveConfig->funcMultipleSectorWrite) (disk->mediaParameters, currentSector, data, sectorCount, false))
+            {
+                disk->error = FILEIO_ERROR_WRITE;
+                return dataWritten;
+            }
+            FILEIO_CacheInvalidate (disk, currentSector, sectorCount);
+
+            // Keep the data buffer coherent if it holds one of the sectors just written
+            cachedSector = disk->bufferStatusPtr->dataBufferCachedSector;
+            if ((cachedSector >= currentSector) && (cachedSector < (currentSector + sectorCount)))
+            {
+                memcpy (disk->dataBuffer, data + ((cachedSector - currentSector) * disk->sectorSize), disk->sectorSize);
+                disk->bufferStatusPtr->flags.dataBufferNeedsWrite = false;
+            }
+
+            writeCount = sectorCount * disk->sectorSize;
+            data += writeCount;
+            filePtr->currentSector += sectorCount - 1;
+            filePtr->currentOffset = disk->sectorSize;
+            dataWritten += writeCount;
+            length -= writeCount;
+            continue;
+        }
+
         // Cache the required sector, if necessary
         if (disk->bufferStatusPtr->dataBufferCachedSector != currentSector)
         {
@@ -2867,7 +3345,7 @@ size_t FILEIO_Write (const void * buffer, size_t size, size_t count, FILEIO_OBJE
                 return FILEIO_ERROR_WRITE;
             }
 
-            if ((*disk->driveConfig->funcSectorRead) (disk->mediaParameters, currentSector, disk->dataBuffer) != true)
+            if (FILEIO_CacheSectorRead (disk, currentSector, disk->dataBuffer) != true)
             {
                 disk->error = FILEIO_ERROR_BAD_SECTOR_READ;
                 return dataWritten;
@@ -2903,8 +3381,12 @@ size_t FILEIO_Read (void * buffer, size_t size, size_t count, FILEIO_OBJECT * fi
     uint8_t * data = (uint8_t *) buffer;
     FILEIO_DRIVE * disk = filePtr->disk;
     uint32_t currentSector;
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+    uint32_t cachedSector;
+#endif
     size_t dataRead = 0;
-    uint16_t readCount;
+    uint32_t readCount;
+    uint16_t sectorCount;
     size_t length = size * count;
 
     if (!filePtr->flags.readEnabled)
@@ -2950,6 +3432,53 @@ size_t FILEIO_Read (void * buffer, size_t size, size_t count, FILEIO_OBJECT * fi
         currentSector = FILEIO_ClusterToSector (disk, filePtr->currentCluster);
         currentSector += filePtr->currentSector;
 
+        // Read whole sectors directly into the caller's buffer, up to the end of the current cluster
+        if ((filePtr->currentOffset == 0) && (disk->driveConfig->funcMultipleSectorRead != NULL))
+        {
+            sectorCount = disk->sectorsPerCluster - filePtr->currentSector;
+            if ((length / disk->sectorSize) < sectorCount)
+            {
+                sectorCount = length / disk->sectorSize;
+            }
+            if (((filePtr->size - filePtr->absoluteOffset) / disk->sectorSize) < sectorCount)
+            {
+                sectorCount = (filePtr->size - filePtr->absoluteOffset) / disk->sectorSize;
+            }
+
+            if (sectorCount != 0)
+            {
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+                // Make sure the media is up to date if the data buffer holds a modified copy of one of these sectors
+                cachedSector = disk->bufferStatusPtr->dataBufferCachedSector;
+                if ((cachedSector >= currentSector) && (cachedSector < (currentSector + sectorCount)))
+                {
+                    if (!FILEIO_FlushBuffer (disk, FILEIO_BUFFER_DATA))
+                    {
+                        disk->error = FILEIO_ERROR_WRITE;
+                        return dataRead;
+                    }
+                }
+#endif
+
+                if (!(*disk->driveConfig->funcMultipleSectorRead) (disk->mediaParameters, currentSector, data, sectorCount))
+                {
+                    disk->error = FILEIO_ERROR_BAD_SECTOR_READ;
+                    return dataRead;
+                }
+                // Sectors modified in the sector cache are newer than the copies just read from the media
+                FILEIO_CacheMerge (disk, currentSector, sectorCount, data);
+
+                readCount = sectorCount * disk->sectorSize;
+                data += readCount;
+                filePtr->currentSector += sectorCount - 1;
+                filePtr->currentOffset = disk->sectorSize;
+                filePtr->absoluteOffset += readCount;
+                dataRead += readCount;
+                length -= readCount;
+                continue;
+            }
+        }
+
         // Cache the required sector, if necessary
         if (disk->bufferStatusPtr->dataBufferCachedSector != currentSector)
         {
@@ -2961,7 +3490,7 @@ size_t FILEIO_Read (void * buffer, size_t size, size_t count, FILEIO_OBJECT * fi
             }
 #endif
 
-            if ((*disk->driveConfig->funcSectorRead) (disk->mediaParameters, currentSector, disk->dataBuffer) != true)
+            if (FILEIO_CacheSectorRead (disk, currentSector, disk->dataBuffer) != true)
             {
                 disk->error = FILEIO_ERROR_BAD_SECTOR_READ;
                 return dataRead;
@@ -3740,6 +4269,7 @@ int FILEIO_CreateMBR (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, uint
                 return false;
             }
             bufferStatusPtr->flags.dataBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate ((FILEIO_DRIVE *)bufferStatusPtr->driveOwner, bufferStatusPtr->dataBufferCachedSector, 1);
         }
     }
 
@@ -3757,6 +4287,7 @@ int FILEIO_CreateMBR (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, uint
                 return false;
             }
             bufferStatusPtr->flags.dataBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate (&gDriveArray[FILEIO_CONFIG_MAX_DRIVES - 1], bufferStatusPtr->dataBufferCachedSector, 1);
         }
     }
 #endif
@@ -3864,6 +4395,7 @@ int FILEIO_Format (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, FILEIO_
                 return false;
             }
             bufferStatusPtr->flags.dataBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate ((FILEIO_DRIVE *)bufferStatusPtr->driveOwner, bufferStatusPtr->dataBufferCachedSector, 1);
         }
         if (bufferStatusPtr->flags.fatBufferNeedsWrite)
         {
@@ -3872,6 +4404,7 @@ int FILEIO_Format (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, FILEIO_
                 return false;
             }
             bufferStatusPtr->flags.fatBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate ((FILEIO_DRIVE *)bufferStatusPtr->driveOwner, bufferStatusPtr->fatBufferCachedSector, 1);
         }
     }
 #else
@@ -3888,6 +4421,7 @@ int FILEIO_Format (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, FILEIO_
                 return false;
             }
             bufferStatusPtr->flags.dataBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate (&gDriveArray[FILEIO_CONFIG_MAX_DRIVES - 1], bufferStatusPtr->dataBufferCachedSector, 1);
         }
         if (bufferStatusPtr->flags.fatBufferNeedsWrite)
         {
@@ -3896,6 +4430,7 @@ int FILEIO_Format (FILEIO_DRIVE_CONFIG * config, void * mediaParameters, FILEIO_
                 return false;
             }
             bufferStatusPtr->flags.fatBufferNeedsWrite = false;
+            FILEIO_CacheInvalidate (&gDriveArray[FILEIO_CONFIG_MAX_DRIVES - 1], bufferStatusPtr->fatBufferCachedSector, 1);
         }
     }
 
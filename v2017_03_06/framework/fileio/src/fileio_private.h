@@ -107,12 +107,34 @@ typedef struct
     uint8_t     mount;                      // Device mount flag (true if disk was mounted successfully, false otherwise)
     uint8_t     error;                      // Last error that occured for this drive
     char        driveId;
+#if !defined (FILEIO_CONFIG_WRITE_DISABLE)
+    uint32_t    freeClusterHint;            // Cluster at which the next search for a free cluster will start
+    uint32_t    fsInfoSector;               // Logical block address of the FAT32 FSInfo sector (0 if the drive doesn't have a valid one)
+    bool        fsInfoNeedsWrite;           // true if the free cluster information in the FSInfo sector is out of date
+    uint8_t     mountSectorReads;           // Sectors read at mount time to load the free cluster hint
+    uint32_t    clustersSearched;           // FAT entries read by free cluster searches since the drive was mounted
+#if defined (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE) && (FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE != 0)
+    uint32_t    clustersPerMapBit;          // The number of clusters described by each bit of fullClusterMap
+    uint8_t     fullClusterMap[FILEIO_CONFIG_FREE_CLUSTER_MAP_SIZE];     // A set bit marks a range of clusters that are all in use
+#endif
+#endif
 #if defined __XC32__ || defined __XC16__
 } __attribute__ ((packed)) FILEIO_DRIVE;
 #else
 } FILEIO_DRIVE;
 #endif
 
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+// Status of one entry of the shared sector cache
+typedef struct
+{
+    FILEIO_DRIVE * drive;               // Drive that owns the cached sector (NULL if the entry is unused)
+    uint32_t sector;                    // Logical block address of the cached sector
+    uint32_t lastUse;                   // Cache access count at the last use of this entry (for LRU replacement)
+    bool needsWrite;                    // true if the cached sector is newer than the copy on the media
+} FILEIO_SECTOR_CACHE_ENTRY;
+#endif
+
 typedef struct
 {
     uint32_t cluster;
@@ -265,11 +287,29 @@ typedef struct {
 #define  BSI_FATSZ32       36
 // A macro for the boot sector start cluster of root directory value offset
 #define  BSI_ROOTCLUS      44
+// A macro for the boot sector FSInfo sector number offset (FAT32)
+#define  BSI_FSINFO        48
 //  A macro for the FAT32 boot sector boot signature offset
 #define  BSI_FAT32_BOOTSIG 66
 // A macro for the FAT32 boot sector file system type string offset
 #define  BSI_FAT32_FSTYPE  82
 
+// A macro for the FSInfo sector lead signature offset
+#define FSI_LEADSIG         0
+// A macro for the FSInfo sector structure signature offset
+#define FSI_STRUCSIG        484
+// A macro for the FSInfo sector free cluster count offset
+#define FSI_FREE_COUNT      488
+// A macro for the FSInfo sector next free cluster offset
+#define FSI_NXT_FREE        492
+// A macro for the FSInfo sector trail signature offset
+#define FSI_TRAILSIG        508
+
+#define FILEIO_FSINFO_LEAD_SIGNATURE        0x41615252ul    // FSInfo lead signature value
+#define FILEIO_FSINFO_STRUCTURE_SIGNATURE   0x61417272ul    // FSInfo structure signature value
+#define FILEIO_FSINFO_TRAIL_SIGNATURE       0xAA550000ul    // FSInfo trail signature value
+#define FILEIO_FSINFO_UNKNOWN               0xFFFFFFFFul    // FSInfo value indicating the free count or next free cluster is unknown
+
 
 // Structure of a partition table entry
 typedef struct
@@ -346,6 +386,8 @@ FILEIO_ERROR_TYPE FILEIO_DirectoryEntryCreate (FILEIO_OBJECT * filePtr, uint16_t
 FILEIO_ERROR_TYPE FILEIO_ClusterAllocate (FILEIO_DRIVE * drive, uint32_t * cluster, bool eraseCluster);
 FILEIO_ERROR_TYPE FILEIO_EraseCluster (FILEIO_DRIVE * drive, uint32_t cluster);
 uint32_t FILEIO_FindEmptyCluster (FILEIO_DRIVE * drive, uint32_t baseCluster);
+void FILEIO_FreeClusterHintLoad (FILEIO_DRIVE * drive);
+FILEIO_ERROR_TYPE FILEIO_FreeClusterHintSave (FILEIO_DRIVE * drive);
 uint32_t FILEIO_CreateFirstCluster (FILEIO_OBJECT * filePtr);
 FILEIO_ERROR_TYPE FILEIO_FindShortFileName (FILEIO_DIRECTORY * directory, FILEIO_OBJECT * filePtr, uint8_t * fileName, uint32_t * currentCluster, uint16_t * currentClusterOffset, uint16_t entryOffset, uint16_t attributes, FILEIO_SEARCH_TYPE mode);
 FILEIO_ERROR_TYPE FILEIO_EraseFile (FILEIO_OBJECT * filePtr, uint16_t * entryHandle, bool eraseData);
@@ -358,4 +400,22 @@ bool FILEIO_IsClusterAllocated(FILEIO_DIRECTORY * directory, FILEIO_OBJECT * fil
 int FILEIO_GetSingleBuffer (FILEIO_DRIVE * drive);
 FILEIO_ERROR_TYPE FILEIO_ForceRecache (FILEIO_DRIVE * disk);
 
+#if defined (FILEIO_CONFIG_SECTOR_CACHE_SIZE) && (FILEIO_CONFIG_SECTOR_CACHE_SIZE != 0)
+FILEIO_SECTOR_CACHE_ENTRY * FILEIO_CacheEntryFind (FILEIO_DRIVE * drive, uint32_t sector);
+FILEIO_SECTOR_CACHE_ENTRY * FILEIO_CacheEntryAllocate (void);
+bool FILEIO_CacheEntryWriteBack (FILEIO_SECTOR_CACHE_ENTRY * entry);
+bool FILEIO_CacheSectorRead (FILEIO_DRIVE * drive, uint32_t sector, uint8_t * buffer);
+bool FILEIO_CacheSectorWrite (FILEIO_DRIVE * drive, uint32_t sector, uint8_t * buffer);
+bool FILEIO_CacheFlush (FILEIO_DRIVE * drive);
+void FILEIO_CacheInvalidate (FILEIO_DRIVE * drive, uint32_t firstSector, uint32_t sectorCount);
+void FILEIO_CacheMerge (FILEIO_DRIVE * drive, uint32_t firstSector, uint16_t sectorCount, uint8_t * buffer);
+#else
+// Without a sector cache, sector accesses go straight to the media driver
+#define FILEIO_CacheSectorRead(drive,sector,buffer)     ((*(drive)->driveConfig->funcSectorRead)((drive)->mediaParameters, (sector), (buffer)))
+#define FILEIO_CacheSectorWrite(drive,sector,buffer)    ((*(drive)->driveConfig->funcSectorWrite)((drive)->mediaParameters, (sector), (buffer), false))
+#define FILEIO_CacheFlush(drive)                        (true)
+#define FILEIO_CacheInvalidate(drive,firstSector,sectorCount)
+#define FILEIO_CacheMerge(drive,firstSector,sectorCount,buffer)
+#endif
+
 #endif
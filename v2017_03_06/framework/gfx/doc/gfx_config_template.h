@@ -742,6 +742,85 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE  /* DOM-IGNORE-BEGIN */ 51 /* DOM-IGNORE-END */
 
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+
+    Summary:
+        Macro enables the glyph cache for fonts sourced externally
+        and sets the number of glyphs it holds.
+        
+    Description:
+        When this macro is defined, the glyph metrics and bitmaps read
+        from external memory are kept in RAM. A character that is
+        rendered again with the same font is taken from the cache
+        instead of being read again through
+        GFX_ExternalResourceCallback(). When the cache is full, the
+        least recently used glyph is replaced. A glyph that
+        GFX_ExternalResourceCallback() fails to read is not cached.
+
+        Each glyph uses GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE bytes plus
+        about 16 bytes of RAM.
+
+        <code>
+            // keep the last 32 rendered glyphs in RAM
+            #define GFX_CONFIG_FONT_GLYPH_CACHE_SIZE 32
+        </code>
+
+        If the external memory holding the fonts is reprogrammed, the
+        application must call GFX_FontCacheFlush().
+        
+        This macro will have no effect when fonts that are sourced 
+        externally is not used.
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_GLYPH_CACHE_SIZE  /* DOM-IGNORE-BEGIN */ 32 /* DOM-IGNORE-END */
+
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_FONT_WIDTH_CACHE_SIZE
+
+    Summary:
+        Macro enables the width cache for fonts sourced externally
+        and sets the number of glyph widths it holds.
+        
+    Description:
+        When this macro is defined, GFX_TextStringWidthGet() keeps the
+        widths of the glyphs it reads from external memory in RAM, so
+        measuring the same strings again (for example to align labels
+        on every redraw) does not read the external memory. When the
+        cache is full, the least recently used width is replaced.
+
+        Each width uses about 8 bytes of RAM.
+
+        <code>
+            // keep the widths of 96 glyphs
+            #define GFX_CONFIG_FONT_WIDTH_CACHE_SIZE 96
+        </code>
+
+        If the external memory holding the fonts is reprogrammed, the
+        application must call GFX_FontCacheFlush().
+        
+        This macro will have no effect when fonts that are sourced 
+        externally is not used.
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_FONT_WIDTH_CACHE_SIZE  /* DOM-IGNORE-BEGIN */ 96 /* DOM-IGNORE-END */
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
@@ -953,6 +1032,54 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // *****************************************************************************
 #define GFX_free(pObj)      free(pObj)
 
+// *****************************************************************************
+/* 
+    <GROUP  configuring_options_graphics_library_doc>
+
+    Macro:
+        GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS
+
+    Summary:
+        Macro enables the spatial index of the Graphics Object Layer
+        and sets the number of columns of its grid.
+        
+    Description:
+        When this macro is defined, the screen is divided into a grid
+        of GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS by
+        GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS cells and each cell lists the
+        objects of the active list that overlap it. Touch screen
+        messages passed to GFX_GOL_ObjectMessage() and rectangles passed
+        to GFX_GOL_ObjectRectangleRedraw() are then checked only against
+        the objects in the cells they touch instead of every object in
+        the active list. This reduces the touch latency of screens with
+        many objects, such as keypads.
+
+        GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS defaults to the number of
+        columns. The cells are allocated with GFX_malloc(); each cell
+        an object overlaps uses 8 bytes on 32 bit devices and 4 bytes on
+        16 bit devices.
+
+        <code>
+            // 8 x 6 grid for a QVGA screen
+            #define GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS 8
+            #define GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS    6
+        </code>
+
+        Scroll bars and custom objects receive every touch message,
+        as they may respond to touches outside their bounds. Other
+        objects receive the messages at or next to their bounds, so a
+        button that is left pressed because the message callback
+        returned false for its release is not cancelled by a touch
+        elsewhere on the screen. After moving objects, call
+        GFX_GOL_SpatialIndexRebuild().
+        
+    Remarks:
+        None.
+        
+*/
+// *****************************************************************************
+#define GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS  /* DOM-IGNORE-BEGIN */ 8 /* DOM-IGNORE-END */
+
 // *****************************************************************************
 /* 
     <GROUP  configuring_options_graphics_library_doc>
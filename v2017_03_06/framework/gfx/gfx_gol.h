@@ -1435,6 +1435,60 @@ GFX_STATUS GFX_GOL_ObjectListSet(GFX_GOL_OBJ_HEADER *pList);
 // *****************************************************************************
 GFX_STATUS GFX_GOL_ObjectListFree(void);
 
+// *****************************************************************************
+/*  
+    <GROUP gol_objects_management>
+    
+    Function:
+        GFX_STATUS GFX_GOL_SpatialIndexRebuild(void)
+
+    Summary:
+        This function rebuilds the spatial index of the active list.
+
+    Description:
+        When GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS is defined, the objects
+        of the active list are indexed by a grid over the screen, so
+        GFX_GOL_ObjectMessage() and GFX_GOL_ObjectRectangleRedraw() only
+        visit the objects near the touch point or the rectangle instead
+        of the whole list.
+
+        The index is kept up to date by GFX_GOL_ObjectAdd(),
+        GFX_GOL_ObjectDelete(), GFX_GOL_ObjectListNew(),
+        GFX_GOL_ObjectListSet() and GFX_GOL_ObjectListFree(). The
+        application must call this function after it moves or resizes
+        an object, or after it links or unlinks objects in the active
+        list through the pNxtObj pointers.
+
+        If the memory for the index cannot be allocated with
+        GFX_malloc(), messages and redraw requests are handled by
+        walking the active list until the index is rebuilt or a new
+        list is started.
+
+        When GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS is not defined, this
+        function does nothing.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        GFX_STATUS_SUCCESS - the index was rebuilt.
+        GFX_STATUS_FAILURE - the index could not be allocated.
+
+    Example:
+       <code>
+            // move the button 10 pixels to the right
+            pButton->hdr.left  += 10;
+            pButton->hdr.right += 10;
+            GFX_GOL_SpatialIndexRebuild();
+       </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_GOL_SpatialIndexRebuild(void);
+
 // *****************************************************************************
 /*  
     <GROUP gol_objects_states>
@@ -725,7 +725,8 @@ GFX_GOL_TEXTENTRY_KEYMEMBER *GFX_GOL_TextEntryKeyListCreate(
         This function will delete the key member list assigned to
         the object from memory. Pointer to the key member list is
         then initialized to NULL. All memory resources allocated to
-        the key member list is freed.
+        the key member list is freed. The active key is cleared and
+        no key is left in the pressed state.
 
     Precondition:
         Object must exist in memory.
@@ -101,6 +101,8 @@ typedef enum
         6. Set alpha blending value to 100 (or no alpha blending) if
            alphe blending feature is enabled.
         7. Set background information to no background.
+        8. Set text background color feature to be disabled.
+        9. Empty the external font caches.
 
         This function does not clear the screen and does not assign
         any color to the currently set color. Application should
@@ -150,6 +152,8 @@ void GFX_Initialize(void);
         6. Set alpha blending value to 100 (or no alpha blending) if
            alphe blending feature is enabled.
         7. Set background information to no background.
+        8. Set text background color feature to be disabled.
+        9. Empty the external font caches.
 
         This function does not clear the screen and does not assign
         any color to the currently set color. Application should
@@ -1688,6 +1692,268 @@ GFX_STATUS GFX_FontAntiAliasSet(GFX_FONT_ANTIALIAS_TYPE type);
 // *****************************************************************************
 GFX_FONT_ANTIALIAS_TYPE GFX_FontAntiAliasGet(void);
 
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_STATUS GFX_TextBackgroundColorEnable(GFX_COLOR color)
+
+    Summary:
+        This function sets the background color of rendered characters
+        and enables the text background color feature.
+
+    Description:
+        This function sets the background color of rendered characters
+        and enables the text background color feature.
+
+        When enabled, every character rendered by GFX_TextCharDraw(),
+        GFX_TextStringDraw() and GFX_TextStringBoxDraw() fills its whole
+        character cell (glyph width by font height): pixels of the glyph
+        are rendered with the current color and the rest with the text
+        background color. Each line of the cell is sent to the display
+        as one GFX_PixelArrayPut() call, which is much faster than
+        clearing the area with GFX_BarDraw() and then rendering the
+        glyph pixels on displays with an external controller.
+        Anti-aliased fonts are blended with the text background color,
+        so the GFX_FONT_ANTIALIAS_TYPE setting has no effect and no
+        pixels are read from the frame buffer.
+
+        Fonts with glyphs that overlap the neighboring characters
+        (extended glyph entries with kerning) will have the overlapped
+        parts covered by the background of the next character.
+
+    Precondition:
+        None.
+
+    Parameters:
+        color - the color value used for the background of characters.
+
+    Returns:
+        The status of the text background color set action.
+
+    Example:
+        <code>
+            // assume Font25 is a valid font resource
+            GFX_XCHAR myString[] = "Microchip Technology Inc.";
+
+            GFX_FontSet((GFX_RESOURCE_HDR*) &Font25);
+            GFX_ColorSet(GFX_X11_WHITE);
+            GFX_TextBackgroundColorEnable(GFX_X11_NAVY);
+            GFX_TextStringDraw(10, 10, myString, 0);
+            GFX_TextBackgroundColorDisable();
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_TextBackgroundColorEnable(GFX_COLOR color);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_STATUS GFX_TextBackgroundColorDisable(void)
+
+    Summary:
+        This function disables the text background color feature.
+
+    Description:
+        This function disables the text background color feature.
+        Only the pixels of the glyphs are rendered when characters
+        are drawn. This is the default setting at initialization.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The status of the text background color disable action.
+
+    Example:
+        See GFX_TextBackgroundColorEnable() example.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_TextBackgroundColorDisable(void);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_COLOR GFX_TextBackgroundColorGet(void)
+
+    Summary:
+        This returns the current text background color.
+
+    Description:
+        This returns the color set by GFX_TextBackgroundColorEnable().
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The current text background color.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_COLOR GFX_TextBackgroundColorGet(void);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_FEATURE_STATUS GFX_TextBackgroundColorStatusGet(void)
+
+    Summary:
+        This returns the current state of the text background
+        color feature.
+
+    Description:
+        This returns the current state of the text background
+        color feature.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        GFX_FEATURE_ENABLED - characters are rendered with a background.
+        GFX_FEATURE_DISABLED - only the glyph pixels are rendered.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_FEATURE_STATUS GFX_TextBackgroundColorStatusGet(void);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_STATUS GFX_FontCacheFlush(void)
+
+    Summary:
+        This function empties the caches of fonts sourced externally.
+
+    Description:
+        This function empties the glyph cache and the width cache
+        (see GFX_CONFIG_FONT_GLYPH_CACHE_SIZE and
+        GFX_CONFIG_FONT_WIDTH_CACHE_SIZE) so that the next characters
+        rendered or measured are read again from external memory.
+        The application must call this function when the external
+        memory holding the fonts is reprogrammed. The caches are also
+        emptied by GFX_Initialize().
+
+        The hit and miss counters are not changed.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The status of the flush action.
+
+    Example:
+        <code>
+            // fonts in the external flash were updated
+            GFX_FontCacheFlush();
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheFlush(void);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_STATUS GFX_FontCacheStatisticsGet(
+                                GFX_FONT_CACHE_STATISTICS *pStatistics)
+
+    Summary:
+        This function returns the hit and miss counters of the caches
+        of fonts sourced externally.
+
+    Description:
+        This function copies the hit and miss counters of the glyph
+        cache and the width cache to the given structure. The counters
+        run from power up or the last call to
+        GFX_FontCacheStatisticsClear(). Every miss is a read of the
+        external memory.
+
+    Precondition:
+        None.
+
+    Parameters:
+        pStatistics - pointer to the structure that receives the counters.
+
+    Returns:
+        The status of the action.
+
+    Example:
+        <code>
+            GFX_FONT_CACHE_STATISTICS stats;
+            uint32_t hitRate;
+
+            GFX_FontCacheStatisticsGet(&stats);
+            if ((stats.glyphHits + stats.glyphMisses) > 0)
+                hitRate = (stats.glyphHits * 100) / (stats.glyphHits + stats.glyphMisses);
+        </code>
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheStatisticsGet(
+                                GFX_FONT_CACHE_STATISTICS *pStatistics);
+
+// *****************************************************************************
+/*  
+    <GROUP text_functions>
+
+    Function:
+        GFX_STATUS GFX_FontCacheStatisticsClear(void)
+
+    Summary:
+        This function clears the hit and miss counters of the caches
+        of fonts sourced externally.
+
+    Description:
+        This function clears the hit and miss counters of the glyph
+        cache and the width cache.
+
+    Precondition:
+        None.
+
+    Parameters:
+        None.
+
+    Returns:
+        The status of the action.
+
+    Example:
+        None.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheStatisticsClear(void);
+
 // *****************************************************************************
 /*  
     <GROUP style_functions>
@@ -4043,6 +4309,16 @@ GFX_FEATURE_STATUS GFX_DoubleBufferSynchronizeStatusGet(void);
         GFX_DoubleBufferSynchronizeRequest() or immediately performed
         using GFX_DoubleBufferSynchronize().
 
+        An area is merged with an area already in the list when their
+        bounding rectangle has no more pixels than the sum of the sizes
+        of the two areas. When the areas overlap, the merged area may
+        include pixels that neither area covers. Areas inside an area
+        already in the list are dropped. When GFX_MAX_INVALIDATE_AREAS
+        areas are listed, the two areas whose bounding rectangle adds
+        the fewest pixels are merged instead of synchronizing the whole
+        screen. The whole screen is synchronized only when a merged
+        area covers it.
+
     Precondition:
         Double buffering feature must be enabled.
 
@@ -4319,7 +4595,9 @@ GFX_FEATURE_STATUS GFX_DoubleBufferSyncAllStatusGet(void);
 
     Parameters:
         index - the index of the rectangular area located in the array of
-                areas that needs synchronization.
+                areas that needs synchronization. The first area has
+                index 1 and the last has index
+                GFX_DoubleBufferSyncAreaCountGet().
 
     Returns:
         The location of the rectangular area specified by the
@@ -286,5 +286,35 @@ typedef struct
 
 // DOM-IGNORE-END
 
+// *****************************************************************************
+/*
+    <GROUP primitive_types>
+
+    Typedef:
+        GFX_FONT_CACHE_STATISTICS
+
+    Summary:
+        Specifies the hit and miss counters of the external font caches.
+
+    Description:
+        Specifies the hit and miss counters of the glyph cache
+        (GFX_CONFIG_FONT_GLYPH_CACHE_SIZE) and the width cache
+        (GFX_CONFIG_FONT_WIDTH_CACHE_SIZE) used with fonts sourced
+        from external memory. Every miss is a read of the external
+        memory through GFX_ExternalResourceCallback().
+
+    Remarks:
+        The counters of a cache that is not enabled stay at zero.
+
+*/
+// *****************************************************************************
+typedef struct
+{
+    uint32_t    glyphHits;                  // Glyphs rendered from the glyph cache.
+    uint32_t    glyphMisses;                // Glyphs read from external memory for rendering.
+    uint32_t    widthHits;                  // Glyph widths found in the width cache.
+    uint32_t    widthMisses;                // Glyph widths read from external memory.
+} GFX_FONT_CACHE_STATISTICS;
+
 #endif // GFX_TYPES_FONT_H
 
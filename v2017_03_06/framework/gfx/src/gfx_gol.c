@@ -65,8 +65,61 @@ static GFX_GOL_OBJ_HEADER               *pGfxObjectFocused = NULL;
 // Variables for panel drawing. Used by GFX_GOL_PanelDraw
 static GOL_PANEL_PARAM                  GfxPanel;
 
+// The spatial index divides the screen into a grid of cells. Each cell
+// lists the objects of the active list that overlap it, in list order,
+// so touch messages and redraw requests only visit the objects near the
+// touch point or rectangle. The extra cell after the grid lists the
+// objects that may respond to touch outside their bounds.
+#ifdef GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS
+    #define GFX_GOL_SPATIAL_INDEX_ENABLE
+    #ifndef GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS
+        #define GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS
+    #endif
+#endif
+
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    #define GFX_GOL_SPATIAL_INDEX_CELLS     (GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS * GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+    #define GFX_GOL_SPATIAL_INDEX_UNBOUNDED (GFX_GOL_SPATIAL_INDEX_CELLS)
+    #define GFX_GOL_SPATIAL_INDEX_CELL_WIDTH                                \
+                ((GFX_MaxXGet() + GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS) / GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+    #define GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT                               \
+                ((GFX_MaxYGet() + GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS) / GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+
+    typedef struct
+    {
+        GFX_GOL_OBJ_HEADER  *pObject;               // object overlapping the cell
+        uint16_t            order;                  // position of the object in the active list
+    } GFX_GOL_SPATIAL_INDEX_ENTRY;
+
+    typedef struct
+    {
+        GFX_GOL_SPATIAL_INDEX_ENTRY *pEntries;      // entries in increasing order
+        uint16_t            count;                  // number of entries used
+        uint16_t            size;                   // number of entries allocated
+    } GFX_GOL_SPATIAL_INDEX_CELL;
+
+    static GFX_GOL_SPATIAL_INDEX_CELL   gfxGolSpatialIndex[GFX_GOL_SPATIAL_INDEX_CELLS + 1];
+    static uint16_t                     gfxGolSpatialIndexOrder;        // order given to the next object added
+    static uint16_t                     gfxGolSpatialIndexGeneration;   // changes when the index is cleared
+    static bool                         gfxGolSpatialIndexFailed;       // set when memory ran out, the list is walked instead
+    static int16_t                      gfxGolTouchPreviousX = -1;      // position of the last touch message
+    static int16_t                      gfxGolTouchPreviousY = -1;
+#endif
+
 /////////////////////// LOCAL FUNCTIONS PROTOTYPES ////////////////////////////
 bool GFX_GOL_DefaultObjectDrawCallback(void);
+static void GFX_GOL_ObjectMessageSend(
+                                GFX_GOL_OBJ_HEADER *pObject,
+                                GFX_GOL_MESSAGE *pMsg);
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+static void GFX_GOL_SpatialIndexClear(void);
+static void GFX_GOL_SpatialIndexObjectInsert(GFX_GOL_OBJ_HEADER *pObject);
+static void GFX_GOL_SpatialIndexObjectRemove(GFX_GOL_OBJ_HEADER *pObject);
+static void GFX_GOL_SpatialIndexMessageSend(
+                                GFX_GOL_MESSAGE *pMsg,
+                                int16_t previousX,
+                                int16_t previousY);
+#endif
 
 
 // *****************************************************************************
@@ -465,6 +518,14 @@ void GFX_GOL_ObjectAdd(GFX_GOL_OBJ_HEADER *pObject)
     }
 
     pObject->pNxtObj = NULL;
+
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    // renumber the list when the order of the new object would wrap
+    if(gfxGolSpatialIndexOrder == 0xFFFF)
+        GFX_GOL_SpatialIndexRebuild();
+    else
+        GFX_GOL_SpatialIndexObjectInsert(pObject);
+#endif
 }
 
 // *****************************************************************************
@@ -515,6 +576,10 @@ GFX_STATUS GFX_GOL_ObjectDelete(GFX_GOL_OBJ_HEADER *pObject)
         prev->pNxtObj = curr->pNxtObj;
     }
 
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    GFX_GOL_SpatialIndexObjectRemove(pObject);
+#endif
+
     if(pObject->FreeObj)
         pObject->FreeObj(pObject);
 
@@ -584,6 +649,9 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_GOL_ObjectListNew(void)
 {
     pGfxGolObjectList    = NULL;
     pGfxObjectFocused = NULL;
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    GFX_GOL_SpatialIndexClear();
+#endif
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -630,6 +698,9 @@ GFX_STATUS __attribute__ ((always_inline)) GFX_GOL_ObjectListSet(
 {
     pGfxGolObjectList    = pList;
     pGfxObjectFocused = NULL;
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    GFX_GOL_SpatialIndexRebuild();
+#endif
     return (GFX_STATUS_SUCCESS);
 }
 
@@ -816,33 +887,65 @@ void GFX_GOL_ObjectRectangleRedraw(
 {
 
     GFX_GOL_OBJ_HEADER  *pCurrentObj;
-    int                 overlapX, overlapY;
+
+#ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
+    // the whole rectangle is damaged, including parts not covered
+    // by any object that the application may have redrawn.
+    GFX_DoubleBufferAreaMark(left, top, right, bottom);
+#endif
+
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    if(gfxGolSpatialIndexFailed == false)
+    {
+        GFX_GOL_SPATIAL_INDEX_CELL  *pCell;
+        uint16_t                    column, row, first, last, bottomRow, i;
+
+        // only the objects listed in the cells touched by the
+        // rectangle can overlap it
+        first = left / GFX_GOL_SPATIAL_INDEX_CELL_WIDTH;
+        if(first >= GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+            first = GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS - 1;
+        last = right / GFX_GOL_SPATIAL_INDEX_CELL_WIDTH;
+        if(last >= GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+            last = GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS - 1;
+        row = top / GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT;
+        if(row >= GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+            row = GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS - 1;
+        bottomRow = bottom / GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT;
+        if(bottomRow >= GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+            bottomRow = GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS - 1;
+
+        for(; row <= bottomRow; row++)
+        {
+            for(column = first; column <= last; column++)
+            {
+                pCell = &gfxGolSpatialIndex[(row * GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS) + column];
+
+                for(i = 0; i < pCell->count; i++)
+                {
+                    pCurrentObj = pCell->pEntries[i].pObject;
+
+                    if ((pCurrentObj->left <= right) && (pCurrentObj->right  >= left) &&
+                        (pCurrentObj->top  <= bottom) && (pCurrentObj->bottom >= top))
+                    {
+                        GFX_GOL_ObjectDrawEnable(pCurrentObj);
+                    }
+                }
+            }
+        }
+        return;
+    }
+#endif
 
     pCurrentObj = pGfxGolObjectList;
 
     while(pCurrentObj != NULL)
     {
-        overlapX = overlapY = 0;
-
-        // check overlaps in x direction
-        if (((pCurrentObj->left <= left)  && (pCurrentObj->right >= left))  ||   \
-            ((pCurrentObj->left <= right) && (pCurrentObj->right >= right)) ||   \
-            ((pCurrentObj->left <= left)  && (pCurrentObj->right >= right)) ||   \
-            ((pCurrentObj->left >= left)  && (pCurrentObj->right <= right))      \
-          )
-            overlapX = 1;
-
-        // check overlaps in y direction
-        if (((pCurrentObj->top <= top)    && (pCurrentObj->bottom >= top))    ||   \
-            ((pCurrentObj->top <= bottom) && (pCurrentObj->bottom >= bottom)) ||   \
-            ((pCurrentObj->top <= top)    && (pCurrentObj->bottom >= bottom)) ||   \
-            ((pCurrentObj->top >= top)    && (pCurrentObj->bottom <= bottom))      \
-          )
-            overlapY = 1;
-
         // When any portion of the widget is touched by the defined
-        // rectangle the x and y overlaps will exist.
-        if (overlapX & overlapY) {
+        // rectangle the widget spans overlap in both directions.
+        if ((pCurrentObj->left <= right) && (pCurrentObj->right  >= left) &&
+            (pCurrentObj->top  <= bottom) && (pCurrentObj->bottom >= top))
+        {
             GFX_GOL_ObjectDrawEnable(pCurrentObj);
         }
 
@@ -974,35 +1077,503 @@ bool __attribute__ ((always_inline)) GFX_GOL_ObjectIsRedrawSet(
 void GFX_GOL_ObjectMessage(GFX_GOL_MESSAGE *pMsg)
 {
     GFX_GOL_OBJ_HEADER        *pCurrentObj;
-    GFX_GOL_TRANSLATED_ACTION  translatedMsg;
 
     if(pMsg->uiEvent == EVENT_INVALID)
         return;
 
+#if defined (GFX_GOL_SPATIAL_INDEX_ENABLE) && !defined (GFX_CONFIG_USE_TOUCHSCREEN_DISABLE)
+    if(pMsg->type == TYPE_TOUCHSCREEN)
+    {
+        int16_t     previousX, previousY;
+
+        previousX = gfxGolTouchPreviousX;
+        previousY = gfxGolTouchPreviousY;
+        gfxGolTouchPreviousX = pMsg->param1;
+        gfxGolTouchPreviousY = pMsg->param2;
+
+        if(gfxGolSpatialIndexFailed == false)
+        {
+            GFX_GOL_SpatialIndexMessageSend(pMsg, previousX, previousY);
+            return;
+        }
+    }
+#endif
+
     pCurrentObj = pGfxGolObjectList;
 
     while(pCurrentObj != NULL)
     {
-        if(pCurrentObj->actionGet)
+        GFX_GOL_ObjectMessageSend(pCurrentObj, pMsg);
+        pCurrentObj = (GFX_GOL_OBJ_HEADER *)pCurrentObj->pNxtObj;
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    static void GFX_GOL_ObjectMessageSend(
+                                GFX_GOL_OBJ_HEADER *pObject,
+                                GFX_GOL_MESSAGE *pMsg)
+
+    Summary:
+        This function passes a message to one object.
+
+    Description:
+        This function translates the message with the action get
+        function of the object. When the message is a valid action for
+        the object, the message callback is called and, if it returns
+        true, the default action of the object is performed.
+
+*/
+// *****************************************************************************
+static void GFX_GOL_ObjectMessageSend(
+                                GFX_GOL_OBJ_HEADER *pObject,
+                                GFX_GOL_MESSAGE *pMsg)
+{
+    GFX_GOL_TRANSLATED_ACTION  translatedMsg;
+
+    if(pObject->actionGet)
+    {
+        translatedMsg = pObject->actionGet(pObject, pMsg);
+
+        if(translatedMsg != GFX_GOL_OBJECT_ACTION_INVALID)
         {
-            translatedMsg = pCurrentObj->actionGet(pCurrentObj, pMsg);
 
-            if(translatedMsg != GFX_GOL_OBJECT_ACTION_INVALID)
+            // if callback function exists call the callback
+            if(pGfxGOLMessageCallbackFunction != NULL)
             {
-
-                // if callback function exists call the callback
-                if(pGfxGOLMessageCallbackFunction != NULL)
-                {
-                    if(pGfxGOLMessageCallbackFunction(translatedMsg, pCurrentObj, pMsg) == true)
-                        if(pCurrentObj->actionSet)
-                            pCurrentObj->actionSet(translatedMsg, pCurrentObj, pMsg);
-                }
+                if(pGfxGOLMessageCallbackFunction(translatedMsg, pObject, pMsg) == true)
+                    if(pObject->actionSet)
+                        pObject->actionSet(translatedMsg, pObject, pMsg);
             }
         }
+    }
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_GOL_SpatialIndexRebuild(void)
+
+    Summary:
+        This function rebuilds the spatial index of the active list.
+
+    Description:
+        This function rebuilds the spatial index from the objects in the
+        active list and their current positions. The index is kept up to
+        date by GFX_GOL_ObjectAdd(), GFX_GOL_ObjectDelete(),
+        GFX_GOL_ObjectListNew() and GFX_GOL_ObjectListSet(). Call this
+        function after moving or resizing objects or after linking
+        objects into the active list directly.
+
+        When memory for the index cannot be allocated, the function
+        returns GFX_STATUS_FAILURE and messages and redraw requests are
+        handled by walking the active list until the next rebuild.
+
+        When GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS is not defined the
+        function does nothing.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_GOL_SpatialIndexRebuild(void)
+{
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+    GFX_GOL_OBJ_HEADER  *pCurrentObj;
+
+    GFX_GOL_SpatialIndexClear();
+
+    pCurrentObj = pGfxGolObjectList;
+    while(pCurrentObj != NULL)
+    {
+        if(gfxGolSpatialIndexOrder == 0xFFFF)
+            gfxGolSpatialIndexFailed = true;
 
+        GFX_GOL_SpatialIndexObjectInsert(pCurrentObj);
         pCurrentObj = (GFX_GOL_OBJ_HEADER *)pCurrentObj->pNxtObj;
     }
+
+    if(gfxGolSpatialIndexFailed == true)
+        return (GFX_STATUS_FAILURE);
+#endif
+    return (GFX_STATUS_SUCCESS);
+}
+
+#ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
+/*********************************************************************
+* Function: static void GFX_GOL_SpatialIndexClear(void)
+*
+* PreCondition: none
+*
+* Input: none
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Empties all the cells of the spatial index. The memory
+*           allocated to the cells is kept for the next list.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static void GFX_GOL_SpatialIndexClear(void)
+{
+    uint16_t i;
+
+    for(i = 0; i <= GFX_GOL_SPATIAL_INDEX_CELLS; i++)
+        gfxGolSpatialIndex[i].count = 0;
+
+    gfxGolSpatialIndexOrder = 0;
+    gfxGolSpatialIndexFailed = false;
+    gfxGolSpatialIndexGeneration++;
+}
+
+/*********************************************************************
+* Function: static bool GFX_GOL_SpatialIndexCellAdd(
+*                               GFX_GOL_SPATIAL_INDEX_CELL *pCell,
+*                               GFX_GOL_OBJ_HEADER *pObject,
+*                               uint16_t order)
+*
+* PreCondition: order is higher than the order of all objects in
+*               the cell
+*
+* Input: pCell - the cell
+*        pObject - the object to add
+*        order - position of the object in the active list
+*
+* Output: false if the cell could not be enlarged
+*
+* Side Effects: none
+*
+* Overview: Appends an object to a cell. The entries of the cell are
+*           doubled with GFX_malloc() when the cell is full.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static bool GFX_GOL_SpatialIndexCellAdd(
+                                GFX_GOL_SPATIAL_INDEX_CELL *pCell,
+                                GFX_GOL_OBJ_HEADER *pObject,
+                                uint16_t order)
+{
+    GFX_GOL_SPATIAL_INDEX_ENTRY *pEntries;
+    uint16_t                    size;
+
+    if(pCell->count == pCell->size)
+    {
+        size = (pCell->size == 0) ? 4 : (pCell->size << 1);
+        pEntries = (GFX_GOL_SPATIAL_INDEX_ENTRY *)GFX_malloc(size * sizeof(GFX_GOL_SPATIAL_INDEX_ENTRY));
+        if(pEntries == NULL)
+            return (false);
+
+        if(pCell->pEntries != NULL)
+        {
+            memcpy(pEntries, pCell->pEntries, pCell->count * sizeof(GFX_GOL_SPATIAL_INDEX_ENTRY));
+            GFX_free(pCell->pEntries);
+        }
+        pCell->pEntries = pEntries;
+        pCell->size = size;
+    }
+
+    pCell->pEntries[pCell->count].pObject = pObject;
+    pCell->pEntries[pCell->count].order = order;
+    pCell->count++;
+    return (true);
+}
+
+/*********************************************************************
+* Function: static bool GFX_GOL_SpatialIndexTouchIsBounded(
+*                               GFX_GOL_OBJ_TYPE type)
+*
+* PreCondition: none
+*
+* Input: type - the object type
+*
+* Output: true if objects of the type only respond to touch inside
+*         their bounds or to the first touch that leaves them.
+*
+* Side Effects: none
+*
+* Overview: The scroll bar reports every release on the screen, and
+*           the behavior of custom objects is not known, so these
+*           receive every touch message.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static bool GFX_GOL_SpatialIndexTouchIsBounded(GFX_GOL_OBJ_TYPE type)
+{
+    switch(type)
+    {
+        case GFX_GOL_BUTTON_TYPE:
+        case GFX_GOL_CHECKBOX_TYPE:
+        case GFX_GOL_DIGITALMETER_TYPE:
+        case GFX_GOL_EDITBOX_TYPE:
+        case GFX_GOL_GROUPBOX_TYPE:
+        case GFX_GOL_LISTBOX_TYPE:
+        case GFX_GOL_METER_TYPE:
+        case GFX_GOL_PICTURECONTROL_TYPE:
+        case GFX_GOL_PROGRESSBAR_TYPE:
+        case GFX_GOL_RADIOBUTTON_TYPE:
+        case GFX_GOL_STATICTEXT_TYPE:
+        case GFX_GOL_TEXTENTRY_TYPE:
+        case GFX_GOL_WINDOW_TYPE:
+            return (true);
+        default:
+            return (false);
+    }
+}
+
+/*********************************************************************
+* Function: static GFX_GOL_SPATIAL_INDEX_CELL *GFX_GOL_SpatialIndexCellGet(
+*                               int16_t x,
+*                               int16_t y)
+*
+* PreCondition: none
+*
+* Input: x, y - position on the screen
+*
+* Output: the cell containing the position. Positions outside of the
+*         screen give the nearest cell.
+*
+* Side Effects: none
+*
+* Overview: Returns the cell of a touch position.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static GFX_GOL_SPATIAL_INDEX_CELL *GFX_GOL_SpatialIndexCellGet(
+                                int16_t x,
+                                int16_t y)
+{
+    uint16_t column, row;
+
+    column = (x < 0) ? 0 : ((uint16_t)x / GFX_GOL_SPATIAL_INDEX_CELL_WIDTH);
+    if(column >= GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+        column = GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS - 1;
+    row = (y < 0) ? 0 : ((uint16_t)y / GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT);
+    if(row >= GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+        row = GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS - 1;
+
+    return (&gfxGolSpatialIndex[(row * GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS) + column]);
+}
+
+/*********************************************************************
+* Function: static void GFX_GOL_SpatialIndexObjectInsert(
+*                               GFX_GOL_OBJ_HEADER *pObject)
+*
+* PreCondition: pObject is the last object of the active list
+*
+* Input: pObject - the object
+*
+* Output: none
+*
+* Side Effects: sets gfxGolSpatialIndexFailed if memory runs out
+*
+* Overview: Adds the object to every cell its bounds overlap.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static void GFX_GOL_SpatialIndexObjectInsert(GFX_GOL_OBJ_HEADER *pObject)
+{
+    uint16_t    column, row, first, last, bottomRow, order;
+
+    if(gfxGolSpatialIndexFailed == true)
+        return;
+
+    order = gfxGolSpatialIndexOrder++;
+
+    // objects past the edge of the screen go to the edge cells, where
+    // touch positions outside of the screen are also looked up
+    first = pObject->left / GFX_GOL_SPATIAL_INDEX_CELL_WIDTH;
+    if(first >= GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+        first = GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS - 1;
+    last  = pObject->right / GFX_GOL_SPATIAL_INDEX_CELL_WIDTH;
+    if(last >= GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS)
+        last = GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS - 1;
+    row       = pObject->top / GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT;
+    if(row >= GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+        row = GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS - 1;
+    bottomRow = pObject->bottom / GFX_GOL_SPATIAL_INDEX_CELL_HEIGHT;
+    if(bottomRow >= GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS)
+        bottomRow = GFX_CONFIG_GOL_SPATIAL_INDEX_ROWS - 1;
+
+    for(; row <= bottomRow; row++)
+    {
+        for(column = first; column <= last; column++)
+        {
+            if(GFX_GOL_SpatialIndexCellAdd(
+                    &gfxGolSpatialIndex[(row * GFX_CONFIG_GOL_SPATIAL_INDEX_COLUMNS) + column],
+                    pObject,
+                    order) == false)
+            {
+                gfxGolSpatialIndexFailed = true;
+                return;
+            }
+        }
+    }
+
+    if(GFX_GOL_SpatialIndexTouchIsBounded(pObject->type) == false)
+    {
+        if(GFX_GOL_SpatialIndexCellAdd(
+                &gfxGolSpatialIndex[GFX_GOL_SPATIAL_INDEX_UNBOUNDED],
+                pObject,
+                order) == false)
+        {
+            gfxGolSpatialIndexFailed = true;
+        }
+    }
+}
+
+/*********************************************************************
+* Function: static void GFX_GOL_SpatialIndexObjectRemove(
+*                               GFX_GOL_OBJ_HEADER *pObject)
+*
+* PreCondition: none
+*
+* Input: pObject - the object
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Removes the object from all cells. All cells are searched
+*           since the object may have moved after it was added.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static void GFX_GOL_SpatialIndexObjectRemove(GFX_GOL_OBJ_HEADER *pObject)
+{
+    GFX_GOL_SPATIAL_INDEX_CELL  *pCell;
+    uint16_t                    i;
+
+    if(gfxGolSpatialIndexFailed == true)
+        return;
+
+    for(pCell = gfxGolSpatialIndex; pCell <= &gfxGolSpatialIndex[GFX_GOL_SPATIAL_INDEX_CELLS]; pCell++)
+    {
+        for(i = 0; i < pCell->count; i++)
+        {
+            if(pCell->pEntries[i].pObject == pObject)
+            {
+                pCell->count--;
+                memmove(&pCell->pEntries[i],
+                        &pCell->pEntries[i + 1],
+                        (pCell->count - i) * sizeof(GFX_GOL_SPATIAL_INDEX_ENTRY));
+                break;
+            }
+        }
+    }
+}
+
+/*********************************************************************
+* Function: static GFX_GOL_SPATIAL_INDEX_ENTRY *GFX_GOL_SpatialIndexEntryFind(
+*                               GFX_GOL_SPATIAL_INDEX_CELL *pCell,
+*                               uint16_t order)
+*
+* PreCondition: none
+*
+* Input: pCell - the cell
+*        order - lowest order to find
+*
+* Output: the first entry with an order of at least order, NULL if
+*         there is none
+*
+* Side Effects: none
+*
+* Overview: Binary search of the entries of a cell.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static GFX_GOL_SPATIAL_INDEX_ENTRY *GFX_GOL_SpatialIndexEntryFind(
+                                GFX_GOL_SPATIAL_INDEX_CELL *pCell,
+                                uint16_t order)
+{
+    uint16_t low, high, middle;
+
+    low = 0;
+    high = pCell->count;
+    while(low < high)
+    {
+        middle = (low + high) >> 1;
+        if(pCell->pEntries[middle].order < order)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return ((low < pCell->count) ? &pCell->pEntries[low] : NULL);
+}
+
+/*********************************************************************
+* Function: static void GFX_GOL_SpatialIndexMessageSend(
+*                               GFX_GOL_MESSAGE *pMsg,
+*                               int16_t previousX,
+*                               int16_t previousY)
+*
+* PreCondition: pMsg is a touch screen message
+*
+* Input: pMsg - the message
+*        previousX, previousY - position of the previous touch message
+*
+* Output: none
+*
+* Side Effects: none
+*
+* Overview: Passes a touch message, in list order, to the objects in
+*           the cell of the touch, the objects in the cell of the
+*           previous touch (so an object that the touch has just left
+*           sees it leave) and the objects that respond to touch
+*           outside their bounds. Objects added by the message
+*           callback also receive the message, as they would at the
+*           end of the list. When the callback replaces the active
+*           list the remaining objects are skipped.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static void GFX_GOL_SpatialIndexMessageSend(
+                                GFX_GOL_MESSAGE *pMsg,
+                                int16_t previousX,
+                                int16_t previousY)
+{
+    GFX_GOL_SPATIAL_INDEX_CELL  *pCells[3];
+    GFX_GOL_SPATIAL_INDEX_ENTRY *pEntry, *pNext;
+    uint16_t                    order, generation, i;
+
+    pCells[0] = GFX_GOL_SpatialIndexCellGet(pMsg->param1, pMsg->param2);
+    pCells[1] = GFX_GOL_SpatialIndexCellGet(previousX, previousY);
+    pCells[2] = &gfxGolSpatialIndex[GFX_GOL_SPATIAL_INDEX_UNBOUNDED];
+
+    generation = gfxGolSpatialIndexGeneration;
+    order = 0;
+
+    while(1)
+    {
+        // the next object in list order is the lowest order
+        // not yet visited in any of the cells. The cells are searched
+        // again each time since the callback may add or delete objects.
+        pNext = NULL;
+        for(i = 0; i < 3; i++)
+        {
+            pEntry = GFX_GOL_SpatialIndexEntryFind(pCells[i], order);
+            if((pEntry != NULL) && ((pNext == NULL) || (pEntry->order < pNext->order)))
+                pNext = pEntry;
+        }
+
+        if(pNext == NULL)
+            break;
+
+        order = pNext->order + 1;
+        GFX_GOL_ObjectMessageSend(pNext->pObject, pMsg);
+
+        if((generation != gfxGolSpatialIndexGeneration) || (gfxGolSpatialIndexFailed == true))
+            break;
+    }
 }
+#endif // #ifdef GFX_GOL_SPATIAL_INDEX_ENABLE
 
 // *****************************************************************************
 /*  Function:
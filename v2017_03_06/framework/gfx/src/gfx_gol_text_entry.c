@@ -578,7 +578,8 @@ GFX_GOL_TEXTENTRY_KEYMEMBER *GFX_GOL_TextEntryKeyListCreate(
         This function will delete the key member list assigned to
         the object from memory. Pointer to the key member list is
         then initialized to NULL. All memory resources allocated to
-        the key member list is freed.
+        the key member list is freed. The active key is cleared and
+        no key is left in the pressed state.
 
     Precondition:
         Object must exist in memory.
@@ -610,7 +611,10 @@ void GFX_GOL_TextEntryKeyMemberListDelete(void *pObject)
         GFX_free(pItem);
     }
 
+    // the active key went with the list
     pTe->pHeadOfList = NULL;
+    pTe->pActiveKey = NULL;
+    GFX_GOL_ObjectStateClear(pTe, GFX_GOL_TEXTENTRY_KEY_PRESSED_STATE);
 }
 
 // *****************************************************************************
@@ -1188,6 +1192,7 @@ GFX_STATUS GFX_GOL_TextEntryDraw(void *pObject)
                                     pTe,
                                     GFX_GOL_TEXTENTRY_DRAW_STATE) !=
                         GFX_GOL_TEXTENTRY_DRAW_STATE) &&
+                   (pTe->pActiveKey != NULL) &&
                    (pTe->pActiveKey->update == true))
                 {
                     CountOfKeys = (pTe->horizontalKeys * pTe->verticalKeys) - 1;
@@ -114,6 +114,9 @@ typedef union
     static GFX_COLOR            gfxColorTransparent;        // transparent color
     static GFX_FEATURE_STATUS   gfxColorTransparentFlag;    // transparent color feature flag
 
+    static GFX_COLOR            gfxTextBackgroundColor;     // text background color
+    static GFX_FEATURE_STATUS   gfxTextBackgroundFlag;      // text background color feature flag
+
     static GFX_RESOURCE_HDR     *pGfxCurrentFont;           // current active font
     static int16_t              gfxTextPositionX;           // used only internally to locate where the character will be rendered in the x coordinate
     static int16_t              gfxTextPositionY;           // used only internally to locate where the character will be rendered in the y coordinate
@@ -160,6 +163,52 @@ typedef union
     static uint16_t             gfxTextClipRight;           // used internally to define the right limit for text rendering
     static uint16_t             gfxTextClipBottom;          // used internally to define the bottom limit for text rendering
 
+    // The glyph and width caches keep what was read from external
+    // memory for fonts sourced externally. Entries are replaced in least
+    // recently used order: each cache has a clock that is incremented on
+    // every access and copied to the lastUse field of the entry used.
+#ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
+#ifdef GFX_CONFIG_FONT_GLYPH_CACHE_SIZE
+    #define GFX_FONT_GLYPH_CACHE_ENABLE
+#endif
+#ifdef GFX_CONFIG_FONT_WIDTH_CACHE_SIZE
+    #define GFX_FONT_WIDTH_CACHE_ENABLE
+#endif
+#endif
+
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    typedef struct
+    {
+        GFX_RESOURCE_HDR    *pFont;                 // font of the glyph, NULL when the entry is free
+        GFX_XCHAR           ch;                     // character code of the glyph
+        uint16_t            lastUse;                // cache clock value when the entry was last used
+        int16_t             chGlyphWidth;           // see GFX_FONT_OUTCHAR
+        int16_t             xAdjust;
+        int16_t             yAdjust;
+        int16_t             xWidthAdjust;
+        int16_t             heightOvershoot;
+        uint8_t             chImage[GFX_EXTERNAL_FONT_RASTER_BUFFER_SIZE];
+    } GFX_FONT_GLYPH_CACHE_ENTRY;
+
+    static GFX_FONT_GLYPH_CACHE_ENTRY gfxFontGlyphCache[GFX_CONFIG_FONT_GLYPH_CACHE_SIZE];
+    static uint16_t             gfxFontGlyphCacheClock;
+#endif
+
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+    typedef struct
+    {
+        GFX_RESOURCE_HDR    *pFont;                 // font of the glyph, NULL when the entry is free
+        GFX_XCHAR           ch;                     // character code of the glyph
+        uint16_t            lastUse;                // cache clock value when the entry was last used
+        uint16_t            width;                  // cursor advance of the glyph
+    } GFX_FONT_WIDTH_CACHE_ENTRY;
+
+    static GFX_FONT_WIDTH_CACHE_ENTRY gfxFontWidthCache[GFX_CONFIG_FONT_WIDTH_CACHE_SIZE];
+    static uint16_t             gfxFontWidthCacheClock;
+#endif
+
+    static GFX_FONT_CACHE_STATISTICS gfxFontCacheStatistics;   // hit and miss counters of the font caches
+
 #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
     // double buffering feature variable
     GFX_DOUBLE_BUFFERING_MODE   gfxDoubleBufferParam;
@@ -499,6 +548,88 @@ inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_TransparentColorSt
     return (gfxColorTransparentFlag);
 }
 
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_TextBackgroundColorEnable(
+                                GFX_COLOR color)
+
+    Summary:
+        This function sets the background color of rendered characters
+        and enables the text background color feature.
+
+    Description:
+        This function sets the background color of rendered characters
+        and enables the text background color feature. When enabled,
+        the pixels of the character cell not covered by the glyph are
+        rendered with this color, and anti-aliased glyph edges are
+        blended with it.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_TextBackgroundColorEnable(
+                                GFX_COLOR color)
+{
+    gfxTextBackgroundColor = color;
+    gfxTextBackgroundFlag  = GFX_FEATURE_ENABLED;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_TextBackgroundColorDisable(void)
+
+    Summary:
+        This function disables the text background color feature.
+
+    Description:
+        This function disables the text background color feature.
+        Only the pixels of the glyph are rendered when characters
+        are drawn.
+
+*/
+// *****************************************************************************
+inline GFX_STATUS __attribute__ ((always_inline)) GFX_TextBackgroundColorDisable(void)
+{
+    gfxTextBackgroundFlag = GFX_FEATURE_DISABLED;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_COLOR GFX_TextBackgroundColorGet(void)
+
+    Summary:
+        This returns the current text background color.
+
+    Description:
+        This returns the color set by GFX_TextBackgroundColorEnable().
+
+*/
+// *****************************************************************************
+inline GFX_COLOR __attribute__ ((always_inline)) GFX_TextBackgroundColorGet(void)
+{
+    return (gfxTextBackgroundColor);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_FEATURE_STATUS GFX_TextBackgroundColorStatusGet(void)
+
+    Summary:
+        This returns the current state of the text background
+        color feature.
+
+    Description:
+        This returns the current state of the text background
+        color feature.
+
+*/
+// *****************************************************************************
+inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_TextBackgroundColorStatusGet(void)
+{
+    return (gfxTextBackgroundFlag);
+}
+
 // *****************************************************************************
 /*  Function:
     void GFX_TextAreaLeftSet(uint16_t left)
@@ -2378,6 +2509,8 @@ void  __attribute__((weak)) GFX_Initialize(void)
         6. Set alpha blending value to 100 (or no alpha blending) if
            alphe blending feature is enabled.
         7. Set background information to no background.
+        8. Set text background color feature to be disabled.
+        9. Empty the external font caches.
 
         This function does not clear the screen and does not assign
         any color to the currently set color. Application should
@@ -2408,6 +2541,12 @@ inline void GFX_Primitive_Initialize(void)
     // initialize the background
     GFX_BackgroundSet(0, 0, NULL, 0);
 
+    // characters are rendered without a background
+    GFX_TextBackgroundColorDisable();
+
+    // external memory may have been reprogrammed
+    GFX_FontCacheFlush();
+
     // initialize the PutImage() render disable flag
     GFX_RenderToDisplayBufferEnable();
 
@@ -3511,6 +3650,214 @@ void GFX_TextCharInfoFlashGet(
     
 }
 
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+/*********************************************************************
+* Function: static GFX_FONT_GLYPH_CACHE_ENTRY *GFX_FontGlyphCacheGet(
+*                               GFX_RESOURCE_HDR *pFont,
+*                               GFX_XCHAR ch,
+*                               bool *pFound)
+*
+* PreCondition: none
+*
+* Input: pFont - font of the glyph
+*        ch - character code of the glyph
+*        pFound - set to true if the glyph is in the cache
+*
+* Output: the cache entry of the glyph
+*
+* Side Effects: none
+*
+* Overview: Looks up a glyph in the glyph cache. When the glyph is not
+*           cached, the least recently used entry is emptied and
+*           returned. The caller fills it and then sets its pFont and
+*           ch fields, only if the glyph was read successfully.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static GFX_FONT_GLYPH_CACHE_ENTRY *GFX_FontGlyphCacheGet(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch,
+                                bool *pFound)
+{
+    GFX_FONT_GLYPH_CACHE_ENTRY *pEntry, *pVictim;
+
+    if(++gfxFontGlyphCacheClock == 0)
+    {
+        // the clock wrapped, so restart the ages of all entries
+        for(pEntry = gfxFontGlyphCache; pEntry < &gfxFontGlyphCache[GFX_CONFIG_FONT_GLYPH_CACHE_SIZE]; pEntry++)
+            pEntry->lastUse = 0;
+        gfxFontGlyphCacheClock = 1;
+    }
+
+    *pFound = false;
+    pVictim = gfxFontGlyphCache;
+    for(pEntry = gfxFontGlyphCache; pEntry < &gfxFontGlyphCache[GFX_CONFIG_FONT_GLYPH_CACHE_SIZE]; pEntry++)
+    {
+        if((pEntry->pFont == pFont) && (pEntry->ch == ch))
+        {
+            *pFound = true;
+            pVictim = pEntry;
+            break;
+        }
+        if(pEntry->lastUse < pVictim->lastUse)
+            pVictim = pEntry;
+    }
+
+    // a replaced entry is keyed by the caller only once it has been
+    // filled, so that an entry that failed to load is never a hit
+    if(*pFound == false)
+        pVictim->pFont = NULL;
+    pVictim->lastUse = gfxFontGlyphCacheClock;
+    return (pVictim);
+}
+#endif // #ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+/*********************************************************************
+* Function: static GFX_FONT_WIDTH_CACHE_ENTRY *GFX_FontWidthCacheGet(
+*                               GFX_RESOURCE_HDR *pFont,
+*                               GFX_XCHAR ch,
+*                               bool *pFound)
+*
+* PreCondition: none
+*
+* Input: pFont - font of the glyph
+*        ch - character code of the glyph
+*        pFound - set to true if the width is in the cache
+*
+* Output: the cache entry of the glyph width
+*
+* Side Effects: none
+*
+* Overview: Same as GFX_FontGlyphCacheGet() for the width cache.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static GFX_FONT_WIDTH_CACHE_ENTRY *GFX_FontWidthCacheGet(
+                                GFX_RESOURCE_HDR *pFont,
+                                GFX_XCHAR ch,
+                                bool *pFound)
+{
+    GFX_FONT_WIDTH_CACHE_ENTRY *pEntry, *pVictim;
+
+    if(++gfxFontWidthCacheClock == 0)
+    {
+        // the clock wrapped, so restart the ages of all entries
+        for(pEntry = gfxFontWidthCache; pEntry < &gfxFontWidthCache[GFX_CONFIG_FONT_WIDTH_CACHE_SIZE]; pEntry++)
+            pEntry->lastUse = 0;
+        gfxFontWidthCacheClock = 1;
+    }
+
+    *pFound = false;
+    pVictim = gfxFontWidthCache;
+    for(pEntry = gfxFontWidthCache; pEntry < &gfxFontWidthCache[GFX_CONFIG_FONT_WIDTH_CACHE_SIZE]; pEntry++)
+    {
+        if((pEntry->pFont == pFont) && (pEntry->ch == ch))
+        {
+            *pFound = true;
+            pVictim = pEntry;
+            break;
+        }
+        if(pEntry->lastUse < pVictim->lastUse)
+            pVictim = pEntry;
+    }
+
+    // a replaced entry is keyed by the caller only once it has been
+    // filled, so that an entry that failed to load is never a hit
+    if(*pFound == false)
+        pVictim->pFont = NULL;
+    pVictim->lastUse = gfxFontWidthCacheClock;
+    return (pVictim);
+}
+#endif // #ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FontCacheFlush(void)
+
+    Summary:
+        Empties the glyph and width caches of fonts sourced externally.
+
+    Description:
+        Empties the glyph and width caches of fonts sourced externally.
+        The hit and miss counters are not changed.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheFlush(void)
+{
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    GFX_FONT_GLYPH_CACHE_ENTRY *pGlyphEntry;
+#endif
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+    GFX_FONT_WIDTH_CACHE_ENTRY *pWidthEntry;
+#endif
+
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    for(pGlyphEntry = gfxFontGlyphCache; pGlyphEntry < &gfxFontGlyphCache[GFX_CONFIG_FONT_GLYPH_CACHE_SIZE]; pGlyphEntry++)
+    {
+        pGlyphEntry->pFont   = NULL;
+        pGlyphEntry->lastUse = 0;
+    }
+    gfxFontGlyphCacheClock = 0;
+#endif
+
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+    for(pWidthEntry = gfxFontWidthCache; pWidthEntry < &gfxFontWidthCache[GFX_CONFIG_FONT_WIDTH_CACHE_SIZE]; pWidthEntry++)
+    {
+        pWidthEntry->pFont   = NULL;
+        pWidthEntry->lastUse = 0;
+    }
+    gfxFontWidthCacheClock = 0;
+#endif
+
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FontCacheStatisticsGet(
+                                GFX_FONT_CACHE_STATISTICS *pStatistics)
+
+    Summary:
+        Returns the hit and miss counters of the external font caches.
+
+    Description:
+        Copies the hit and miss counters of the external font caches
+        to the given structure.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheStatisticsGet(
+                                GFX_FONT_CACHE_STATISTICS *pStatistics)
+{
+    *pStatistics = gfxFontCacheStatistics;
+    return (GFX_STATUS_SUCCESS);
+}
+
+// *****************************************************************************
+/*  Function:
+    GFX_STATUS GFX_FontCacheStatisticsClear(void)
+
+    Summary:
+        Clears the hit and miss counters of the external font caches.
+
+    Description:
+        Clears the hit and miss counters of the external font caches.
+
+*/
+// *****************************************************************************
+GFX_STATUS GFX_FontCacheStatisticsClear(void)
+{
+    gfxFontCacheStatistics.glyphHits   = 0;
+    gfxFontCacheStatistics.glyphMisses = 0;
+    gfxFontCacheStatistics.widthHits   = 0;
+    gfxFontCacheStatistics.widthMisses = 0;
+    return (GFX_STATUS_SUCCESS);
+}
+
 // *****************************************************************************
 /*  Function:
     void GFX_TextCharInfoExternalGet(
@@ -3536,12 +3883,41 @@ void GFX_TextCharInfoExternalGet(
     GFX_FONT_GLYPH_ENTRY            chTable;
     GFX_FONT_GLYPH_ENTRY_EXTENDED   chTableExtended;
     uint16_t                        imageSize;
-    GFX_UXCHAR                      temp;
+    uint32_t                        temp;
     PRIMITIVE_UINT32_UNION          glyphOffset;
+    GFX_STATUS                      status;
+    uint8_t                         *pImage;
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    GFX_FONT_GLYPH_CACHE_ENTRY      *pEntry;
+    bool                            found;
+#endif
 
     // set color depth of font,
     // based on 2^bpp where bpp is the color depth setting in the GFX_FONT_HEADER
     pParam->bpp = 1 << pGfxCurrentFont->resource.font.header.bpp;
+    pImage = (uint8_t *) &(pParam->chImage);
+
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    pEntry = GFX_FontGlyphCacheGet(pGfxCurrentFont, ch, &found);
+    if(found)
+    {
+        gfxFontCacheStatistics.glyphHits++;
+
+        // the bitmap is rendered directly from the cache entry
+        pParam->chGlyphWidth          = pEntry->chGlyphWidth;
+        pParam->chEffectiveGlyphWidth = pEntry->chGlyphWidth * pParam->bpp;
+        pParam->xAdjust               = pEntry->xAdjust;
+        pParam->yAdjust               = pEntry->yAdjust;
+        pParam->xWidthAdjust          = pEntry->xWidthAdjust;
+        pParam->heightOvershoot       = pEntry->heightOvershoot;
+        pParam->pChImage              = (uint8_t *) pEntry->chImage;
+        return;
+    }
+    gfxFontCacheStatistics.glyphMisses++;
+
+    // read the glyph into the cache entry assigned to it
+    pImage = pEntry->chImage;
+#endif
        
     if(pGfxCurrentFont->resource.font.header.extendedGlyphEntry)
     {
@@ -3549,7 +3925,7 @@ void GFX_TextCharInfoExternalGet(
         temp *= sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED);
         temp += sizeof(GFX_FONT_HEADER);
 
-        GFX_ExternalResourceCallback
+        status = GFX_ExternalResourceCallback
         (
             pGfxCurrentFont,
             temp,
@@ -3577,7 +3953,7 @@ void GFX_TextCharInfoExternalGet(
     else
     {
         // get glyph entry
-        GFX_ExternalResourceCallback
+        status = GFX_ExternalResourceCallback
         (
             pGfxCurrentFont,
             sizeof(GFX_FONT_HEADER) + ((GFX_UXCHAR)ch - (GFX_UXCHAR)pGfxCurrentFont->resource.font.header.firstChar) * sizeof(GFX_FONT_GLYPH_ENTRY),
@@ -3608,13 +3984,143 @@ void GFX_TextCharInfoExternalGet(
         glyphOffset.uint3216BitValue[0] = (chTable.offsetMSB << 8) + (chTable.offsetLSB);
     }
             
-    GFX_ExternalResourceCallback(pGfxCurrentFont, glyphOffset.uint32Value, imageSize, &(pParam->chImage));
-    pParam->pChImage = (uint8_t *) &(pParam->chImage);
+    // the image size is not valid if the glyph entry was not read
+    if(status == GFX_STATUS_SUCCESS)
+        status = GFX_ExternalResourceCallback(pGfxCurrentFont, glyphOffset.uint32Value, imageSize, pImage);
+    pParam->pChImage = pImage;
+
+#ifdef GFX_FONT_GLYPH_CACHE_ENABLE
+    if(status == GFX_STATUS_SUCCESS)
+    {
+        pEntry->chGlyphWidth    = pParam->chGlyphWidth;
+        pEntry->xAdjust         = pParam->xAdjust;
+        pEntry->yAdjust         = pParam->yAdjust;
+        pEntry->xWidthAdjust    = pParam->xWidthAdjust;
+        pEntry->heightOvershoot = pParam->heightOvershoot;
+        pEntry->pFont           = pGfxCurrentFont;
+        pEntry->ch              = ch;
+    }
+#endif
 
 #endif //#ifndef GFX_CONFIG_FONT_EXTERNAL_DISABLE
 
 }
 
+/*********************************************************************
+* Function: static void GFX_TextGlyphRunRender(int16_t x, int16_t y,
+*                               GFX_FONT_SPACE uint8_t *pRow,
+*                               int16_t first, int16_t last,
+*                               GFX_FONT_OUTCHAR *pParam)
+*
+* PreCondition: the anti-aliasing colors must be calculated for 2 bpp
+*               glyphs, first and last must be visible columns
+*
+* Input: x, y - position of the first column of the glyph row
+*        pRow - pointer to the glyph row bitmap
+*        first, last - columns of the glyph row to render
+*        pParam - pointer to character information structure
+*
+* Output: none
+*
+* Side Effects: gfxLineBuffer0 is used to build the pixel array
+*
+* Overview: Renders one run of a glyph row. A run of a 1 bpp glyph
+*           without text background is a solid line rendered with
+*           GFX_BarDraw(). All other runs are converted to colors and
+*           rendered with one GFX_PixelArrayPut() call.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static void GFX_TextGlyphRunRender(
+                                int16_t x,
+                                int16_t y,
+                                GFX_FONT_SPACE uint8_t *pRow,
+                                int16_t first,
+                                int16_t last,
+                                GFX_FONT_OUTCHAR *pParam)
+{
+    GFX_FONT_SPACE uint8_t *pData;
+    GFX_COLOR   *pPixel;
+    GFX_COLOR   color[4];
+    uint8_t     temp, mask, shift;
+    int16_t     xCnt;
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    uint8_t     val, translucent = 0;
+#endif
+
+    if(     (pParam->bpp == 1) &&
+            (GFX_TextBackgroundColorStatusGet() == GFX_FEATURE_DISABLED)
+      )
+    {
+        if(first == last)
+        {
+            GFX_PixelPut(x + first, y);
+        }
+        else
+        {
+            while(GFX_BarDraw(x + first, y, x + last, y) == GFX_STATUS_FAILURE);
+        }
+        return;
+    }
+
+    // color of each pixel value, 0 is the text background
+    color[0] = GFX_TextBackgroundColorGet();
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+    if(pParam->bpp == 2)
+    {
+        color[1] = gfx_TextForegroundColor25;
+        color[2] = gfx_TextForegroundColor75;
+        color[3] = gfx_TextForegroundColor100;
+
+        // translucent edges are blended with the pixels under the run
+        if(     (GFX_FontAntiAliasGet() == GFX_FONT_ANTIALIAS_TRANSLUCENT) &&
+                (GFX_TextBackgroundColorStatusGet() == GFX_FEATURE_DISABLED)
+          )
+        {
+            GFX_PixelArrayGet(x + first, y, gfxLineBuffer0, last - first + 1);
+            translucent = 1;
+        }
+    }
+    else
+#endif
+    {
+        color[1] = GFX_ColorGet();
+    }
+
+    mask  = (1 << pParam->bpp) - 1;
+    pData = pRow + ((first * pParam->bpp) >> 3);
+    shift = (first * pParam->bpp) & 0x07;
+    temp  = *pData++;
+
+    pPixel = gfxLineBuffer0;
+    for(xCnt = first; xCnt <= last; xCnt++)
+    {
+        if(shift == 8)
+        {
+            temp  = *pData++;
+            shift = 0;
+        }
+
+#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
+        val = (temp >> shift) & mask;
+        if((translucent) && (val != 3) && (gfx_TextBackgroundColor100 != *pPixel))
+        {
+            gfx_TextBackgroundColor100 = *pPixel;
+            GFX_CalculateColors();
+            color[1] = gfx_TextForegroundColor25;
+            color[2] = gfx_TextForegroundColor75;
+        }
+        *pPixel++ = color[val];
+#else
+        *pPixel++ = color[(temp >> shift) & mask];
+#endif
+        shift += pParam->bpp;
+    }
+
+    GFX_PixelArrayPut(x + first, y, gfxLineBuffer0, last - first + 1);
+}
+
 /*********************************************************************
 * Function:  void GFX_TextCharRender(GFX_XCHAR ch, GFX_FONT_OUTCHAR *pParam)
 *
@@ -3627,7 +4133,12 @@ void GFX_TextCharInfoExternalGet(
 *
 * Side Effects: none
 *
-* Overview: Performs the actual rendering of the character using PutPixel().
+* Overview: Performs the actual rendering of the character. Each row
+*           of the glyph is split into runs of non-zero pixels that
+*           are rendered with GFX_TextGlyphRunRender(), so the display
+*           is accessed once per run instead of once per pixel. When
+*           the text background color is enabled, each row of the
+*           character cell is rendered as a single run.
 *
 * Note: Application should not call this function. This function is for 
 *       versatility of implementing hardware accelerated text rendering
@@ -3638,12 +4149,18 @@ GFX_STATUS GFX_TextCharRender(
                                 GFX_XCHAR ch,
                                 GFX_FONT_OUTCHAR *pParam)
 {
-    uint8_t     temp = 0;
-    uint8_t     mask;
-    uint8_t     restoremask;
-    int16_t     xCnt, yCnt, x = 0, y, fontHeight;
+    GFX_FONT_SPACE uint8_t *pRow;
+    GFX_FONT_SPACE uint8_t *pData;
+    uint8_t     temp, restoremask, shift;
+    uint16_t    rowSize;
+    int16_t     xCnt, yCnt, x, y, fontHeight;
+    int16_t     first, last, runStart;
+    int16_t     clipLeft, clipTop, clipRight, clipBottom;
+    GFX_FILL_STYLE  prevFillStyle;
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    GFX_FEATURE_STATUS prevTransparentStatus;
+#endif
 #ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-    uint8_t     val, shift;
     GFX_COLOR   bgcolor;
 #endif
 
@@ -3665,9 +4182,16 @@ GFX_STATUS GFX_TextCharRender(
             return (GFX_STATUS_FAILURE); // BPP > 2 are not yet supported
         }
         
-        bgcolor = GFX_PixelGet( GFX_TextCursorPositionXGet(),
-                                GFX_TextCursorPositionYGet() + (fontHeight >> 1)
-                              );
+        if(GFX_TextBackgroundColorStatusGet() == GFX_FEATURE_ENABLED)
+        {
+            bgcolor = GFX_TextBackgroundColorGet();
+        }
+        else
+        {
+            bgcolor = GFX_PixelGet( GFX_TextCursorPositionXGet(),
+                                    GFX_TextCursorPositionYGet() + (fontHeight >> 1)
+                                  );
+        }
         
         if((gfx_TextForegroundColor100 != GFX_ColorGet()) ||
            (gfx_TextBackgroundColor100 != bgcolor))
@@ -3680,109 +4204,92 @@ GFX_STATUS GFX_TextCharRender(
 #else
     restoremask = 0x01;
 #endif
-    
+
+    // pixels are rendered only inside the text area (the edges
+    // of the text area are excluded) and inside the screen
+    clipLeft   = GFX_TextAreaLeftGet() + 1;
+    clipTop    = GFX_TextAreaTopGet() + 1;
+    clipRight  = GFX_TextAreaRightGet() - 1;
+    clipBottom = GFX_TextAreaBottomGet() - 1;
+    if(clipRight > (int16_t)GFX_MaxXGet())
+        clipRight = GFX_MaxXGet();
+    if(clipBottom > (int16_t)GFX_MaxYGet())
+        clipBottom = GFX_MaxYGet();
+
+    // visible columns of the glyph
+    x = GFX_TextCursorPositionXGet() + pParam->xAdjust;
+    first = (clipLeft > x) ? (clipLeft - x) : 0;
+    last  = pParam->chGlyphWidth - 1;
+    if(clipRight < (x + last))
+        last = clipRight - x;
+
+    // runs are rendered with solid color bars and pixel arrays that
+    // must not be affected by the fill style and transparent color
+    prevFillStyle = GFX_FillStyleGet();
+    GFX_FillStyleSet(GFX_FILL_STYLE_COLOR);
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    prevTransparentStatus = GFX_TransparentColorStatusGet();
+    GFX_TransparentColorDisable();
+#endif
+
+    // each glyph row starts on a byte boundary
+    rowSize = ((pParam->chGlyphWidth * pParam->bpp) + 7) >> 3;
+    pRow = pParam->pChImage;
     y = GFX_TextCursorPositionYGet() + pParam->yAdjust;
 
     for(yCnt = 0; yCnt < fontHeight + pParam->heightOvershoot; yCnt++)
     {
-
-        x = GFX_TextCursorPositionXGet() + pParam->xAdjust;
-        mask = 0;
-
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-        shift = 0;
-#endif
-
-        if (    (GFX_TextAreaTopGet()    < y) &&
-                (GFX_TextAreaBottomGet() > y)
-           )
+        if((first <= last) && (clipTop <= y) && (clipBottom >= y))
         {
-
-            for(xCnt = 0; xCnt < pParam->chGlyphWidth; xCnt++)
+            if(GFX_TextBackgroundColorStatusGet() == GFX_FEATURE_ENABLED)
             {
+                GFX_TextGlyphRunRender(x, y, pRow, first, last, pParam);
+            }
+            else
+            {
+                pData = pRow + ((first * pParam->bpp) >> 3);
+                shift = (first * pParam->bpp) & 0x07;
+                temp  = *pData++;
+                runStart = -1;
 
-                if(mask == 0)
-                {
-                    temp = *(pParam->pChImage)++;
-                    mask = restoremask;
-
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                    shift = 0;
-#endif
-                }
-
-                // check if the pixel is in the text region
-                if(    (GFX_TextAreaLeftGet()   < x) &&
-                       (GFX_TextAreaRightGet()  > x)
-                   )
+                for(xCnt = first; xCnt <= last; xCnt++)
                 {
-
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                    if (pParam->bpp == 1)
+                    if(shift == 8)
                     {
-                        if (temp & mask)
-                        {
-                            GFX_PixelPut(x, y);
-                        }
+                        temp  = *pData++;
+                        shift = 0;
                     }
-                    else
-                    {
-                        val = (temp & mask) >> shift;
-                        if (val)
-                        {
-                            if(GFX_FontAntiAliasGet() == GFX_FONT_ANTIALIAS_TRANSLUCENT)
-                            {
-                                bgcolor = GFX_PixelGet(x, y);
-                                if(gfx_TextBackgroundColor100 != bgcolor)
-                                {
-                                    gfx_TextBackgroundColor100 = bgcolor;
-                                    GFX_CalculateColors();
-                                }
-                            }
 
-                            switch(val)
-                            {
-                                case 1:
-                                    GFX_ColorSet(gfx_TextForegroundColor25);
-                                    break;
-
-                                case 2:
-                                    GFX_ColorSet(gfx_TextForegroundColor75);
-                                    break;
-
-                                case 3:
-                                    GFX_ColorSet(gfx_TextForegroundColor100);
-                                    break;
-                                default:
-                                    // should not happen since this switch statement
-                                    // is within if(val) statement.
-                                    break;
-                            }
-
-                            GFX_PixelPut(x, y);
-                        }
+                    if((temp >> shift) & restoremask)
+                    {
+                        if(runStart < 0)
+                            runStart = xCnt;
                     }
-#else
-                    if(temp & mask)
+                    else if(runStart >= 0)
                     {
-                        GFX_PixelPut(x, y);
+                        GFX_TextGlyphRunRender(x, y, pRow, runStart, xCnt - 1, pParam);
+                        runStart = -1;
                     }
-#endif
-                } // end of if statement to check if in rendering area
-
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-                mask  <<=  pParam->bpp;
-                shift  +=  pParam->bpp;
-#else
-                mask <<= 1;
-#endif
-                x++;
+                    shift += pParam->bpp;
+                }
 
-            } // for(xCnt = 0; xCnt < pParam->chGlyphWidth; xCnt++)...
+                if(runStart >= 0)
+                {
+                    GFX_TextGlyphRunRender(x, y, pRow, runStart, last, pParam);
+                }
+            }
         }
+
+        pRow += rowSize;
         y++;
     } // end of for(yCnt = 0; yCnt...
 
+    GFX_FillStyleSet(prevFillStyle);
+#ifndef GFX_CONFIG_TRANSPARENT_COLOR_DISABLE
+    if(prevTransparentStatus == GFX_FEATURE_ENABLED)
+        GFX_TransparentColorEnable(GFX_TransparentColorGet());
+#endif
+
     // move cursor
     GFX_TextCursorPositionSet(
                                 (   GFX_TextCursorPositionXGet() + 
@@ -3791,13 +4298,6 @@ GFX_STATUS GFX_TextCharRender(
                                 GFX_TextCursorPositionYGet()
                              );
 
-    // restore color
-#ifndef GFX_CONFIG_FONT_ANTIALIASED_DISABLE
-    if(pParam->bpp > 1)
-    {
-        GFX_ColorSet(gfx_TextForegroundColor100);
-    }
-#endif
     return (GFX_STATUS_SUCCESS);
 
 }
@@ -4636,9 +5136,18 @@ uint16_t __attribute__((weak)) GFX_TextStringWidthExternalGet(
     GFX_XCHAR       ch;
     GFX_XCHAR       fontFirstChar;
     GFX_XCHAR       fontLastChar;
+    uint16_t        chWidth;
+    GFX_STATUS      status;
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+    GFX_FONT_WIDTH_CACHE_ENTRY *pEntry;
+    bool            found;
+#endif
 
+    // use the copy of the header in the resource, as
+    // GFX_TextCharInfoExternalGet() does, so that strings with cached
+    // widths are measured without external memory access
+    header = pFont->resource.font.header;
 
-    GFX_ExternalResourceCallback((void*)pFont, 0, sizeof(GFX_FONT_HEADER), &header);
     fontFirstChar = header.firstChar;
     fontLastChar = header.lastChar;
     textWidth = 0;
@@ -4648,28 +5157,48 @@ uint16_t __attribute__((weak)) GFX_TextStringWidthExternalGet(
             continue;
         if((GFX_UXCHAR)ch > (GFX_UXCHAR)fontLastChar)
             continue;
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+        pEntry = GFX_FontWidthCacheGet(pFont, ch, &found);
+        if(found)
+        {
+            gfxFontCacheStatistics.widthHits++;
+            textWidth += pEntry->width;
+            continue;
+        }
+        gfxFontCacheStatistics.widthMisses++;
+#endif
         if(header.extendedGlyphEntry)
         {
-            GFX_ExternalResourceCallback
+            status = GFX_ExternalResourceCallback
             (
                 (void*)pFont,
                 sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED) * ((GFX_UXCHAR)ch - (GFX_UXCHAR)fontFirstChar),
                 sizeof(GFX_FONT_GLYPH_ENTRY_EXTENDED),
                 &chTableExtended
             );
-            textWidth += chTableExtended.cursorAdvance;
+            chWidth = chTableExtended.cursorAdvance;
         }
         else
         {
-            GFX_ExternalResourceCallback
+            status = GFX_ExternalResourceCallback
             (
                 (void*)pFont,
                 sizeof(GFX_FONT_HEADER) + sizeof(GFX_FONT_GLYPH_ENTRY) * ((GFX_UXCHAR)ch - (GFX_UXCHAR)fontFirstChar),
                 sizeof(GFX_FONT_GLYPH_ENTRY),
                 &chTable
             );
-            textWidth += chTable.width;
+            chWidth = chTable.width;
         }
+
+        // a glyph entry that could not be read adds no width
+        if(status != GFX_STATUS_SUCCESS)
+            continue;
+        textWidth += chWidth;
+#ifdef GFX_FONT_WIDTH_CACHE_ENABLE
+        pEntry->width = chWidth;
+        pEntry->pFont = pFont;
+        pEntry->ch    = ch;
+#endif
     }
 
     return (textWidth);
@@ -8319,6 +8848,55 @@ inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAl
     return (gfxDoubleBufferParam.gfxDoubleBufferFullSync);
 }
 
+/*********************************************************************
+* Function: static uint32_t GFX_DoubleBufferAreaGrowthGet(
+*                               const GFX_RECTANGULAR_AREA *pArea1,
+*                               const GFX_RECTANGULAR_AREA *pArea2,
+*                               GFX_RECTANGULAR_AREA *pMerged)
+*
+* PreCondition: none
+*
+* Input: pArea1, pArea2 - the two areas
+*        pMerged - receives the bounding rectangle of the two areas,
+*                  it may point to one of the areas
+*
+* Output: The number of pixels the bounding rectangle covers in excess
+*         of the two areas copied separately, 0 if merging the areas
+*         does not add pixels.
+*
+* Side Effects: none
+*
+* Overview: Computes the cost of replacing two synchronization areas
+*           with their bounding rectangle.
+*
+* Note: Internal to this file
+*
+********************************************************************/
+static uint32_t GFX_DoubleBufferAreaGrowthGet(
+                                const GFX_RECTANGULAR_AREA *pArea1,
+                                const GFX_RECTANGULAR_AREA *pArea2,
+                                GFX_RECTANGULAR_AREA *pMerged)
+{
+    uint32_t size1, size2, sizeMerged;
+
+    size1 = (uint32_t)(pArea1->right - pArea1->left + 1) *
+                      (pArea1->bottom - pArea1->top + 1);
+    size2 = (uint32_t)(pArea2->right - pArea2->left + 1) *
+                      (pArea2->bottom - pArea2->top + 1);
+
+    pMerged->left   = (pArea1->left   < pArea2->left)   ? pArea1->left   : pArea2->left;
+    pMerged->top    = (pArea1->top    < pArea2->top)    ? pArea1->top    : pArea2->top;
+    pMerged->right  = (pArea1->right  > pArea2->right)  ? pArea1->right  : pArea2->right;
+    pMerged->bottom = (pArea1->bottom > pArea2->bottom) ? pArea1->bottom : pArea2->bottom;
+
+    sizeMerged = (uint32_t)(pMerged->right - pMerged->left + 1) *
+                           (pMerged->bottom - pMerged->top + 1);
+
+    if (sizeMerged <= (size1 + size2))
+        return (0);
+    return (sizeMerged - (size1 + size2));
+}
+
 // *****************************************************************************
 /*  Function:
     void GFX_DoubleBufferAreaMark(
@@ -8341,6 +8919,19 @@ inline GFX_FEATURE_STATUS __attribute__ ((always_inline)) GFX_DoubleBufferSyncAl
         GFX_DoubleBufferSynchronizeRequest() or immediately performed
         using GFX_DoubleBufferSynchronize().
 
+        The list of areas is kept as a damage region. An area is merged
+        with a listed area when the bounding rectangle of the two has no
+        more pixels than the sum of their sizes. Separate areas only meet
+        this when they are adjacent and their union is a rectangle.
+        Overlapping areas can meet it with a bounding rectangle larger
+        than their union, so the merged area may include pixels that
+        were not marked. Areas inside a listed area are dropped.
+        When the list is full, the two areas whose bounding rectangle adds
+        the least pixels are merged, so the list never overflows and the
+        copy is limited to the merged areas instead of the whole screen.
+        Full synchronization is only scheduled when a merged area covers
+        the whole screen.
+
 */
 // *****************************************************************************
 void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
@@ -8349,7 +8940,11 @@ void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
                                 uint16_t right,
                                 uint16_t bottom)
 {
-    uint16_t count;
+    GFX_RECTANGULAR_AREA    *pAreas = gfxDoubleBufferParam.gfxDoubleBufferAreas;
+    GFX_RECTANGULAR_AREA    area, merged;
+    uint16_t                count, i, j, bestI, bestJ;
+    uint32_t                growth, bestGrowth;
+    bool                    restart;
 
     if ((GFX_DoubleBufferSyncAllStatusGet() == GFX_FEATURE_ENABLED) ||
         (GFX_DoubleBufferStatusGet()        == GFX_FEATURE_DISABLED)
@@ -8360,25 +8955,101 @@ void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
         return;
     }
 
-    else if((gfxDoubleBufferParam.gfxUnsyncedAreaCount >= GFX_MAX_INVALIDATE_AREAS) ||
-            (gfxDoubleBufferParam.gfxDoubleBufferFullSync == GFX_FEATURE_ENABLED)
-           )
-    {
-        // full frame synchronization is requested or number of unsynchronized
-        // area reached the max size. Set the synchronization request
-        // flag.
-        GFX_DoubleBufferSyncAllStatusSet();
+    // only the visible part of the area needs synchronization
+    if (right > GFX_MaxXGet())
+        right = GFX_MaxXGet();
+    if (bottom > GFX_MaxYGet())
+        bottom = GFX_MaxYGet();
+    if ((left > right) || (top > bottom))
         return;
-    }
-    else
+
+    area.left   = left;
+    area.top    = top;
+    area.right  = right;
+    area.bottom = bottom;
+
+    count = gfxDoubleBufferParam.gfxUnsyncedAreaCount;
+
+    while(1)
     {
-        // update the count then get the area parameters
-        count = ++(gfxDoubleBufferParam.gfxUnsyncedAreaCount);
+        // merge the new area with every listed area whose bounding
+        // rectangle with it is no larger than the sum of their sizes.
+        // A merged area can reach areas that the original did not, so
+        // start over after each merge.
+        do
+        {
+            restart = false;
+            for (i = 0; i < count; i++)
+            {
+                if (GFX_DoubleBufferAreaGrowthGet(&pAreas[i], &area, &merged) != 0)
+                    continue;
+
+                if ((merged.left  == pAreas[i].left)  && (merged.top    == pAreas[i].top) &&
+                    (merged.right == pAreas[i].right) && (merged.bottom == pAreas[i].bottom))
+                {
+                    // already inside a listed area
+                    return;
+                }
+
+                // remove the listed area and continue with the merged one
+                area = merged;
+                pAreas[i] = pAreas[--count];
+                restart = true;
+                break;
+            }
+        } while(restart == true);
+
+        if ((area.left == 0) && (area.top == 0) &&
+            (area.right == GFX_MaxXGet()) && (area.bottom == GFX_MaxYGet()))
+        {
+            // the whole screen is damaged, one continuous copy is faster.
+            // Synchronization is still left to the caller to request.
+            GFX_DoubleBufferSyncAreaCountSet(0);
+            gfxDoubleBufferParam.gfxDoubleBufferFullSync = GFX_FEATURE_ENABLED;
+            return;
+        }
+
+        if (count < GFX_MAX_INVALIDATE_AREAS)
+        {
+            pAreas[count++] = area;
+            GFX_DoubleBufferSyncAreaCountSet(count);
+            return;
+        }
+
+        // The list is full. Find the pair (including the new area, at
+        // index count) whose bounding rectangle adds the least pixels.
+        bestGrowth = 0xFFFFFFFF;
+        bestI = bestJ = 0;
+        for (i = 0; i < count; i++)
+        {
+            for (j = i + 1; j <= count; j++)
+            {
+                growth = GFX_DoubleBufferAreaGrowthGet(
+                                &pAreas[i],
+                                (j == count) ? &area : &pAreas[j],
+                                &merged);
+                if (growth < bestGrowth)
+                {
+                    bestGrowth = growth;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
 
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].left   = left;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].top    = top;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].right  = right;
-        gfxDoubleBufferParam.gfxDoubleBufferAreas[count].bottom = bottom;
+        if (bestJ == count)
+        {
+            // grow the new area and try again with one slot free
+            GFX_DoubleBufferAreaGrowthGet(&pAreas[bestI], &area, &area);
+            pAreas[bestI] = pAreas[--count];
+        }
+        else
+        {
+            // merge the two listed areas, this frees one slot
+            GFX_DoubleBufferAreaGrowthGet(&pAreas[bestI], &pAreas[bestJ], &pAreas[bestI]);
+            pAreas[bestJ] = pAreas[--count];
+        }
+        GFX_DoubleBufferSyncAreaCountSet(count);
     }
 }
 
@@ -8392,14 +9063,15 @@ void __attribute__ ((weak)) GFX_DoubleBufferAreaMark(
 
     Description:
         This function returns rectangular area position on the
-        draw buffer.
+        draw buffer. index starts at 1 and ends at
+        GFX_DoubleBufferSyncAreaCountGet().
 
 */
 // *****************************************************************************
 GFX_RECTANGULAR_AREA __attribute__ ((weak)) *GFX_DoubleBufferAreaGet(
                                 uint16_t count)
 {
-    return (&(gfxDoubleBufferParam.gfxDoubleBufferAreas[count]));
+    return (&(gfxDoubleBufferParam.gfxDoubleBufferAreas[count - 1]));
 }
 
 #endif // #ifndef GFX_CONFIG_DOUBLE_BUFFERING_DISABLE
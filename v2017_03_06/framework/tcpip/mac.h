@@ -268,6 +268,9 @@ void MACProcess(void);
 bool MACIsLinked(void);
 
 bool MACGetHeader(MAC_ADDR *remote, uint8_t *type);
+#if defined(WF_CS_TRIS)
+bool MACIsRxPending(void);
+#endif
 void MACSetReadPtrInRx(uint16_t offset);
 PTR_BASE MACSetWritePtr(PTR_BASE address);
 PTR_BASE MACSetReadPtr(PTR_BASE address);
@@ -1061,51 +1061,126 @@ uint32_t swapl(uint32_t v)
 
 /*****************************************************************************
   Function:
-    uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t count)
+    static uint16_t ChecksumSum(const uint8_t *buffer, uint16_t count)
 
   Summary:
-    Calculates an IP checksum value.
+    Computes the folded one's complement sum of a block of data.
 
   Description:
-    This function calculates an IP checksum over an array of input data.  The
-    checksum is the 16-bit one's complement of one's complement sum of all
-    words in the data (with zero-padding if an odd number of bytes are
-    summed).  This checksum is defined in RFC 793.
+    This function is the common kernel behind CalcIPChecksum() and the
+    ChecksumAdd() incremental API.  Data is summed in a 32-bit accumulator
+    so end-around carries only need to be folded once at the end.  On PIC32
+    the data is read 32 bits at a time with the carries out of each add
+    counted separately; elsewhere it is read 16 bits at a time.  The main
+    loops are unrolled to cover 16 bytes per iteration.
 
   Precondition:
-    buffer is uint16_t aligned (even memory address) on 16- and 32-bit PICs.
+    None
 
   Parameters:
-    buffer - pointer to the data to be checksummed
-    count  - number of bytes to be checksummed
+    buffer - pointer to the data to be summed.  Need not be aligned.
+    count  - number of bytes to be summed
 
   Returns:
-    The calculated checksum.
+    The 16-bit one's complement sum of the data (not complemented), as if
+    the data started at an even offset and was zero-padded to an even
+    length.
 
-  Internal:
-    This function could be improved to do 32-bit sums on PIC32 platforms.
+  Remarks:
+    16- and 32-bit loads must be aligned on PIC24 and PIC32.  An odd-
+    addressed leading byte is summed separately and the rest of the sum is
+    byte swapped back into place, relying on the byte order independence
+    of the one's complement sum (RFC 1071).
  ***************************************************************************/
-uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t count)
+static uint16_t ChecksumSum(const uint8_t *buffer, uint16_t count)
 {
-    uint16_t i;
-    uint16_t *val;
+    const uint16_t *val;
+    uint8_t vLead;
+    bool bLead;
 
     union {
         uint16_t w[2];
         uint32_t dw;
     } sum;
 
-    i = count >> 1;
-    val = (uint16_t *)buffer;
+    bLead = false;
+    vLead = 0;
+    if (((PTR_BASE) buffer & 0x1) && count) {
+        vLead = *buffer++;
+        count--;
+        bLead = true;
+    }
 
-    // Calculate the sum of all words
+    val = (const uint16_t *) buffer;
     sum.dw = 0x00000000ul;
-    while (i--)
-        sum.dw += (uint32_t)*val++;
+
+#if defined(__XC32)
+    {
+        const uint32_t *val32;
+        uint32_t dw;
+        uint32_t carries;
+
+        // Get to a 32-bit boundary
+        if (((PTR_BASE) val & 0x2) && (count >= 2u)) {
+            sum.dw = (uint32_t) * val++;
+            count -= 2;
+        }
+
+        // Sum whole 32-bit words, counting the carries out of bit 31.  Each
+        // carry is worth 2^32, which is 1 in one's complement arithmetic.
+        val32 = (const uint32_t *) val;
+        carries = 0;
+        while (count >= 16u) {
+            dw = val32[0];
+            sum.dw += dw;
+            carries += (sum.dw < dw);
+            dw = val32[1];
+            sum.dw += dw;
+            carries += (sum.dw < dw);
+            dw = val32[2];
+            sum.dw += dw;
+            carries += (sum.dw < dw);
+            dw = val32[3];
+            sum.dw += dw;
+            carries += (sum.dw < dw);
+            val32 += 4;
+            count -= 16;
+        }
+        while (count >= 4u) {
+            dw = *val32++;
+            sum.dw += dw;
+            carries += (sum.dw < dw);
+            count -= 4;
+        }
+        val = (const uint16_t *) val32;
+
+        sum.dw = (uint32_t) sum.w[0] + (uint32_t) sum.w[1] + carries;
+    }
+#else
+    // Sum 16-bit words, eight per iteration
+    while (count >= 16u) {
+        sum.dw += (uint32_t) val[0];
+        sum.dw += (uint32_t) val[1];
+        sum.dw += (uint32_t) val[2];
+        sum.dw += (uint32_t) val[3];
+        sum.dw += (uint32_t) val[4];
+        sum.dw += (uint32_t) val[5];
+        sum.dw += (uint32_t) val[6];
+        sum.dw += (uint32_t) val[7];
+        val += 8;
+        count -= 16;
+    }
+#endif
+
+    // Sum the remaining words
+    while (count >= 2u) {
+        sum.dw += (uint32_t) * val++;
+        count -= 2;
+    }
 
     // Add in the sum of the remaining byte, if present
-    if (count & 0x1)
-        sum.dw += (uint32_t)*((uint8_t *)val);
+    if (count)
+        sum.dw += (uint32_t) * ((const uint8_t *) val);
 
     // Do an end-around carry (one's complement arrithmatic)
     sum.dw = (uint32_t) sum.w[0] + (uint32_t) sum.w[1];
@@ -1114,8 +1189,221 @@ uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t count)
     // caused a carry out
     sum.w[0] += sum.w[1];
 
-    // Return the resulting checksum
-    return ~sum.w[0];
+    // Rotate the sum of the remaining data back into place behind an odd
+    // leading byte
+    if (bLead) {
+        sum.dw = (uint32_t) swaps(sum.w[0]) + (uint32_t) vLead;
+        sum.w[0] += sum.w[1];
+    }
+
+    return sum.w[0];
+}
+
+/*****************************************************************************
+  Function:
+    uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t count)
+
+  Summary:
+    Calculates an IP checksum value.
+
+  Description:
+    This function calculates an IP checksum over an array of input data.  The
+    checksum is the 16-bit one's complement of one's complement sum of all
+    words in the data (with zero-padding if an odd number of bytes are
+    summed).  This checksum is defined in RFC 793.
+
+  Precondition:
+    None
+
+  Parameters:
+    buffer - pointer to the data to be checksummed
+    count  - number of bytes to be checksummed
+
+  Returns:
+    The calculated checksum.
+
+  Remarks:
+    To checksum data that arrives in pieces, use ChecksumBegin(),
+    ChecksumAdd() and ChecksumFinish() instead.
+ ***************************************************************************/
+uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t count)
+{
+    return ~ChecksumSum(buffer, count);
+}
+
+/*****************************************************************************
+  Function:
+    void ChecksumBegin(IP_CHECKSUM *cs)
+
+  Summary:
+    Starts an incremental IP checksum calculation.
+
+  Description:
+    This function clears an IP_CHECKSUM accumulator so that data can be
+    added to it in pieces with ChecksumAdd().
+
+  Precondition:
+    None
+
+  Parameters:
+    cs - the accumulator to initialize
+
+  Returns:
+    None
+ ***************************************************************************/
+void ChecksumBegin(IP_CHECKSUM *cs)
+{
+    cs->Sum = 0x00000000ul;
+    cs->bOdd = false;
+}
+
+/*****************************************************************************
+  Function:
+    void ChecksumAdd(IP_CHECKSUM *cs, const void *buffer, uint16_t len)
+
+  Summary:
+    Adds a block of data to an incremental IP checksum.
+
+  Description:
+    This function adds the next len bytes of a message to the checksum
+    accumulated in cs.  The pieces may be of any length and at any
+    alignment; a piece that follows an odd number of bytes is summed into
+    the opposite byte lanes, so the final result is identical to calling
+    CalcIPChecksum() once over the concatenated data.
+
+  Precondition:
+    ChecksumBegin() has been called on cs.
+
+  Parameters:
+    cs     - the accumulator to update
+    buffer - pointer to the data to be added
+    len    - number of bytes to add
+
+  Returns:
+    None
+ ***************************************************************************/
+void ChecksumAdd(IP_CHECKSUM *cs, const void *buffer, uint16_t len)
+{
+    uint16_t w;
+
+    w = ChecksumSum((const uint8_t *) buffer, len);
+    if (cs->bOdd)
+        w = swaps(w);
+
+    cs->Sum += (uint32_t) w;
+    cs->Sum = (cs->Sum & 0xFFFFul) + (cs->Sum >> 16);
+    if (len & 0x1)
+        cs->bOdd = !cs->bOdd;
+}
+
+/*****************************************************************************
+  Function:
+    void ChecksumMerge(IP_CHECKSUM *cs, IP_CHECKSUM *next)
+
+  Summary:
+    Appends one incremental IP checksum to another.
+
+  Description:
+    This function adds the data accumulated in next to cs as if it had been
+    passed to ChecksumAdd() on cs directly.  It allows a protocol to sum its
+    payload while the payload is being written and to prepend the headers,
+    which are only known at transmit time, afterwards.
+
+  Precondition:
+    ChecksumBegin() has been called on both cs and next.
+
+  Parameters:
+    cs   - the accumulator covering the leading data
+    next - the accumulator covering the data that follows
+
+  Returns:
+    None
+ ***************************************************************************/
+void ChecksumMerge(IP_CHECKSUM *cs, IP_CHECKSUM *next)
+{
+    uint16_t w;
+
+    w = (uint16_t) ((next->Sum & 0xFFFFul) + (next->Sum >> 16));
+    if (cs->bOdd)
+        w = swaps(w);
+
+    cs->Sum += (uint32_t) w;
+    cs->Sum = (cs->Sum & 0xFFFFul) + (cs->Sum >> 16);
+    if (next->bOdd)
+        cs->bOdd = !cs->bOdd;
+}
+
+/*****************************************************************************
+  Function:
+    uint16_t ChecksumFinish(IP_CHECKSUM *cs)
+
+  Summary:
+    Completes an incremental IP checksum calculation.
+
+  Description:
+    This function folds the accumulator and returns the checksum of all the
+    data added to it.  The accumulator is left unchanged, so more data can
+    still be added afterwards.
+
+  Precondition:
+    ChecksumBegin() has been called on cs.
+
+  Parameters:
+    cs - the accumulator to complete
+
+  Returns:
+    The calculated checksum, in the same form returned by CalcIPChecksum().
+ ***************************************************************************/
+uint16_t ChecksumFinish(IP_CHECKSUM *cs)
+{
+    uint16_t w;
+
+    w = (uint16_t) ((cs->Sum & 0xFFFFul) + (cs->Sum >> 16));
+
+    return ~w;
+}
+
+/*****************************************************************************
+  Function:
+    uint16_t ChecksumAdjust(uint16_t checksum, uint16_t oldValue,
+                            uint16_t newValue)
+
+  Summary:
+    Updates an IP checksum after a 16-bit field is rewritten.
+
+  Description:
+    This function incrementally updates a checksum when one 16-bit word of
+    the data it covers changes from oldValue to newValue, without
+    re-reading the rest of the data.  It implements equation 3 of RFC 1624,
+    HC' = ~(~HC + ~m + m'), which unlike the RFC 1141 form never produces
+    a -0 (0xFFFF) result from a +0 sum.
+
+  Precondition:
+    None
+
+  Parameters:
+    checksum - the checksum currently stored in the header
+    oldValue - the word being replaced, as it was stored in the header
+    newValue - the replacement word, in the same byte order
+
+  Returns:
+    The updated checksum, in the same byte order as the inputs.
+
+  Remarks:
+    The one's complement sum is byte order independent, so the arguments
+    may be passed either in network order or as read directly from memory
+    as long as all three are in the same order.  To rewrite a 32-bit field,
+    call this function once for each half.
+ ***************************************************************************/
+uint16_t ChecksumAdjust(uint16_t checksum, uint16_t oldValue, uint16_t newValue)
+{
+    uint32_t sum;
+
+    sum = (uint32_t) (uint16_t) ~checksum + (uint32_t) (uint16_t) ~oldValue + (uint32_t) newValue;
+    sum = (sum & 0xFFFFul) + (sum >> 16);
+    sum += sum >> 16;
+
+    return ~(uint16_t) sum;
 }
 
 /*****************************************************************************
@@ -83,6 +83,19 @@ uint32_t swapl(uint32_t v);
 
 uint16_t CalcIPChecksum(uint8_t *buffer, uint16_t len);
 
+// Running state of an incremental IP checksum calculation
+
+typedef struct {
+    uint32_t Sum; // One's complement sum of the data added so far
+    bool bOdd; // An odd number of bytes has been added so far
+} IP_CHECKSUM;
+
+void ChecksumBegin(IP_CHECKSUM *cs);
+void ChecksumAdd(IP_CHECKSUM *cs, const void *buffer, uint16_t len);
+void ChecksumMerge(IP_CHECKSUM *cs, IP_CHECKSUM *next);
+uint16_t ChecksumFinish(IP_CHECKSUM *cs);
+uint16_t ChecksumAdjust(uint16_t checksum, uint16_t oldValue, uint16_t newValue);
+
 #if defined(__XC8)
 uint32_t leftRotateDWORD(uint32_t val, uint8_t bits);
 #else
@@ -93,7 +93,24 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
  * When a file has an index, that index file has no file name,
  * but is accessible as the file immediately following in the image.
  *
- * Current version is 2.1
+ * Version 2.2 images add a name index directly after the File Records,
+ * so the layout becomes:
+ *     [Name Hash 0]...[Name Hash N]
+ *     [File Record 0]...[File Record N]
+ *     [Index Entry 0]...[Index Entry N]
+ *     [String 0]...[String N]
+ *     [File Data 0]...[File Data N]
+ *
+ * Index Entry Structure (4 bytes):
+ *     [uint16_t Name Hash][uint16_t File ID]
+ *
+ *     Entries are sorted by ascending name hash, so MPFSOpen can binary
+ *     search for a name instead of scanning every hash.  The File Records
+ *     themselves keep their original order, since index files are found
+ *     by File ID + 1.
+ *
+ * Current version is 2.2.  Version 2.1 images (no index) are still
+ * accepted and searched linearly.
  */
 
 /****************************************************************************
@@ -117,8 +134,25 @@ static uint16_t fatCacheID;
 // Number of files in this MPFS image
 static uint16_t numFiles;
 
+// true if this MPFS image carries a sorted name index (version 2.2)
+static bool hasNameIndex;
+
+// Name hash search state for _FindFirst and _FindNext
+static uint16_t findHash;
+static uint16_t findPos;
+static uint16_t hashCache[8];
+
+// Address of the sorted name index within the image
+#define MPFS_INDEX_ADDR  (8 + (uint32_t)numFiles * 24)
+
 static void _LoadFATRecord(uint16_t fatID);
 static void _Validate(void);
+static uint16_t _FindFirst(uint16_t nameHash);
+static uint16_t _FindNext(void);
+static bool _CompareName(uint16_t fatID, uint8_t * cFile, uint16_t len);
+#if defined(__XC8)
+static bool _CompareNameROM(uint16_t fatID, ROM uint8_t * cFile, uint16_t len);
+#endif
 
 /****************************************************************************
   Section:
@@ -230,12 +264,8 @@ void MPFSInit(void)
 MPFS_HANDLE MPFSOpen(uint8_t * cFile)
 {
     MPFS_HANDLE hMPFS;
-    uint16_t nameHash, i;
-    uint16_t hashCache[8];
-    uint8_t *ptr, c;
-
-    // Initialize c to avoid "may be used uninitialized" compiler warning
-    c = 0;
+    uint16_t nameHash, i, len;
+    uint8_t *ptr;
 
     // Make sure MPFS is unlocked and we got a filename
     if (*cFile == '\0' || isMPFSLocked == true)
@@ -246,6 +276,7 @@ MPFS_HANDLE MPFSOpen(uint8_t * cFile)
         nameHash += *ptr;
         nameHash <<= 1;
     }
+    len = (uint16_t) (ptr - cFile) + 1;
 
     // Find a free file handle to use
     for (hMPFS = 1; hMPFS <= MAX_MPFS_HANDLES; hMPFS++)
@@ -254,36 +285,13 @@ MPFS_HANDLE MPFSOpen(uint8_t * cFile)
     if (hMPFS == MAX_MPFS_HANDLES)
         return MPFS_INVALID_HANDLE;
 
-    // Read in hashes, and check remainder on a match.  Store 8 in cache for performance
-    for (i = 0; i < numFiles; i++) {
-        // For new block of 8, read in data
-        if ((i & 0x07) == 0u) {
-            MPFSStubs[0].addr = 8 + i * 2;
-            MPFSStubs[0].bytesRem = 16;
-            MPFSGetArray(0, (uint8_t *) hashCache, 16);
-        }
-
-        // If the hash matches, compare the full filename
-        if (hashCache[i & 0x07] == nameHash) {
-            _LoadFATRecord(i);
-            MPFSStubs[0].addr = fatCache.string;
-            MPFSStubs[0].bytesRem = 255;
-
-            // Loop over filename to perform comparison
-            for (ptr = cFile; *ptr != '\0'; ptr++) {
-                MPFSGet(0, &c);
-                if (*ptr != c)
-                    break;
-            }
-
-            MPFSGet(0, &c);
-
-            if (c == '\0' && *ptr == '\0') { // Filename matches, so return true
-                MPFSStubs[hMPFS].addr = fatCache.data;
-                MPFSStubs[hMPFS].bytesRem = fatCache.len;
-                MPFSStubs[hMPFS].fatID = i;
-                return hMPFS;
-            }
+    // Visit each file with a matching hash and compare the full filename
+    for (i = _FindFirst(nameHash); i != MPFS_INVALID_FAT; i = _FindNext()) {
+        if (_CompareName(i, cFile, len)) { // Filename matches, so return true
+            MPFSStubs[hMPFS].addr = fatCache.data;
+            MPFSStubs[hMPFS].bytesRem = fatCache.len;
+            MPFSStubs[hMPFS].fatID = i;
+            return hMPFS;
         }
     }
 
@@ -315,10 +323,8 @@ MPFS_HANDLE MPFSOpen(uint8_t * cFile)
 MPFS_HANDLE MPFSOpenROM(ROM uint8_t * cFile)
 {
     MPFS_HANDLE hMPFS;
-    uint16_t nameHash, i;
-    uint16_t hashCache[8];
+    uint16_t nameHash, i, len;
     ROM uint8_t *ptr;
-    uint8_t c;
 
     // Make sure MPFS is unlocked and we got a filename
     if (*cFile == '\0' || isMPFSLocked == true)
@@ -329,6 +335,7 @@ MPFS_HANDLE MPFSOpenROM(ROM uint8_t * cFile)
         nameHash += *ptr;
         nameHash <<= 1;
     }
+    len = (uint16_t) (ptr - cFile) + 1;
 
     // Find a free file handle to use
     for (hMPFS = 1; hMPFS <= MAX_MPFS_HANDLES; hMPFS++)
@@ -337,36 +344,13 @@ MPFS_HANDLE MPFSOpenROM(ROM uint8_t * cFile)
     if (hMPFS == MAX_MPFS_HANDLES)
         return MPFS_INVALID_HANDLE;
 
-    // Read in hashes, and check remainder on a match.  Store 8 in cache for performance
-    for (i = 0; i < numFiles; i++) {
-        // For new block of 8, read in data
-        if ((i & 0x07) == 0u) {
-            MPFSStubs[0].addr = 8 + i * 2;
-            MPFSStubs[0].bytesRem = 16;
-            MPFSGetArray(0, (uint8_t *) hashCache, 16);
-        }
-
-        // If the hash matches, compare the full filename
-        if (hashCache[i & 0x07] == nameHash) {
-            _LoadFATRecord(i);
-            MPFSStubs[0].addr = fatCache.string;
-            MPFSStubs[0].bytesRem = 255;
-
-            // Loop over filename to perform comparison
-            for (ptr = cFile; *ptr != '\0'; ptr++) {
-                MPFSGet(0, &c);
-                if (*ptr != c)
-                    break;
-            }
-
-            MPFSGet(0, &c);
-
-            if (c == '\0' && *ptr == '\0') { // Filename matches, so return true
-                MPFSStubs[hMPFS].addr = fatCache.data;
-                MPFSStubs[hMPFS].bytesRem = fatCache.len;
-                MPFSStubs[hMPFS].fatID = i;
-                return hMPFS;
-            }
+    // Visit each file with a matching hash and compare the full filename
+    for (i = _FindFirst(nameHash); i != MPFS_INVALID_FAT; i = _FindNext()) {
+        if (_CompareNameROM(i, cFile, len)) { // Filename matches, so return true
+            MPFSStubs[hMPFS].addr = fatCache.data;
+            MPFSStubs[hMPFS].bytesRem = fatCache.len;
+            MPFSStubs[hMPFS].fatID = i;
+            return hMPFS;
         }
     }
 
@@ -666,6 +650,45 @@ uint16_t MPFSGetArray(MPFS_HANDLE hMPFS, uint8_t * cData, uint16_t wLen)
     return wLen;
 }
 
+/*****************************************************************************
+  Function:
+    ROM uint8_t * MPFSGetROMPointer(MPFS_HANDLE hMPFS)
+
+  Description:
+    Locates the current read position of a file in program memory.
+
+  Precondition:
+    The file handle referenced by hMPFS is already open.
+
+  Parameters:
+    hMPFS - the file handle for which to locate the data
+
+  Returns:
+    A pointer to the next byte that would be read from the file, or NULL if
+    the handle is invalid.
+
+  Remarks:
+    This function is only available when the image is stored in byte
+    addressable program memory (MPFS_ROM_POINTER is defined).  It lets
+    callers copy file data in place, without staging it through RAM.  The
+    file position is not changed; use MPFSGetArray() with a NULL buffer to
+    advance past the bytes that were consumed.
+ ***************************************************************************/
+#if defined(MPFS_ROM_POINTER)
+ROM uint8_t * MPFSGetROMPointer(MPFS_HANDLE hMPFS)
+{
+    uint32_t dwHITECHWorkaround = MPFS_HEAD;
+
+    // Make sure a valid file is open
+    if (hMPFS > MAX_MPFS_HANDLES)
+        return NULL;
+    if (MPFSStubs[hMPFS].addr == MPFS_INVALID)
+        return NULL;
+
+    return (ROM uint8_t *) (MPFSStubs[hMPFS].addr + dwHITECHWorkaround);
+}
+#endif
+
 /*****************************************************************************
   Function:
     bool MPFSGetLong(MPFS_HANDLE hMPFS, uint32_t* ul)
@@ -1281,10 +1304,192 @@ static void _Validate(void)
     MPFSStubs[0].addr = 0;
     MPFSStubs[0].bytesRem = 8;
     MPFSGetArray(0, (uint8_t *) & fatCache, 6);
+    hasNameIndex = false;
     if (!memcmppgm2ram((void *) &fatCache, (ROM void *) "MPFS\x02\x01", 6))
         MPFSGetArray(0, (uint8_t *) & numFiles, 2);
-    else
+    else if (!memcmppgm2ram((void *) &fatCache, (ROM void *) "MPFS\x02\x02", 6)) {
+        MPFSGetArray(0, (uint8_t *) & numFiles, 2);
+        hasNameIndex = true;
+    } else
         numFiles = 0;
     fatCacheID = MPFS_INVALID_FAT;
 }
+
+/*****************************************************************************
+  Function:
+    static uint16_t _FindFirst(uint16_t nameHash)
+
+  Summary:
+    Begins a search for files with a given name hash.
+
+  Description:
+    Locates the first file whose name hash matches nameHash.  Images with
+    a sorted name index are binary searched; older images fall back to
+    scanning the hash table 8 entries at a time.  Further matches are
+    returned by _FindNext.
+
+  Precondition:
+    _Validate has been called
+
+  Parameters:
+    nameHash - the name hash to search for
+
+  Returns:
+    The FAT ID of the first matching file, or MPFS_INVALID_FAT if no
+    file has this hash.
+
+  Remarks:
+    MPFSStubs[0] and the FAT cache may be reused between calls to
+    _FindNext, but the search state must not be shared by two searches.
+ ***************************************************************************/
+static uint16_t _FindFirst(uint16_t nameHash)
+{
+    uint16_t lo, hi, mid, w;
+
+    findHash = nameHash;
+    findPos = 0;
+
+    if (hasNameIndex) {
+        // Find the first index entry whose hash is not below nameHash
+        lo = 0;
+        hi = numFiles;
+        while (lo < hi) {
+            mid = lo + ((hi - lo) >> 1);
+            MPFSStubs[0].addr = MPFS_INDEX_ADDR + (uint32_t)mid * 4;
+            MPFSStubs[0].bytesRem = 2;
+            MPFSGetArray(0, (uint8_t *) & w, 2);
+            if (w < nameHash)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        findPos = lo;
+    }
+
+    return _FindNext();
+}
+
+/*****************************************************************************
+  Function:
+    static uint16_t _FindNext(void)
+
+  Summary:
+    Continues a search for files with a given name hash.
+
+  Description:
+    Returns the next file matching the hash passed to _FindFirst.
+
+  Precondition:
+    _FindFirst has been called
+
+  Parameters:
+    None
+
+  Returns:
+    The FAT ID of the next matching file, or MPFS_INVALID_FAT if no
+    more files have this hash.
+ ***************************************************************************/
+static uint16_t _FindNext(void)
+{
+    uint16_t entry[2];
+
+    if (hasNameIndex) {
+        if (findPos >= numFiles)
+            return MPFS_INVALID_FAT;
+
+        // Entries are sorted, so the first mismatch ends the search
+        MPFSStubs[0].addr = MPFS_INDEX_ADDR + (uint32_t)findPos * 4;
+        MPFSStubs[0].bytesRem = 4;
+        MPFSGetArray(0, (uint8_t *) entry, 4);
+        if (entry[0] != findHash) {
+            findPos = numFiles;
+            return MPFS_INVALID_FAT;
+        }
+        findPos++;
+        return entry[1];
+    }
+
+    // Read in hashes, and stop on a match.  Store 8 in cache for performance
+    while (findPos < numFiles) {
+        // For new block of 8, read in data
+        if ((findPos & 0x07) == 0u) {
+            MPFSStubs[0].addr = 8 + findPos * 2;
+            MPFSStubs[0].bytesRem = 16;
+            MPFSGetArray(0, (uint8_t *) hashCache, 16);
+        }
+
+        if (hashCache[findPos++ & 0x07] == findHash)
+            return findPos - 1;
+    }
+
+    return MPFS_INVALID_FAT;
+}
+
+/*****************************************************************************
+  Function:
+    static bool _CompareName(uint16_t fatID, uint8_t * cFile, uint16_t len)
+
+  Description:
+    Compares a file name against the name stored for a file in the image.
+    The stored name is read in blocks rather than one byte at a time, to
+    limit the number of accesses to external memory.
+
+  Precondition:
+    None
+
+  Parameters:
+    fatID - the ID of the file whose name is to be compared
+    cFile - the null terminated name to compare against
+    len - the length of cFile, including the null terminator
+
+  Return Values:
+    true - the names match, and the FAT record for fatID is loaded
+    false - the names differ
+
+  Remarks:
+    _CompareNameROM is the PIC18 variant for names stored in ROM.
+ ***************************************************************************/
+static bool _CompareName(uint16_t fatID, uint8_t * cFile, uint16_t len)
+{
+    uint8_t buf[16];
+    uint16_t w;
+
+    _LoadFATRecord(fatID);
+    MPFSStubs[0].addr = fatCache.string;
+    MPFSStubs[0].bytesRem = len;
+
+    while (len) {
+        w = len > sizeof(buf) ? sizeof(buf) : len;
+        MPFSGetArray(0, buf, w);
+        if (memcmp(buf, cFile, w))
+            return false;
+        cFile += w;
+        len -= w;
+    }
+
+    return true;
+}
+
+#if defined(__XC8)
+static bool _CompareNameROM(uint16_t fatID, ROM uint8_t * cFile, uint16_t len)
+{
+    uint8_t buf[16];
+    uint16_t w;
+
+    _LoadFATRecord(fatID);
+    MPFSStubs[0].addr = fatCache.string;
+    MPFSStubs[0].bytesRem = len;
+
+    while (len) {
+        w = len > sizeof(buf) ? sizeof(buf) : len;
+        MPFSGetArray(0, buf, w);
+        if (memcmppgm2ram(buf, (ROM void *) cFile, w))
+            return false;
+        cFile += w;
+        len -= w;
+    }
+
+    return true;
+}
+#endif
 #endif // #if defined(STACK_USE_MPFS2)
@@ -60,6 +60,12 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #endif
 #endif
 
+// Defined when the image is stored byte addressable in program memory, so
+// file data can be read in place through MPFSGetROMPointer()
+#if !defined(MPFS_USE_EEPROM) && !defined(MPFS_USE_SPI_FLASH) && !defined(__XC16)
+#define MPFS_ROM_POINTER
+#endif
+
 /****************************************************************************
   Section:
     Type Definitions
@@ -118,6 +124,9 @@ bool MPFSGet(MPFS_HANDLE hMPFS, uint8_t * c);
 uint16_t MPFSGetArray(MPFS_HANDLE hMPFS, uint8_t * cData, uint16_t wLen);
 bool MPFSGetLong(MPFS_HANDLE hMPFS, uint32_t* ul);
 bool MPFSSeek(MPFS_HANDLE hMPFS, uint32_t dwOffset, MPFS_SEEK_MODE tMode);
+#if defined(MPFS_ROM_POINTER)
+ROM uint8_t * MPFSGetROMPointer(MPFS_HANDLE hMPFS);
+#endif
 #if defined(__XC16)
 // Assembly function to read all three bytes of program memory for 16-bit parts
 extern uint32_t ReadProgramMemory(uint32_t address);
@@ -67,6 +67,40 @@ typedef enum {
 
 static SM_STACK smStack;
 
+// Work for StackTask() to do on this call
+#define STACK_WORK_MAC    (0x01u) // Process the MAC and any received packets
+#define STACK_WORK_TIMERS (0x02u) // Run the timer driven modules
+#define STACK_WORK_TCP    (0x04u) // Run TCPTick()
+
+// Most received frames StackTask() processes in one call.  Override in
+// tcpip_config.h if needed.
+#if !defined(STACK_RX_BUDGET_FRAMES)
+#define STACK_RX_BUDGET_FRAMES (8u)
+#endif
+
+// Longest time, in microseconds, StackTask() spends processing received
+// frames in one call.  Override in tcpip_config.h if needed.
+#if !defined(STACK_RX_BUDGET_US)
+#define STACK_RX_BUDGET_US (2000ul)
+#endif
+#define STACK_RX_BUDGET_TICKS ((uint32_t)(TICK_SECOND * STACK_RX_BUDGET_US / 1000000ul))
+
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+// How often the timer driven modules run when no event has been posted.
+// Override in tcpip_config.h if needed.
+#if !defined(STACK_TIMER_TASK_INTERVAL)
+#define STACK_TIMER_TASK_INTERVAL (TICK_SECOND/100)
+#endif
+
+volatile uint8_t vStackEventsPosted[STACK_EVENT_COUNT];
+static uint8_t vStackEventsSeen[STACK_EVENT_COUNT]; // vStackEventsPosted values already handled
+static uint32_t dwLastTimerTask; // Tick when the timer driven modules last ran
+static bool bRxPending; // Received packets were left for the next call
+static STACK_EVENT_STATS StackEventStats;
+
+static bool StackTakeEvent(STACK_EVENT vEvent);
+#endif
+
 NODE_INFO remoteNode;
 
 #if defined (WF_CS_TRIS) && defined (STACK_USE_DHCP_CLIENT)
@@ -99,6 +133,15 @@ void StackInit(void)
     static bool once = false;
     smStack = SM_STACK_IDLE;
 
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    // Consider all events handled, but run everything on the first call
+    memcpy((void *) vStackEventsSeen, (void *) vStackEventsPosted, sizeof (vStackEventsSeen));
+    dwLastTimerTask = TickGet() - STACK_TIMER_TASK_INTERVAL;
+    bRxPending = true;
+    StackEventStats.dwWakeups = 0;
+    StackEventStats.dwPackets = 0;
+#endif
+
 #if defined(STACK_USE_IP_GLEANING) || defined(STACK_USE_DHCP_CLIENT)
     /*
      * If DHCP or IP Gleaning is enabled,
@@ -213,6 +256,19 @@ void StackInit(void)
  *                  This function must be called periodically to
  *                  ensure timely responses.
  *
+ *                  Up to STACK_RX_BUDGET_FRAMES received frames are
+ *                  processed per call, for at most STACK_RX_BUDGET_US
+ *                  microseconds, but always at least one frame.  TCP
+ *                  ACKs for the segments in one batch are coalesced.
+ *
+ *                  If STACK_USE_EVENT_DRIVEN_TASK is defined, only
+ *                  the modules with pending work are run.  Received
+ *                  packets are processed after a MAC event, TCPTick()
+ *                  runs after a TCP event, and the timer driven
+ *                  modules run every STACK_TIMER_TASK_INTERVAL or on
+ *                  a Tick interrupt.  With no work pending this
+ *                  function returns immediately.
+ *
  ********************************************************************/
 void StackTask(void)
 {
@@ -220,96 +276,151 @@ void StackTask(void)
     IP_ADDR tempLocalIP;
     uint8_t cFrameType;
     uint8_t cIPFrameType;
+    uint8_t vWork;
+    uint8_t vFrames;
+    uint32_t dwRxStart;
+
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    uint32_t dwTime;
+
+    // Find out what has happened since the last call
+    vWork = 0;
+    if (StackTakeEvent(STACK_EVENT_MAC) || bRxPending)
+        vWork |= STACK_WORK_MAC | STACK_WORK_TCP;
+    if (StackTakeEvent(STACK_EVENT_TCP))
+        vWork |= STACK_WORK_TCP;
+    dwTime = TickGet();
+    if (StackTakeEvent(STACK_EVENT_TICK) || (dwTime - dwLastTimerTask >= STACK_TIMER_TASK_INTERVAL)) {
+        dwLastTimerTask = dwTime;
+        vWork |= STACK_WORK_MAC | STACK_WORK_TIMERS | STACK_WORK_TCP;
+    }
+
+    // Nothing to do, so leave the CPU to the application
+    if (vWork == 0u)
+        return;
+    StackEventStats.dwWakeups++;
+    bRxPending = false;
+#else
+    vWork = STACK_WORK_MAC | STACK_WORK_TIMERS | STACK_WORK_TCP;
+#endif
 
 #if defined( WF_CS_TRIS )
     // This task performs low-level MAC processing specific to the MRF24W
-    MACProcess();
+    if (vWork & STACK_WORK_MAC)
+        MACProcess();
 
+    if (vWork & STACK_WORK_TIMERS) {
 #if defined( STACK_USE_EZ_CONFIG ) && !defined(__XC8)
-    WFEasyConfigMgr();
+        WFEasyConfigMgr();
 #endif
 
 #if defined(STACK_USE_DHCP_CLIENT)
-    // Normally, an application would not include DHCP module
-    // if it is not enabled. But in case some one wants to disable
-    // DHCP module at run-time, remember to not clear our IP
-    // address if link is removed.
-    if (AppConfig.Flags.bIsDHCPEnabled) {
-        if (g_DhcpRenew == true) {
-            g_DhcpRenew = false;
-            AppConfig.MyIPAddr.Val = AppConfig.DefaultIPAddr.Val;
-            AppConfig.MyMask.Val = AppConfig.DefaultMask.Val;
-            AppConfig.Flags.bInConfigMode = true;
-            DHCPInit(0);
-            g_DhcpRetryTimer = (uint32_t) TickGet();
-        } else {
-            if (g_DhcpRetryTimer && TickGet() - g_DhcpRetryTimer >= TICKS_PER_SECOND * 8) {
+        // Normally, an application would not include DHCP module
+        // if it is not enabled. But in case some one wants to disable
+        // DHCP module at run-time, remember to not clear our IP
+        // address if link is removed.
+        if (AppConfig.Flags.bIsDHCPEnabled) {
+            if (g_DhcpRenew == true) {
+                g_DhcpRenew = false;
+                AppConfig.MyIPAddr.Val = AppConfig.DefaultIPAddr.Val;
+                AppConfig.MyMask.Val = AppConfig.DefaultMask.Val;
+                AppConfig.Flags.bInConfigMode = true;
                 DHCPInit(0);
                 g_DhcpRetryTimer = (uint32_t) TickGet();
+            } else {
+                if (g_DhcpRetryTimer && TickGet() - g_DhcpRetryTimer >= TICKS_PER_SECOND * 8) {
+                    DHCPInit(0);
+                    g_DhcpRetryTimer = (uint32_t) TickGet();
+                }
             }
-        }
 
-        // DHCP must be called all the time even after IP configuration is
-        // discovered.
-        // DHCP has to account lease expiration time and renew the configuration
-        // time.
-        DHCPTask();
+            // DHCP must be called all the time even after IP configuration is
+            // discovered.
+            // DHCP has to account lease expiration time and renew the configuration
+            // time.
+            DHCPTask();
 
-        if (DHCPIsBound(0)) {
-            AppConfig.Flags.bInConfigMode = false;
-            g_DhcpRetryTimer = 0;
+            if (DHCPIsBound(0)) {
+                AppConfig.Flags.bInConfigMode = false;
+                g_DhcpRetryTimer = 0;
+            }
         }
-    }
 #endif // STACK_USE_DHCP_CLIENT
+    }
 
 #endif // WF_CS_TRIS
 
+    if (vWork & STACK_WORK_TIMERS) {
 #if defined(STACK_USE_DHCP_CLIENT) && !defined(WF_CS_TRIS)
-    // Normally, an application would not include  DHCP module
-    // if it is not enabled. But in case some one wants to disable
-    // DHCP module at run-time, remember to not clear our IP
-    // address if link is removed.
-    if (AppConfig.Flags.bIsDHCPEnabled) {
-        static bool bLastLinkState = false;
-        bool bCurrentLinkState;
-
-        bCurrentLinkState = MACIsLinked();
-        if (bCurrentLinkState != bLastLinkState) {
-            bLastLinkState = bCurrentLinkState;
-            if (!bCurrentLinkState) {
-                AppConfig.MyIPAddr.Val = AppConfig.DefaultIPAddr.Val;
-                AppConfig.MyMask.Val = AppConfig.DefaultMask.Val;
-                AppConfig.Flags.bInConfigMode = true;
-                DHCPInit(0);
+        // Normally, an application would not include  DHCP module
+        // if it is not enabled. But in case some one wants to disable
+        // DHCP module at run-time, remember to not clear our IP
+        // address if link is removed.
+        if (AppConfig.Flags.bIsDHCPEnabled) {
+            static bool bLastLinkState = false;
+            bool bCurrentLinkState;
+
+            bCurrentLinkState = MACIsLinked();
+            if (bCurrentLinkState != bLastLinkState) {
+                bLastLinkState = bCurrentLinkState;
+                if (!bCurrentLinkState) {
+                    AppConfig.MyIPAddr.Val = AppConfig.DefaultIPAddr.Val;
+                    AppConfig.MyMask.Val = AppConfig.DefaultMask.Val;
+                    AppConfig.Flags.bInConfigMode = true;
+                    DHCPInit(0);
+                }
             }
-        }
 
-        // DHCP must be called all the time even after IP configuration is
-        // discovered.
-        // DHCP has to account lease expiration time and renew the configuration
-        // time.
-        DHCPTask();
+            // DHCP must be called all the time even after IP configuration is
+            // discovered.
+            // DHCP has to account lease expiration time and renew the configuration
+            // time.
+            DHCPTask();
 
-        if (DHCPIsBound(0))
-            AppConfig.Flags.bInConfigMode = false;
-    }
+            if (DHCPIsBound(0))
+                AppConfig.Flags.bInConfigMode = false;
+        }
 #endif
 
 #if defined (STACK_USE_AUTO_IP)
-    AutoIPTasks();
+        AutoIPTasks();
 #endif
+    }
 
 #if defined(STACK_USE_TCP)
     // Perform all TCP time related tasks (retransmit, send acknowledge, close connection, etc)
-    TCPTick();
+    if (vWork & STACK_WORK_TCP)
+        TCPTick();
 #endif
 
 #if defined(STACK_USE_UDP)
-    UDPTask();
+    if (vWork & STACK_WORK_TIMERS)
+        UDPTask();
 #endif
 
-    // Process as many incomming packets as we can
+    if (!(vWork & STACK_WORK_MAC))
+        return;
+
+    // Process as many incomming packets as the budget allows
+    vFrames = 0;
+    dwRxStart = TickGet();
+#if defined(STACK_USE_TCP)
+    TCPRxBatchBegin();
+#endif
     while (1) {
+        // Leave the remaining packets for the next call.  At least one
+        // packet is always processed, however short the time budget.
+        if (vFrames != 0u && (vFrames >= STACK_RX_BUDGET_FRAMES || TickGet() - dwRxStart >= STACK_RX_BUDGET_TICKS)) {
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+            // Frames not yet signalled will post STACK_EVENT_MAC
+            // themselves, so only a frame already signalled needs a
+            // reminder
+            if (MACIsRxPending())
+                bRxPending = true;
+#endif
+            break;
+        }
+
         //if using the random module, generate entropy
 #if defined(STACK_USE_RANDOM)
         RandomAdd(remoteNode.MACAddr.v[5]);
@@ -324,8 +435,20 @@ void StackTask(void)
 
         // Fetch a packet (throws old one away, if not thrown away
         // yet)
-        if (!MACGetHeader(&remoteNode.MACAddr, &cFrameType))
-            break;
+        if (!MACGetHeader(&remoteNode.MACAddr, &cFrameType)) {
+#if defined(WF_CS_TRIS)
+            // The MRF24W signals one packet per interrupt, so service the
+            // next interrupt now rather than on the next call
+            WFProcess();
+            if (!MACGetHeader(&remoteNode.MACAddr, &cFrameType))
+#endif
+                break;
+        }
+
+        vFrames++;
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+        StackEventStats.dwPackets++;
+#endif
 
         // When using a WiFi module, filter out all incoming packets that have
         // the same source MAC address as our own MAC address.  This is to
@@ -387,16 +510,113 @@ void StackTask(void)
 #if defined(STACK_USE_UDP)
             if (cIPFrameType == IP_PROT_UDP) {
                 // Stop processing packets if we came upon a UDP frame with application data in it
-                if (UDPProcess(&remoteNode, &tempLocalIP, dataCount))
+                if (UDPProcess(&remoteNode, &tempLocalIP, dataCount)) {
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+                    // Pick up the remaining packets on the next call
+                    bRxPending = true;
+#endif
+#if defined(STACK_USE_TCP)
+                    TCPRxBatchEnd();
+#endif
                     return;
+                }
             }
 #endif
 
             break;
         }
     }
+
+#if defined(STACK_USE_TCP)
+    // Send the ACKs coalesced over the batch
+    TCPRxBatchEnd();
+#endif
+}
+
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+/*********************************************************************
+ * Function:        static bool StackTakeEvent(STACK_EVENT vEvent)
+ *
+ * PreCondition:    StackInit() is already called.
+ *
+ * Input:           vEvent - Event to check
+ *
+ * Output:          true if vEvent was posted since the last call
+ *
+ * Side Effects:    The event is marked as handled
+ *
+ * Note:            Any number of posts since the last call count
+ *                  as a single event.
+ *
+ ********************************************************************/
+static bool StackTakeEvent(STACK_EVENT vEvent)
+{
+    uint8_t vPosted;
+
+    vPosted = vStackEventsPosted[vEvent];
+    if (vPosted == vStackEventsSeen[vEvent])
+        return false;
+
+    vStackEventsSeen[vEvent] = vPosted;
+    return true;
+}
+
+/*********************************************************************
+ * Function:        bool StackIsIdle(void)
+ *
+ * PreCondition:    StackInit() is already called.
+ *
+ * Input:           None
+ *
+ * Output:          true if StackTask() has no work pending
+ *
+ * Side Effects:    None
+ *
+ * Note:            The application may idle the CPU until the next
+ *                  interrupt when this returns true.  The Tick
+ *                  interrupt only occurs once every 65536 Ticks, so
+ *                  applications that idle for long periods need
+ *                  another wake up source no slower than
+ *                  STACK_TIMER_TASK_INTERVAL to keep TCP timers
+ *                  accurate.
+ *
+ ********************************************************************/
+bool StackIsIdle(void)
+{
+    uint8_t i;
+
+    if (bRxPending)
+        return false;
+
+    for (i = 0; i < STACK_EVENT_COUNT; i++) {
+        if (vStackEventsPosted[i] != vStackEventsSeen[i])
+            return false;
+    }
+
+    return (TickGet() - dwLastTimerTask < STACK_TIMER_TASK_INTERVAL);
 }
 
+/*********************************************************************
+ * Function:        void StackGetEventStats(STACK_EVENT_STATS *stats)
+ *
+ * PreCondition:    StackInit() is already called.
+ *
+ * Input:           stats - Where to store the statistics
+ *
+ * Output:          Number of StackTask() wakeups and received packets
+ *                  since StackInit()
+ *
+ * Side Effects:    None
+ *
+ * Note:            None
+ *
+ ********************************************************************/
+void StackGetEventStats(STACK_EVENT_STATS *stats)
+{
+    *stats = StackEventStats;
+}
+#endif
+
 /*********************************************************************
  * Function:        void StackApplications(void)
  *
@@ -57,6 +57,13 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #error Invalid MAX_HTTP_CONNECTIONS value specified.
 #endif
 
+// Check for potential configuration errors in "tcpip_config.h"
+// Only the MRF24W driver posts STACK_EVENT_MAC, so with a wired MAC
+// received packets would wait for the next STACK_TIMER_TASK_INTERVAL
+#if defined(STACK_USE_EVENT_DRIVEN_TASK) && !defined(WF_CS_TRIS)
+#error STACK_USE_EVENT_DRIVEN_TASK is only supported with the MRF24W
+#endif
+
 // Structure to contain a MAC address
 typedef struct __attribute__((__packed__)) {
     uint8_t v[6];
@@ -116,6 +123,38 @@ APP_CONFIG;
 extern APP_CONFIG AppConfig;
 #endif
 
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+// Sources of work for StackTask() when STACK_USE_EVENT_DRIVEN_TASK is defined
+// in tcpip_config.h.  In that mode StackTask() returns right away unless an
+// event has been posted or the timer driven modules are due to run.
+typedef enum {
+    STACK_EVENT_MAC = 0u, // MAC interrupt: packet received or transmission complete
+    STACK_EVENT_TICK, // Tick timer interrupt
+    STACK_EVENT_TCP, // A TCP socket needs servicing by TCPTick()
+    STACK_EVENT_COUNT
+} STACK_EVENT;
+
+// Statistics for the event-driven StackTask().  Wakeups per packet is
+// dwWakeups / dwPackets.
+typedef struct {
+    uint32_t dwWakeups; // Number of StackTask() calls that found work to do
+    uint32_t dwPackets; // Number of packets received from the MAC
+} STACK_EVENT_STATS;
+
+// Number of times each event has been posted.  Each counter is only ever
+// incremented by the one interrupt or task that posts its event, so posting
+// needs no locking.  StackTask() compares the counters to the values it saw
+// last time to find out which events are pending.
+extern volatile uint8_t vStackEventsPosted[STACK_EVENT_COUNT];
+
+// Posts an event to StackTask().  Safe to use from an ISR as long as each
+// event is only posted from one interrupt level.
+#define StackPostEvent(e) (vStackEventsPosted[(e)]++)
+
+bool StackIsIdle(void);
+void StackGetEventStats(STACK_EVENT_STATS *stats);
+#endif
+
 void StackInit(void);
 void StackTask(void);
 void StackApplications(void);
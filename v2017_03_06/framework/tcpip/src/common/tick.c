@@ -386,6 +386,9 @@ void TickUpdate(void)
     if (INTCONbits.TMR0IF) {
         // Increment internal high tick counter
         dwInternalTicks++;
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+        StackPostEvent(STACK_EVENT_TICK);
+#endif
 
         // Reset interrupt flag
         INTCONbits.TMR0IF = 0;
@@ -413,6 +416,9 @@ void __attribute((interrupt(ipl2AUTO), vector(_TIMER_1_VECTOR), nomips16)) _T1In
 {
     // Increment internal high tick counter
     dwInternalTicks++;
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    StackPostEvent(STACK_EVENT_TICK);
+#endif
 
     // Reset interrupt flag
     IFS0CLR = _IFS0_T1IF_MASK;
@@ -427,6 +433,9 @@ void _ISR _T1Interrupt(void)
 {
     // Increment internal high tick counter
     dwInternalTicks++;
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    StackPostEvent(STACK_EVENT_TICK);
+#endif
 
     // Reset interrupt flag
     IFS0bits.T1IF = 0;
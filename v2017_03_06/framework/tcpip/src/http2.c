@@ -923,21 +923,17 @@ static void HTTPProcess(void)
 static bool HTTPSendFile(void)
 {
     uint16_t numBytes, len;
-    uint8_t c, data[64];
+    uint8_t c;
 
     // Determine how many bytes we can read right now
     len = TCPIsPutReady(sktHTTP);
     numBytes = mMIN(len, curHTTP.nextCallback - curHTTP.byteCount);
 
-    // Get/put as many bytes as possible
+    // Move as many bytes as possible straight from the file to the socket
     curHTTP.byteCount += numBytes;
-    while (numBytes > 0u) {
-        len = MPFSGetArray(curHTTP.file, data, mMIN(numBytes, sizeof (data)));
-        if (len == 0u)
+    if (numBytes > 0u) {
+        if (TCPPutFromMPFS(sktHTTP, curHTTP.file, numBytes) < numBytes)
             return true;
-        else
-            TCPPutArray(sktHTTP, data, len);
-        numBytes -= len;
     }
 
     // Check if a callback index was reached
@@ -1609,7 +1605,8 @@ static HTTP_IO_RESULT HTTPMPFSUpload(void)
             // Make sure it's an MPFS of the correct version
             lenA = TCPGetArray(sktHTTP, c, 10);
             curHTTP.byteCount -= lenA;
-            if (memcmppgm2ram(c, (ROM void *) "\r\n\r\nMPFS\x02\x01", 10) == 0) { // Read as Ver 2.1
+            if (memcmppgm2ram(c, (ROM void *) "\r\n\r\nMPFS\x02\x01", 10) == 0 || // Read as Ver 2.1
+                memcmppgm2ram(c, (ROM void *) "\r\n\r\nMPFS\x02\x02", 10) == 0) { // or Ver 2.2 with name index
                 curHTTP.httpStatus = HTTP_MPFS_OK;
 
                 // Format MPFS storage and put 6 byte tag
@@ -1705,8 +1702,7 @@ static HTTP_IO_RESULT HTTPMPFSUpload(void)
  ***************************************************************************/
 void HTTPIncFile(ROM uint8_t *cFile)
 {
-    uint16_t wCount, wLen;
-    uint8_t data[64];
+    uint16_t wCount;
     MPFS_HANDLE fp;
 
     // Check if this is a first round call
@@ -1724,17 +1720,13 @@ void HTTPIncFile(ROM uint8_t *cFile)
         MPFSSeek(fp, ((TCPIP_UINT32_VAL*) & curHTTP.callbackPos)->w[1], MPFS_SEEK_FORWARD);
     }
 
-    // Get/put as many bytes as possible
+    // Move as many bytes as possible straight from the file to the socket
     wCount = TCPIsPutReady(sktHTTP);
-    while (wCount > 0u) {
-        wLen = MPFSGetArray(fp, data, mMIN(wCount, sizeof (data)));
-        if (wLen == 0u) { // If no bytes were read, an EOF was reached
+    if (wCount > 0u) {
+        if (TCPPutFromMPFS(sktHTTP, fp, wCount) < wCount) { // If fewer bytes were read, an EOF was reached
             MPFSClose(fp);
             curHTTP.callbackPos = 0x00;
             return;
-        } else { // Write the bytes to the socket
-            TCPPutArray(sktHTTP, data, wLen);
-            wCount -= wLen;
         }
     }
 
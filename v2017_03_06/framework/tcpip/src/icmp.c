@@ -131,14 +131,11 @@ void ICMPProcess(NODE_INFO *remote, uint16_t len)
         if (MACCalcRxChecksum(0 + sizeof (IP_HEADER), len))
             return;
 
-        // Calculate new Type, Code, and Checksum values
+        // Calculate new Type, Code, and Checksum values.  Only the Type
+        // changes, so the checksum is adjusted per RFC 1624 rather than
+        // recomputed over the echoed payload.
         dwVal.v[0] = 0x00; // Type: 0 (ICMP echo/ping reply)
-        dwVal.v[2] += 8; // Subtract 0x0800 from the checksum
-        if (dwVal.v[2] < 8u) {
-            dwVal.v[3]++;
-            if (dwVal.v[3] == 0u)
-                dwVal.v[2]++;
-        }
+        dwVal.w[1] = ChecksumAdjust(dwVal.w[1], 0x0008u, dwVal.w[0]);
 
         // Wait for TX hardware to become available (finish transmitting
         // any previous packet)
@@ -81,6 +81,21 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #undef TCP_OPTIMIZE_FOR_SIZE
 #endif
 
+// Normally each socket's TCB is stored in front of its FIFOs in the socket's
+// memory medium, and only the TCB currently in use is cached in PIC RAM.  If
+// you define TCP_TCBS_IN_PIC_RAM, all TCBs are kept in a PIC RAM array
+// instead and are accessed in place, eliminating the copying that occurs
+// every time a different socket is used.  This costs sizeof(TCB) bytes of
+// PIC RAM per socket, but frees the same amount in the memory mediums.  Stub
+// caching is also disabled in this mode, so TCP_OPTIMIZE_FOR_SIZE is ignored.
+// Recommended for parts with plenty of RAM, especially when the sockets are
+// stored in Ethernet or SPI RAM.
+//#define TCP_TCBS_IN_PIC_RAM
+
+#if defined(TCP_TCBS_IN_PIC_RAM) && defined(TCP_OPTIMIZE_FOR_SIZE)
+#undef TCP_OPTIMIZE_FOR_SIZE
+#endif
+
 // TCP Maximum Segment Size for TX.  The TX maximum segment size is actually
 // govered by the remote node's MSS option advirtised during connection
 // establishment.  However, if the remote node specifies an unhandlably large
@@ -89,13 +104,17 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // option, all TX segments are fixed at 536 bytes maximum.
 #define TCP_MAX_SEG_SIZE_TX (1460u)
 
-// TCP Maximum Segment Size for RX.  This value is advirtised during connection
-// establishment and the remote node should obey it.  This should be set to 536
-// to avoid IP layer fragmentation from causing packet loss.  However, raising
-// its value can enhance performance at the (small) risk of introducing
-// incompatibility with certain special remote nodes (ex: ones connected via a
-// slow dial up modem).
-#define TCP_MAX_SEG_SIZE_RX (536u)
+// TCP Maximum Segment Size for RX.  Each socket advirtises an MSS during
+// connection establishment based on its RX FIFO size and the MAC RX buffer
+// size, and the remote node should obey it.  This define is the upper limit
+// for that value.  1460 bytes fills a standard Ethernet frame.  Lowering it to
+// 536 avoids IP layer fragmentation on paths with a smaller MTU (ex: ones
+// using a slow dial up modem) at the cost of more per-packet overhead.
+#define TCP_MAX_SEG_SIZE_RX (1460u)
+
+// Largest RX segment that fits in the MAC RX buffer along with its Ethernet,
+// IP, and TCP headers and any MAC status bytes
+#define TCP_MAX_SEG_SIZE_MAC ((uint16_t)(RXSIZE - 64ul))
 
 // TCP Timeout and retransmit numbers
 #define TCP_START_TIMEOUT_VAL       ((uint32_t)TICK_SECOND*1) // Timeout to retransmit unacked data
@@ -113,6 +132,17 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 #define TCP_SYN_QUEUE_MAX_ENTRIES (3u) // Number of TCP RX SYN packets to save if they cannot be serviced immediately
 #define TCP_SYN_QUEUE_TIMEOUT     ((uint32_t)TICK_SECOND*3) // Timeout for when SYN queue entries are deleted if unserviceable
 
+#define TCP_HASH_TABLE_SIZE (8u) // Number of buckets used to find the socket for an incoming segment.  Must be a power of 2.
+
+#define TCP_TIMER_WHEEL_SLOTS (32u) // Number of slots in the timer wheel used by TCPTick().  Must be a power of 2.
+#define TCP_TIMER_WHEEL_SHIFT (3u)  // Each timer wheel slot spans (1<<TCP_TIMER_WHEEL_SHIFT) TickGetDiv256() counts
+
+#if defined(__XC8)
+#define TCP_MPFS_COPY_BUFFER_SIZE (64u) // Bytes staged through RAM per external storage read by TCPPutFromMPFS()
+#else
+#define TCP_MPFS_COPY_BUFFER_SIZE (256u) // Bytes staged through RAM per external storage read by TCPPutFromMPFS()
+#endif
+
 /****************************************************************************
   Section:
     TCP Header Data Types
@@ -202,12 +232,47 @@ static TCB_STUB TCBStubs[TCP_SOCKET_COUNT] = {'\0'};
 static TCB_STUB TCBStubs[TCP_SOCKET_COUNT];
 #endif
 
+#if defined(TCP_TCBS_IN_PIC_RAM)
+static TCB TCBs[TCP_SOCKET_COUNT]; // TCBs for all sockets, used in place
+#else
 static TCB MyTCB; // Currently loaded TCB
+#endif
 static TCP_SOCKET hCurrentTCP = INVALID_SOCKET; // Current TCP socket
 #if TCP_SYN_QUEUE_MAX_ENTRIES
 static TCP_SYN_QUEUE SYNQueue[TCP_SYN_QUEUE_MAX_ENTRIES]; // Array of saved incoming SYN requests that need to be serviced later
 #endif
 
+// Sockets are chained into buckets by their remoteHash value, so incoming
+// segments only have to examine the sockets that could possibly match.
+// Listening sockets are found through the bucket of their local port, since
+// remoteHash holds the local port while listening.
+static TCP_SOCKET TCBHashHead[TCP_HASH_TABLE_SIZE]; // First socket in each bucket, or INVALID_SOCKET
+static TCP_SOCKET TCBHashNext[TCP_SOCKET_COUNT]; // Next socket in the same bucket, or INVALID_SOCKET
+#if defined(STACK_USE_SSL_SERVER)
+static TCP_SOCKET TCBSSLListenHead; // First socket that has had an SSL listening port added
+static TCP_SOCKET TCBSSLListenNext[TCP_SOCKET_COUNT]; // Next socket with an SSL listening port, or INVALID_SOCKET
+#endif
+
+// Selects the hash bucket for a remoteHash value or local port number
+#define TCPHashBucket(a) ((uint8_t)((a) ^ ((a) >> 8)) & (TCP_HASH_TABLE_SIZE - 1u))
+
+// Sockets with a pending timer are chained into the slot of the timer wheel
+// in which their earliest deadline falls.  Sockets that must be serviced on
+// the next TCPTick() are chained on the ready list instead, and sockets with
+// nothing pending are not on any list.
+#define TCP_TIMER_READY (TCP_TIMER_WHEEL_SLOTS) // List index of the ready list
+#define TCP_TIMER_IDLE  (0xFFu) // Socket is on no list
+static TCP_SOCKET TCBTimerHead[TCP_TIMER_WHEEL_SLOTS + 1]; // First socket in each wheel slot and the ready list
+static TCP_SOCKET TCBTimerNext[TCP_SOCKET_COUNT]; // Next socket in the same list, or INVALID_SOCKET
+static uint8_t TCBTimerList[TCP_SOCKET_COUNT]; // List each socket is on, or TCP_TIMER_IDLE
+static uint16_t wTimerWheelTime; // Wheel time (TickGetDiv256() >> TCP_TIMER_WHEEL_SHIFT) of the last slot moved to the ready list
+
+// While a batch of received frames is being processed, ACKs that would be
+// sent immediately are deferred to TCPRxBatchEnd() so one ACK covers all of
+// the segments a socket received in the batch.
+static bool bRxBatch; // TCPRxBatchBegin() was called
+static bool bRxBatchACKs; // ACKs were deferred to TCPRxBatchEnd()
+
 /****************************************************************************
   Section:
     Function Prototypes
@@ -220,12 +285,30 @@ static void TCPRAMCopyROM(PTR_BASE wDest, uint8_t wDestType, ROM uint8_t * wSour
 #define TCPRAMCopyROM(a,b,c,d) TCPRAMCopy(a,b,c,TCP_PIC_RAM,d)
 #endif
 
+#if defined(STACK_USE_MPFS2)
+static void TCPRAMCopyMPFS(PTR_BASE wDest, uint8_t wDestType, MPFS_HANDLE hMPFS, uint16_t wLength);
+#endif
+
 static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags);
 static void HandleTCPSeg(TCP_HEADER* h, uint16_t len);
 static bool FindMatchingSocket(TCP_HEADER* h, NODE_INFO* remote);
 static void SwapTCPHeader(TCP_HEADER* header);
 static void CloseSocket(void);
+#if !defined(TCP_TCBS_IN_PIC_RAM)
 static void SyncTCB(void);
+#endif
+static void SetRemoteHash(uint16_t wHash);
+static void MoveTCBTimer(TCP_SOCKET hTCP, uint8_t vList);
+static void WakeSocket(void);
+static void ScheduleSocket(void);
+static void TickSocket(TCP_SOCKET hTCP);
+static uint16_t GetBytesInFlight(void);
+static void ResetCongestionWindow(void);
+static void RetransmitFirstSegment(void);
+static uint16_t GetLocalMaxSegSize(void);
+static uint16_t GetRxRangesEnd(void);
+static void AddRxRange(uint16_t wOffset, uint16_t wLength);
+static void AdvanceRxRanges(uint16_t wLength);
 
 #if defined(WF_CS_TRIS)
 uint16_t WFGetTCBSize(void);
@@ -271,6 +354,18 @@ static void SyncTCBStub(TCP_SOCKET hTCP)
 #define MyTCBStub TCBStubs[hCurrentTCP]
 #endif
 
+#if defined(TCP_TCBS_IN_PIC_RAM)
+// Flushes MyTCB cache and loads up the specified TCB.
+// Does nothing since TCBs are used in place.
+#define SyncTCB()
+// Alias to current TCB.
+#define MyTCB TCBs[hCurrentTCP]
+// Bytes of memory medium space used for each TCB
+#define TCB_MEDIUM_SIZE (0u)
+#else
+// Bytes of memory medium space used for each TCB
+#define TCB_MEDIUM_SIZE (sizeof (TCB))
+
 // Flushes MyTCB cache and loads up the specified TCB.
 // Does nothing on cache hit.
 static void SyncTCB(void)
@@ -289,6 +384,65 @@ static void SyncTCB(void)
     hLastTCB = hCurrentTCP;
     TCPRAMCopy((PTR_BASE) & MyTCB, TCP_PIC_RAM, MyTCBStub.bufferTxStart - sizeof (MyTCB), MyTCBStub.vMemoryMedium, sizeof (MyTCB));
 }
+#endif
+
+// Sets the remoteHash of the current socket and moves the socket to the
+// matching hash bucket.  All changes to remoteHash must be made through here.
+static void SetRemoteHash(uint16_t wHash)
+{
+    TCP_SOCKET *p;
+
+    // Unlink from the old bucket (a socket not yet in any bucket is
+    // simply not found)
+    for (p = &TCBHashHead[TCPHashBucket(MyTCBStub.remoteHash.Val)]; *p != INVALID_SOCKET; p = &TCBHashNext[*p]) {
+        if (*p == hCurrentTCP) {
+            *p = TCBHashNext[hCurrentTCP];
+            break;
+        }
+    }
+
+    // Link at the head of the new bucket
+    MyTCBStub.remoteHash.Val = wHash;
+    p = &TCBHashHead[TCPHashBucket(wHash)];
+    TCBHashNext[hCurrentTCP] = *p;
+    *p = hCurrentTCP;
+}
+
+// Moves a socket to a timer wheel slot, the ready list (TCP_TIMER_READY),
+// or off all lists (TCP_TIMER_IDLE).
+static void MoveTCBTimer(TCP_SOCKET hTCP, uint8_t vList)
+{
+    TCP_SOCKET *p;
+
+    if (TCBTimerList[hTCP] != TCP_TIMER_IDLE) {
+        for (p = &TCBTimerHead[TCBTimerList[hTCP]]; *p != INVALID_SOCKET; p = &TCBTimerNext[*p]) {
+            if (*p == hTCP) {
+                *p = TCBTimerNext[hTCP];
+                break;
+            }
+        }
+    }
+
+    TCBTimerList[hTCP] = vList;
+    if (vList != TCP_TIMER_IDLE) {
+        TCBTimerNext[hTCP] = TCBTimerHead[vList];
+        TCBTimerHead[vList] = hTCP;
+    }
+}
+
+// Has the current socket serviced by the next TCPTick() call.  Must be
+// called whenever a timer or flag examined by TCPTick() may have changed
+// outside of TCPTick() itself.
+static void WakeSocket(void)
+{
+    if (TCBTimerList[hCurrentTCP] != TCP_TIMER_READY)
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+
+#if defined(STACK_USE_EVENT_DRIVEN_TASK)
+    // Make sure StackTask() calls TCPTick() to service the socket
+    StackPostEvent(STACK_EVENT_TCP);
+#endif
+}
 
 /*****************************************************************************
   Function:
@@ -346,6 +500,21 @@ void TCPInit(void)
     memset((void *) SYNQueue, 0x00, sizeof (SYNQueue));
 #endif
 
+    // Empty the socket lookup tables.  CloseSocket() below adds each socket.
+    for (i = 0; i < TCP_HASH_TABLE_SIZE; i++)
+        TCBHashHead[i] = INVALID_SOCKET;
+#if defined(STACK_USE_SSL_SERVER)
+    TCBSSLListenHead = INVALID_SOCKET;
+#endif
+
+    // Empty the timer wheel.  CloseSocket() below leaves each socket on the
+    // ready list so TCPTick() schedules it.
+    for (i = 0; i < TCP_TIMER_WHEEL_SLOTS + 1u; i++)
+        TCBTimerHead[i] = INVALID_SOCKET;
+    for (i = 0; i < TCP_SOCKET_COUNT; i++)
+        TCBTimerList[i] = TCP_TIMER_IDLE;
+    wTimerWheelTime = (uint16_t) (TickGetDiv256() >> TCP_TIMER_WHEEL_SHIFT);
+
     // Allocate all socket FIFO addresses
     for (i = 0; i < TCP_SOCKET_COUNT; i++) {
         // Generate all needed sockets of each type (TCP_PURPOSE_*)
@@ -359,7 +528,7 @@ void TCPInit(void)
 #if TCP_ETH_RAM_SIZE > 0
         case TCP_ETH_RAM:
             ptrBaseAddress = wCurrentETHAddress;
-            wCurrentETHAddress += sizeof (TCB) + wTXSize + 1 + wRXSize + 1;
+            wCurrentETHAddress += TCB_MEDIUM_SIZE + wTXSize + 1 + wRXSize + 1;
             // Do a sanity check to ensure that we aren't going to use memory that hasn't been allocated to us.
             // If your code locks up right here, it means you've incorrectly allocated your TCP socket buffers in tcpip_config.h.  See the TCP memory allocation section.  More RAM needs to be allocated to the base memory mediums, or the individual sockets TX and RX FIFOS and socket quantiy needs to be shrunken.
 #if defined(WF_CS_TRIS)
@@ -373,7 +542,7 @@ void TCPInit(void)
 #if TCP_PIC_RAM_SIZE > 0
         case TCP_PIC_RAM:
             ptrBaseAddress = ptrCurrentPICAddress;
-            ptrCurrentPICAddress += sizeof (TCB) + wTXSize + 1 + wRXSize + 1;
+            ptrCurrentPICAddress += TCB_MEDIUM_SIZE + wTXSize + 1 + wRXSize + 1;
             // Do a sanity check to ensure that we aren't going to use memory that hasn't been allocated to us.
             // If your code locks up right here, it means you've incorrectly allocated your TCP socket buffers in tcpip_config.h.  See the TCP memory allocation section.  More RAM needs to be allocated to the base memory mediums, or the individual sockets TX and RX FIFOS and socket quantiy needs to be shrunken.
             while (ptrCurrentPICAddress > TCP_PIC_RAM_BASE_ADDRESS + TCP_PIC_RAM_SIZE);
@@ -383,7 +552,7 @@ void TCPInit(void)
 #if TCP_SPI_RAM_SIZE > 0
         case TCP_SPI_RAM:
             ptrBaseAddress = wCurrentSPIAddress;
-            wCurrentSPIAddress += sizeof (TCB) + wTXSize + 1 + wRXSize + 1;
+            wCurrentSPIAddress += TCB_MEDIUM_SIZE + wTXSize + 1 + wRXSize + 1;
             // Do a sanity check to ensure that we aren't going to use memory that hasn't been allocated to us.
             // If your code locks up right here, it means you've incorrectly allocated your TCP socket buffers in tcpip_config.h.  See the TCP memory allocation section.  More RAM needs to be allocated to the base memory mediums, or the individual sockets TX and RX FIFOS and socket quantiy needs to be shrunken.
             while (wCurrentSPIAddress > TCP_SPI_RAM_BASE_ADDRESS + TCP_SPI_RAM_SIZE);
@@ -396,7 +565,7 @@ void TCPInit(void)
         }
 
         MyTCBStub.vMemoryMedium = vMedium;
-        MyTCBStub.bufferTxStart = ptrBaseAddress + sizeof (TCB);
+        MyTCBStub.bufferTxStart = ptrBaseAddress + TCB_MEDIUM_SIZE;
         MyTCBStub.bufferRxStart = MyTCBStub.bufferTxStart + wTXSize + 1;
         MyTCBStub.bufferEnd = MyTCBStub.bufferRxStart + wRXSize;
         MyTCBStub.smState = TCP_CLOSED;
@@ -558,7 +727,7 @@ TCP_SOCKET TCPOpen(uint32_t dwRemoteHost, uint8_t vRemoteHostType, uint16_t wPor
             MyTCB.localPort.Val = wPort;
             MyTCBStub.Flags.bServer = true;
             MyTCBStub.smState = TCP_LISTEN;
-            MyTCBStub.remoteHash.Val = wPort;
+            SetRemoteHash(wPort);
 #if defined(STACK_USE_SSL_SERVER)
             MyTCB.localSSLPort.Val = 0;
 #endif
@@ -593,7 +762,7 @@ TCP_SOCKET TCPOpen(uint32_t dwRemoteHost, uint8_t vRemoteHostType, uint16_t wPor
                     // dwRemoteHost is a literal IP address.  This
                     // doesn't need DNS and can skip directly to the
                     // Gateway ARPing step.
-                    MyTCBStub.remoteHash.Val = (((TCPIP_UINT32_VAL*) & dwRemoteHost)->w[1]+((TCPIP_UINT32_VAL*) & dwRemoteHost)->w[0] + wPort) ^ MyTCB.localPort.Val;
+                    SetRemoteHash((((TCPIP_UINT32_VAL*) & dwRemoteHost)->w[1]+((TCPIP_UINT32_VAL*) & dwRemoteHost)->w[0] + wPort) ^ MyTCB.localPort.Val);
                     MyTCB.remote.niRemoteMACIP.IPAddr.Val = dwRemoteHost;
                     MyTCB.retryCount = 0;
                     MyTCB.retryInterval = (TICK_SECOND / 4) / 256;
@@ -601,7 +770,7 @@ TCP_SOCKET TCPOpen(uint32_t dwRemoteHost, uint8_t vRemoteHostType, uint16_t wPor
                     break;
 
                 case TCP_OPEN_NODE_INFO:
-                    MyTCBStub.remoteHash.Val = (((NODE_INFO*) (PTR_BASE) dwRemoteHost)->IPAddr.w[1]+((NODE_INFO*) (PTR_BASE) dwRemoteHost)->IPAddr.w[0] + wPort) ^ MyTCB.localPort.Val;
+                    SetRemoteHash((((NODE_INFO*) (PTR_BASE) dwRemoteHost)->IPAddr.w[1]+((NODE_INFO*) (PTR_BASE) dwRemoteHost)->IPAddr.w[0] + wPort) ^ MyTCB.localPort.Val);
                     memcpy((void *) (uint8_t *) & MyTCB.remote, (void *) (uint8_t *) (PTR_BASE) dwRemoteHost, sizeof (NODE_INFO));
                     MyTCBStub.smState = TCP_SYN_SENT;
                     SendTCP(SYN, SENDTCP_RESET_TIMERS);
@@ -615,6 +784,7 @@ TCP_SOCKET TCPOpen(uint32_t dwRemoteHost, uint8_t vRemoteHostType, uint16_t wPor
 #endif
         }
 
+        WakeSocket();
         return hTCP;
     }
 
@@ -802,10 +972,11 @@ void TCPDisconnect(TCP_SOCKET hTCP)
         // more data wating in the TX FIFO than can be sent in a single
         // packet (due to the remote Max Segment Size packet size limit),
         // we will keep generating more packets until either all data gets
-        // transmitted or the remote node's receive window fills up.
+        // transmitted or the remote node's receive window or our
+        // congestion window fills up.
         do {
             SendTCP(FIN | ACK, SENDTCP_RESET_TIMERS);
-            if (MyTCB.remoteWindow == 0u)
+            if ((MyTCB.remoteWindow == 0u) || (GetBytesInFlight() >= MyTCB.wCongestionWindow))
                 break;
         } while (MyTCBStub.txHead != MyTCB.txUnackedTail);
 
@@ -817,10 +988,11 @@ void TCPDisconnect(TCP_SOCKET hTCP)
         // more data wating in the TX FIFO than can be sent in a single
         // packet (due to the remote Max Segment Size packet size limit),
         // we will keep generating more packets until either all data gets
-        // transmitted or the remote node's receive window fills up.
+        // transmitted or the remote node's receive window or our
+        // congestion window fills up.
         do {
             SendTCP(FIN | ACK, SENDTCP_RESET_TIMERS);
-            if (MyTCB.remoteWindow == 0u)
+            if ((MyTCB.remoteWindow == 0u) || (GetBytesInFlight() >= MyTCB.wCongestionWindow))
                 break;
         } while (MyTCBStub.txHead != MyTCB.txUnackedTail);
 
@@ -1110,6 +1282,7 @@ bool TCPPut(TCP_SOCKET hTCP, uint8_t byte)
     else if (!MyTCBStub.Flags.bTimer2Enabled) {
         MyTCBStub.Flags.bTimer2Enabled = true;
         MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_AUTO_TRANSMIT_TIMEOUT_VAL / 256ull;
+        WakeSocket();
     }
 
     return true;
@@ -1214,6 +1387,7 @@ uint16_t TCPPutArray(TCP_SOCKET hTCP, uint8_t * data, uint16_t len)
     else if (!MyTCBStub.Flags.bTimer2Enabled) {
         MyTCBStub.Flags.bTimer2Enabled = true;
         MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_AUTO_TRANSMIT_TIMEOUT_VAL / 256ull;
+        WakeSocket();
     }
 
     return wActualLen + wRightLen;
@@ -1322,6 +1496,116 @@ uint16_t TCPPutROMArray(TCP_SOCKET hTCP, ROM uint8_t * data, uint16_t len)
     else if (!MyTCBStub.Flags.bTimer2Enabled) {
         MyTCBStub.Flags.bTimer2Enabled = true;
         MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_AUTO_TRANSMIT_TIMEOUT_VAL / 256ull;
+        WakeSocket();
+    }
+
+    return wActualLen + wRightLen;
+}
+#endif
+
+/*****************************************************************************
+  Function:
+    uint16_t TCPPutFromMPFS(TCP_SOCKET hTCP, MPFS_HANDLE hMPFS, uint16_t len)
+
+  Description:
+    Writes the next bytes of an MPFS file to a TCP socket.
+
+  Precondition:
+    TCP is initialized and hMPFS is open for reading.
+
+  Parameters:
+    hTCP  - The socket to which data is to be written.
+    hMPFS - The file from which data is to be read.
+    len   - Number of bytes to be written.
+
+  Returns:
+    The number of bytes written to the socket.  If less than len, the
+    buffer became full, the end of the file was reached, or the socket is
+    not conected.
+
+  Remarks:
+    The file data is moved straight into the socket's TX FIFO instead of
+    being staged through an application buffer and TCPPutArray().  See
+    TCPRAMCopyMPFS() for how each storage medium is handled.
+ ***************************************************************************/
+#if defined(STACK_USE_MPFS2)
+uint16_t TCPPutFromMPFS(TCP_SOCKET hTCP, MPFS_HANDLE hMPFS, uint16_t len)
+{
+    uint16_t wActualLen;
+    uint16_t wFreeTXSpace;
+    uint16_t wRightLen = 0;
+    PTR_BASE ptrHead;
+
+    if (hTCP >= TCP_SOCKET_COUNT) {
+        return 0;
+    }
+
+    // Never move the FIFO head past the data that can actually be read
+    if (MPFSGetBytesRem(hMPFS) < (uint32_t) len)
+        len = (uint16_t) MPFSGetBytesRem(hMPFS);
+    if (len == 0u)
+        return 0;
+
+    SyncTCBStub(hTCP);
+
+    wFreeTXSpace = TCPIsPutReady(hTCP);
+    if (wFreeTXSpace == 0u) {
+        TCPFlush(hTCP);
+        return 0;
+    }
+
+    wActualLen = wFreeTXSpace;
+    if (wFreeTXSpace > len)
+        wActualLen = len;
+
+    // Send all current bytes if we are crossing half full
+    // This is required to improve performance with the delayed
+    // acknowledgement algorithm
+    if ((!MyTCBStub.Flags.bHalfFullFlush) && (wFreeTXSpace <= ((MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart) >> 1))) {
+        TCPFlush(hTCP);
+        MyTCBStub.Flags.bHalfFullFlush = true;
+    }
+
+#if defined(STACK_USE_SSL)
+    if (MyTCBStub.sslStubID != SSL_INVALID_ID)
+        ptrHead = MyTCBStub.sslTxHead;
+    else
+        ptrHead = MyTCBStub.txHead;
+#else
+    ptrHead = MyTCBStub.txHead;
+#endif
+
+    // See if we need a two part put
+    if (ptrHead + wActualLen >= MyTCBStub.bufferRxStart) {
+        wRightLen = MyTCBStub.bufferRxStart - ptrHead;
+        TCPRAMCopyMPFS(ptrHead, MyTCBStub.vMemoryMedium, hMPFS, wRightLen);
+        wActualLen -= wRightLen;
+        ptrHead = MyTCBStub.bufferTxStart;
+    }
+
+    TCPRAMCopyMPFS(ptrHead, MyTCBStub.vMemoryMedium, hMPFS, wActualLen);
+    ptrHead += wActualLen;
+
+#if defined(STACK_USE_SSL)
+    if (MyTCBStub.sslStubID != SSL_INVALID_ID)
+        MyTCBStub.sslTxHead = ptrHead;
+    else
+        MyTCBStub.txHead = ptrHead;
+#else
+    MyTCBStub.txHead = ptrHead;
+#endif
+
+    // Send these bytes right now if we are out of TX buffer space
+    if (wFreeTXSpace <= len) {
+        TCPFlush(hTCP);
+    }
+    // If not already enabled, start a timer so this data will
+    // eventually get sent even if the application doens't call
+    // TCPFlush()
+    else if (!MyTCBStub.Flags.bTimer2Enabled) {
+        MyTCBStub.Flags.bTimer2Enabled = true;
+        MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_AUTO_TRANSMIT_TIMEOUT_VAL / 256ull;
+        WakeSocket();
     }
 
     return wActualLen + wRightLen;
@@ -1539,12 +1823,14 @@ bool TCPGet(TCP_SOCKET hTCP, uint8_t * byte)
     // Send a window update if we've run out of data
     if (wGetReadyCount == 1u) {
         MyTCBStub.Flags.bTXASAPWithoutTimerReset = 1;
+        WakeSocket();
     }
     // If not already enabled, start a timer so a window
     // update will get sent to the remote node at some point
     else if (!MyTCBStub.Flags.bTimer2Enabled) {
         MyTCBStub.Flags.bTimer2Enabled = true;
         MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_WINDOW_UPDATE_TIMEOUT_VAL / 256ull;
+        WakeSocket();
     }
 
     return true;
@@ -1605,11 +1891,13 @@ uint16_t TCPGetArray(TCP_SOCKET hTCP, uint8_t * buffer, uint16_t len)
     // Send a window update if we've run low on data
     if (wGetReadyCount - len <= len) {
         MyTCBStub.Flags.bTXASAPWithoutTimerReset = 1;
+        WakeSocket();
     } else if (!MyTCBStub.Flags.bTimer2Enabled) {
         // If not already enabled, start a timer so a window
         // update will get sent to the remote node at some point
         MyTCBStub.Flags.bTimer2Enabled = true;
         MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256() + TCP_WINDOW_UPDATE_TIMEOUT_VAL / 256ull;
+        WakeSocket();
     }
 
     return len;
@@ -2169,9 +2457,11 @@ uint16_t TCPFindEx(TCP_SOCKET hTCP, uint8_t cFind, uint16_t wStart, uint16_t wSe
     Performs periodic TCP tasks.
 
   Description:
-    This function performs any required periodic TCP tasks.  Each
-    socket's state machine is checked, and any elapsed timeout periods
-    are handled.
+    This function performs any required periodic TCP tasks.  Sockets are
+    kept on a timer wheel keyed by their earliest deadline, so only the
+    sockets whose deadline has passed, or that were woken by socket API
+    calls or incoming segments, have their state machines checked and
+    elapsed timeout periods handled.
 
   Precondition:
     TCP is initialized.
@@ -2185,386 +2475,638 @@ uint16_t TCPFindEx(TCP_SOCKET hTCP, uint8_t cFind, uint16_t wStart, uint16_t wSe
 void TCPTick(void)
 {
     TCP_SOCKET hTCP;
+    TCP_SOCKET hNextTCP;
+    uint16_t w;
+    uint16_t wNow;
+
+    // Move the sockets in every timer wheel slot that has come due onto the
+    // ready list.  If the wheel was not turned for a full revolution, every
+    // slot is due.
+    wNow = (uint16_t) (TickGetDiv256() >> TCP_TIMER_WHEEL_SHIFT);
+    for (w = 0; w < TCP_TIMER_WHEEL_SLOTS && wTimerWheelTime != wNow; w++) {
+        wTimerWheelTime++;
+        while ((hTCP = TCBTimerHead[wTimerWheelTime & (TCP_TIMER_WHEEL_SLOTS - 1u)]) != INVALID_SOCKET)
+            MoveTCBTimer(hTCP, TCP_TIMER_READY);
+    }
+    wTimerWheelTime = wNow;
+
+    // Service only the sockets on the ready list and then file each one
+    // under its next deadline.  Sockets woken while this runs are left on a
+    // fresh ready list for the next call.
+    hTCP = TCBTimerHead[TCP_TIMER_READY];
+    TCBTimerHead[TCP_TIMER_READY] = INVALID_SOCKET;
+    while (hTCP != INVALID_SOCKET) {
+        hNextTCP = TCBTimerNext[hTCP];
+        TCBTimerList[hTCP] = TCP_TIMER_IDLE;
+
+        TickSocket(hTCP);
+        SyncTCBStub(hTCP);
+        ScheduleSocket();
+
+        hTCP = hNextTCP;
+    }
+
+#if TCP_SYN_QUEUE_MAX_ENTRIES
+    // Process SYN Queue entry timeouts
+    for (w = 0; w < TCP_SYN_QUEUE_MAX_ENTRIES; w++) {
+        // Abort search if there are no more valid records
+        if (SYNQueue[w].wDestPort == 0u)
+            break;
+
+        // See if this SYN has timed out
+        if ((uint16_t) TickGetDiv256() - SYNQueue[w].wTimestamp > (uint16_t) (TCP_SYN_QUEUE_TIMEOUT / 256ull)) {
+            // Delete this SYN from the SYNQueue and compact the SYNQueue[] array
+            TCPRAMCopy((PTR_BASE) & SYNQueue[w], TCP_PIC_RAM, (PTR_BASE) & SYNQueue[w + 1], TCP_PIC_RAM, (TCP_SYN_QUEUE_MAX_ENTRIES - 1u - w) * sizeof (TCP_SYN_QUEUE));
+            SYNQueue[TCP_SYN_QUEUE_MAX_ENTRIES - 1].wDestPort = 0u;
+
+            // Since we deleted an entry, we need to roll back one
+            // index so next loop will process the correct record
+            w--;
+        }
+    }
+#endif
+}
+
+/*****************************************************************************
+  Function:
+    static void TickSocket(TCP_SOCKET hTCP)
+
+  Summary:
+    Performs the periodic tasks of one socket.
+
+  Description:
+    This function handles the SSL processing, pending transmissions, SYN
+    queue and elapsed timeouts of a single socket.  It is called by
+    TCPTick() for each socket on the ready list.
+
+  Precondition:
+    TCP is initialized.
+
+  Parameters:
+    hTCP - The socket to service
+
+  Returns:
+    None
+ ***************************************************************************/
+static void TickSocket(TCP_SOCKET hTCP)
+{
     bool bRetransmit;
     bool bCloseSocket;
     uint8_t vFlags;
     uint16_t w;
 
-    // Periodically all "not closed" sockets must perform timed operations
-    for (hTCP = 0; hTCP < TCP_SOCKET_COUNT; hTCP++) {
-        SyncTCBStub(hTCP);
+    SyncTCBStub(hTCP);
 
-        // Handle any SSL Processing and Message Transmission
+    // Handle any SSL Processing and Message Transmission
 #if defined(STACK_USE_SSL)
-        if (MyTCBStub.sslStubID != SSL_INVALID_ID) {
-            // Handle any periodic tasks, such as RSA operations
-            SSLPeriodic(hTCP, MyTCBStub.sslStubID);
+    if (MyTCBStub.sslStubID != SSL_INVALID_ID) {
+        // Handle any periodic tasks, such as RSA operations
+        SSLPeriodic(hTCP, MyTCBStub.sslStubID);
 
-            // If unsent data is waiting, transmit it as an application record
-            if (MyTCBStub.sslTxHead != MyTCBStub.txHead && TCPSSLGetPendingTxSize(hTCP) != 0u)
-                SSLTxRecord(hTCP, MyTCBStub.sslStubID, SSL_APPLICATION);
+        // If unsent data is waiting, transmit it as an application record
+        if (MyTCBStub.sslTxHead != MyTCBStub.txHead && TCPSSLGetPendingTxSize(hTCP) != 0u)
+            SSLTxRecord(hTCP, MyTCBStub.sslStubID, SSL_APPLICATION);
 
-            // If an SSL message is requested, send it now
-            if (MyTCBStub.sslReqMessage != SSL_NO_MESSAGE)
-                SSLTxMessage(hTCP, MyTCBStub.sslStubID, MyTCBStub.sslReqMessage);
-        }
+        // If an SSL message is requested, send it now
+        if (MyTCBStub.sslReqMessage != SSL_NO_MESSAGE)
+            SSLTxMessage(hTCP, MyTCBStub.sslStubID, MyTCBStub.sslReqMessage);
+    }
 #endif
 
-        vFlags = 0x00;
-        bRetransmit = false;
-        bCloseSocket = false;
+    vFlags = 0x00;
+    bRetransmit = false;
+    bCloseSocket = false;
 
-        // Transmit ASAP data if the medium is available
-        if (MyTCBStub.Flags.bTXASAP || MyTCBStub.Flags.bTXASAPWithoutTimerReset) {
-            if (MACIsTxReady()) {
-                vFlags = ACK;
-                bRetransmit = MyTCBStub.Flags.bTXASAPWithoutTimerReset;
-            }
+    // Transmit ASAP data if the medium is available
+    if (MyTCBStub.Flags.bTXASAP || MyTCBStub.Flags.bTXASAPWithoutTimerReset) {
+        if (MACIsTxReady()) {
+            vFlags = ACK;
+            bRetransmit = MyTCBStub.Flags.bTXASAPWithoutTimerReset;
         }
+    }
 
-        // Perform any needed window updates and data transmissions
-        if (MyTCBStub.Flags.bTimer2Enabled) {
-            // See if the timeout has occured, and we need to send a new window update and pending data
-            if ((int16_t) (MyTCBStub.eventTime2 - (uint16_t) TickGetDiv256()) <= (int16_t) 0)
-                vFlags = ACK;
-        }
+    // Perform any needed window updates and data transmissions
+    if (MyTCBStub.Flags.bTimer2Enabled) {
+        // See if the timeout has occured, and we need to send a new window update and pending data
+        if ((int16_t) (MyTCBStub.eventTime2 - (uint16_t) TickGetDiv256()) <= (int16_t) 0)
+            vFlags = ACK;
+    }
 
-        // Process Delayed ACKnowledgement timer
-        if (MyTCBStub.Flags.bDelayedACKTimerEnabled) {
-            // See if the timeout has occured and delayed ACK needs to be sent
-            if ((int16_t) (MyTCBStub.OverlappedTimers.delayedACKTime - (uint16_t) TickGetDiv256()) <= (int16_t) 0)
-                vFlags = ACK;
-        }
+    // Process Delayed ACKnowledgement timer
+    if (MyTCBStub.Flags.bDelayedACKTimerEnabled) {
+        // See if the timeout has occured and delayed ACK needs to be sent
+        if ((int16_t) (MyTCBStub.OverlappedTimers.delayedACKTime - (uint16_t) TickGetDiv256()) <= (int16_t) 0)
+            vFlags = ACK;
+    }
 
-        // Process TCP_CLOSE_WAIT timer
-        if (MyTCBStub.smState == TCP_CLOSE_WAIT) {
-            // Automatically close the socket on our end if the application
-            // fails to call TCPDisconnect() is a reasonable amount of time.
-            if ((int16_t) (MyTCBStub.OverlappedTimers.closeWaitTime - (uint16_t) TickGetDiv256()) <= (int16_t) 0) {
-                vFlags = FIN | ACK;
-                MyTCBStub.smState = TCP_LAST_ACK;
-            }
+    // Process TCP_CLOSE_WAIT timer
+    if (MyTCBStub.smState == TCP_CLOSE_WAIT) {
+        // Automatically close the socket on our end if the application
+        // fails to call TCPDisconnect() is a reasonable amount of time.
+        if ((int16_t) (MyTCBStub.OverlappedTimers.closeWaitTime - (uint16_t) TickGetDiv256()) <= (int16_t) 0) {
+            vFlags = FIN | ACK;
+            MyTCBStub.smState = TCP_LAST_ACK;
         }
+    }
 
-        // Process listening server sockets that might have a SYN waiting in the SYNQueue[]
+    // Process listening server sockets that might have a SYN waiting in the SYNQueue[]
 #if TCP_SYN_QUEUE_MAX_ENTRIES
-        if (MyTCBStub.smState == TCP_LISTEN) {
-            for (w = 0; w < TCP_SYN_QUEUE_MAX_ENTRIES; w++) {
-                // Abort search if there are no more valid records
-                if (SYNQueue[w].wDestPort == 0u)
-                    break;
+    if (MyTCBStub.smState == TCP_LISTEN) {
+        for (w = 0; w < TCP_SYN_QUEUE_MAX_ENTRIES; w++) {
+            // Abort search if there are no more valid records
+            if (SYNQueue[w].wDestPort == 0u)
+                break;
 
-                // Stop searching if this SYN queue entry can be used by this socket
+            // Stop searching if this SYN queue entry can be used by this socket
 #if defined(STACK_USE_SSL_SERVER)
-                if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val || SYNQueue[w].wDestPort == MyTCBStub.sslTxHead)
+            if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val || SYNQueue[w].wDestPort == MyTCBStub.sslTxHead)
 #else
-                if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val)
+            if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val)
 #endif
-                {
-                    // Set up our socket and generate a reponse SYN+ACK packet
-                    SyncTCB();
+            {
+                // Set up our socket and generate a reponse SYN+ACK packet
+                SyncTCB();
 
 #if defined(STACK_USE_SSL_SERVER)
-                    // If this matches the SSL port, make sure that can be configured
-                    // before continuing.  If not, break and leave this in the queue
-                    if (SYNQueue[w].wDestPort == MyTCBStub.sslTxHead && !TCPStartSSLServer(hTCP))
-                        break;
+                // If this matches the SSL port, make sure that can be configured
+                // before continuing.  If not, break and leave this in the queue
+                if (SYNQueue[w].wDestPort == MyTCBStub.sslTxHead && !TCPStartSSLServer(hTCP))
+                    break;
 #endif
 
-                    memcpy((void *) &MyTCB.remote.niRemoteMACIP, (void *) &SYNQueue[w].niSourceAddress, sizeof (NODE_INFO));
-                    MyTCB.remotePort.Val = SYNQueue[w].wSourcePort;
-                    MyTCB.RemoteSEQ = SYNQueue[w].dwSourceSEQ + 1;
-                    MyTCBStub.remoteHash.Val = (MyTCB.remote.niRemoteMACIP.IPAddr.w[1] + MyTCB.remote.niRemoteMACIP.IPAddr.w[0] + MyTCB.remotePort.Val) ^ MyTCB.localPort.Val;
-                    vFlags = SYN | ACK;
-                    MyTCBStub.smState = TCP_SYN_RECEIVED;
+                memcpy((void *) &MyTCB.remote.niRemoteMACIP, (void *) &SYNQueue[w].niSourceAddress, sizeof (NODE_INFO));
+                MyTCB.remotePort.Val = SYNQueue[w].wSourcePort;
+                MyTCB.RemoteSEQ = SYNQueue[w].dwSourceSEQ + 1;
+                SetRemoteHash((MyTCB.remote.niRemoteMACIP.IPAddr.w[1] + MyTCB.remote.niRemoteMACIP.IPAddr.w[0] + MyTCB.remotePort.Val) ^ MyTCB.localPort.Val);
+                vFlags = SYN | ACK;
+                MyTCBStub.smState = TCP_SYN_RECEIVED;
 
-                    // Delete this SYN from the SYNQueue and compact the SYNQueue[] array
-                    TCPRAMCopy((PTR_BASE) & SYNQueue[w], TCP_PIC_RAM, (PTR_BASE) & SYNQueue[w + 1], TCP_PIC_RAM, (TCP_SYN_QUEUE_MAX_ENTRIES - 1u - w) * sizeof (TCP_SYN_QUEUE));
-                    SYNQueue[TCP_SYN_QUEUE_MAX_ENTRIES - 1].wDestPort = 0u;
+                // Delete this SYN from the SYNQueue and compact the SYNQueue[] array
+                TCPRAMCopy((PTR_BASE) & SYNQueue[w], TCP_PIC_RAM, (PTR_BASE) & SYNQueue[w + 1], TCP_PIC_RAM, (TCP_SYN_QUEUE_MAX_ENTRIES - 1u - w) * sizeof (TCP_SYN_QUEUE));
+                SYNQueue[TCP_SYN_QUEUE_MAX_ENTRIES - 1].wDestPort = 0u;
 
-                    break;
-                }
+                break;
             }
         }
+    }
 #endif
 
-        if (vFlags)
-            SendTCP(vFlags, bRetransmit ? 0 : SENDTCP_RESET_TIMERS);
+    if (vFlags)
+        SendTCP(vFlags, bRetransmit ? 0 : SENDTCP_RESET_TIMERS);
 
-        // The TCP_CLOSED, TCP_LISTEN, and sometimes the TCP_ESTABLISHED
-        // state don't need any timeout events, so see if the timer is enabled
-        if (!MyTCBStub.Flags.bTimerEnabled) {
+    // The TCP_CLOSED, TCP_LISTEN, and sometimes the TCP_ESTABLISHED
+    // state don't need any timeout events, so see if the timer is enabled
+    if (!MyTCBStub.Flags.bTimerEnabled) {
 #if defined(TCP_KEEP_ALIVE_TIMEOUT)
-            // Only the established state has any use for keep-alives
-            if (MyTCBStub.smState == TCP_ESTABLISHED) {
-                // If timeout has not occured, do not do anything.
-                if ((int32_t) (TickGet() - MyTCBStub.eventTime) < (int32_t) 0)
-                    continue;
-
-                // If timeout has occured and the connection appears to be dead (no
-                // responses from remote node at all), close the connection so the
-                // application doesn't sit around indefinitely with a useless socket
-                // that it thinks is still open
-                if (MyTCBStub.Flags.vUnackedKeepalives == TCP_MAX_UNACKED_KEEP_ALIVES) {
-                    vFlags = MyTCBStub.Flags.bServer;
-
-                    // Force an immediate FIN and RST transmission
-                    // Double calling TCPDisconnect() will also place us
-                    // back in the listening state immediately if a server socket.
-                    TCPDisconnect(hTCP);
-                    TCPDisconnect(hTCP);
-
-                    // Prevent client mode sockets from getting reused by other applications.
-                    // The application must call TCPDisconnect() with the handle to free this
-                    // socket (and the handle associated with it)
-                    if (!vFlags)
-                        MyTCBStub.smState = TCP_CLOSED_BUT_RESERVED;
-
-                    continue;
-                }
+        // Only the established state has any use for keep-alives
+        if (MyTCBStub.smState == TCP_ESTABLISHED) {
+            // If timeout has not occured, do not do anything.
+            if ((int32_t) (TickGet() - MyTCBStub.eventTime) < (int32_t) 0)
+                return;
 
-                // Otherwise, if a timeout occured, simply send a keep-alive packet
-                SyncTCB();
-                SendTCP(ACK, SENDTCP_KEEP_ALIVE);
-                MyTCBStub.eventTime = TickGet() + TCP_KEEP_ALIVE_TIMEOUT;
+            // If timeout has occured and the connection appears to be dead (no
+            // responses from remote node at all), close the connection so the
+            // application doesn't sit around indefinitely with a useless socket
+            // that it thinks is still open
+            if (MyTCBStub.Flags.vUnackedKeepalives == TCP_MAX_UNACKED_KEEP_ALIVES) {
+                vFlags = MyTCBStub.Flags.bServer;
+
+                // Force an immediate FIN and RST transmission
+                // Double calling TCPDisconnect() will also place us
+                // back in the listening state immediately if a server socket.
+                TCPDisconnect(hTCP);
+                TCPDisconnect(hTCP);
+
+                // Prevent client mode sockets from getting reused by other applications.
+                // The application must call TCPDisconnect() with the handle to free this
+                // socket (and the handle associated with it)
+                if (!vFlags)
+                    MyTCBStub.smState = TCP_CLOSED_BUT_RESERVED;
+
+                return;
             }
-#endif
-            continue;
+
+            // Otherwise, if a timeout occured, simply send a keep-alive packet
+            SyncTCB();
+            SendTCP(ACK, SENDTCP_KEEP_ALIVE);
+            MyTCBStub.eventTime = TickGet() + TCP_KEEP_ALIVE_TIMEOUT;
         }
+#endif
+        return;
+    }
 
-        // If timeout has not occured, do not do anything.
-        if ((int32_t) (TickGet() - MyTCBStub.eventTime) < (int32_t) 0)
-            continue;
+    // If timeout has not occured, do not do anything.
+    if ((int32_t) (TickGet() - MyTCBStub.eventTime) < (int32_t) 0)
+        return;
 
-        // Load up extended TCB information
-        SyncTCB();
+    // Load up extended TCB information
+    SyncTCB();
 
-        // A timeout has occured.  Respond to this timeout condition
-        // depending on what state this socket is in.
-        switch (MyTCBStub.smState) {
+    // A timeout has occured.  Respond to this timeout condition
+    // depending on what state this socket is in.
+    switch (MyTCBStub.smState) {
 #if defined(STACK_CLIENT_MODE)
 #if defined(STACK_USE_DNS_CLIENT)
-        case TCP_GET_DNS_MODULE:
-            if (DNSBeginUsage()) {
-                MyTCBStub.smState = TCP_DNS_RESOLVE;
-                if (MyTCB.flags.bRemoteHostIsROM)
-                    DNSResolveROM((ROM uint8_t *) (ROM_PTR_BASE) MyTCB.remote.dwRemoteHost, DNS_TYPE_A);
-                else
-                    DNSResolve((uint8_t *) (PTR_BASE) MyTCB.remote.dwRemoteHost, DNS_TYPE_A);
-            }
-            break;
+    case TCP_GET_DNS_MODULE:
+        if (DNSBeginUsage()) {
+            MyTCBStub.smState = TCP_DNS_RESOLVE;
+            if (MyTCB.flags.bRemoteHostIsROM)
+                DNSResolveROM((ROM uint8_t *) (ROM_PTR_BASE) MyTCB.remote.dwRemoteHost, DNS_TYPE_A);
+            else
+                DNSResolve((uint8_t *) (PTR_BASE) MyTCB.remote.dwRemoteHost, DNS_TYPE_A);
+        }
+        break;
 
-        case TCP_DNS_RESOLVE:
-        {
-            IP_ADDR ipResolvedDNSIP;
-
-            // See if DNS resolution has finished.  Note that if the DNS
-            // fails, the &ipResolvedDNSIP will be written with 0x00000000.
-            // MyTCB.remote.dwRemoteHost is unioned with
-            // MyTCB.remote.niRemoteMACIP.IPAddr, so we can't directly write
-            // the DNS result into MyTCB.remote.niRemoteMACIP.IPAddr.  We
-            // must copy it over only if the DNS is resolution step was
-            // successful.
-            if (DNSIsResolved(&ipResolvedDNSIP)) {
-                if (DNSEndUsage()) {
-                    MyTCB.remote.niRemoteMACIP.IPAddr.Val = ipResolvedDNSIP.Val;
-                    MyTCBStub.smState = TCP_GATEWAY_SEND_ARP;
-                    MyTCBStub.remoteHash.Val = (MyTCB.remote.niRemoteMACIP.IPAddr.w[1] + MyTCB.remote.niRemoteMACIP.IPAddr.w[0] + MyTCB.remotePort.Val) ^ MyTCB.localPort.Val;
-                    MyTCB.retryCount = 0;
-                    MyTCB.retryInterval = (TICK_SECOND / 4) / 256;
-                } else {
-                    MyTCBStub.eventTime = TickGet() + 10 * TICK_SECOND;
-                    MyTCBStub.smState = TCP_GET_DNS_MODULE;
-                }
+    case TCP_DNS_RESOLVE:
+    {
+        IP_ADDR ipResolvedDNSIP;
+
+        // See if DNS resolution has finished.  Note that if the DNS
+        // fails, the &ipResolvedDNSIP will be written with 0x00000000.
+        // MyTCB.remote.dwRemoteHost is unioned with
+        // MyTCB.remote.niRemoteMACIP.IPAddr, so we can't directly write
+        // the DNS result into MyTCB.remote.niRemoteMACIP.IPAddr.  We
+        // must copy it over only if the DNS is resolution step was
+        // successful.
+        if (DNSIsResolved(&ipResolvedDNSIP)) {
+            if (DNSEndUsage()) {
+                MyTCB.remote.niRemoteMACIP.IPAddr.Val = ipResolvedDNSIP.Val;
+                MyTCBStub.smState = TCP_GATEWAY_SEND_ARP;
+                SetRemoteHash((MyTCB.remote.niRemoteMACIP.IPAddr.w[1] + MyTCB.remote.niRemoteMACIP.IPAddr.w[0] + MyTCB.remotePort.Val) ^ MyTCB.localPort.Val);
+                MyTCB.retryCount = 0;
+                MyTCB.retryInterval = (TICK_SECOND / 4) / 256;
+            } else {
+                MyTCBStub.eventTime = TickGet() + 10 * TICK_SECOND;
+                MyTCBStub.smState = TCP_GET_DNS_MODULE;
             }
-            break;
         }
+        break;
+    }
 #endif // #if defined(STACK_USE_DNS_CLIENT)
 
-        case TCP_GATEWAY_SEND_ARP:
-            // Obtain the MAC address associated with the server's IP address (either direct MAC address on same subnet, or the MAC address of the Gateway machine)
-            MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256();
-            ARPResolve(&MyTCB.remote.niRemoteMACIP.IPAddr);
-            MyTCBStub.smState = TCP_GATEWAY_GET_ARP;
-            break;
-
-        case TCP_GATEWAY_GET_ARP:
-            // Wait for the MAC address to finish being obtained
-            if (!ARPIsResolved(&MyTCB.remote.niRemoteMACIP.IPAddr, &MyTCB.remote.niRemoteMACIP.MACAddr)) {
-                // Time out if too much time is spent in this state
-                // Note that this will continuously send out ARP
-                // requests for an infinite time if the Gateway
-                // never responds
-                if ((uint16_t) TickGetDiv256() - MyTCBStub.eventTime2 > (uint16_t) MyTCB.retryInterval) {
-                    // Exponentially increase timeout until we reach 6 attempts then stay constant
-                    if (MyTCB.retryCount < 6u) {
-                        MyTCB.retryCount++;
-                        MyTCB.retryInterval <<= 1;
-                    }
+    case TCP_GATEWAY_SEND_ARP:
+        // Obtain the MAC address associated with the server's IP address (either direct MAC address on same subnet, or the MAC address of the Gateway machine)
+        MyTCBStub.eventTime2 = (uint16_t) TickGetDiv256();
+        ARPResolve(&MyTCB.remote.niRemoteMACIP.IPAddr);
+        MyTCBStub.smState = TCP_GATEWAY_GET_ARP;
+        break;
 
-                    // Retransmit ARP request
-                    MyTCBStub.smState = TCP_GATEWAY_SEND_ARP;
+    case TCP_GATEWAY_GET_ARP:
+        // Wait for the MAC address to finish being obtained
+        if (!ARPIsResolved(&MyTCB.remote.niRemoteMACIP.IPAddr, &MyTCB.remote.niRemoteMACIP.MACAddr)) {
+            // Time out if too much time is spent in this state
+            // Note that this will continuously send out ARP
+            // requests for an infinite time if the Gateway
+            // never responds
+            if ((uint16_t) TickGetDiv256() - MyTCBStub.eventTime2 > (uint16_t) MyTCB.retryInterval) {
+                // Exponentially increase timeout until we reach 6 attempts then stay constant
+                if (MyTCB.retryCount < 6u) {
+                    MyTCB.retryCount++;
+                    MyTCB.retryInterval <<= 1;
                 }
-                break;
-            }
 
-            // Send out SYN connection request to remote node
-            // This automatically disables the Timer from
-            // continuously firing for this socket
-            vFlags = SYN;
-            bRetransmit = false;
-            MyTCBStub.smState = TCP_SYN_SENT;
+                // Retransmit ARP request
+                MyTCBStub.smState = TCP_GATEWAY_SEND_ARP;
+            }
             break;
+        }
+
+        // Send out SYN connection request to remote node
+        // This automatically disables the Timer from
+        // continuously firing for this socket
+        vFlags = SYN;
+        bRetransmit = false;
+        MyTCBStub.smState = TCP_SYN_SENT;
+        break;
 #endif // #if defined(STACK_CLIENT_MODE)
 
-        case TCP_SYN_SENT:
-            // Keep sending SYN until we hear from remote node.
-            // This may be for infinite time, in that case
-            // caller must detect it and do something.
-            vFlags = SYN;
-            bRetransmit = true;
+    case TCP_SYN_SENT:
+        // Keep sending SYN until we hear from remote node.
+        // This may be for infinite time, in that case
+        // caller must detect it and do something.
+        vFlags = SYN;
+        bRetransmit = true;
+
+        // Exponentially increase timeout until we reach TCP_MAX_RETRIES attempts then stay constant
+        if (MyTCB.retryCount >= (TCP_MAX_RETRIES - 1)) {
+            MyTCB.retryCount = TCP_MAX_RETRIES - 1;
+            MyTCB.retryInterval = TCP_START_TIMEOUT_VAL << (TCP_MAX_RETRIES - 1);
+        }
+        break;
 
-            // Exponentially increase timeout until we reach TCP_MAX_RETRIES attempts then stay constant
-            if (MyTCB.retryCount >= (TCP_MAX_RETRIES - 1)) {
-                MyTCB.retryCount = TCP_MAX_RETRIES - 1;
-                MyTCB.retryInterval = TCP_START_TIMEOUT_VAL << (TCP_MAX_RETRIES - 1);
-            }
-            break;
-
-        case TCP_SYN_RECEIVED:
-            // We must receive ACK before timeout expires.
-            // If not, resend SYN+ACK.
-            // Abort, if maximum attempts counts are reached.
-            if (MyTCB.retryCount < TCP_MAX_SYN_RETRIES) {
-                vFlags = SYN | ACK;
-                bRetransmit = true;
+    case TCP_SYN_RECEIVED:
+        // We must receive ACK before timeout expires.
+        // If not, resend SYN+ACK.
+        // Abort, if maximum attempts counts are reached.
+        if (MyTCB.retryCount < TCP_MAX_SYN_RETRIES) {
+            vFlags = SYN | ACK;
+            bRetransmit = true;
+        } else {
+            if (MyTCBStub.Flags.bServer) {
+                vFlags = RST | ACK;
+                bCloseSocket = true;
             } else {
-                if (MyTCBStub.Flags.bServer) {
-                    vFlags = RST | ACK;
-                    bCloseSocket = true;
-                } else {
-                    vFlags = SYN;
-                }
+                vFlags = SYN;
             }
-            break;
+        }
+        break;
 
-        case TCP_ESTABLISHED:
-        case TCP_CLOSE_WAIT:
-            // Retransmit any unacknowledged data
-            if (MyTCB.retryCount < TCP_MAX_RETRIES) {
-                vFlags = ACK;
-                bRetransmit = true;
-            } else {
-                // No response back for too long, close connection
-                // This could happen, for instance, if the communication
-                // medium was lost
-                MyTCBStub.smState = TCP_FIN_WAIT_1;
-                vFlags = FIN | ACK;
-            }
-            break;
+    case TCP_ESTABLISHED:
+    case TCP_CLOSE_WAIT:
+        // Retransmit any unacknowledged data
+        if (MyTCB.retryCount < TCP_MAX_RETRIES) {
+            vFlags = ACK;
+            bRetransmit = true;
+        } else {
+            // No response back for too long, close connection
+            // This could happen, for instance, if the communication
+            // medium was lost
+            MyTCBStub.smState = TCP_FIN_WAIT_1;
+            vFlags = FIN | ACK;
+        }
+        break;
 
-        case TCP_FIN_WAIT_1:
-            if (MyTCB.retryCount < TCP_MAX_RETRIES) {
-                // Send another FIN
-                vFlags = FIN | ACK;
-                bRetransmit = true;
-            } else {
-                // Close on our own, we can't seem to communicate
-                // with the remote node anymore
-                vFlags = RST | ACK;
-                bCloseSocket = true;
-            }
-            break;
+    case TCP_FIN_WAIT_1:
+        if (MyTCB.retryCount < TCP_MAX_RETRIES) {
+            // Send another FIN
+            vFlags = FIN | ACK;
+            bRetransmit = true;
+        } else {
+            // Close on our own, we can't seem to communicate
+            // with the remote node anymore
+            vFlags = RST | ACK;
+            bCloseSocket = true;
+        }
+        break;
 
-        case TCP_FIN_WAIT_2:
+    case TCP_FIN_WAIT_2:
+        // Close on our own, we can't seem to communicate
+        // with the remote node anymore
+        vFlags = RST | ACK;
+        bCloseSocket = true;
+        break;
+
+    case TCP_CLOSING:
+        if (MyTCB.retryCount < TCP_MAX_RETRIES) {
+            // Send another ACK+FIN (the FIN is retransmitted
+            // automatically since it hasn't been acknowledged by
+            // the remote node yet)
+            vFlags = ACK;
+            bRetransmit = true;
+        } else {
             // Close on our own, we can't seem to communicate
             // with the remote node anymore
             vFlags = RST | ACK;
             bCloseSocket = true;
-            break;
+        }
+        break;
 
-        case TCP_CLOSING:
-            if (MyTCB.retryCount < TCP_MAX_RETRIES) {
-                // Send another ACK+FIN (the FIN is retransmitted
-                // automatically since it hasn't been acknowledged by
-                // the remote node yet)
-                vFlags = ACK;
-                bRetransmit = true;
-            } else {
-                // Close on our own, we can't seem to communicate
-                // with the remote node anymore
-                vFlags = RST | ACK;
-                bCloseSocket = true;
-            }
-            break;
+    //case TCP_TIME_WAIT:
+    //    // Wait around for a while (2MSL) and then goto closed state
+    //    bCloseSocket = true;
+    //    break;
 
-        //case TCP_TIME_WAIT:
-        //    // Wait around for a while (2MSL) and then goto closed state
-        //    bCloseSocket = true;
-        //    break;
-
-        case TCP_LAST_ACK:
-            // Send some more FINs or close anyway
-            if (MyTCB.retryCount < TCP_MAX_RETRIES) {
-                vFlags = FIN | ACK;
-                bRetransmit = true;
-            } else {
-                vFlags = RST | ACK;
-                bCloseSocket = true;
+    case TCP_LAST_ACK:
+        // Send some more FINs or close anyway
+        if (MyTCB.retryCount < TCP_MAX_RETRIES) {
+            vFlags = FIN | ACK;
+            bRetransmit = true;
+        } else {
+            vFlags = RST | ACK;
+            bCloseSocket = true;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (vFlags) {
+        // Transmit all unacknowledged data over again
+        if (bRetransmit) {
+            // Set the appropriate retry time
+            MyTCB.retryCount++;
+            MyTCB.retryInterval <<= 1;
+
+            // Calculate how many bytes we have to roll back and retransmit
+            w = GetBytesInFlight();
+
+            // A timeout signals heavy loss, so restart from slow start with
+            // one segment in flight (RFC 5681 section 3.1)
+            if (w) {
+                MyTCB.wSlowStartThreshold = w >> 1;
+                if (MyTCB.wSlowStartThreshold < (MyTCB.wRemoteMSS << 1))
+                    MyTCB.wSlowStartThreshold = MyTCB.wRemoteMSS << 1;
+                MyTCB.wCongestionWindow = MyTCB.wRemoteMSS;
+                MyTCB.flags.vDuplicateACKs = 0;
+                MyTCB.flags.bFastRecovery = 0;
             }
-            break;
 
-        default:
-            break;
-        }
+            // Perform roll back of local SEQuence counter, remote window
+            // adjustment, and cause all unacknowledged data to be
+            // retransmitted by moving the unacked tail pointer.
+            MyTCB.MySEQ -= w;
+            MyTCB.remoteWindow += w;
+            MyTCB.txUnackedTail = MyTCBStub.txTail;
+            SendTCP(vFlags, 0);
+        } else
+            SendTCP(vFlags, SENDTCP_RESET_TIMERS);
 
-        if (vFlags) {
-            // Transmit all unacknowledged data over again
-            if (bRetransmit) {
-                // Set the appropriate retry time
-                MyTCB.retryCount++;
-                MyTCB.retryInterval <<= 1;
-
-                // Calculate how many bytes we have to roll back and retransmit
-                w = MyTCB.txUnackedTail - MyTCBStub.txTail;
-                if (MyTCB.txUnackedTail < MyTCBStub.txTail)
-                    w += MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart;
-
-                // Perform roll back of local SEQuence counter, remote window
-                // adjustment, and cause all unacknowledged data to be
-                // retransmitted by moving the unacked tail pointer.
-                MyTCB.MySEQ -= w;
-                MyTCB.remoteWindow += w;
-                MyTCB.txUnackedTail = MyTCBStub.txTail;
-                SendTCP(vFlags, 0);
-            } else
-                SendTCP(vFlags, SENDTCP_RESET_TIMERS);
+    }
 
-        }
+    if (bCloseSocket)
+        CloseSocket();
+}
 
-        if (bCloseSocket)
-            CloseSocket();
+/*****************************************************************************
+  Function:
+    static void ScheduleSocket(void)
+
+  Summary:
+    Files the current socket under its earliest pending deadline.
+
+  Description:
+    This function examines the timers and flags that TickSocket() acts on
+    and moves the current socket to the timer wheel slot in which its
+    earliest deadline falls.  A socket with work pending right away goes on
+    the ready list and a socket with no timers running is taken off all
+    lists until WakeSocket() is called for it.  Deadlines beyond the end of
+    the wheel are filed in its last slot and refiled when that slot comes
+    due.  Because a slot may come due a little before the deadlines filed
+    in it, a socket whose deadline falls in the current slot is kept on the
+    ready list.
+
+  Precondition:
+    The socket's TCB stub is synced.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ***************************************************************************/
+static void ScheduleSocket(void)
+{
+    int32_t lDelay; // Time until the earliest deadline, in TickGetDiv256() counts
+    int32_t lTimer;
+    uint32_t dwNow;
+    uint16_t wSlot;
+    uint16_t w;
+    bool bArmed;
+
+    dwNow = TickGetDiv256();
+    lDelay = 0;
+    bArmed = false;
+
+    // Work that TickSocket() must retry on every call
+    if (MyTCBStub.Flags.bTXASAP || MyTCBStub.Flags.bTXASAPWithoutTimerReset) {
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+        return;
     }
 
+#if defined(STACK_USE_SSL)
+    if (MyTCBStub.sslStubID != SSL_INVALID_ID) {
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+        return;
+    }
+#endif
+
 #if TCP_SYN_QUEUE_MAX_ENTRIES
-    // Process SYN Queue entry timeouts
-    for (w = 0; w < TCP_SYN_QUEUE_MAX_ENTRIES; w++) {
-        // Abort search if there are no more valid records
-        if (SYNQueue[w].wDestPort == 0u)
-            break;
+    if (MyTCBStub.smState == TCP_LISTEN) {
+        for (w = 0; w < TCP_SYN_QUEUE_MAX_ENTRIES; w++) {
+            if (SYNQueue[w].wDestPort == 0u)
+                break;
+#if defined(STACK_USE_SSL_SERVER)
+            if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val || SYNQueue[w].wDestPort == MyTCBStub.sslTxHead)
+#else
+            if (SYNQueue[w].wDestPort == MyTCBStub.remoteHash.Val)
+#endif
+            {
+                MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+                return;
+            }
+        }
+    }
+#endif
 
-        // See if this SYN has timed out
-        if ((uint16_t) TickGetDiv256() - SYNQueue[w].wTimestamp > (uint16_t) (TCP_SYN_QUEUE_TIMEOUT / 256ull)) {
-            // Delete this SYN from the SYNQueue and compact the SYNQueue[] array
-            TCPRAMCopy((PTR_BASE) & SYNQueue[w], TCP_PIC_RAM, (PTR_BASE) & SYNQueue[w + 1], TCP_PIC_RAM, (TCP_SYN_QUEUE_MAX_ENTRIES - 1u - w) * sizeof (TCP_SYN_QUEUE));
-            SYNQueue[TCP_SYN_QUEUE_MAX_ENTRIES - 1].wDestPort = 0u;
+    // Find the earliest running timer
+    if (MyTCBStub.Flags.bTimer2Enabled) {
+        lTimer = (int16_t) (MyTCBStub.eventTime2 - (uint16_t) dwNow);
+        if (!bArmed || lTimer < lDelay)
+            lDelay = lTimer;
+        bArmed = true;
+    }
 
-            // Since we deleted an entry, we need to roll back one
-            // index so next loop will process the correct record
-            w--;
-        }
+    if (MyTCBStub.Flags.bDelayedACKTimerEnabled) {
+        lTimer = (int16_t) (MyTCBStub.OverlappedTimers.delayedACKTime - (uint16_t) dwNow);
+        if (!bArmed || lTimer < lDelay)
+            lDelay = lTimer;
+        bArmed = true;
     }
+
+    if (MyTCBStub.smState == TCP_CLOSE_WAIT) {
+        lTimer = (int16_t) (MyTCBStub.OverlappedTimers.closeWaitTime - (uint16_t) dwNow);
+        if (!bArmed || lTimer < lDelay)
+            lDelay = lTimer;
+        bArmed = true;
+    }
+
+#if defined(TCP_KEEP_ALIVE_TIMEOUT)
+    if (MyTCBStub.Flags.bTimerEnabled || MyTCBStub.smState == TCP_ESTABLISHED)
+#else
+    if (MyTCBStub.Flags.bTimerEnabled)
 #endif
+    {
+        // eventTime counts TickGet() ticks.  Rounding down makes the slot
+        // come due no later than the deadline.
+        lTimer = (int32_t) (MyTCBStub.eventTime - TickGet());
+        if (lTimer > 0)
+            lTimer = (uint32_t) lTimer >> 8;
+        if (!bArmed || lTimer < lDelay)
+            lDelay = lTimer;
+        bArmed = true;
+    }
+
+    if (!bArmed) {
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_IDLE);
+        return;
+    }
+
+    if (lDelay <= 0) {
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+        return;
+    }
+
+    // Pick the slot, relative to the last slot that came due
+    wSlot = (uint16_t) ((dwNow + (uint32_t) lDelay) >> TCP_TIMER_WHEEL_SHIFT) - wTimerWheelTime;
+    if ((int16_t) wSlot <= 0) {
+        MoveTCBTimer(hCurrentTCP, TCP_TIMER_READY);
+        return;
+    }
+    if (wSlot > TCP_TIMER_WHEEL_SLOTS)
+        wSlot = TCP_TIMER_WHEEL_SLOTS;
+
+    MoveTCBTimer(hCurrentTCP, (uint8_t) ((wTimerWheelTime + wSlot) & (TCP_TIMER_WHEEL_SLOTS - 1u)));
+}
+
+/*****************************************************************************
+  Function:
+    void TCPRxBatchBegin(void)
+
+  Summary:
+    Starts processing a batch of received frames.
+
+  Description:
+    Called by StackTask() before it processes several received frames in a
+    row.  Until TCPRxBatchEnd() is called, in order segments that would
+    normally be ACKed immediately only expire the socket's delayed ACK
+    timer.  Segments that create or fill a hole are still ACKed right away
+    so the remote node sees every duplicate ACK.
+
+  Precondition:
+    TCP is initialized.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ***************************************************************************/
+void TCPRxBatchBegin(void)
+{
+    bRxBatch = true;
+}
+
+/*****************************************************************************
+  Function:
+    void TCPRxBatchEnd(void)
+
+  Summary:
+    Finishes processing a batch of received frames.
+
+  Description:
+    Sends the ACKs deferred since TCPRxBatchBegin(), one per socket.
+
+  Precondition:
+    TCPRxBatchBegin() was called.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ***************************************************************************/
+void TCPRxBatchEnd(void)
+{
+    bRxBatch = false;
+
+    if (bRxBatchACKs) {
+        bRxBatchACKs = false;
+
+        // The sockets are on the ready list with their delayed ACK timer
+        // expired, so TCPTick() sends the ACKs
+        TCPTick();
+    }
 }
 
 /*****************************************************************************
@@ -2708,10 +3250,17 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
     TCP_HEADER header;
     TCP_OPTIONS options;
     PSEUDO_HEADER pseudoHeader;
+    IP_CHECKSUM payloadChecksum;
+    IP_CHECKSUM checksum;
+    bool bPayloadSummed;
     uint16_t len;
+    uint16_t wSendWindow;
 
     SyncTCB();
 
+    // The timers are rearmed below, so have TCPTick() reschedule the socket
+    WakeSocket();
+
     // FINs must be handled specially
     if (vTCPFlags & FIN) {
         MyTCBStub.Flags.bTXFIN = 1;
@@ -2730,11 +3279,26 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
     //  Make sure that we can write to the MAC transmit area
     while (!IPIsTxReady());
 
+    // Application data held in PIC RAM is summed as it is copied into the
+    // MAC, so the segment need not be read back to compute the checksum
+    ChecksumBegin(&payloadChecksum);
+    bPayloadSummed = true;
+
     // Put all socket application data in the TX space
     if (vTCPFlags & (SYN | RST)) {
         // Don't put any data in SYN and RST messages
         len = 0;
     } else {
+        // New data may fill neither the remote receive window nor the
+        // congestion window
+        wSendWindow = GetBytesInFlight();
+        if (wSendWindow < MyTCB.wCongestionWindow)
+            wSendWindow = MyTCB.wCongestionWindow - wSendWindow;
+        else
+            wSendWindow = 0;
+        if (wSendWindow > MyTCB.remoteWindow)
+            wSendWindow = MyTCB.remoteWindow;
+
         // Begin copying any application data over to the TX space
         if (MyTCBStub.txHead == MyTCB.txUnackedTail) {
             // All caught up on data TX, no real data for this packet
@@ -2742,8 +3306,8 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
         } else if (MyTCBStub.txHead > MyTCB.txUnackedTail) {
             len = MyTCBStub.txHead - MyTCB.txUnackedTail;
 
-            if (len > MyTCB.remoteWindow)
-                len = MyTCB.remoteWindow;
+            if (len > wSendWindow)
+                len = wSendWindow;
 
             if (len > MyTCB.wRemoteMSS) {
                 len = MyTCB.wRemoteMSS;
@@ -2752,13 +3316,17 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
 
             // Copy application data into the raw TX buffer
             TCPRAMCopy(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER) + sizeof (TCP_HEADER), TCP_ETH_RAM, MyTCB.txUnackedTail, MyTCBStub.vMemoryMedium, len);
+            if (MyTCBStub.vMemoryMedium == TCP_PIC_RAM)
+                ChecksumAdd(&payloadChecksum, (uint8_t *) MyTCB.txUnackedTail, len);
+            else
+                bPayloadSummed = false;
             MyTCB.txUnackedTail += len;
         } else {
             pseudoHeader.Length = MyTCBStub.bufferRxStart - MyTCB.txUnackedTail;
             len = pseudoHeader.Length + MyTCBStub.txHead - MyTCBStub.bufferTxStart;
 
-            if (len > MyTCB.remoteWindow)
-                len = MyTCB.remoteWindow;
+            if (len > wSendWindow)
+                len = wSendWindow;
 
             if (len > MyTCB.wRemoteMSS) {
                 len = MyTCB.wRemoteMSS;
@@ -2770,11 +3338,17 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
 
             // Copy application data into the raw TX buffer
             TCPRAMCopy(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER) + sizeof (TCP_HEADER), TCP_ETH_RAM, MyTCB.txUnackedTail, MyTCBStub.vMemoryMedium, pseudoHeader.Length);
+            if (MyTCBStub.vMemoryMedium == TCP_PIC_RAM)
+                ChecksumAdd(&payloadChecksum, (uint8_t *) MyTCB.txUnackedTail, pseudoHeader.Length);
+            else
+                bPayloadSummed = false;
             pseudoHeader.Length = len - pseudoHeader.Length;
 
             // Copy any left over chunks of application data over
             if (pseudoHeader.Length) {
                 TCPRAMCopy(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER) + sizeof (TCP_HEADER)+(MyTCBStub.bufferRxStart - MyTCB.txUnackedTail), TCP_ETH_RAM, MyTCBStub.bufferTxStart, MyTCBStub.vMemoryMedium, pseudoHeader.Length);
+                if (MyTCBStub.vMemoryMedium == TCP_PIC_RAM)
+                    ChecksumAdd(&payloadChecksum, (uint8_t *) MyTCBStub.bufferTxStart, pseudoHeader.Length);
             }
 
             MyTCB.txUnackedTail += len;
@@ -2784,7 +3358,7 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
 
         // If we are to transmit a FIN, make sure we can put one in this packet
         if (MyTCBStub.Flags.bTXFIN) {
-            if ((len != MyTCB.remoteWindow) && (len != MyTCB.wRemoteMSS))
+            if ((MyTCB.txUnackedTail == MyTCBStub.txHead) && (len != MyTCB.remoteWindow))
                 vTCPFlags |= FIN;
         }
     }
@@ -2813,9 +3387,11 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
         // Increment Keep Alive TX counter to handle disconnection if not response is returned
         MyTCBStub.Flags.vUnackedKeepalives++;
 
-        // Generate a dummy byte
+        // Generate a dummy byte.  It is whatever is already in the MAC
+        // buffer, so it must be summed there.
         MyTCB.MySEQ -= 1;
         len = 1;
+        bPayloadSummed = false;
     } else if (MyTCBStub.Flags.bTimerEnabled) {
         // If we have data to transmit, but the remote RX window is zero,
         // so we aren't transmitting any right now then make sure to not
@@ -2892,7 +3468,7 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
         options.Length = 0x04;
 
         // Load MSS and swap to big endian
-        options.MaxSegSize.Val = (((TCP_MAX_SEG_SIZE_RX)&0x00FF) << 8) | (((TCP_MAX_SEG_SIZE_RX)&0xFF00) >> 8);
+        options.MaxSegSize.Val = swaps(GetLocalMaxSegSize());
 
         header.DataOffset.Val += sizeof (options) >> 2;
     }
@@ -2906,6 +3482,22 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
     SwapPseudoHeader(pseudoHeader);
     header.Checksum = ~CalcIPChecksum((uint8_t *) & pseudoHeader, sizeof (pseudoHeader));
 
+    // Complete the TCP checksum now if the payload has already been summed
+    if (bPayloadSummed) {
+        ChecksumBegin(&checksum);
+        ChecksumAdd(&checksum, &header, sizeof (header));
+        if (vTCPFlags & SYN)
+            ChecksumAdd(&checksum, &options, sizeof (options));
+        ChecksumMerge(&checksum, &payloadChecksum);
+        header.Checksum = ChecksumFinish(&checksum);
+#if defined(DEBUG_GENERATE_TX_LOSS)
+        // Damage TCP checksums on TX packets randomly
+        if (LFSRRand() > DEBUG_GENERATE_TX_LOSS) {
+            header.Checksum++;
+        }
+#endif
+    }
+
     // Write IP header
     MACSetWritePtr(BASE_TX_ADDR + sizeof (ETHER_HEADER));
     IPPutHeader(&MyTCB.remote.niRemoteMACIP, IP_PROT_TCP, len);
@@ -2913,17 +3505,19 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
     if (vTCPFlags & SYN)
         MACPutArray((uint8_t *) & options, sizeof (options));
 
-    // Update the TCP checksum
-    MACSetReadPtr(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER));
-    wVal.Val = CalcIPBufferChecksum(len);
+    // Otherwise update the TCP checksum from the MAC buffer
+    if (!bPayloadSummed) {
+        MACSetReadPtr(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER));
+        wVal.Val = CalcIPBufferChecksum(len);
 #if defined(DEBUG_GENERATE_TX_LOSS)
-    // Damage TCP checksums on TX packets randomly
-    if (LFSRRand() > DEBUG_GENERATE_TX_LOSS) {
-        wVal.Val++;
-    }
+        // Damage TCP checksums on TX packets randomly
+        if (LFSRRand() > DEBUG_GENERATE_TX_LOSS) {
+            wVal.Val++;
+        }
 #endif
-    MACSetWritePtr(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER) + 16);
-    MACPutArray((uint8_t *) & wVal, sizeof (uint16_t));
+        MACSetWritePtr(BASE_TX_ADDR + sizeof (ETHER_HEADER) + sizeof (IP_HEADER) + 16);
+        MACPutArray((uint8_t *) & wVal, sizeof (uint16_t));
+    }
 
     // Physically start the packet transmission over the network
     MACFlush();
@@ -2942,6 +3536,10 @@ static void SendTCP(uint8_t vTCPFlags, uint8_t vSendFlags)
     index is saved in hCurrentTCP and the associated MyTCBStub and MyTCB are
     loaded. Otherwise, INVALID_SOCKET is placed in hCurrentTCP.
 
+    Only the sockets chained in the hash bucket of the segment's remoteHash
+    value, and of its destination port for listening sockets, are examined.
+    The full TCB is loaded only for sockets whose remoteHash matches.
+
   Precondition:
     TCP is initialized.
 
@@ -2966,24 +3564,12 @@ static bool FindMatchingSocket(TCP_HEADER* h, NODE_INFO* remote)
     partialMatch = INVALID_SOCKET;
     hash = (remote->IPAddr.w[1] + remote->IPAddr.w[0] + h->SourcePort) ^ h->DestPort;
 
-    // Loop through all sockets looking for a socket that is expecting this
-    // packet or can handle it.
-    for (hTCP = 0; hTCP < TCP_SOCKET_COUNT; hTCP++) {
+    // Loop through the sockets sharing this hash bucket looking for a
+    // socket that is expecting this packet.
+    for (hTCP = TCBHashHead[TCPHashBucket(hash)]; hTCP != INVALID_SOCKET; hTCP = TCBHashNext[hTCP]) {
         SyncTCBStub(hTCP);
 
-        if (MyTCBStub.smState == TCP_CLOSED) {
-            continue;
-        } else if (MyTCBStub.smState == TCP_LISTEN) { // For listening ports, check if this is the correct port
-            if (MyTCBStub.remoteHash.Val == h->DestPort)
-                partialMatch = hTCP;
-
-#if defined(STACK_USE_SSL_SERVER)
-            // Check the SSL port as well for SSL Servers
-            // 0 is defined as an invalid port number
-            if (MyTCBStub.sslTxHead == h->DestPort)
-                partialMatch = hTCP;
-#endif
-
+        if (MyTCBStub.smState == TCP_CLOSED || MyTCBStub.smState == TCP_LISTEN) {
             continue;
         } else if (MyTCBStub.remoteHash.Val != hash) { // Ignore if the hash doesn't match
             continue;
@@ -2997,6 +3583,31 @@ static bool FindMatchingSocket(TCP_HEADER* h, NODE_INFO* remote)
         }
     }
 
+    // Listening sockets hold their local port in remoteHash, so look for one
+    // that can handle it in the bucket for the destination port.  The highest
+    // numbered socket is chosen, as the linear search used to do.
+    for (hTCP = TCBHashHead[TCPHashBucket(h->DestPort)]; hTCP != INVALID_SOCKET; hTCP = TCBHashNext[hTCP]) {
+        SyncTCBStub(hTCP);
+
+        if (MyTCBStub.smState == TCP_LISTEN && MyTCBStub.remoteHash.Val == h->DestPort) {
+            if (partialMatch == INVALID_SOCKET || hTCP > partialMatch)
+                partialMatch = hTCP;
+        }
+    }
+
+#if defined(STACK_USE_SSL_SERVER)
+    // Check the SSL port as well for SSL Servers
+    // 0 is defined as an invalid port number
+    for (hTCP = TCBSSLListenHead; hTCP != INVALID_SOCKET; hTCP = TCBSSLListenNext[hTCP]) {
+        SyncTCBStub(hTCP);
+
+        if (MyTCBStub.smState == TCP_LISTEN && MyTCBStub.sslTxHead == h->DestPort) {
+            if (partialMatch == INVALID_SOCKET || hTCP > partialMatch)
+                partialMatch = hTCP;
+        }
+    }
+#endif
+
     // If there is a partial match, then a listening socket is currently
     // available.  Set up the extended TCB with the info needed
     // to establish a connection and return this socket to the
@@ -3010,8 +3621,11 @@ static bool FindMatchingSocket(TCP_HEADER* h, NODE_INFO* remote)
         if (MyTCBStub.sslTxHead == h->DestPort) {
             // Try to start an SSL session.  If no stubs are available,
             // we can't service this request right now, so ignore it.
-            if (!TCPStartSSLServer(partialMatch))
+            // Keep the listener polling the SYN queue until a stub frees up.
+            if (!TCPStartSSLServer(partialMatch)) {
+                WakeSocket();
                 partialMatch = INVALID_SOCKET;
+            }
         }
 #endif
 
@@ -3019,7 +3633,7 @@ static bool FindMatchingSocket(TCP_HEADER* h, NODE_INFO* remote)
         // redundant for non-SSL sockets).  Otherwise, fall out to below
         // and add to the SYN queue.
         if (partialMatch != INVALID_SOCKET) {
-            MyTCBStub.remoteHash.Val = hash;
+            SetRemoteHash(hash);
 
             memcpy((void *) &MyTCB.remote, (void *) remote, sizeof (NODE_INFO));
             MyTCB.remotePort.Val = h->SourcePort;
@@ -3153,8 +3767,9 @@ static void SwapTCPHeader(TCP_HEADER* header)
 static void CloseSocket(void)
 {
     SyncTCB();
+    WakeSocket();
 
-    MyTCBStub.remoteHash.Val = MyTCB.localPort.Val;
+    SetRemoteHash(MyTCB.localPort.Val);
     MyTCBStub.txHead = MyTCBStub.bufferTxStart;
     MyTCBStub.txTail = MyTCBStub.bufferTxStart;
     MyTCBStub.rxHead = MyTCBStub.bufferRxStart;
@@ -3178,7 +3793,7 @@ static void CloseSocket(void)
         MyTCBStub.sslStubID = SSL_INVALID_ID;
 
         // Swap the SSL port and local port back to proper values
-        MyTCBStub.remoteHash.Val = MyTCB.localSSLPort.Val;
+        SetRemoteHash(MyTCB.localSSLPort.Val);
         MyTCB.localSSLPort.Val = MyTCB.localPort.Val;
         MyTCB.localPort.Val = MyTCBStub.remoteHash.Val;
     }
@@ -3194,13 +3809,13 @@ static void CloseSocket(void)
 
     MyTCB.flags.bFINSent = 0;
     MyTCB.flags.bSYNSent = 0;
-    MyTCB.flags.bRXNoneACKed1 = 0;
-    MyTCB.flags.bRXNoneACKed2 = 0;
     MyTCB.txUnackedTail = MyTCBStub.bufferTxStart;
     ((TCPIP_UINT32_VAL*) (&MyTCB.MySEQ))->w[0] = LFSRRand();
     ((TCPIP_UINT32_VAL*) (&MyTCB.MySEQ))->w[1] = LFSRRand();
-    MyTCB.sHoleSize = -1;
+    MyTCB.vRxRanges = 0;
     MyTCB.remoteWindow = 1;
+    MyTCB.wRemoteMSS = 536;
+    ResetCongestionWindow();
 }
 
 /*****************************************************************************
@@ -3295,6 +3910,310 @@ static uint16_t GetMaxSegSizeOption(void)
     return 536;
 }
 
+/*****************************************************************************
+  Function:
+    static uint16_t GetLocalMaxSegSize(void)
+
+  Summary:
+    Calculates the MSS to advertise to the remote node.
+
+  Description:
+    Chooses the Maximum Segment Size option for the current socket's SYN or
+    SYN+ACK.  The value is limited to what the socket's RX FIFO can hold and
+    what fits in the MAC RX buffer, and never exceeds TCP_MAX_SEG_SIZE_RX.
+    Small RX FIFOs still advertise the 536 byte default, since the receive
+    window already limits how much the remote node can send.
+
+  Precondition:
+    The current TCB stub is synced.
+
+  Parameters:
+    None
+
+  Returns:
+    The MSS for the current socket, in bytes.
+ ***************************************************************************/
+static uint16_t GetLocalMaxSegSize(void)
+{
+    uint16_t wMSS;
+
+    wMSS = MyTCBStub.bufferEnd - MyTCBStub.bufferRxStart;
+    if (wMSS < 536u)
+        wMSS = 536u;
+    if (wMSS > TCP_MAX_SEG_SIZE_RX)
+        wMSS = TCP_MAX_SEG_SIZE_RX;
+    if (wMSS > TCP_MAX_SEG_SIZE_MAC)
+        wMSS = TCP_MAX_SEG_SIZE_MAC;
+
+    return wMSS;
+}
+
+/*****************************************************************************
+  Function:
+    static uint16_t GetBytesInFlight(void)
+
+  Summary:
+    Counts the bytes that have been transmitted but not yet acknowledged.
+
+  Description:
+    Returns the distance from the TX tail pointer to the unacknowledged
+    TX tail pointer of the current socket, accounting for FIFO wrap.
+
+  Precondition:
+    The current TCB is synced.
+
+  Parameters:
+    None
+
+  Returns:
+    Number of bytes in flight.
+ ***************************************************************************/
+static uint16_t GetBytesInFlight(void)
+{
+    uint16_t w;
+
+    w = MyTCB.txUnackedTail - MyTCBStub.txTail;
+    if (MyTCB.txUnackedTail < MyTCBStub.txTail)
+        w += MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart;
+
+    return w;
+}
+
+/*****************************************************************************
+  Function:
+    static void ResetCongestionWindow(void)
+
+  Summary:
+    Sets the congestion control state for a new connection.
+
+  Description:
+    Sets the congestion window to the RFC 5681 initial window for the
+    current remote MSS, which allows two to four segments to be sent before
+    the first ACK arrives.  The slow start threshold starts out unlimited.
+
+  Precondition:
+    The current TCB is synced and wRemoteMSS is valid.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ***************************************************************************/
+static void ResetCongestionWindow(void)
+{
+    // IW = min(4*MSS, max(2*MSS, 4380 bytes))
+    MyTCB.wCongestionWindow = 4380;
+    if (MyTCB.wCongestionWindow < (MyTCB.wRemoteMSS << 1))
+        MyTCB.wCongestionWindow = MyTCB.wRemoteMSS << 1;
+    if (MyTCB.wCongestionWindow > (MyTCB.wRemoteMSS << 2))
+        MyTCB.wCongestionWindow = MyTCB.wRemoteMSS << 2;
+
+    MyTCB.wSlowStartThreshold = 0xFFFF;
+    MyTCB.flags.vDuplicateACKs = 0;
+    MyTCB.flags.bFastRecovery = 0;
+}
+
+/*****************************************************************************
+  Function:
+    static void RetransmitFirstSegment(void)
+
+  Summary:
+    Retransmits the oldest unacknowledged segment.
+
+  Description:
+    Performs a fast retransmission by sending a single segment of data
+    starting at the TX tail pointer.  Unlike a retransmission timeout, the
+    data after this segment is not rolled back, so segments that are still
+    in flight are not sent again.
+
+  Precondition:
+    The current TCB is synced and data is in flight.
+
+  Parameters:
+    None
+
+  Returns:
+    None
+ ***************************************************************************/
+static void RetransmitFirstSegment(void)
+{
+    PTR_BASE txUnackedTail;
+    uint32_t dwSEQ;
+    uint16_t wRemoteWindow;
+    uint16_t wCongestionWindow;
+    uint16_t w;
+
+    txUnackedTail = MyTCB.txUnackedTail;
+    dwSEQ = MyTCB.MySEQ;
+    wRemoteWindow = MyTCB.remoteWindow;
+    wCongestionWindow = MyTCB.wCongestionWindow;
+
+    // Rewind to the oldest unacknowledged byte and allow one segment
+    w = GetBytesInFlight();
+    MyTCB.MySEQ -= w;
+    MyTCB.remoteWindow += w;
+    MyTCB.txUnackedTail = MyTCBStub.txTail;
+    MyTCB.wCongestionWindow = MyTCB.wRemoteMSS;
+    SendTCP(ACK, 0);
+    MyTCB.wCongestionWindow = wCongestionWindow;
+
+    // Pick the transmission back up where it was, unless the retransmitted
+    // segment already reached beyond it
+    if ((int32_t) (MyTCB.MySEQ - dwSEQ) < (int32_t) 0) {
+        MyTCB.txUnackedTail = txUnackedTail;
+        MyTCB.MySEQ = dwSEQ;
+        MyTCB.remoteWindow = wRemoteWindow;
+    }
+}
+
+/*****************************************************************************
+  Function:
+    static uint16_t GetRxRangesEnd(void)
+
+  Summary:
+    Finds the end of the out-of-order data in the RX FIFO.
+
+  Description:
+    Returns the number of bytes between rxHead and the end of the last
+    out-of-order data range.  Everything up to this point must be preserved
+    when RX FIFO data is moved or the FIFO is resized.
+
+  Precondition:
+    The current TCB is synced.
+
+  Parameters:
+    None
+
+  Returns:
+    Offset of the end of the out-of-order data, or 0 if there is none.
+ ***************************************************************************/
+static uint16_t GetRxRangesEnd(void)
+{
+    if (MyTCB.vRxRanges == 0u)
+        return 0;
+
+    return MyTCB.rxRanges[MyTCB.vRxRanges - 1].wOffset + MyTCB.rxRanges[MyTCB.vRxRanges - 1].wLength;
+}
+
+/*****************************************************************************
+  Function:
+    static void AddRxRange(uint16_t wOffset, uint16_t wLength)
+
+  Summary:
+    Records out-of-order data that was copied into the RX FIFO.
+
+  Description:
+    Inserts a new range into the sorted out-of-order range list, merging it
+    with any ranges that it overlaps or touches.  If the range is disjoint
+    from all others and the list already holds TCP_MAX_RX_RANGES entries,
+    the new data is not recorded.  Data that is already being tracked is
+    never discarded; the remote node will retransmit the forgotten bytes.
+
+  Precondition:
+    The current TCB is synced.
+
+  Parameters:
+    wOffset - Number of missing bytes between rxHead and the new data
+    wLength - Number of bytes of new data
+
+  Returns:
+    None
+ ***************************************************************************/
+static void AddRxRange(uint16_t wOffset, uint16_t wLength)
+{
+    uint8_t i, j;
+    uint16_t wEnd;
+    uint16_t w;
+
+    wEnd = wOffset + wLength;
+
+    // Skip past ranges that end before the new data begins
+    for (i = 0; i < MyTCB.vRxRanges; i++) {
+        if (MyTCB.rxRanges[i].wOffset + MyTCB.rxRanges[i].wLength >= wOffset)
+            break;
+    }
+
+    if ((i < MyTCB.vRxRanges) && (MyTCB.rxRanges[i].wOffset <= wEnd)) {
+        // Merge with this range and any following ranges the result reaches
+        if (MyTCB.rxRanges[i].wOffset < wOffset)
+            wOffset = MyTCB.rxRanges[i].wOffset;
+        for (j = i; (j < MyTCB.vRxRanges) && (MyTCB.rxRanges[j].wOffset <= wEnd); j++) {
+            w = MyTCB.rxRanges[j].wOffset + MyTCB.rxRanges[j].wLength;
+            if (w > wEnd)
+                wEnd = w;
+        }
+        MyTCB.rxRanges[i].wOffset = wOffset;
+        MyTCB.rxRanges[i].wLength = wEnd - wOffset;
+
+        // Close up the entries that were absorbed
+        for (i++; j < MyTCB.vRxRanges; i++, j++)
+            MyTCB.rxRanges[i] = MyTCB.rxRanges[j];
+        MyTCB.vRxRanges = i;
+        return;
+    }
+
+    // New disjoint range, insert it in order if there is room
+    if (MyTCB.vRxRanges >= TCP_MAX_RX_RANGES)
+        return;
+    for (j = MyTCB.vRxRanges; j > i; j--)
+        MyTCB.rxRanges[j] = MyTCB.rxRanges[j - 1];
+    MyTCB.rxRanges[i].wOffset = wOffset;
+    MyTCB.rxRanges[i].wLength = wLength;
+    MyTCB.vRxRanges++;
+}
+
+/*****************************************************************************
+  Function:
+    static void AdvanceRxRanges(uint16_t wLength)
+
+  Summary:
+    Accounts for in-order data that was just added to the RX FIFO.
+
+  Description:
+    After wLength bytes of in-order data have been written at the old
+    rxHead, the out-of-order ranges are rebased to the new rxHead.  Any
+    range that the new data reaches becomes in-order data as well, so
+    RemoteSEQ and rxHead are advanced past it and it is removed from the
+    list.
+
+  Precondition:
+    The current TCB is synced.  RemoteSEQ and rxHead have already been
+    advanced by wLength.
+
+  Parameters:
+    wLength - Number of in-order bytes just written to the RX FIFO
+
+  Returns:
+    None
+ ***************************************************************************/
+static void AdvanceRxRanges(uint16_t wLength)
+{
+    uint8_t i, j;
+    uint16_t w;
+
+    for (i = 0, j = 0; i < MyTCB.vRxRanges; i++) {
+        if (MyTCB.rxRanges[i].wOffset <= wLength) {
+            // Gap is filled, so this data is now in order
+            w = MyTCB.rxRanges[i].wOffset + MyTCB.rxRanges[i].wLength;
+            if (w > wLength) {
+                w -= wLength;
+                MyTCB.RemoteSEQ += w;
+                MyTCBStub.rxHead += w;
+                if (MyTCBStub.rxHead > MyTCBStub.bufferEnd)
+                    MyTCBStub.rxHead -= MyTCBStub.bufferEnd - MyTCBStub.bufferRxStart + 1;
+                wLength += w;
+            }
+            continue;
+        }
+
+        MyTCB.rxRanges[j].wOffset = MyTCB.rxRanges[i].wOffset - wLength;
+        MyTCB.rxRanges[j].wLength = MyTCB.rxRanges[i].wLength;
+        j++;
+    }
+    MyTCB.vRxRanges = j;
+}
+
 /*****************************************************************************
   Function:
     static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
@@ -3331,14 +4250,19 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
     uint32_t localSeqNumber;
     uint16_t wSegmentLength;
     bool bSegmentAcceptable;
+    bool bACKNow;
     uint16_t wNewWindow;
 
+    // Any of the socket's timers may change below
+    WakeSocket();
+
     // Cache a few variables in local RAM.
     // PIC18s take a fair amount of code and execution time to
     // dereference pointers frequently.
     localHeaderFlags = h->Flags.byte;
     localAckNumber = h->AckNumber;
     localSeqNumber = h->SeqNumber;
+    bACKNow = false;
 
     // We received a packet, reset the keep alive timer and count
 #if defined(TCP_KEEP_ALIVE_TIMEOUT)
@@ -3375,6 +4299,7 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
 
             // Get MSS option
             MyTCB.wRemoteMSS = GetMaxSegSizeOption();
+            ResetCongestionWindow();
 
             // Set Initial Send Sequence (ISS) number
             // Nothing to do on this step... ISS already set in CloseSocket()
@@ -3423,6 +4348,7 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
 
             // Get MSS option
             MyTCB.wRemoteMSS = GetMaxSegSizeOption();
+            ResetCongestionWindow();
 
             if (localHeaderFlags & ACK) {
                 SendTCP(ACK, SENDTCP_RESET_TIMERS);
@@ -3570,8 +4496,7 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
         // Calcluate how many bytes were ACKed with this packet
         dwTemp = localAckNumber - dwTemp;
         if (((int32_t) (dwTemp) > (int32_t) 0) && (dwTemp <= MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart)) {
-            MyTCB.flags.bRXNoneACKed1 = 0;
-            MyTCB.flags.bRXNoneACKed2 = 0;
+            MyTCB.flags.vDuplicateACKs = 0;
             MyTCBStub.Flags.bHalfFullFlush = false;
 
             // Bytes ACKed, free up the TX FIFO space
@@ -3593,23 +4518,70 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
                 MyTCBStub.txTail -= MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart;
             if (MyTCB.txUnackedTail >= MyTCBStub.bufferRxStart)
                 MyTCB.txUnackedTail -= MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart;
-        } else {
-            // See if we have outstanding TX data that is waiting for an ACK
-            if (MyTCBStub.txTail != MyTCB.txUnackedTail) {
-                if (MyTCB.flags.bRXNoneACKed1) {
-                    if (MyTCB.flags.bRXNoneACKed2) {
-                        // Set up to perform a fast retransmission
-                        // Roll back unacknowledged TX tail pointer to cause retransmit to occur
-                        MyTCB.MySEQ -= (int32_t) (int16_t) (MyTCB.txUnackedTail - MyTCBStub.txTail);
-                        if (MyTCB.txUnackedTail < MyTCBStub.txTail)
-                            MyTCB.MySEQ -= (int32_t) (int16_t) (MyTCBStub.bufferRxStart - MyTCBStub.bufferTxStart);
-                        MyTCB.txUnackedTail = MyTCBStub.txTail;
-                        MyTCBStub.Flags.bTXASAPWithoutTimerReset = 1;
-                    }
-                    MyTCB.flags.bRXNoneACKed2 = 1;
+
+            // Open up the congestion window (RFC 5681 and RFC 6582)
+            if (MyTCB.flags.bFastRecovery) {
+                if ((int32_t) (localAckNumber - MyTCB.dwRecoverSEQ) >= (int32_t) 0) {
+                    // Everything outstanding at the time of the loss has
+                    // arrived, so deflate the window and leave recovery
+                    MyTCB.flags.bFastRecovery = 0;
+                    MyTCB.wCongestionWindow = MyTCB.wSlowStartThreshold;
+                } else {
+                    // Partial ACK: the segment after the one just repaired
+                    // was lost too, so resend it without waiting for more
+                    // duplicate ACKs
+                    if (MyTCB.wCongestionWindow > (uint16_t) dwTemp)
+                        MyTCB.wCongestionWindow -= (uint16_t) dwTemp;
+                    else
+                        MyTCB.wCongestionWindow = 0;
+                    MyTCB.wCongestionWindow += MyTCB.wRemoteMSS;
+                    RetransmitFirstSegment();
+                }
+            } else {
+                // Slow start grows by up to one MSS per ACK, congestion
+                // avoidance by about one MSS per round trip
+                if (MyTCB.wCongestionWindow < MyTCB.wSlowStartThreshold) {
+                    if (dwTemp > MyTCB.wRemoteMSS)
+                        dwTemp = MyTCB.wRemoteMSS;
+                } else {
+                    dwTemp = ((uint32_t) MyTCB.wRemoteMSS * MyTCB.wRemoteMSS) / MyTCB.wCongestionWindow;
+                    if (dwTemp == 0u)
+                        dwTemp = 1;
+                }
+                dwTemp += MyTCB.wCongestionWindow;
+                MyTCB.wCongestionWindow = dwTemp > 0xFFFFu ? 0xFFFFu : (uint16_t) dwTemp;
+            }
+
+            // Clock out any data that was waiting on the freed window space
+            if (MyTCBStub.txHead != MyTCB.txUnackedTail)
+                MyTCBStub.Flags.bTXASAP = 1;
+        } else if ((dwTemp == 0u) && (wSegmentLength == 0u) && (MyTCBStub.txTail != MyTCB.txUnackedTail)
+                && ((uint16_t) (h->Window - (uint16_t) (MyTCB.MySEQ - localAckNumber)) == MyTCB.remoteWindow)) {
+            // A duplicate ACK: no data, no window change and nothing new
+            // acknowledged while data is outstanding
+            if (MyTCB.flags.bFastRecovery) {
+                // Each further duplicate ACK means another segment has left
+                // the network, so let a new one take its place
+                if (MyTCB.wCongestionWindow <= 0xFFFFu - MyTCB.wRemoteMSS)
+                    MyTCB.wCongestionWindow += MyTCB.wRemoteMSS;
+            } else if (MyTCB.flags.vDuplicateACKs < 3u) {
+                if (++MyTCB.flags.vDuplicateACKs == 3u) {
+                    // Third duplicate ACK: resend the missing segment now
+                    // rather than waiting for the retransmission timeout
+                    wTemp = GetBytesInFlight() >> 1;
+                    if (wTemp < (PTR_BASE) (MyTCB.wRemoteMSS << 1))
+                        wTemp = MyTCB.wRemoteMSS << 1;
+                    MyTCB.wSlowStartThreshold = (uint16_t) wTemp;
+                    MyTCB.dwRecoverSEQ = MyTCB.MySEQ;
+                    RetransmitFirstSegment();
+                    MyTCB.wCongestionWindow = MyTCB.wSlowStartThreshold + 3 * MyTCB.wRemoteMSS;
+                    MyTCB.flags.bFastRecovery = 1;
                 }
-                MyTCB.flags.bRXNoneACKed1 = 1;
             }
+
+            // The window may have grown enough to send new data
+            if (MyTCB.flags.bFastRecovery && (MyTCBStub.txHead != MyTCB.txUnackedTail))
+                MyTCBStub.Flags.bTXASAP = 1;
         }
 
         // No need to keep our retransmit timer going if we have nothing that needs ACKing anymore
@@ -3750,23 +4722,14 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
                 MyTCBStub.rxHead += len;
             }
 
-            // See if we have a hole and other data waiting already in the RX FIFO
-            if (MyTCB.sHoleSize != -1) {
-                MyTCB.sHoleSize -= len;
-                wTemp = MyTCB.wFutureDataSize + MyTCB.sHoleSize;
-
-                // See if we just closed up a hole, and if so, advance head pointer
-                if ((int16_t) wTemp < (int16_t) 0) {
-                    MyTCB.sHoleSize = -1;
-                } else if (MyTCB.sHoleSize <= 0) {
-                    MyTCB.RemoteSEQ += wTemp;
-                    MyTCBStub.rxHead += wTemp;
-                    if (MyTCBStub.rxHead > MyTCBStub.bufferEnd)
-                        MyTCBStub.rxHead -= MyTCBStub.bufferEnd - MyTCBStub.bufferRxStart + 1;
-                    MyTCB.sHoleSize = -1;
-                }
+            // See if we have holes and other data waiting already in the RX FIFO
+            if (MyTCB.vRxRanges) {
+                AdvanceRxRanges(len);
+
+                // ACK right away so the remote node learns the hole is filled
+                bACKNow = true;
             }
-        } 
+        }
         // This packet is out of order or we lost a packet, see if we can generate a hole to accomodate it
         else if ((int16_t) wMissingBytes > 0) {
             // Truncate packets that would overflow our TCP RX FIFO
@@ -3790,27 +4753,13 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
                 TCPRAMCopy(MyTCBStub.rxHead + wMissingBytes, MyTCBStub.vMemoryMedium, (PTR_BASE) - 1, TCP_ETH_RAM, len);
             }
 
-            // Record the hole is here
-            if (MyTCB.sHoleSize == -1) {
-                MyTCB.sHoleSize = wMissingBytes;
-                MyTCB.wFutureDataSize = len;
-            } else {
-                // We already have a hole, see if we can shrink the hole
-                // or extend the future data size
-                if (wMissingBytes < (uint16_t) MyTCB.sHoleSize) {
-                    if ((wMissingBytes + len > (uint16_t) MyTCB.sHoleSize + MyTCB.wFutureDataSize) || (wMissingBytes + len < (uint16_t) MyTCB.sHoleSize))
-                        MyTCB.wFutureDataSize = len;
-                    else
-                        MyTCB.wFutureDataSize = (uint16_t) MyTCB.sHoleSize + MyTCB.wFutureDataSize - wMissingBytes;
-                    MyTCB.sHoleSize = wMissingBytes;
-                } else if (wMissingBytes + len > (uint16_t) MyTCB.sHoleSize + MyTCB.wFutureDataSize) {
-                    // Make sure that there isn't a second hole between
-                    // our future data and this TCP segment's future data
-                    if (wMissingBytes <= (uint16_t) MyTCB.sHoleSize + MyTCB.wFutureDataSize)
-                        MyTCB.wFutureDataSize += wMissingBytes + len - (uint16_t) MyTCB.sHoleSize - MyTCB.wFutureDataSize;
-                }
+            // Record where this data is so it can be merged once the holes
+            // in front of it are filled
+            AddRxRange(wMissingBytes, len);
 
-            }
+            // ACK right away so the remote node gets a duplicate ACK and
+            // can fast retransmit the missing data
+            bACKNow = true;
         }
     }
 
@@ -3833,7 +4782,14 @@ static void HandleTCPSeg(TCP_HEADER* h, uint16_t len)
         if (MyTCBStub.smState != TCP_ESTABLISHED)
             MyTCBStub.rxTail = MyTCBStub.rxHead;
 
-        if (MyTCBStub.Flags.bOneSegmentReceived) {
+        if (bRxBatch && !bACKNow && MyTCBStub.Flags.bOneSegmentReceived) {
+            // Let TCPRxBatchEnd() send one ACK for the whole batch.  The
+            // socket was already woken, so TCPTick() will see the
+            // expired timer.
+            MyTCBStub.Flags.bDelayedACKTimerEnabled = 1;
+            MyTCBStub.OverlappedTimers.delayedACKTime = (uint16_t) TickGetDiv256();
+            bRxBatchACKs = true;
+        } else if (MyTCBStub.Flags.bOneSegmentReceived || bACKNow) {
             SendTCP(ACK, SENDTCP_RESET_TIMERS);
             SyncTCB();
             // bOneSegmentReceived is cleared in SendTCP(), so no need here
@@ -4044,8 +5000,8 @@ bool TCPAdjustFIFOSize(TCP_SOCKET hTCP, uint16_t wMinRXSize, uint16_t wMinTXSize
 #endif
 
     // If there's out-of-order data pending, adjust the head pointer to compensate
-    if (MyTCB.sHoleSize != -1) {
-        ptrHead += MyTCB.sHoleSize + MyTCB.wFutureDataSize;
+    if (MyTCB.vRxRanges) {
+        ptrHead += GetRxRangesEnd();
         if (ptrHead > MyTCBStub.bufferEnd)
             ptrHead -= MyTCBStub.bufferEnd - MyTCBStub.bufferRxStart + 1;
     }
@@ -4339,6 +5295,71 @@ static void TCPRAMCopyROM(PTR_BASE wDest, uint8_t wDestType, ROM uint8_t * wSour
 }
 #endif
 
+/*****************************************************************************
+  Function:
+    static void TCPRAMCopyMPFS(PTR_BASE wDest, uint8_t wDestType, MPFS_HANDLE hMPFS,
+                                uint16_t wLength)
+
+  Summary:
+    Copies data from an MPFS file to various memory mediums.
+
+  Description:
+    This function reads the next wLength bytes of an MPFS file into a
+    memory medium (PIC RAM, SPI RAM, and Ethernet buffer RAM) with as few
+    intermediate copies as the storage allows.  Destinations in PIC RAM
+    are read into directly, as a single burst from external storage.
+    Images in program memory are written to the destination in place.
+    Otherwise, the data is staged through a static
+    TCP_MPFS_COPY_BUFFER_SIZE buffer so each external storage read is a
+    long burst.
+
+  Precondition:
+    TCP is initialized and at least wLength bytes remain in the file.
+
+  Parameters:
+    wDest       - Address to write to
+    wDestType   - Destination meidum (TCP_PIC_RAM, TCP_ETH_RAM, TCP_SPI_RAM)
+    hMPFS       - MPFS file to read from
+    wLength     - Number of bytes to copy
+
+  Returns:
+    None
+ ***************************************************************************/
+#if defined(STACK_USE_MPFS2)
+static void TCPRAMCopyMPFS(PTR_BASE wDest, uint8_t wDestType, MPFS_HANDLE hMPFS, uint16_t wLength)
+{
+#if !defined(MPFS_ROM_POINTER)
+    // Static rather than on the stack; the stack task is never re-entered
+    static uint8_t vBuffer[TCP_MPFS_COPY_BUFFER_SIZE];
+    uint16_t w;
+#endif
+
+    if (wDestType == TCP_PIC_RAM) {
+        MPFSGetArray(hMPFS, (uint8_t *) wDest, wLength);
+        return;
+    }
+
+#if defined(MPFS_ROM_POINTER)
+    TCPRAMCopyROM(wDest, wDestType, MPFSGetROMPointer(hMPFS), wLength);
+    MPFSGetArray(hMPFS, NULL, wLength);
+#else
+    w = sizeof (vBuffer);
+    while (wLength) {
+        if (w > wLength)
+            w = wLength;
+
+        // Read and write a chunk
+        if (MPFSGetArray(hMPFS, vBuffer, w) != w)
+            break;
+
+        TCPRAMCopy(wDest, wDestType, (PTR_BASE) vBuffer, TCP_PIC_RAM, w);
+        wDest += w;
+        wLength -= w;
+    }
+#endif
+}
+#endif
+
 /****************************************************************************
   Section:
     SSL Functions
@@ -4397,6 +5418,7 @@ bool TCPStartSSLClient(TCP_SOCKET hTCP, uint8_t * host)
     MyTCBStub.sslRxHead = MyTCBStub.rxHead;
     MyTCBStub.sslTxHead = MyTCBStub.txHead;
     MyTCBStub.Flags.bSSLHandshaking = 1;
+    WakeSocket();
     for (i = 0; i < 5u; i++) { // Skip first 5 bytes in TX for the record header
         if (++MyTCBStub.sslTxHead >= MyTCBStub.bufferRxStart)
             MyTCBStub.sslTxHead = MyTCBStub.bufferTxStart;
@@ -4460,6 +5482,7 @@ bool TCPStartSSLClientEx(TCP_SOCKET hTCP, uint8_t * host, void * buffer, uint8_t
     MyTCBStub.sslRxHead = MyTCBStub.rxHead;
     MyTCBStub.sslTxHead = MyTCBStub.txHead;
     MyTCBStub.Flags.bSSLHandshaking = 1;
+    WakeSocket();
     for (i = 0; i < 5u; i++) { // Skip first 5 bytes in TX for the record header
         if (++MyTCBStub.sslTxHead >= MyTCBStub.bufferRxStart)
             MyTCBStub.sslTxHead = MyTCBStub.bufferTxStart;
@@ -4514,7 +5537,7 @@ bool TCPStartSSLServer(TCP_SOCKET hTCP)
         return false;
 
     // Swap the localPort and localSSLPort
-    MyTCBStub.remoteHash.Val = MyTCB.localPort.Val;
+    SetRemoteHash(MyTCB.localPort.Val);
     MyTCB.localPort.Val = MyTCB.localSSLPort.Val;
     MyTCB.localSSLPort.Val = MyTCBStub.remoteHash.Val;
 
@@ -4523,6 +5546,7 @@ bool TCPStartSSLServer(TCP_SOCKET hTCP)
     MyTCBStub.sslRxHead = MyTCBStub.rxHead;
     MyTCBStub.sslTxHead = MyTCBStub.txHead;
     MyTCBStub.Flags.bSSLHandshaking = 1;
+    WakeSocket();
     for (i = 0; i < 5u; i++) { // Skip first 5 bytes in TX for the record header
         if (++MyTCBStub.sslTxHead >= MyTCBStub.bufferRxStart)
             MyTCBStub.sslTxHead = MyTCBStub.bufferTxStart;
@@ -4557,6 +5581,8 @@ bool TCPStartSSLServer(TCP_SOCKET hTCP)
 
 bool TCPAddSSLListener(TCP_SOCKET hTCP, uint16_t port)
 {
+    TCP_SOCKET hTCP2;
+
     if (hTCP >= TCP_SOCKET_COUNT) {
         return false;
     }
@@ -4571,6 +5597,14 @@ bool TCPAddSSLListener(TCP_SOCKET hTCP, uint16_t port)
     MyTCB.localSSLPort.Val = port;
     MyTCBStub.sslTxHead = port;
 
+    // Make the socket visible to FindMatchingSocket() on its SSL port
+    for (hTCP2 = TCBSSLListenHead; hTCP2 != INVALID_SOCKET; hTCP2 = TCBSSLListenNext[hTCP2]) {
+        if (hTCP2 == hTCP)
+            return true;
+    }
+    TCBSSLListenNext[hTCP] = TCBSSLListenHead;
+    TCBSSLListenHead = hTCP;
+
     return true;
 }
 #endif // SSL Server
@@ -5087,10 +6121,10 @@ void TCPSSLHandleIncoming(TCP_SOCKET hTCP)
                 SyncTCB();
 
                 // Calculate how big the SSL hole is
-                if (MyTCB.sHoleSize == -1) { // Just need to move pending SSL data
+                if (MyTCB.vRxRanges == 0u) { // Just need to move pending SSL data
                     wToMove = TCPIsGetReady(hTCP);
-                } else { // A TCP hole exists, so move all data
-                    wToMove = TCPIsGetReady(hTCP) + MyTCB.sHoleSize + MyTCB.wFutureDataSize;
+                } else { // TCP holes exist, so move all data
+                    wToMove = TCPIsGetReady(hTCP) + GetRxRangesEnd();
                 }
 
                 // Start with the destination as the startRxTail and source as current rxTail
@@ -56,6 +56,14 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 void TCPTXPerformanceTask(void);
 void TCPRXPerformanceTask(void);
 
+// Time spent in batches of TCPPut*() and TCPGetArray() calls, used to report
+// the per-call cost of the TCP API.  Build once with and once without
+// TCP_TCBS_IN_PIC_RAM in tcp.c to compare the TCB storage modes.
+static uint32_t dwPutTicks, dwPutCalls;
+static uint32_t dwGetArrayTicks, dwGetArrayCalls;
+
+static void PutNanosecondsPerCall(TCP_SOCKET hTCP, ROM uint8_t *name, uint32_t dwTicks, uint32_t dwCalls);
+
 /*****************************************************************************
   Function:
     void TCPPerformanceTask(void)
@@ -161,7 +169,9 @@ void TCPTXPerformanceTask(void)
     vBuffer[0] = '0';
     vBuffer[1] = 'x';
 
-    // Transmit as much data as the TX FIFO will allow
+    // Transmit as much data as the TX FIFO will allow.  The whole batch of
+    // lines is timed, since a single call is shorter than a Tick.
+    dw = TickGet();
     while (w >= 12 + 27 + 5 + 32u) {
         dwVLine.Val = TickGet();
 
@@ -186,7 +196,9 @@ void TCPTXPerformanceTask(void)
 
         w -= 12 + 27 + 5 + 32;
         dwBytesSent += 12 + 27 + 5 + 32;
+        dwPutCalls += 5;
     }
+    dwPutTicks += TickGet() - dw;
 
     // Send everything immediately
     TCPFlush(MySocket);
@@ -219,7 +231,10 @@ void TCPTXPerformanceTask(void)
     open a telnet connection to the device on RX_PERFORMANCE_PORT (9763 by
     default).  Then use your telnet utility to upload a large file to the
     device.  Each second the board will report back how many bytes were
-    received in the previous second.
+    received in the previous second.  If the socket's TX FIFO has room,
+    the report also includes the average time spent in each TCPGetArray()
+    call, and in each of the five TCPPut*() calls that
+    TCPTXPerformanceTask() makes per line (including the line formatting).
 
     TCP performance is affected by many factors, including round-trip time
     and the TCP buffer size.  For faster results, increase the size of the
@@ -270,14 +285,18 @@ void TCPRXPerformanceTask(void)
     if (w == 0u)
         return;
 
+    // Time the whole batch of reads, since a single call is shorter than a Tick
     dwBytesRead += w;
     wGetLen = sizeof (vBuffer);
+    dw = TickGet();
     while (w) {
         if (w < sizeof (vBuffer))
             wGetLen = w;
         TCPGetArray(MySocket, vBuffer, wGetLen);
+        dwGetArrayCalls++;
         w -= wGetLen;
     }
+    dwGetArrayTicks += TickGet() - dw;
 
     dw = TickGet() - dwTimeStart;
     if (dw > TICK_SECOND) {
@@ -292,10 +311,69 @@ void TCPRXPerformanceTask(void)
         qw /= dw;
         tcpip_helper_ultoa((uint32_t) qw, vBuffer);
         TCPPutString(MySocket, vBuffer);
-        TCPPutROMString(MySocket, (ROM uint8_t *) " bytes/second\r\n");
+        TCPPutROMString(MySocket, (ROM uint8_t *) " bytes/second");
+
+        // Report the TCP API per-call cost
+        if (TCPIsPutReady(MySocket) >= 2 * (10 + 27) + 2u) {
+            PutNanosecondsPerCall(MySocket, (ROM uint8_t *) "TCPGetArray", dwGetArrayTicks, dwGetArrayCalls);
+            PutNanosecondsPerCall(MySocket, (ROM uint8_t *) "TCPPut*", dwPutTicks, dwPutCalls);
+        }
+        TCPPutROMString(MySocket, (ROM uint8_t *) "\r\n");
 
         dwBytesRead = 0;
+        dwGetArrayTicks = 0;
+        dwGetArrayCalls = 0;
+        dwPutTicks = 0;
+        dwPutCalls = 0;
     }
 }
 
+/*****************************************************************************
+  Function:
+    static void PutNanosecondsPerCall(TCP_SOCKET hTCP, ROM uint8_t *name,
+                                      uint32_t dwTicks, uint32_t dwCalls)
+
+  Summary:
+    Writes the average cost of a TCP API call to a socket.
+
+  Description:
+    Converts the accumulated Tick count for a number of calls to an average
+    in nanoseconds and writes it as ", <name>() <ns> ns/call".  Nothing is
+    written if no calls were made.  The Ticks are read once per batch of
+    calls (a whole TX FIFO fill or RX FIFO drain) rather than around each
+    call, which is much shorter than a Tick.
+
+  Precondition:
+    The socket has room for the text in its TX FIFO.
+
+  Parameters:
+    hTCP - Socket to write the text to
+    name - Name of the API function that was measured
+    dwTicks - Total Ticks spent in the calls
+    dwCalls - Number of calls made
+
+  Returns:
+    None
+ ***************************************************************************/
+static void PutNanosecondsPerCall(TCP_SOCKET hTCP, ROM uint8_t *name, uint32_t dwTicks, uint32_t dwCalls)
+{
+    uint8_t vBuffer[11];
+    uint64_t qw;
+
+    if (dwCalls == 0u)
+        return;
+
+    qw = (uint64_t) dwTicks * 1000000000ull;
+    qw /= TICK_SECOND;
+    qw += dwCalls >> 1;
+    qw /= dwCalls;
+    tcpip_helper_ultoa((uint32_t) qw, vBuffer);
+
+    TCPPutROMString(hTCP, (ROM uint8_t *) ", ");
+    TCPPutROMString(hTCP, name);
+    TCPPutROMString(hTCP, (ROM uint8_t *) "() ");
+    TCPPutString(hTCP, vBuffer);
+    TCPPutROMString(hTCP, (ROM uint8_t *) " ns/call");
+}
+
 #endif // #if defined(STACK_USE_TCP_PERFORMANCE_TEST)
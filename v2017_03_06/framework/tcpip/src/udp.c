@@ -58,6 +58,10 @@ SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
 // Last port number for randomized local port number selection
 #define LOCAL_UDP_PORT_END_NUMBER (8192u)
 
+// Number of buckets used to find the socket for an incoming segment by its
+// destination port.  Must be a power of 2.
+#define UDP_HASH_TABLE_SIZE (8u)
+
 /***************************************************************************
   Section:
     UDP Global Variables
@@ -74,17 +78,29 @@ uint16_t UDPRxCount; // Number of bytes read from this UDP segment
 static UDP_SOCKET LastPutSocket = INVALID_UDP_SOCKET; // Indicates the last socket to which data was written
 static uint16_t wPutOffset; // Offset from beginning of payload where data is to be written.
 static uint16_t wGetOffset; // Offset from beginning of payload from where data is to be read.
+#if defined(UDP_USE_TX_CHECKSUM)
+static IP_CHECKSUM TxChecksum; // Running checksum of the payload bytes written so far
+#endif
 
 // Stores various flags for the UDP module
 
 static struct {
     unsigned char bFirstRead : 1; // No data has been read from this segment yet
     unsigned char bWasDiscarded : 1; // The data in this segment has been discarded
+    unsigned char bTxChecksumValid : 1; // TxChecksum covers the whole TX payload
 } Flags;
 
 // Indicates which socket has currently received data for this loop
 static UDP_SOCKET SocketWithRxData = INVALID_UDP_SOCKET;
 
+// Open sockets are chained into buckets by their local port so incoming
+// segments only have to examine the sockets bound to their destination port.
+static UDP_SOCKET UDPHashHead[UDP_HASH_TABLE_SIZE]; // First socket in each bucket, or INVALID_UDP_SOCKET
+static UDP_SOCKET UDPHashNext[MAX_UDP_SOCKETS]; // Next socket in the same bucket, or INVALID_UDP_SOCKET
+
+// Selects the hash bucket for a local port number
+#define UDPHashBucket(a) ((uint8_t)((a) ^ ((a) >> 8)) & (UDP_HASH_TABLE_SIZE - 1u))
+
 /****************************************************************************
   Section:
     Function Prototypes
@@ -92,6 +108,7 @@ static UDP_SOCKET SocketWithRxData = INVALID_UDP_SOCKET;
 
 static UDP_SOCKET FindMatchingSocket(UDP_HEADER *h, NODE_INFO *remoteNode,
         IP_ADDR *localIP);
+static void SetLocalPort(UDP_SOCKET s, UDP_PORT localPort);
 
 /****************************************************************************
   Section:
@@ -125,6 +142,10 @@ void UDPInit(void)
 {
     UDP_SOCKET s;
 
+    for (s = 0; s < UDP_HASH_TABLE_SIZE; s++) {
+        UDPHashHead[s] = INVALID_UDP_SOCKET;
+    }
+
     for (s = 0; s < MAX_UDP_SOCKETS; s++) {
         UDPClose(s);
     }
@@ -205,13 +226,13 @@ UDP_SOCKET UDPOpenEx(uint32_t remoteHost, uint8_t remoteHostType, UDP_PORT local
     p = UDPSocketInfo;
     for (s = 0; s < MAX_UDP_SOCKETS; s++) {
         if (p->localPort == INVALID_UDP_PORT) {
-            p->localPort = localPort;
             if (localPort == 0x0000u) {
                 if (NextPort > LOCAL_UDP_PORT_END_NUMBER || NextPort < LOCAL_UDP_PORT_START_NUMBER)
                     NextPort = LOCAL_UDP_PORT_START_NUMBER;
 
-                p->localPort = NextPort++;
+                localPort = NextPort++;
             }
+            SetLocalPort(s, localPort);
             if ((remoteHostType == UDP_OPEN_SERVER) || (remoteHost == 0)) {
                 //Set remote node as 0xFF ( broadcast address)
                 // else Set broadcast address
@@ -485,14 +506,13 @@ UDP_SOCKET UDPOpen(UDP_PORT localPort,
     p = UDPSocketInfo;
     for (s = 0; s < MAX_UDP_SOCKETS; s++) {
         if (p->localPort == INVALID_UDP_PORT) {
-            p->localPort = localPort;
-
             if (localPort == 0x0000u) {
                 if (NextPort > LOCAL_UDP_PORT_END_NUMBER || NextPort < LOCAL_UDP_PORT_START_NUMBER)
                     NextPort = LOCAL_UDP_PORT_START_NUMBER;
 
-                p->localPort = NextPort++;
+                localPort = NextPort++;
             }
+            SetLocalPort(s, localPort);
 
             // If remoteNode is supplied, remember it.
             if (remoteNode) {
@@ -549,11 +569,56 @@ void UDPClose(UDP_SOCKET s)
     if (s >= MAX_UDP_SOCKETS)
         return;
 
-    UDPSocketInfo[s].localPort = INVALID_UDP_PORT;
+    SetLocalPort(s, INVALID_UDP_PORT);
     UDPSocketInfo[s].remote.remoteNode.IPAddr.Val = 0x00000000;
     UDPSocketInfo[s].smState = UDP_CLOSED;
 }
 
+/*****************************************************************************
+  Function:
+    static void SetLocalPort(UDP_SOCKET s, UDP_PORT localPort)
+
+  Summary:
+    Binds a UDP socket to a local port.
+
+  Description:
+    Changes the local port of a socket and moves the socket to the hash
+    bucket used by FindMatchingSocket() for that port.  Sockets set to
+    INVALID_UDP_PORT are left out of the hash buckets.
+
+  Precondition:
+    UDPInit() has emptied the hash buckets.
+
+  Parameters:
+    s - The socket to bind.
+    localPort - The new local port, or INVALID_UDP_PORT to free the socket.
+
+  Returns:
+    None
+ ***************************************************************************/
+static void SetLocalPort(UDP_SOCKET s, UDP_PORT localPort)
+{
+    UDP_SOCKET *p;
+
+    // Unlink from the bucket of the old port.  Free sockets are in no bucket.
+    if (UDPSocketInfo[s].localPort != INVALID_UDP_PORT) {
+        for (p = &UDPHashHead[UDPHashBucket(UDPSocketInfo[s].localPort)]; *p != INVALID_UDP_SOCKET; p = &UDPHashNext[*p]) {
+            if (*p == s) {
+                *p = UDPHashNext[s];
+                break;
+            }
+        }
+    }
+
+    UDPSocketInfo[s].localPort = localPort;
+
+    if (localPort != INVALID_UDP_PORT) {
+        p = &UDPHashHead[UDPHashBucket(localPort)];
+        UDPHashNext[s] = *p;
+        *p = s;
+    }
+}
+
 /*****************************************************************************
   Function:
     void UDPSetTxBuffer(uint16_t wOffset)
@@ -581,6 +646,13 @@ void UDPSetTxBuffer(uint16_t wOffset)
 {
     IPSetTxBuffer(wOffset + sizeof (UDP_HEADER));
     wPutOffset = wOffset;
+
+#if defined(UDP_USE_TX_CHECKSUM)
+    // Data written anywhere but the end of the payload may overwrite bytes
+    // that were already summed, so UDPFlush must checksum the MAC buffer
+    if (wOffset != UDPTxCount)
+        Flags.bTxChecksumValid = 0;
+#endif
 }
 
 /*****************************************************************************
@@ -647,6 +719,10 @@ uint16_t UDPIsPutReady(UDP_SOCKET s)
         LastPutSocket = s;
         UDPTxCount = 0;
         UDPSetTxBuffer(0);
+#if defined(UDP_USE_TX_CHECKSUM)
+        ChecksumBegin(&TxChecksum);
+        Flags.bTxChecksumValid = 1;
+#endif
     }
 
     activeUDPSocket = s;
@@ -685,6 +761,9 @@ bool UDPPut(uint8_t v)
 
     // Load application data byte
     MACPut(v);
+#if defined(UDP_USE_TX_CHECKSUM)
+    ChecksumAdd(&TxChecksum, &v, 1);
+#endif
     wPutOffset++;
     if (wPutOffset > UDPTxCount)
         UDPTxCount = wPutOffset;
@@ -730,6 +809,9 @@ uint16_t UDPPutArray(uint8_t *cData, uint16_t wDataLen)
 
     // Load application data bytes
     MACPutArray(cData, wDataLen);
+#if defined(UDP_USE_TX_CHECKSUM)
+    ChecksumAdd(&TxChecksum, cData, wDataLen);
+#endif
 
     return wDataLen;
 }
@@ -778,6 +860,10 @@ uint16_t UDPPutROMArray(ROM uint8_t *cData, uint16_t wDataLen)
 
     // Load application data bytes
     MACPutROMArray(cData, wDataLen);
+#if defined(UDP_USE_TX_CHECKSUM)
+    // ROM data cannot be summed in place; checksum the MAC buffer instead
+    Flags.bTxChecksumValid = 0;
+#endif
 
     return wDataLen;
 }
@@ -905,6 +991,19 @@ void UDPFlush(void)
         pseudoHeader.Length = wUDPLength;
         SwapPseudoHeader(pseudoHeader);
         h.Checksum = ~CalcIPChecksum((uint8_t *) & pseudoHeader, sizeof (pseudoHeader));
+
+        // If the payload was summed as it was written, finish the checksum
+        // here rather than reading the whole segment back from the MAC
+        if (Flags.bTxChecksumValid) {
+            IP_CHECKSUM cs;
+
+            ChecksumBegin(&cs);
+            ChecksumAdd(&cs, &h, sizeof (h));
+            ChecksumMerge(&cs, &TxChecksum);
+            h.Checksum = ChecksumFinish(&cs);
+            if (h.Checksum == 0x0000u)
+                h.Checksum = 0xFFFF;
+        }
     }
 #endif
 
@@ -918,9 +1017,10 @@ void UDPFlush(void)
     // Write UDP header to packet
     MACPutArray((uint8_t *) & h, sizeof (h));
 
-    // Calculate the final UDP checksum and write it in, if enabled
+    // Calculate the final UDP checksum and write it in, if enabled and it
+    // could not be computed while the payload was written
 #if defined(UDP_USE_TX_CHECKSUM)
-    {
+    if (!Flags.bTxChecksumValid) {
         PTR_BASE wReadPtrSave;
         uint16_t wChecksum;
 
@@ -1233,8 +1333,10 @@ static UDP_SOCKET FindMatchingSocket(UDP_HEADER *h,
 
     partialMatch = INVALID_UDP_SOCKET;
 
-    p = UDPSocketInfo;
-    for (s = 0; s < MAX_UDP_SOCKETS; s++) {
+    // Only sockets in the destination port's hash bucket can match
+    for (s = UDPHashHead[UDPHashBucket(h->DestinationPort)]; s != INVALID_UDP_SOCKET; s = UDPHashNext[s]) {
+        p = &UDPSocketInfo[s];
+
         // This packet is said to be matching with current socket:
         // 1. If its destination port matches with our local port and
         // 2. Packet source IP address matches with previously saved socket remote IP address and
@@ -1246,9 +1348,10 @@ static UDP_SOCKET FindMatchingSocket(UDP_HEADER *h,
                 }
             }
 
-            partialMatch = s;
+            // Prefer the highest numbered socket, as the linear search used to
+            if (partialMatch == INVALID_UDP_SOCKET || s > partialMatch)
+                partialMatch = s;
         }
-        p++;
     }
 
     if (partialMatch != INVALID_UDP_SOCKET) {
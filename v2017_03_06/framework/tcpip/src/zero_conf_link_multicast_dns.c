@@ -2064,7 +2064,8 @@ MDNS_STATIC void mDNSResponder(void)
             memcpy((void *) &UDPSocketInfo[mDNS_socket].remote.remoteNode,
                     (const void *) &mDNSRemote, sizeof (mDNSRemote));
             UDPSocketInfo[mDNS_socket].remotePort = MDNS_PORT;
-            UDPSocketInfo[mDNS_socket].localPort = MDNS_PORT;
+            // The local port stays MDNS_PORT from UDPOpenEx(); it must only
+            // change through udp.c, which keeps the port lookup table.
         }
 
         // Retrieve the mDNS header
@@ -52,6 +52,20 @@ typedef uint8_t TCP_SOCKET;
 #define INVALID_SOCKET (0xFE) // The socket is invalid or could not be opened
 #define UNKNOWN_SOCKET (0xFF) // The socket is not known
 
+// Maximum number of separate out-of-order data ranges each socket can hold in
+// its RX FIFO while waiting for the missing data ahead of them.  Each range
+// costs 4 bytes of TCB storage.  Override in tcpip_config.h if needed.
+#if !defined(TCP_MAX_RX_RANGES)
+#define TCP_MAX_RX_RANGES (4u)
+#endif
+
+// Out-of-order data that has already been copied into the RX FIFO.
+// Offsets are relative to rxHead (RemoteSEQ), so a range never starts at 0.
+typedef struct {
+    uint16_t wOffset; // Number of missing bytes between rxHead and this data
+    uint16_t wLength; // Number of contiguous data bytes in this range
+} TCP_RX_RANGE;
+
 /****************************************************************************
   Section:
     State Machine Variables
@@ -142,7 +156,7 @@ typedef struct {
 
 // Remainder of TCP Control Block data.
 // The rest of the TCB is stored in Ethernet buffer RAM or elsewhere as defined by vMemoryMedium.
-// Current size is 41 (PIC18), 42 (PIC24), or 48 bytes (PIC32)
+// Current size is 62 (PIC18), 62 (PIC24), or 68 bytes (PIC32) with the default TCP_MAX_RX_RANGES
 
 typedef struct {
     uint32_t retryInterval; // How long to wait before retrying transmission
@@ -152,23 +166,26 @@ typedef struct {
     TCPIP_UINT16_VAL remotePort; // Remote port number
     TCPIP_UINT16_VAL localPort; // Local port number
     uint16_t remoteWindow; // Remote window size
-    uint16_t wFutureDataSize; // How much out-of-order data has been received
 
     union {
         NODE_INFO niRemoteMACIP; // 10 bytes for MAC and IP address
         uint32_t dwRemoteHost; // RAM or ROM pointer to a hostname string (ex: "www.microchip.com")
     } remote;
-    int16_t sHoleSize; // Size of the hole, or -1 for none exists.  (0 indicates hole has just been filled)
+    TCP_RX_RANGE rxRanges[TCP_MAX_RX_RANGES]; // Out-of-order data waiting in the RX FIFO, sorted by offset
+    uint8_t vRxRanges; // Number of valid entries in rxRanges
 
     struct {
         unsigned char bFINSent : 1; // A FIN has been sent
         unsigned char bSYNSent : 1; // A SYN has been sent
         unsigned char bRemoteHostIsROM : 1; // Remote host is stored in ROM
-        unsigned char bRXNoneACKed1 : 1; // A duplicate ACK was likely received
-        unsigned char bRXNoneACKed2 : 1; // A second duplicate ACK was likely received
-        unsigned char filler : 3; // future use
+        unsigned char vDuplicateACKs : 2; // Number of consecutive duplicate ACKs received, saturating at 3
+        unsigned char bFastRecovery : 1; // Fast recovery is in progress after a fast retransmit
+        unsigned char filler : 2; // future use
     } flags;
     uint16_t wRemoteMSS; // Maximum Segment Size option advertised by the remote node during initial handshaking
+    uint16_t wCongestionWindow; // Maximum number of unacknowledged bytes allowed in flight (cwnd)
+    uint16_t wSlowStartThreshold; // Congestion window size where slow start ends (ssthresh)
+    uint32_t dwRecoverSEQ; // Highest SEQ sent when fast recovery began
 #if defined(STACK_USE_SSL)
     TCPIP_UINT16_VAL localSSLPort; // Local SSL port number (for listening sockets)
 #endif
@@ -209,6 +226,8 @@ uint16_t TCPFindArrayEx(TCP_SOCKET hTCP, uint8_t *cFindArray, uint16_t wLen, uin
 void TCPDiscard(TCP_SOCKET hTCP);
 bool TCPProcess(NODE_INFO *remote, IP_ADDR *localIP, uint16_t len);
 void TCPTick(void);
+void TCPRxBatchBegin(void);
+void TCPRxBatchEnd(void);
 void TCPFlush(TCP_SOCKET hTCP);
 
 // Create a server socket and ignore dwRemoteHost.
@@ -266,6 +285,11 @@ ROM uint8_t * TCPPutROMString(TCP_SOCKET hTCP, ROM uint8_t * Data);
 
 uint16_t TCPGetTxFIFOFull(TCP_SOCKET hTCP);
 
+#if defined(STACK_USE_MPFS2)
+#include "tcpip/src/common/mpfs2.h"
+uint16_t TCPPutFromMPFS(TCP_SOCKET hTCP, MPFS_HANDLE hMPFS, uint16_t len);
+#endif
+
 // Alias to TCPIsGetReady provided for API completeness
 #define TCPGetRxFIFOFull(a)             TCPIsGetReady(a)
 // Alias to TCPIsPutReady provided for API completeness
@@ -23,11 +23,28 @@ please contact mla_licensing@microchip.com
 #define CDC_H
 
 /** I N C L U D E S **********************************************************/
+#include <stddef.h>
 #include "usb.h"
 #include "usb_config.h"
 
 /** D E F I N I T I O N S ****************************************************/
 
+/* Number of independent CDC ports (virtual COM ports) provided by the driver.
+ * When more than one is used, usb_config.h must also define
+ * USB_CDC_INSTANCE_BINDINGS, one CDC_INSTANCE_BINDING initializer per
+ * instance, for example:
+ *
+ *  #define USB_MAX_CDC_INSTANCES       2
+ *  #define USB_CDC_INSTANCE_BINDINGS   {0, 1, 1, 2}, {2, 3, 3, 4}
+ *
+ * The configuration descriptor must describe matching interface pairs
+ * (normally each grouped with an interface association descriptor).
+ * More than one instance cannot be used with FIXED_ADDRESS_MEMORY.
+ */
+#if !defined(USB_MAX_CDC_INSTANCES)
+    #define USB_MAX_CDC_INSTANCES       1
+#endif
+
 /* Class-Specific Requests */
 #define SEND_ENCAPSULATED_COMMAND   0x00
 #define GET_ENCAPSULATED_RESPONSE   0x01
@@ -392,6 +409,36 @@ please contact mla_licensing@microchip.com
  *****************************************************************************/
 #define USBUSARTIsTxTrfReady()      (cdc_trf_state == CDC_TX_READY)
 
+/******************************************************************************
+    Function:
+        bool CDCInstanceIsTxTrfReady(uint8_t instance)
+
+    Summary:
+        USBUSARTIsTxTrfReady() for the given CDC instance.
+ *****************************************************************************/
+#define CDCInstanceIsTxTrfReady(instance)   (cdcInstance[instance].trfState == CDC_TX_READY)
+
+/******************************************************************************
+    Function:
+        LINE_CODING CDCInstanceLineCoding(uint8_t instance)
+
+    Summary:
+        The line coding (baud rate, stop bits, parity, data bits) last set by
+        the host for the given CDC instance.  For instance 0 this is the
+        same structure as line_coding.
+ *****************************************************************************/
+#define CDCInstanceLineCoding(instance)     (cdcInstance[instance].lineCoding)
+
+/******************************************************************************
+    Function:
+        CONTROL_SIGNAL_BITMAP CDCInstanceControlSignals(uint8_t instance)
+
+    Summary:
+        The DTR/RTS state last set by the host with SET_CONTROL_LINE_STATE
+        for the given CDC instance.
+ *****************************************************************************/
+#define CDCInstanceControlSignals(instance) (cdcInstance[instance].controlSignals)
+
 /******************************************************************************
     Function:
         void mUSBUSARTTxRam(uint8_t *pData, uint8_t len)
@@ -531,10 +578,33 @@ please contact mla_licensing@microchip.com
   Conditions:
     None
   Remarks:
-    None                                                                   
+    All USB_MAX_CDC_INSTANCES instances are initialized, using the
+    endpoints given for each of them in USB_CDC_INSTANCE_BINDINGS.
   **************************************************************************/
 void CDCInitEP(void);
 
+/**************************************************************************
+  Function:
+        uint8_t CDCInstanceFromInterface(uint8_t interface)
+
+  Summary:
+    Returns the CDC instance that owns a USB interface number.
+
+  Description:
+    Looks up the communication and data interface numbers of every
+    instance.  This is useful in a USB_CDC_SET_LINE_CODING_HANDLER, which
+    can pass SetupPkt.bIntfID to find out which port the new line coding
+    is meant for.
+
+  Input:
+    uint8_t interface - the bInterfaceNumber to look up
+
+  Return:
+    The instance index, or USB_MAX_CDC_INSTANCES if no instance uses the
+    interface.
+  **************************************************************************/
+uint8_t CDCInstanceFromInterface(uint8_t interface);
+
 /******************************************************************************
  	Function:
  		void USBCheckCDCRequest(void)
@@ -557,7 +627,8 @@ void CDCInitEP(void);
 		
 	Remarks:
 		This function does not change status or do anything if the SETUP packet
-		did not contain a CDC class specific request.		 
+		did not contain a CDC class specific request.  The request is routed
+		to the instance that owns the addressed interface.
   *****************************************************************************/
 void USBCheckCDCRequest(void);
 
@@ -576,6 +647,7 @@ void USBCheckCDCRequest(void);
     the information to the USB host.  This can be done by calling 
     CDCNotificationHandler() by itself, or, by calling CDCTxService() which
     also calls CDCNotificationHandler() internally, when appropriate.
+    The DSR pin, and therefore the notification, belongs to instance 0.
   **************************************************************************/
 void CDCNotificationHandler(void);
 
@@ -652,6 +724,95 @@ bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size);
   **********************************************************************************/
 uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len);
 
+/**********************************************************************************
+  Function:
+        uint8_t CDCInstanceGets(uint8_t instance, uint8_t *buffer, uint8_t len)
+
+  Summary:
+    getsUSBUSART() for the given CDC instance.
+
+  Input:
+    instance - the CDC instance (0 to USB_MAX_CDC_INSTANCES - 1)
+    buffer -  Pointer to where received BYTEs are to be stored
+    len -     The number of BYTEs expected.
+
+  Return:
+    The number of bytes copied to 'buffer', 0 if no data is available.
+  **********************************************************************************/
+uint8_t CDCInstanceGets(uint8_t instance, uint8_t *buffer, uint8_t len);
+
+#if defined(USB_CDC_RX_ZERO_COPY)
+/**********************************************************************************
+  Function:
+        bool CDC_RxPacketGet(uint8_t **data, uint8_t *length)
+
+  Summary:
+    CDC_RxPacketGet returns a pointer to the oldest packet received through
+    the USB CDC Bulk OUT endpoint, without copying it.
+
+  Description:
+    CDC_RxPacketGet returns a pointer to the oldest packet received through
+    the USB CDC Bulk OUT endpoint.  Two ping-pong endpoint buffers are kept,
+    so the host can send the next packet while the application processes the
+    current one in place.  Each packet must be handed back with
+    CDC_RxPacketRelease().
+
+    Typical Usage:
+    <code>
+        uint8_t *packet;
+        uint8_t length;
+
+        if(CDC_RxPacketGet(&packet, &length) == true)
+        {
+            ProcessCommand(packet, length);
+            CDC_RxPacketRelease();
+        }
+    </code>
+  Conditions:
+    USB_CDC_RX_ZERO_COPY must be defined in usb_config.h, and USB_PING_PONG_MODE
+    must be USB_PING_PONG__FULL_PING_PONG or USB_PING_PONG__ALL_BUT_EP0.
+  Input:
+    data -    Receives a pointer to the packet data
+    length -  Receives the number of bytes in the packet
+  Output:
+    bool -    true if a packet is available, otherwise false.
+                                                                                   
+  **********************************************************************************/
+bool CDC_RxPacketGet(uint8_t **data, uint8_t *length);
+
+/**********************************************************************************
+  Function:
+        void CDC_RxPacketRelease(void)
+
+  Summary:
+    CDC_RxPacketRelease re-arms the endpoint buffer returned by the last
+    CDC_RxPacketGet() call so it can receive more data from the host.
+
+  Conditions:
+    USB_CDC_RX_ZERO_COPY must be defined in usb_config.h.
+                                                                                   
+  **********************************************************************************/
+void CDC_RxPacketRelease(void);
+
+/**********************************************************************************
+  Function:
+        bool CDCInstanceRxPacketGet(uint8_t instance, uint8_t **data, uint8_t *length)
+
+  Summary:
+    CDC_RxPacketGet() for the given CDC instance.
+  **********************************************************************************/
+bool CDCInstanceRxPacketGet(uint8_t instance, uint8_t **data, uint8_t *length);
+
+/**********************************************************************************
+  Function:
+        void CDCInstanceRxPacketRelease(uint8_t instance)
+
+  Summary:
+    CDC_RxPacketRelease() for the given CDC instance.
+  **********************************************************************************/
+void CDCInstanceRxPacketRelease(uint8_t instance);
+#endif
+
 /******************************************************************************
   Function:
 	void putUSBUSART(char *data, uint8_t length)
@@ -694,6 +855,18 @@ uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len);
  *****************************************************************************/
 void putUSBUSART(uint8_t *data, uint8_t Length);
 
+/******************************************************************************
+  Function:
+	void CDCInstancePut(uint8_t instance, uint8_t *data, uint8_t length)
+
+  Summary:
+    putUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+ *****************************************************************************/
+void CDCInstancePut(uint8_t instance, uint8_t *data, uint8_t length);
+
 /******************************************************************************
 	Function:
 		void putsUSBUSART(char *data)
@@ -735,6 +908,18 @@ void putUSBUSART(uint8_t *data, uint8_t Length);
  *****************************************************************************/
 void putsUSBUSART(char *data);
 
+/******************************************************************************
+  Function:
+	void CDCInstancePuts(uint8_t instance, char *data)
+
+  Summary:
+    putsUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+ *****************************************************************************/
+void CDCInstancePuts(uint8_t instance, char *data);
+
 
 /**************************************************************************
   Function:
@@ -778,6 +963,93 @@ void putsUSBUSART(char *data);
   **************************************************************************/
 void putrsUSBUSART(const const char *data);
 
+/**************************************************************************
+  Function:
+        void CDCInstancePutrs(uint8_t instance, const char *data)
+
+  Summary:
+    putrsUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+  **************************************************************************/
+void CDCInstancePutrs(uint8_t instance, const char *data);
+
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+/**************************************************************************
+  Function:
+        size_t CDC_TxWrite(const uint8_t *data, size_t length)
+
+  Summary:
+    CDC_TxWrite queues data into the CDC transmit ring buffer for sending
+    to the host, without requiring USBUSARTIsTxTrfReady() to be true.
+
+  Description:
+    CDC_TxWrite copies as much of 'data' as currently fits into the
+    USB_CDC_TX_BUFFER_SIZE byte transmit ring buffer and returns the number
+    of bytes accepted.  The length is not limited to 255 bytes and the data
+    buffer may be reused as soon as the function returns.  CDCTxService()
+    sends the buffered data in CDC_DATA_IN_EP_SIZE packets, followed by a
+    zero length packet when required.
+
+    Typical Usage:
+    <code>
+        static size_t sent = 0;
+
+        sent += CDC_TxWrite(&logRecord[sent], sizeof(logRecord) - sent);
+        if(sent == sizeof(logRecord))
+        {
+            sent = 0;
+        }
+    </code>
+
+  Conditions:
+    USB_CDC_TX_BUFFER_SIZE must be defined in usb_config.h.  The device
+    should be in the CONFIGURED_STATE.
+
+  Input:
+    const uint8_t *data - pointer to a RAM array of data to be transfered
+                          to the host
+    size_t length - the number of bytes to be transfered
+
+  Return:
+    The number of bytes accepted, which may be less than 'length' when
+    the ring buffer is full.
+  **************************************************************************/
+size_t CDC_TxWrite(const uint8_t *data, size_t length);
+
+/**************************************************************************
+  Function:
+        size_t CDC_TxFreeSpaceGet(void)
+
+  Summary:
+    Returns the number of bytes CDC_TxWrite() can currently accept.
+
+  Conditions:
+    USB_CDC_TX_BUFFER_SIZE must be defined in usb_config.h.
+  **************************************************************************/
+size_t CDC_TxFreeSpaceGet(void);
+
+/**************************************************************************
+  Function:
+        size_t CDCInstanceTxWrite(uint8_t instance, const uint8_t *data, size_t length)
+
+  Summary:
+    CDC_TxWrite() for the given CDC instance.  Each instance has its own
+    USB_CDC_TX_BUFFER_SIZE byte ring buffer.
+  **************************************************************************/
+size_t CDCInstanceTxWrite(uint8_t instance, const uint8_t *data, size_t length);
+
+/**************************************************************************
+  Function:
+        size_t CDCInstanceTxFreeSpaceGet(uint8_t instance)
+
+  Summary:
+    CDC_TxFreeSpaceGet() for the given CDC instance.
+  **************************************************************************/
+size_t CDCInstanceTxFreeSpaceGet(uint8_t instance);
+#endif
+
 /************************************************************************
   Function:
         void CDCTxService(void)
@@ -826,7 +1098,9 @@ void putrsUSBUSART(const const char *data);
     CDCIniEP() function should have already exectuted/the device should be
     in the CONFIGURED_STATE.
   Remarks:
-    None                                                                 
+    All CDC instances are serviced in each call.  Every instance sends at
+    most one packet per call, so a long transfer on one port does not
+    delay the others.
   ************************************************************************/
 void CDCTxService(void);
 
@@ -938,18 +1212,56 @@ typedef struct
     uint8_t    Reserved;
 }SERIAL_STATE_NOTIFICATION;   
 
+/* Interface and endpoint numbers used by one CDC instance */
+typedef struct
+{
+    uint8_t commInterface;      // Communication class interface number
+    uint8_t dataInterface;      // Data class interface number
+    uint8_t commEP;             // Notification (interrupt IN) endpoint
+    uint8_t dataEP;             // Bulk IN/OUT data endpoint
+} CDC_INSTANCE_BINDING;
+
+/* Run time state of one CDC instance */
+typedef struct
+{
+    LINE_CODING lineCoding;                 // Line coding set by the host
+    CONTROL_SIGNAL_BITMAP controlSignals;   // DTR/RTS set by the host
+    USB_HANDLE dataOutHandle;
+    USB_HANDLE dataInHandle;
+    POINTER pSrc;                           // Source pointer of the putUSBUSART() transfer
+    uint8_t rxLength;                       // Length of the last getsUSBUSART() read
+    uint8_t txLength;                       // Bytes left in the putUSBUSART() transfer
+    uint8_t trfState;                       // CDC_TX_READY, CDC_TX_BUSY, ...
+    uint8_t memType;                        // USB_EP0_ROM or USB_EP0_RAM
+    #if defined(USB_CDC_RX_ZERO_COPY)
+        USB_HANDLE dataOutOddHandle;        // Handle for the odd receive buffer
+        bool rxEvenNext;                    // true when the even buffer completes next
+    #endif
+    #if defined(USB_CDC_TX_BUFFER_SIZE)
+        volatile size_t txRingHead;         // Next free location (written by CDC_TxWrite())
+        volatile size_t txRingTail;         // Next location to send (read by CDCTxService())
+        volatile size_t txRingCount;        // Number of bytes waiting to be sent
+        bool txRingZlpPending;              // Last packet was full sized, a ZLP may be needed
+    #endif
+} CDC_INSTANCE;
+
 //DOM-IGNORE-BEGIN
 /** E X T E R N S ************************************************************/
-extern uint8_t cdc_rx_len;
+extern CDC_INSTANCE cdcInstance[USB_MAX_CDC_INSTANCES];
 extern USB_HANDLE lastTransmission;
 
-extern uint8_t cdc_trf_state;
-extern POINTER pCDCSrc;
-extern uint8_t cdc_tx_len;
-extern uint8_t cdc_mem_type;
+/* The single port API and its variables refer to instance 0 */
+#define line_coding             cdcInstance[0].lineCoding
+#define control_signal_bitmap   cdcInstance[0].controlSignals
+#define cdc_rx_len              cdcInstance[0].rxLength
+#define cdc_trf_state           cdcInstance[0].trfState
+#define pCDCSrc                 cdcInstance[0].pSrc
+#define cdc_tx_len              cdcInstance[0].txLength
+#define cdc_mem_type            cdcInstance[0].memType
+#define CDCDataOutHandle        cdcInstance[0].dataOutHandle
+#define CDCDataInHandle         cdcInstance[0].dataInHandle
 
 extern CDC_NOTICE cdc_notice;
-extern LINE_CODING line_coding;
 
 extern volatile CTRL_TRF_SETUP SetupPkt;
 extern const uint8_t configDescriptor1[];
@@ -963,10 +1275,23 @@ extern const uint8_t configDescriptor1[];
 //void USBCheckCDCRequest(void);
 //void CDCInitEP(void);
 //bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size);
+//uint8_t CDCInstanceFromInterface(uint8_t interface);
 //uint8_t getsUSBUSART(char *buffer, uint8_t len);
+//uint8_t CDCInstanceGets(uint8_t instance, uint8_t *buffer, uint8_t len);
+//bool CDC_RxPacketGet(uint8_t **data, uint8_t *length);
+//void CDC_RxPacketRelease(void);
+//bool CDCInstanceRxPacketGet(uint8_t instance, uint8_t **data, uint8_t *length);
+//void CDCInstanceRxPacketRelease(uint8_t instance);
 //void putUSBUSART(char *data, uint8_t Length);
+//void CDCInstancePut(uint8_t instance, uint8_t *data, uint8_t length);
 //void putsUSBUSART(char *data);
+//void CDCInstancePuts(uint8_t instance, char *data);
 //void putrsUSBUSART(const const char *data);
+//void CDCInstancePutrs(uint8_t instance, const char *data);
+//size_t CDC_TxWrite(const uint8_t *data, size_t length);
+//size_t CDC_TxFreeSpaceGet(void);
+//size_t CDCInstanceTxWrite(uint8_t instance, const uint8_t *data, size_t length);
+//size_t CDCInstanceTxFreeSpaceGet(uint8_t instance);
 //void CDCTxService(void);
 //void CDCNotificationHandler(void);
 //------------------------------------------------------------------------------
@@ -0,0 +1,663 @@
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright 2015 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef USB_HAL_SIM_H
+#define USB_HAL_SIM_H
+
+/*****************************************************************************/
+/****** include files ********************************************************/
+/*****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "usb_config.h"
+#include "usb_common.h"
+
+/*****************************************************************************/
+/****** Constant definitions *************************************************/
+/*****************************************************************************/
+
+//The simulated serial interface engine (SIE) models the 16-bit PIC24F USB
+//module register set, but keeps the SFRs and the buffer descriptor table (BDT)
+//in ordinary host RAM.  BDT entries hold a full host pointer, so only the
+//full ping-pong layout (which the stack addresses by XORing the entry address)
+//is supported.
+#define DEVICE_SPECIFIC_IEC_REGISTER_COUNT  1
+#define USB_HAL_VBUSTristate()
+
+#if (USB_PING_PONG_MODE == USB_PING_PONG__FULL_PING_PONG)
+    #define BDT_NUM_ENTRIES      ((USB_MAX_EP_NUMBER + 1) * 4)
+#else
+    #error "The simulated USB module only supports USB_PING_PONG__FULL_PING_PONG."
+#endif
+
+//Depth of the USTAT FIFO, matching the four entry FIFO of the real module.
+#define USB_SIM_USTAT_FIFO_SIZE         4
+
+//----- USBEnableEndpoint() input definitions ----------------------------------
+#define USB_HANDSHAKE_ENABLED           0x01
+#define USB_HANDSHAKE_DISABLED          0x00
+
+#define USB_OUT_ENABLED                 0x08
+#define USB_OUT_DISABLED                0x00
+
+#define USB_IN_ENABLED                  0x04
+#define USB_IN_DISABLED                 0x00
+
+#define USB_ALLOW_SETUP                 0x00
+#define USB_DISALLOW_SETUP              0x10
+
+#define USB_STALL_ENDPOINT              0x02
+
+//----- usb_config.h input definitions -----------------------------------------
+#define USB_PULLUP_ENABLE               0x00
+
+#define USB_INTERNAL_TRANSCEIVER        0x00
+#define USB_EXTERNAL_TRANSCEIVER        0x01
+
+#define USB_FULL_SPEED                  0x04
+
+#define USB_OTG_ENABLE                  0x04
+
+//----- Interrupt Flag definitions --------------------------------------------
+#define USBTransactionCompleteIE        U1IEbits.TRNIE
+#define USBTransactionCompleteIF        U1IRbits.TRNIF
+#define USBTransactionCompleteIFReg     U1IR
+#define USBTransactionCompleteIFBitNum  3
+
+#define USBResetIE                      U1IEbits.URSTIE
+#define USBResetIF                      U1IRbits.URSTIF
+#define USBResetIFReg                   U1IR
+#define USBResetIFBitNum                0
+
+#define USBIdleIE                       U1IEbits.IDLEIE
+#define USBIdleIF                       U1IRbits.IDLEIF
+#define USBIdleIFReg                    U1IR
+#define USBIdleIFBitNum                 4
+
+#define USBActivityIE                   U1OTGIEbits.ACTVIE
+#define USBActivityIF                   U1OTGIRbits.ACTVIF
+#define USBActivityIFReg                U1OTGIR
+#define USBActivityIFBitNum             4
+
+#define USBSOFIE                        U1IEbits.SOFIE
+#define USBSOFIF                        U1IRbits.SOFIF
+#define USBSOFIFReg                     U1IR
+#define USBSOFIFBitNum                  2
+
+#define USBStallIE                      U1IEbits.STALLIE
+#define USBStallIF                      U1IRbits.STALLIF
+#define USBStallIFReg                   U1IR
+#define USBStallIFBitNum                7
+
+#define USBErrorIE                      U1IEbits.UERRIE
+#define USBErrorIF                      U1IRbits.UERRIF
+#define USBErrorIFReg                   U1IR
+#define USBErrorIFBitNum                1
+
+#define USBT1MSECIE                     U1OTGIEbits.T1MSECIE
+#define USBT1MSECIF                     U1OTGIRbits.T1MSECIF
+#define USBT1MSECIFReg                  U1OTGIR
+#define USBT1MSECIFBitNum               6
+
+#define USBIDIE                         U1OTGIEbits.IDIE
+#define USBIDIF                         U1OTGIRbits.IDIF
+#define USBIDIFReg                      U1OTGIR
+#define USBIDIFBitNum                   7
+
+#define USBSESVDIE                      U1OTGIEbits.SESVDIE
+#define USBSESVDIF                      U1OTGIRbits.SESVDIF
+#define USBSESVDReg                     U1OTGIR
+#define USBSESVDBitNum                  3
+
+#define USBRESUMEIE                     U1IEbits.RESUMEIE
+#define USBRESUMEIF                     U1IRbits.RESUMEIF
+#define USBRESUMEIFReg                  U1IR
+#define USBRESUMEIFBitNum               5
+
+//----- Event call back definitions --------------------------------------------
+#if defined(USB_DISABLE_SOF_HANDLER)
+    #define USB_SOF_INTERRUPT           0x00
+#else
+    #define USB_SOF_INTERRUPT           0x04
+#endif
+#define USB_ERROR_INTERRUPT             0x02
+
+//----- USB module control bits -----------------------------------------------
+//Writes to PPBRST are routed through the simulated SIE, which resets its
+//ping-pong pointers when the stack asserts the bit.
+#define USBPingPongBufferReset          (*USBSimPingPongBufferReset())
+#define USBSE0Event                     U1CONbits.SE0
+#define USBSuspendControl               U1PWRCbits.USUSPND
+#define USBPacketDisable                U1CONbits.PKTDIS
+#define USBResumeControl                U1CONbits.RESUME
+
+//----- BDnSTAT bit definitions -----------------------------------------------
+#define _BSTALL                         0x04        //Buffer Stall enable
+#define _DTSEN                          0x08        //Data Toggle Synch enable
+#define _DAT0                           0x00        //DATA0 packet expected next
+#define _DAT1                           0x40        //DATA1 packet expected next
+#define _DTSMASK                        0x40        //DTS Mask
+#define _USIE                           0x80        //SIE owns buffer
+#define _UCPU                           0x00        //CPU owns buffer
+#define _STAT_MASK                      0xFC
+
+//----- USTAT bit definitions -------------------------------------------------
+#define USTAT_EP0_PP_MASK               ~0x04
+#define USTAT_EP_MASK                   0xFC
+#define USTAT_EP0_OUT                   0x00
+#define USTAT_EP0_OUT_EVEN              0x00
+#define USTAT_EP0_OUT_ODD               0x04
+#define USTAT_EP0_IN                    0x08
+#define USTAT_EP0_IN_EVEN               0x08
+#define USTAT_EP0_IN_ODD                0x0C
+#define ENDPOINT_MASK                   0xF0
+
+//----- U1OTGCON bit definitions ----------------------------------------------
+#define USB_OTG_DPLUS_ENABLE            0x80
+
+//----- U1EP bit definitions --------------------------------------------------
+#define UEP_STALL                       0x0002
+// Cfg Control pipe for this ep
+#define EP_CTRL                         0x0C
+
+//The stack toggles between the even and odd BDT entry by XORing the entry
+//address, so the table must be aligned to a multiple of its size.
+#define BDT_BASE_ADDR_TAG   __attribute__ ((aligned (1024)))
+#define CTRL_TRF_SETUP_ADDR_TAG
+#define CTRL_TRF_DATA_ADDR_TAG
+
+/*****************************************************************************/
+/****** Type definitions *****************************************************/
+/*****************************************************************************/
+
+// Buffer Descriptor Status Register layout.
+typedef union __attribute__ ((packed)) _BD_STAT
+{
+    struct __attribute__ ((packed)){
+        uint8_t            :2;     //Byte count
+        uint8_t    BSTALL  :1;     //Buffer Stall Enable
+        uint8_t    DTSEN   :1;     //Data Toggle Synch Enable
+        uint8_t            :2;     //Reserved - write as 00
+        uint8_t    DTS     :1;     //Data Toggle Synch Value
+        uint8_t    UOWN    :1;     //USB Ownership
+    };
+    struct __attribute__ ((packed)){
+        uint8_t            :2;
+        uint8_t    PID0    :1;
+        uint8_t    PID1    :1;
+        uint8_t    PID2    :1;
+        uint8_t    PID3    :1;
+    };
+    struct __attribute__ ((packed)){
+        uint8_t            :2;
+        uint8_t    PID     :4;     // Packet Identifier
+    };
+    uint8_t            Val;
+} BD_STAT;                      //Buffer Descriptor Status Register
+
+// BDT Entry Layout.  STAT occupies the low byte of Val (as on PIC32), so that
+// clearing Val also releases the entry to the CPU.  ADR is a full host pointer.
+typedef union __BDT
+{
+    struct
+    {
+        BD_STAT     STAT;
+        uint8_t     reserved;
+        uint16_t    CNT;
+        uint32_t    reserved2;
+        uintptr_t   ADR;        //Buffer Address
+    };
+    uint32_t           Val;
+    uint16_t            v[2];
+} BDT_ENTRY;
+
+// USTAT Register Layout
+typedef union __USTAT
+{
+    struct
+    {
+        unsigned char filler1           :2;
+        unsigned char ping_pong         :1;
+        unsigned char direction         :1;
+        unsigned char endpoint_number   :4;
+    };
+    uint8_t Val;
+} USTAT_FIELDS;
+
+//Macros for fetching parameters from a USTAT_FIELDS variable.
+#define USBHALGetLastEndpoint(stat)     stat.endpoint_number
+#define USBHALGetLastDirection(stat)    stat.direction
+#define USBHALGetLastPingPong(stat)     stat.ping_pong
+
+typedef union _POINTER
+{
+    struct
+    {
+        uint8_t bLow;
+        uint8_t bHigh;
+    };
+    uint16_t _word;                         // bLow & bHigh
+
+    uint8_t* bRam;                          // Ram byte pointer
+    uint16_t* wRam;                         // Ram word pointer
+
+    const uint8_t* bRom;
+    const uint16_t* wRom;
+} POINTER;
+
+//----- Simulated special function registers ----------------------------------
+typedef union
+{
+    struct
+    {
+        uint16_t USBEN      :1;
+        uint16_t PPBRST     :1;
+        uint16_t RESUME     :1;
+        uint16_t HOSTEN     :1;
+        uint16_t USBRST     :1;
+        uint16_t PKTDIS     :1;
+        uint16_t SE0        :1;
+        uint16_t JSTATE     :1;
+        uint16_t SUSPND     :1;
+    };
+    uint16_t Val;
+} USB_SIM_U1CON;
+
+typedef union
+{
+    struct
+    {
+        uint16_t URSTIF     :1;
+        uint16_t UERRIF     :1;
+        uint16_t SOFIF      :1;
+        uint16_t TRNIF      :1;
+        uint16_t IDLEIF     :1;
+        uint16_t RESUMEIF   :1;
+        uint16_t ATTACHIF   :1;
+        uint16_t STALLIF    :1;
+    };
+    struct
+    {
+        uint16_t URSTIE     :1;
+        uint16_t UERRIE     :1;
+        uint16_t SOFIE      :1;
+        uint16_t TRNIE      :1;
+        uint16_t IDLEIE     :1;
+        uint16_t RESUMEIE   :1;
+        uint16_t ATTACHIE   :1;
+        uint16_t STALLIE    :1;
+    };
+    uint16_t Val;
+} USB_SIM_U1IR;
+
+typedef union
+{
+    struct
+    {
+        uint16_t VBUSVDIF   :1;
+        uint16_t            :1;
+        uint16_t SESENDIF   :1;
+        uint16_t SESVDIF    :1;
+        uint16_t ACTVIF     :1;
+        uint16_t LSTATEIF   :1;
+        uint16_t T1MSECIF   :1;
+        uint16_t IDIF       :1;
+    };
+    struct
+    {
+        uint16_t VBUSVDIE   :1;
+        uint16_t            :1;
+        uint16_t SESENDIE   :1;
+        uint16_t SESVDIE    :1;
+        uint16_t ACTVIE     :1;
+        uint16_t LSTATEIE   :1;
+        uint16_t T1MSECIE   :1;
+        uint16_t IDIE       :1;
+    };
+    uint16_t Val;
+} USB_SIM_U1OTGIR;
+
+typedef union
+{
+    struct
+    {
+        uint16_t VBUSDIS    :1;
+        uint16_t VBUSCHG    :1;
+        uint16_t OTGEN      :1;
+        uint16_t VBUSON     :1;
+        uint16_t DMPULDWN   :1;
+        uint16_t DPPULDWN   :1;
+        uint16_t DMPULUP    :1;
+        uint16_t DPPULUP    :1;
+    };
+    uint16_t Val;
+} USB_SIM_U1OTGCON;
+
+typedef union
+{
+    struct
+    {
+        uint16_t USBPWR     :1;
+        uint16_t USUSPND    :1;
+    };
+    uint16_t Val;
+} USB_SIM_U1PWRC;
+
+typedef union
+{
+    struct
+    {
+        uint8_t EPHSHK      :1;
+        uint8_t EPSTALL     :1;
+        uint8_t EPTXEN      :1;
+        uint8_t EPRXEN      :1;
+        uint8_t EPCONDIS    :1;
+    };
+    uint8_t Val;
+} USB_SIM_U1EP;
+
+typedef struct
+{
+    USB_SIM_U1CON       con;
+    USB_SIM_U1IR        ir;
+    USB_SIM_U1IR        ie;
+    uint16_t            eir;
+    uint16_t            eie;
+    USB_SIM_U1OTGIR     otgir;
+    USB_SIM_U1OTGIR     otgie;
+    USB_SIM_U1OTGCON    otgcon;
+    USB_SIM_U1PWRC      pwrc;
+    uint16_t            stat;
+    uint16_t            addr;
+    uint16_t            cnfg1;
+    uint16_t            cnfg2;
+    uintptr_t           bdtp;
+    USB_SIM_U1EP        ep[16];
+} USB_SIM_SFR;
+
+extern volatile USB_SIM_SFR USBSimSFR;
+
+#define U1CON               USBSimSFR.con.Val
+#define U1CONbits           USBSimSFR.con
+#define U1IR                USBSimSFR.ir.Val
+#define U1IRbits            USBSimSFR.ir
+#define U1IE                USBSimSFR.ie.Val
+#define U1IEbits            USBSimSFR.ie
+#define U1EIR               USBSimSFR.eir
+#define U1EIE               USBSimSFR.eie
+#define U1OTGIR             USBSimSFR.otgir.Val
+#define U1OTGIRbits         USBSimSFR.otgir
+#define U1OTGIE             USBSimSFR.otgie.Val
+#define U1OTGIEbits         USBSimSFR.otgie
+#define U1OTGCON            USBSimSFR.otgcon.Val
+#define U1OTGCONbits        USBSimSFR.otgcon
+#define U1PWRC              USBSimSFR.pwrc.Val
+#define U1PWRCbits          USBSimSFR.pwrc
+#define U1STAT              USBSimSFR.stat
+#define U1ADDR              USBSimSFR.addr
+#define U1CNFG1             USBSimSFR.cnfg1
+#define U1CNFG2             USBSimSFR.cnfg2
+#define U1EP0               USBSimSFR.ep[0].Val
+#define U1EP0bits           USBSimSFR.ep[0]
+#define U1EP1               USBSimSFR.ep[1].Val
+
+//----- Simulated bus (host side) interface -----------------------------------
+//Result of a token issued by the simulated host.
+typedef enum
+{
+    USB_SIM_ACK,            //The transaction completed
+    USB_SIM_NAK,            //The endpoint (or the USTAT FIFO) was not ready
+    USB_SIM_STALL,          //The endpoint is stalled
+    USB_SIM_DISABLED        //The endpoint or direction is not enabled
+} USB_SIM_RESULT;
+
+//Counters maintained by the simulated SIE.
+typedef struct
+{
+    uint32_t deviceTasksCalls;      //Number of USBDeviceTasks() invocations
+    uint32_t transactions;          //Completed (ACKed) transactions, all endpoints
+    uint32_t naks;                  //Tokens answered with NAK
+    uint32_t stalls;                //Tokens answered with STALL
+    uint64_t bytesOut;              //Data bytes received by the device on non-zero endpoints
+    uint64_t bytesIn;               //Data bytes sent by the device on non-zero endpoints
+    uint32_t frames;                //Start of frame tokens issued
+} USB_SIM_STATISTICS;
+
+extern USB_SIM_STATISTICS USBSimStatistics;
+
+/*****************************************************************************/
+/****** Function prototypes and macro functions ******************************/
+/*****************************************************************************/
+
+#define ConvertToPhysicalAddress(a) ((uintptr_t)(a))
+#define ConvertToVirtualAddress(a)  ((void *)(a))
+
+//USBDeviceTasks() calls this exactly once on every exit path, which makes it a
+//convenient place to count the number of stack invocations.
+#define USBClearUSBInterrupt()      {USBSimStatistics.deviceTasksCalls++;}
+
+#define USBMaskInterrupts()
+#define USBUnmaskInterrupts()
+#define USBEnableInterrupts()
+#define USBDisableInterrupts()
+
+#define PullUpConfiguration()       U1OTGCONbits.OTGEN = 0;
+
+#define SetConfigurationOptions()   {\
+                                        U1CNFG1 = USB_PING_PONG_MODE;\
+                                        U1CNFG2 = USB_TRANSCEIVER_OPTION;\
+                                        PullUpConfiguration();\
+                                        U1EIE = 0x9F;\
+                                        U1IE = 0x99 | USB_SOF_INTERRUPT | USB_ERROR_INTERRUPT;\
+                                        USBT1MSECIE = 1;\
+                                    }
+
+bool USBSleepOnSuspend(void);
+
+#define USBPowerModule()            U1PWRCbits.USBPWR = 1;
+
+#define USBModuleDisable() {\
+    U1CON = 0;\
+    U1IE = 0;\
+    U1OTGIE = 0;\
+    U1PWRCbits.USUSPND = 0;\
+    U1PWRCbits.USBPWR = 0;\
+    USBDeviceState = DETACHED_STATE;\
+}
+
+#define USBSetBDTAddress(addr)      USBSimSFR.bdtp = (uintptr_t)(addr);
+
+//Interrupt flags in the real module are cleared by writing '1'.  The
+//simulated SIE also uses the clear of TRNIF to advance its USTAT FIFO.
+#define USBClearInterruptRegister(reg)                  USBSimClearInterruptFlags(&(reg), 0xFFFF);
+#define USBClearInterruptFlag(reg_name, if_flag_offset) USBSimClearInterruptFlags(&(reg_name), (1 << (if_flag_offset)))
+
+#define DisableNonZeroEndpoints(last_ep_num) memset((void*)&USBSimSFR.ep[1],0x00,(last_ep_num));
+
+bool USBRemoteWakeupAssertBlocking(void);
+int8_t USBVBUSSessionValidStateGet(bool AllowInvasiveReads);
+void USBMaskAllUSBInterrupts(void);
+void USBRestoreUSBInterrupts(void);
+
+/*********************************************************************
+* Function: void USBSimClearInterruptFlags(volatile uint16_t *reg, uint16_t mask)
+*
+* Overview: Write-one-to-clear emulation for the U1IR, U1OTGIR and U1EIR
+*           registers.  Clearing TRNIF pops the USTAT FIFO and re-asserts
+*           TRNIF if more completed transactions are waiting.
+*
+* Input: reg - the register to clear flags in, mask - the flags to clear
+*
+* Output: None
+*
+********************************************************************/
+void USBSimClearInterruptFlags(volatile uint16_t *reg, uint16_t mask);
+
+/*********************************************************************
+* Function: volatile uint8_t* USBSimPingPongBufferReset(void)
+*
+* Overview: Resets all of the simulated ping-pong pointers to the even BDT
+*           entry and returns the location backing the PPBRST bit.
+*
+* Input: None
+*
+* Output: Pointer to the simulated PPBRST bit
+*
+********************************************************************/
+volatile uint8_t* USBSimPingPongBufferReset(void);
+
+/*********************************************************************
+* Function: void USBSimBusReset(void)
+*
+* Overview: Signals a USB bus reset from the simulated host (URSTIF).
+*
+* PreCondition: The device has been attached with USBDeviceAttach().
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void USBSimBusReset(void);
+
+/*********************************************************************
+* Function: void USBSimStartOfFrame(void)
+*
+* Overview: Signals a start of frame and the 1ms timer tick (SOFIF and
+*           T1MSECIF).
+*
+* PreCondition: None
+*
+* Input: None
+*
+* Output: None
+*
+********************************************************************/
+void USBSimStartOfFrame(void);
+
+/*********************************************************************
+* Function: USB_SIM_RESULT USBSimSetupToken(const uint8_t *setup)
+*
+* Overview: Issues a SETUP transaction with the 8 byte setup packet to EP0.
+*
+* PreCondition: None
+*
+* Input: setup - the 8 byte setup packet
+*
+* Output: USB_SIM_ACK if the device accepted the packet, otherwise USB_SIM_NAK
+*
+********************************************************************/
+USB_SIM_RESULT USBSimSetupToken(const uint8_t *setup);
+
+/*********************************************************************
+* Function: USB_SIM_RESULT USBSimOutToken(uint8_t ep, const uint8_t *data, uint16_t length)
+*
+* Overview: Issues an OUT transaction carrying 'length' bytes to endpoint 'ep'.
+*
+* PreCondition: None
+*
+* Input: ep - endpoint number, data - packet payload, length - payload size
+*
+* Output: The handshake returned by the device
+*
+********************************************************************/
+USB_SIM_RESULT USBSimOutToken(uint8_t ep, const uint8_t *data, uint16_t length);
+
+/*********************************************************************
+* Function: USB_SIM_RESULT USBSimInToken(uint8_t ep, uint8_t *data, uint16_t *length)
+*
+* Overview: Issues an IN transaction to endpoint 'ep'.
+*
+* PreCondition: None
+*
+* Input: ep - endpoint number, data - receives the packet payload (must hold
+*        the endpoint max packet size), length - receives the payload size
+*
+* Output: The handshake returned by the device
+*
+********************************************************************/
+USB_SIM_RESULT USBSimInToken(uint8_t ep, uint8_t *data, uint16_t *length);
+
+/*********************************************************************
+* Function: bool USBSimControlTransferStart(const uint8_t *setup, uint8_t *data)
+*
+* Overview: Starts a control transfer on EP0.  The data stage (if any) is read
+*           into or written from 'data' as USBSimControlTransferTasks() runs.
+*
+* PreCondition: No other control transfer is in progress.
+*
+* Input: setup - the 8 byte setup packet, data - data stage buffer (wLength
+*        bytes), may be NULL if wLength is 0
+*
+* Output: true if the transfer was started
+*
+********************************************************************/
+bool USBSimControlTransferStart(const uint8_t *setup, uint8_t *data);
+
+/*********************************************************************
+* Function: bool USBSimControlTransferTasks(void)
+*
+* Overview: Issues the next token of the control transfer in progress.  Call
+*           once per main loop pass, interleaved with USBDeviceTasks().
+*
+* PreCondition: USBSimControlTransferStart() was called.
+*
+* Input: None
+*
+* Output: true while the transfer is still in progress
+*
+********************************************************************/
+bool USBSimControlTransferTasks(void);
+
+/*********************************************************************
+* Function: bool USBSimEnumerateTasks(uint8_t configuration)
+*
+* Overview: Runs the simulated host enumeration sequence (bus reset,
+*           GET_DESCRIPTOR(device), SET_ADDRESS, GET_DESCRIPTOR(config),
+*           SET_CONFIGURATION) one token per call.
+*
+* PreCondition: None
+*
+* Input: configuration - the bConfigurationValue to select
+*
+* Output: true once the device has been configured
+*
+********************************************************************/
+bool USBSimEnumerateTasks(uint8_t configuration);
+
+/*****************************************************************************/
+/****** Extern variable definitions ******************************************/
+/*****************************************************************************/
+
+#if defined(USB_SUPPORT_DEVICE) | defined(USB_SUPPORT_OTG)
+    #if !defined(USBDEVICE_C)
+        extern USB_VOLATILE uint8_t USBActiveConfiguration;
+        extern USB_VOLATILE IN_PIPE inPipes[1];
+        extern USB_VOLATILE OUT_PIPE outPipes[1];
+    #endif
+	extern volatile BDT_ENTRY* pBDTEntryOut[USB_MAX_EP_NUMBER+1];
+	extern volatile BDT_ENTRY* pBDTEntryIn[USB_MAX_EP_NUMBER+1];
+#endif
+
+#endif //USB_HAL_SIM_H
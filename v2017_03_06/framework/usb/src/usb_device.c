@@ -2384,7 +2384,7 @@ static void USBCtrlEPService(void)
 		//Point to the EP0 OUT buffer of the buffer that arrived
         #if defined (_PIC14E) || defined(__18CXX) || defined(__XC8)
             pBDTEntryEP0OutCurrent = (volatile BDT_ENTRY*)&BDT[(USTATcopy.Val & USTAT_EP_MASK)>>1];
-        #elif defined(__C30__) || defined(__C32__) || defined __XC16__
+        #elif defined(__C30__) || defined(__C32__) || defined __XC16__ || defined(USB_HAL_SIMULATOR)
             pBDTEntryEP0OutCurrent = (volatile BDT_ENTRY*)&BDT[(USTATcopy.Val & USTAT_EP_MASK)>>2];
         #else
             #error "unimplemented"
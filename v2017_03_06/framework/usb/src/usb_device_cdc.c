@@ -42,6 +42,16 @@ please contact mla_licensing@microchip.com
   
   2.9b   Updated to implement optional support for DTS reporting.
 
+  2.9c   Added the optional USB_CDC_TX_BUFFER_SIZE transmit ring buffer
+         and the CDC_TxWrite()/CDC_TxFreeSpaceGet() functions.
+
+  2.9d   Added the optional USB_CDC_RX_ZERO_COPY ping-pong receive mode
+         and the CDC_RxPacketGet()/CDC_RxPacketRelease() functions.
+
+  2.9e   Moved the per-port state into the CDC_INSTANCE context structure
+         and added USB_MAX_CDC_INSTANCES, so one device can expose several
+         virtual COM ports.  The original API operates on instance 0.
+
 ********************************************************************/
 
 /** I N C L U D E S **********************************************************/
@@ -49,6 +59,8 @@ please contact mla_licensing@microchip.com
 #include "usb.h"
 #include "usb_device_cdc.h"
 
+#include <string.h>
+
 #ifdef USB_USE_CDC
 
 #ifndef FIXED_ADDRESS_MEMORY
@@ -61,9 +73,32 @@ please contact mla_licensing@microchip.com
     #error "One of the fixed memory address definitions is not defined.  Please define the required address tags for the required buffers."
 #endif
 
+//The fixed address tags in fixed_address_memory.h reserve room for one
+//instance's endpoint buffers only.
+#if defined(FIXED_ADDRESS_MEMORY) && (USB_MAX_CDC_INSTANCES > 1)
+    #error "USB_MAX_CDC_INSTANCES greater than 1 is not supported with FIXED_ADDRESS_MEMORY."
+#endif
+
+#if defined(USB_CDC_RX_ZERO_COPY)
+    #if (USB_PING_PONG_MODE != USB_PING_PONG__FULL_PING_PONG) && (USB_PING_PONG_MODE != USB_PING_PONG__ALL_BUT_EP0)
+        #error "USB_CDC_RX_ZERO_COPY requires USB_PING_PONG__FULL_PING_PONG or USB_PING_PONG__ALL_BUT_EP0."
+    #endif
+
+    #ifndef FIXED_ADDRESS_MEMORY
+        #define OUT_ODD_DATA_BUFFER_ADDRESS_TAG
+    #endif
+
+    #if !defined(OUT_ODD_DATA_BUFFER_ADDRESS_TAG)
+        #error "USB_CDC_RX_ZERO_COPY with FIXED_ADDRESS_MEMORY requires OUT_ODD_DATA_BUFFER_ADDRESS_TAG."
+    #endif
+#endif
+
 /** V A R I A B L E S ********************************************************/
-volatile unsigned char cdc_data_tx[CDC_DATA_IN_EP_SIZE] IN_DATA_BUFFER_ADDRESS_TAG;
-volatile unsigned char cdc_data_rx[CDC_DATA_OUT_EP_SIZE] OUT_DATA_BUFFER_ADDRESS_TAG;
+volatile unsigned char cdc_data_tx[USB_MAX_CDC_INSTANCES][CDC_DATA_IN_EP_SIZE] IN_DATA_BUFFER_ADDRESS_TAG;
+volatile unsigned char cdc_data_rx[USB_MAX_CDC_INSTANCES][CDC_DATA_OUT_EP_SIZE] OUT_DATA_BUFFER_ADDRESS_TAG;
+#if defined(USB_CDC_RX_ZERO_COPY)
+    volatile unsigned char cdc_data_rx_odd[USB_MAX_CDC_INSTANCES][CDC_DATA_OUT_EP_SIZE] OUT_ODD_DATA_BUFFER_ADDRESS_TAG;
+#endif
 
 typedef union
 {
@@ -73,25 +108,26 @@ typedef union
 
 //static CONTROL_BUFFER controlBuffer CONTROL_BUFFER_ADDRESS_TAG;
 
-LINE_CODING line_coding;    // Buffer to store line coding information
 CDC_NOTICE cdc_notice;
 
 #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
     SERIAL_STATE_NOTIFICATION SerialStatePacket;
 #endif
 
-uint8_t cdc_rx_len;            // total rx length
-uint8_t cdc_trf_state;         // States are defined cdc.h
-POINTER pCDCSrc;            // Dedicated source pointer
-POINTER pCDCDst;            // Dedicated destination pointer
-uint8_t cdc_tx_len;            // total tx length
-uint8_t cdc_mem_type;          // _ROM, _RAM
+CDC_INSTANCE cdcInstance[USB_MAX_CDC_INSTANCES];    // Per-port state, see usb_device_cdc.h
 
-USB_HANDLE CDCDataOutHandle;
-USB_HANDLE CDCDataInHandle;
+//Interface and endpoint numbers of each instance.  Instance 0 uses the
+//CDC_COMM_INTF_ID/CDC_DATA_INTF_ID/CDC_COMM_EP/CDC_DATA_EP definitions unless
+//usb_config.h provides a USB_CDC_INSTANCE_BINDINGS table.
+#if !defined(USB_CDC_INSTANCE_BINDINGS)
+    #if (USB_MAX_CDC_INSTANCES > 1)
+        #error "USB_CDC_INSTANCE_BINDINGS must be defined in usb_config.h when USB_MAX_CDC_INSTANCES is greater than 1."
+    #endif
+    #define USB_CDC_INSTANCE_BINDINGS {CDC_COMM_INTF_ID, CDC_DATA_INTF_ID, CDC_COMM_EP, CDC_DATA_EP}
+#endif
 
+static const CDC_INSTANCE_BINDING cdcBinding[USB_MAX_CDC_INSTANCES] = { USB_CDC_INSTANCE_BINDINGS };
 
-CONTROL_SIGNAL_BITMAP control_signal_bitmap;
 uint32_t BaudRateGen;			// BRG value calculated from baud rate
 
 #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
@@ -100,6 +136,13 @@ uint32_t BaudRateGen;			// BRG value calculated from baud rate
     USB_HANDLE CDCNotificationInHandle;
 #endif
 
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+    #if (USB_CDC_TX_BUFFER_SIZE < CDC_DATA_IN_EP_SIZE)
+        #error "USB_CDC_TX_BUFFER_SIZE must be at least CDC_DATA_IN_EP_SIZE bytes."
+    #endif
+    static uint8_t cdc_tx_ring[USB_MAX_CDC_INSTANCES][USB_CDC_TX_BUFFER_SIZE];
+#endif
+
 /**************************************************************************
   SEND_ENCAPSULATED_COMMAND and GET_ENCAPSULATED_RESPONSE are required
   requests according to the CDC specification.
@@ -115,6 +158,10 @@ CTRL_TRF_RETURN USB_CDC_SET_LINE_CODING_HANDLER(CTRL_TRF_PARAMS);
 
 /** P R I V A T E  P R O T O T Y P E S ***************************************/
 void USBCDCSetLineCoding(void);
+static void CDCTxServiceInstance(uint8_t instance);
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+static void CDCTxRingService(uint8_t instance);
+#endif
 
 /** D E C L A R A T I O N S **************************************************/
 //#pragma code
@@ -142,10 +189,14 @@ void USBCDCSetLineCoding(void);
 		
 	Remarks:
 		This function does not change status or do anything if the SETUP packet
-		did not contain a CDC class specific request.		 
+		did not contain a CDC class specific request.  The request is routed
+		to the instance that owns the addressed interface.
   *****************************************************************************/
 void USBCheckCDCRequest(void)
 {
+    uint8_t instance;
+    CDC_INSTANCE *cdc;
+
     /*
      * If request recipient is not an interface then return
      */
@@ -158,10 +209,11 @@ void USBCheckCDCRequest(void)
 
     /*
      * Interface ID must match interface numbers associated with
-     * CDC class, else return
+     * one of the CDC instances, else return
      */
-    if((SetupPkt.bIntfID != CDC_COMM_INTF_ID)&&
-       (SetupPkt.bIntfID != CDC_DATA_INTF_ID)) return;
+    instance = CDCInstanceFromInterface(SetupPkt.bIntfID);
+    if(instance >= USB_MAX_CDC_INSTANCES) return;
+    cdc = &cdcInstance[instance];
     
     switch(SetupPkt.bRequest)
     {
@@ -183,20 +235,24 @@ void USBCheckCDCRequest(void)
         #if defined(USB_CDC_SUPPORT_ABSTRACT_CONTROL_MANAGEMENT_CAPABILITIES_D1)
         case SET_LINE_CODING:
             outPipes[0].wCount.Val = SetupPkt.wLength;
-            outPipes[0].pDst.bRam = (uint8_t*)LINE_CODING_TARGET;
+            #if defined(USB_CDC_SET_LINE_CODING_HANDLER)
+                outPipes[0].pDst.bRam = (uint8_t*)LINE_CODING_TARGET;
+            #else
+                outPipes[0].pDst.bRam = (uint8_t*)&cdc->lineCoding._byte[0];
+            #endif
             outPipes[0].pFunc = LINE_CODING_PFUNC;
             outPipes[0].info.bits.busy = 1;
             break;
             
         case GET_LINE_CODING:
             USBEP0SendRAMPtr(
-                (uint8_t*)&line_coding,
+                (uint8_t*)&cdc->lineCoding,
                 LINE_CODING_LENGTH,
                 USB_EP0_INCLUDE_ZERO);
             break;
 
         case SET_CONTROL_LINE_STATE:
-            control_signal_bitmap._byte = (uint8_t)SetupPkt.wValue;
+            cdc->controlSignals._byte = (uint8_t)SetupPkt.wValue;
             //------------------------------------------------------------------            
             //One way to control the RTS pin is to allow the USB host to decide the value
             //that should be output on the RTS pin.  Although RTS and CTS pin functions
@@ -219,14 +275,18 @@ void USBCheckCDCRequest(void)
             //------------------------------------------------------------------            
             
             #if defined(USB_CDC_SUPPORT_DTR_SIGNALING)
-                if(control_signal_bitmap.DTE_PRESENT == 1)
+                //The DTR pin belongs to instance 0.
+                if(instance == 0)
                 {
-                    UART_DTR = USB_CDC_DTR_ACTIVE_LEVEL;
+                    if(cdc->controlSignals.DTE_PRESENT == 1)
+                    {
+                        UART_DTR = USB_CDC_DTR_ACTIVE_LEVEL;
+                    }
+                    else
+                    {
+                        UART_DTR = (USB_CDC_DTR_ACTIVE_LEVEL ^ 1);
+                    }
                 }
-                else
-                {
-                    UART_DTR = (USB_CDC_DTR_ACTIVE_LEVEL ^ 1);
-                }        
             #endif
             inPipes[0].info.bits.busy = 1;
             break;
@@ -235,6 +295,11 @@ void USBCheckCDCRequest(void)
         #if defined(USB_CDC_SUPPORT_ABSTRACT_CONTROL_MANAGEMENT_CAPABILITIES_D2)
         case SEND_BREAK:                        // Optional
             inPipes[0].info.bits.busy = 1;
+            //The UART break signaling pins belong to instance 0.
+            if(instance != 0)
+            {
+                break;
+            }
 			if (SetupPkt.wValue == 0xFFFF)  //0xFFFF means send break indefinitely until a new SEND_BREAK command is received
 			{
 				UART_Tx = 0;       // Prepare to drive TX low (for break signaling)
@@ -289,34 +354,58 @@ void USBCheckCDCRequest(void)
   Conditions:
     None
   Remarks:
-    None                                                                   
+    All USB_MAX_CDC_INSTANCES instances are initialized, using the
+    endpoints given for each of them in USB_CDC_INSTANCE_BINDINGS.
   **************************************************************************/
 void CDCInitEP(void)
 {
-    //Abstract line coding information
-    line_coding.dwDTERate   = 19200;      // baud rate
-    line_coding.bCharFormat = 0x00;             // 1 stop bit
-    line_coding.bParityType = 0x00;             // None
-    line_coding.bDataBits = 0x08;               // 5,6,7,8, or 16
+    uint8_t i;
+    CDC_INSTANCE *cdc;
 
-    cdc_rx_len = 0;
-    
-    /*
-     * Do not have to init Cnt of IN pipes here.
-     * Reason:  Number of BYTEs to send to the host
-     *          varies from one transaction to
-     *          another. Cnt should equal the exact
-     *          number of BYTEs to transmit for
-     *          a given IN transaction.
-     *          This number of BYTEs will only
-     *          be known right before the data is
-     *          sent.
-     */
-    USBEnableEndpoint(CDC_COMM_EP,USB_IN_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
-    USBEnableEndpoint(CDC_DATA_EP,USB_IN_ENABLED|USB_OUT_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
+    for(i = 0; i < USB_MAX_CDC_INSTANCES; i++)
+    {
+        cdc = &cdcInstance[i];
+
+        //Abstract line coding information
+        cdc->lineCoding.dwDTERate   = 19200;      // baud rate
+        cdc->lineCoding.bCharFormat = 0x00;             // 1 stop bit
+        cdc->lineCoding.bParityType = 0x00;             // None
+        cdc->lineCoding.bDataBits = 0x08;               // 5,6,7,8, or 16
+
+        cdc->rxLength = 0;
 
-    CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
-    CDCDataInHandle = NULL;
+        /*
+         * Do not have to init Cnt of IN pipes here.
+         * Reason:  Number of BYTEs to send to the host
+         *          varies from one transaction to
+         *          another. Cnt should equal the exact
+         *          number of BYTEs to transmit for
+         *          a given IN transaction.
+         *          This number of BYTEs will only
+         *          be known right before the data is
+         *          sent.
+         */
+        USBEnableEndpoint(cdcBinding[i].commEP,USB_IN_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
+        USBEnableEndpoint(cdcBinding[i].dataEP,USB_IN_ENABLED|USB_OUT_ENABLED|USB_HANDSHAKE_ENABLED|USB_DISALLOW_SETUP);
+
+        cdc->dataOutHandle = USBRxOnePacket(cdcBinding[i].dataEP,(uint8_t*)&cdc_data_rx[i],sizeof(cdc_data_rx[i]));
+        #if defined(USB_CDC_RX_ZERO_COPY)
+            //Arm the odd ping-pong buffer as well, so the host is not NAKed while
+            //the application is still working on the even buffer.
+            cdc->dataOutOddHandle = USBRxOnePacket(cdcBinding[i].dataEP,(uint8_t*)&cdc_data_rx_odd[i],sizeof(cdc_data_rx_odd[i]));
+            cdc->rxEvenNext = true;
+        #endif
+        cdc->dataInHandle = NULL;
+
+        #if defined(USB_CDC_TX_BUFFER_SIZE)
+            cdc->txRingHead = 0;
+            cdc->txRingTail = 0;
+            cdc->txRingCount = 0;
+            cdc->txRingZlpPending = false;
+        #endif
+
+        cdc->trfState = CDC_TX_READY;
+    }
 
     #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
       	CDCNotificationInHandle = NULL;
@@ -327,7 +416,7 @@ void CDCInitEP(void)
         SerialStatePacket.bmRequestType = 0xA1; //Always 0xA1 for this type of packet.
         SerialStatePacket.bNotification = SERIAL_STATE;
         SerialStatePacket.wValue = 0x0000;  //Always 0x0000 for this type of packet
-        SerialStatePacket.wIndex = CDC_COMM_INTF_ID;  //Interface number  
+        SerialStatePacket.wIndex = cdcBinding[0].commInterface;  //Interface number
         SerialStatePacket.SerialState.byte = 0x00;
         SerialStatePacket.Reserved = 0x00;
         SerialStatePacket.wLength = 0x02;   //Always 2 bytes for this type of packet    
@@ -342,10 +431,43 @@ void CDCInitEP(void)
   	    mInitRTSPin();
   	    mInitCTSPin();
   	#endif
-    
-    cdc_trf_state = CDC_TX_READY;
 }//end CDCInitEP
 
+/**************************************************************************
+  Function:
+        uint8_t CDCInstanceFromInterface(uint8_t interface)
+
+  Summary:
+    Returns the CDC instance that owns a USB interface number.
+
+  Description:
+    Looks up the communication and data interface numbers of every
+    instance.  This is useful in a USB_CDC_SET_LINE_CODING_HANDLER, which
+    can pass SetupPkt.bIntfID to find out which port the new line coding
+    is meant for.
+
+  Input:
+    uint8_t interface - the bInterfaceNumber to look up
+
+  Return:
+    The instance index, or USB_MAX_CDC_INSTANCES if no instance uses the
+    interface.
+  **************************************************************************/
+uint8_t CDCInstanceFromInterface(uint8_t interface)
+{
+    uint8_t i;
+
+    for(i = 0; i < USB_MAX_CDC_INSTANCES; i++)
+    {
+        if((cdcBinding[i].commInterface == interface) ||
+           (cdcBinding[i].dataInterface == interface))
+        {
+            break;
+        }
+    }
+    return i;
+}//end CDCInstanceFromInterface
+
 
 /**************************************************************************
   Function: void CDCNotificationHandler(void)
@@ -361,6 +483,7 @@ void CDCInitEP(void)
     the information to the USB host.  This can be done by calling 
     CDCNotificationHandler() by itself, or, by calling CDCTxService() which
     also calls CDCNotificationHandler() internally, when appropriate.
+    The DSR pin, and therefore the notification, belongs to instance 0.
   **************************************************************************/
 #if defined(USB_CDC_SUPPORT_DSR_REPORTING)
 void CDCNotificationHandler(void)
@@ -387,7 +510,7 @@ void CDCNotificationHandler(void)
         //initialized value.
 
         //Send the packet over USB to the host.
-        CDCNotificationInHandle = USBTransferOnePacket(CDC_COMM_EP, IN_TO_HOST, (uint8_t*)&SerialStatePacket, sizeof(SERIAL_STATE_NOTIFICATION));
+        CDCNotificationInHandle = USBTransferOnePacket(cdcBinding[0].commEP, IN_TO_HOST, (uint8_t*)&SerialStatePacket, sizeof(SERIAL_STATE_NOTIFICATION));
         
         //Save the old value, so we can detect changes later.
         OldSerialStateBitmap.byte = SerialStateBitmap.byte;
@@ -423,18 +546,38 @@ void CDCNotificationHandler(void)
   **********************************************************************************/
 bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
 {
+    uint8_t i;
+    CDC_INSTANCE *cdc;
+
     switch( (uint16_t)event )
     {  
         case EVENT_TRANSFER_TERMINATED:
-            if(pdata == CDCDataOutHandle)
-            {
-                CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
-            }
-            if(pdata == CDCDataInHandle)
+            for(i = 0; i < USB_MAX_CDC_INSTANCES; i++)
             {
-                //flush all of the data in the CDC buffer
-                cdc_trf_state = CDC_TX_READY;
-                cdc_tx_len = 0;
+                cdc = &cdcInstance[i];
+
+                if(pdata == cdc->dataOutHandle)
+                {
+                    cdc->dataOutHandle = USBRxOnePacket(cdcBinding[i].dataEP,(uint8_t*)&cdc_data_rx[i],sizeof(cdc_data_rx[i]));
+                }
+                #if defined(USB_CDC_RX_ZERO_COPY)
+                    if(pdata == cdc->dataOutOddHandle)
+                    {
+                        cdc->dataOutOddHandle = USBRxOnePacket(cdcBinding[i].dataEP,(uint8_t*)&cdc_data_rx_odd[i],sizeof(cdc_data_rx_odd[i]));
+                    }
+                #endif
+                if(pdata == cdc->dataInHandle)
+                {
+                    //flush all of the data in the CDC buffer
+                    cdc->trfState = CDC_TX_READY;
+                    cdc->txLength = 0;
+                    #if defined(USB_CDC_TX_BUFFER_SIZE)
+                        cdc->txRingHead = 0;
+                        cdc->txRingTail = 0;
+                        cdc->txRingCount = 0;
+                        cdc->txRingZlpPending = false;
+                    #endif
+                }
             }
             break;
         default:
@@ -484,34 +627,209 @@ bool USBCDCEventHandler(USB_EVENT event, void *pdata, uint16_t size)
   **********************************************************************************/
 uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len)
 {
-    cdc_rx_len = 0;
+    return CDCInstanceGets(0, buffer, len);
+}//end getsUSBUSART
+
+/**********************************************************************************
+  Function:
+        uint8_t CDCInstanceGets(uint8_t instance, uint8_t *buffer, uint8_t len)
+
+  Summary:
+    getsUSBUSART() for the given CDC instance.
+
+  Input:
+    instance - the CDC instance (0 to USB_MAX_CDC_INSTANCES - 1)
+    buffer -  Pointer to where received BYTEs are to be stored
+    len -     The number of BYTEs expected.
+
+  Return:
+    The number of bytes copied to 'buffer', 0 if no data is available.
+  **********************************************************************************/
+uint8_t CDCInstanceGets(uint8_t instance, uint8_t *buffer, uint8_t len)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+#if defined(USB_CDC_RX_ZERO_COPY)
+    uint8_t *packet;
+    uint8_t packet_len;
+
+    cdc->rxLength = 0;
+
+    if(CDCInstanceRxPacketGet(instance, &packet, &packet_len) == true)
+    {
+        if(len > packet_len)
+            len = packet_len;
+
+        for(cdc->rxLength = 0; cdc->rxLength < len; cdc->rxLength++)
+            buffer[cdc->rxLength] = packet[cdc->rxLength];
+
+        CDCInstanceRxPacketRelease(instance);
+    }
+
+    return cdc->rxLength;
+#else
+    cdc->rxLength = 0;
     
-    if(!USBHandleBusy(CDCDataOutHandle))
+    if(!USBHandleBusy(cdc->dataOutHandle))
     {
         /*
          * Adjust the expected number of BYTEs to equal
          * the actual number of BYTEs received.
          */
-        if(len > USBHandleGetLength(CDCDataOutHandle))
-            len = USBHandleGetLength(CDCDataOutHandle);
+        if(len > USBHandleGetLength(cdc->dataOutHandle))
+            len = USBHandleGetLength(cdc->dataOutHandle);
         
         /*
          * Copy data from dual-ram buffer to user's buffer
          */
-        for(cdc_rx_len = 0; cdc_rx_len < len; cdc_rx_len++)
-            buffer[cdc_rx_len] = cdc_data_rx[cdc_rx_len];
+        for(cdc->rxLength = 0; cdc->rxLength < len; cdc->rxLength++)
+            buffer[cdc->rxLength] = cdc_data_rx[instance][cdc->rxLength];
 
         /*
          * Prepare dual-ram buffer for next OUT transaction
          */
 
-        CDCDataOutHandle = USBRxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_rx,sizeof(cdc_data_rx));
+        cdc->dataOutHandle = USBRxOnePacket(cdcBinding[instance].dataEP,(uint8_t*)&cdc_data_rx[instance],sizeof(cdc_data_rx[instance]));
 
     }//end if
     
-    return cdc_rx_len;
-    
-}//end getsUSBUSART
+    return cdc->rxLength;
+#endif
+}//end CDCInstanceGets
+
+#if defined(USB_CDC_RX_ZERO_COPY)
+/**********************************************************************************
+  Function:
+        bool CDC_RxPacketGet(uint8_t **data, uint8_t *length)
+
+  Summary:
+    Returns a pointer to the oldest packet received on the CDC bulk OUT
+    endpoint without copying it.
+
+  Description:
+    CDC_RxPacketGet gives the application direct access to the ping-pong
+    endpoint buffer holding the oldest received packet.  The other ping-pong
+    buffer remains armed, so the host can keep sending while the application
+    processes the data in place.  The packet must be handed back with
+    CDC_RxPacketRelease() once the application is done with it.  Calling
+    CDC_RxPacketGet() again before releasing returns the same packet.
+
+    Typical Usage:
+    <code>
+        uint8_t *packet;
+        uint8_t length;
+
+        if(CDC_RxPacketGet(&packet, &length) == true)
+        {
+            //Parse the packet in place.
+            ProcessCommand(packet, length);
+            CDC_RxPacketRelease();
+        }
+    </code>
+
+  Conditions:
+    USB_CDC_RX_ZERO_COPY must be defined in usb_config.h.  The device should
+    be in the CONFIGURED_STATE.
+
+  Input:
+    data - receives a pointer to the packet data
+    length - receives the number of bytes in the packet (may be 0 for a zero
+             length packet)
+
+  Output:
+    bool - true if a packet is available, false if both buffers are still
+           owned by the USB module.
+  **********************************************************************************/
+bool CDC_RxPacketGet(uint8_t **data, uint8_t *length)
+{
+    return CDCInstanceRxPacketGet(0, data, length);
+}//end CDC_RxPacketGet
+
+/**********************************************************************************
+  Function:
+        void CDC_RxPacketRelease(void)
+
+  Summary:
+    Returns the packet obtained with CDC_RxPacketGet() to the USB module.
+
+  Description:
+    CDC_RxPacketRelease re-arms the ping-pong buffer that was returned by the
+    last successful CDC_RxPacketGet() call so it can receive the next OUT
+    transaction.  Pointers previously returned by CDC_RxPacketGet() must not
+    be used after this call.
+
+  Conditions:
+    USB_CDC_RX_ZERO_COPY must be defined in usb_config.h.  A packet must have
+    been obtained with CDC_RxPacketGet().
+  **********************************************************************************/
+void CDC_RxPacketRelease(void)
+{
+    CDCInstanceRxPacketRelease(0);
+}//end CDC_RxPacketRelease
+
+/**********************************************************************************
+  Function:
+        bool CDCInstanceRxPacketGet(uint8_t instance, uint8_t **data, uint8_t *length)
+
+  Summary:
+    CDC_RxPacketGet() for the given CDC instance.
+  **********************************************************************************/
+bool CDCInstanceRxPacketGet(uint8_t instance, uint8_t **data, uint8_t *length)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+
+    if(cdc->rxEvenNext == true)
+    {
+        if(USBHandleBusy(cdc->dataOutHandle))
+        {
+            return false;
+        }
+        *data = (uint8_t*)&cdc_data_rx[instance];
+        *length = USBHandleGetLength(cdc->dataOutHandle);
+    }
+    else
+    {
+        if(USBHandleBusy(cdc->dataOutOddHandle))
+        {
+            return false;
+        }
+        *data = (uint8_t*)&cdc_data_rx_odd[instance];
+        *length = USBHandleGetLength(cdc->dataOutOddHandle);
+    }
+
+    return true;
+}//end CDCInstanceRxPacketGet
+
+/**********************************************************************************
+  Function:
+        void CDCInstanceRxPacketRelease(uint8_t instance)
+
+  Summary:
+    CDC_RxPacketRelease() for the given CDC instance.
+  **********************************************************************************/
+void CDCInstanceRxPacketRelease(uint8_t instance)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+
+    if(cdc->rxEvenNext == true)
+    {
+        if(USBHandleBusy(cdc->dataOutHandle))
+        {
+            return;
+        }
+        cdc->dataOutHandle = USBRxOnePacket(cdcBinding[instance].dataEP,(uint8_t*)&cdc_data_rx[instance],sizeof(cdc_data_rx[instance]));
+        cdc->rxEvenNext = false;
+    }
+    else
+    {
+        if(USBHandleBusy(cdc->dataOutOddHandle))
+        {
+            return;
+        }
+        cdc->dataOutOddHandle = USBRxOnePacket(cdcBinding[instance].dataEP,(uint8_t*)&cdc_data_rx_odd[instance],sizeof(cdc_data_rx_odd[instance]));
+        cdc->rxEvenNext = true;
+    }
+}//end CDCInstanceRxPacketRelease
+#endif //USB_CDC_RX_ZERO_COPY
 
 /******************************************************************************
   Function:
@@ -555,6 +873,23 @@ uint8_t getsUSBUSART(uint8_t *buffer, uint8_t len)
  *****************************************************************************/
 void putUSBUSART(uint8_t *data, uint8_t  length)
 {
+    CDCInstancePut(0, data, length);
+}//end putUSBUSART
+
+/******************************************************************************
+  Function:
+	void CDCInstancePut(uint8_t instance, uint8_t *data, uint8_t length)
+
+  Summary:
+    putUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+ *****************************************************************************/
+void CDCInstancePut(uint8_t instance, uint8_t *data, uint8_t length)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+
     /*
      * User should have checked that cdc_trf_state is in CDC_TX_READY state
      * before calling this function.
@@ -579,12 +914,15 @@ void putUSBUSART(uint8_t *data, uint8_t  length)
      * Use a state machine instead.
      */
     USBMaskInterrupts();
-    if(cdc_trf_state == CDC_TX_READY)
+    if(cdc->trfState == CDC_TX_READY)
     {
-        mUSBUSARTTxRam((uint8_t*)data, length);     // See cdc.h
+        cdc->pSrc.bRam = data;
+        cdc->txLength = length;
+        cdc->memType = USB_EP0_RAM;
+        cdc->trfState = CDC_TX_BUSY;
     }
     USBUnmaskInterrupts();
-}//end putUSBUSART
+}//end CDCInstancePut
 
 /******************************************************************************
 	Function:
@@ -628,6 +966,22 @@ void putUSBUSART(uint8_t *data, uint8_t  length)
  
 void putsUSBUSART(char *data)
 {
+    CDCInstancePuts(0, data);
+}//end putsUSBUSART
+
+/******************************************************************************
+  Function:
+	void CDCInstancePuts(uint8_t instance, char *data)
+
+  Summary:
+    putsUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+ *****************************************************************************/
+void CDCInstancePuts(uint8_t instance, char *data)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
     uint8_t len;
     char *pData;
 
@@ -655,7 +1009,7 @@ void putsUSBUSART(char *data)
      * Use a state machine instead.
      */
     USBMaskInterrupts();
-    if(cdc_trf_state != CDC_TX_READY)
+    if(cdc->trfState != CDC_TX_READY)
     {
         USBUnmaskInterrupts();
         return;
@@ -679,9 +1033,12 @@ void putsUSBUSART(char *data)
      * The actual transfer process will be handled by CDCTxService(),
      * which should be called once per Main Program loop.
      */
-    mUSBUSARTTxRam((uint8_t*)data, len);     // See cdc.h
+    cdc->pSrc.bRam = (uint8_t*)data;
+    cdc->txLength = len;
+    cdc->memType = USB_EP0_RAM;
+    cdc->trfState = CDC_TX_BUSY;
     USBUnmaskInterrupts();
-}//end putsUSBUSART
+}//end CDCInstancePuts
 
 /**************************************************************************
   Function:
@@ -725,8 +1082,24 @@ void putsUSBUSART(char *data)
   **************************************************************************/
 void putrsUSBUSART(const const char *data)
 {
+    CDCInstancePutrs(0, data);
+}//end putrsUSBUSART
+
+/**************************************************************************
+  Function:
+        void CDCInstancePutrs(uint8_t instance, const char *data)
+
+  Summary:
+    putrsUSBUSART() for the given CDC instance.
+
+  Conditions:
+    CDCInstanceIsTxTrfReady(instance) must return true.
+  **************************************************************************/
+void CDCInstancePutrs(uint8_t instance, const char *data)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
     uint8_t len;
-    const const char *pData;
+    const char *pData;
 
     /*
      * User should have checked that cdc_trf_state is in CDC_TX_READY state
@@ -752,7 +1125,7 @@ void putrsUSBUSART(const const char *data)
      * Use a state machine instead.
      */
     USBMaskInterrupts();
-    if(cdc_trf_state != CDC_TX_READY)
+    if(cdc->trfState != CDC_TX_READY)
     {
         USBUnmaskInterrupts();
         return;
@@ -777,10 +1150,224 @@ void putrsUSBUSART(const const char *data)
      * which should be called once per Main Program loop.
      */
 
-    mUSBUSARTTxRom((const uint8_t*)data,len); // See cdc.h
+    cdc->pSrc.bRom = (const uint8_t*)data;
+    cdc->txLength = len;
+    cdc->memType = USB_EP0_ROM;
+    cdc->trfState = CDC_TX_BUSY;
     USBUnmaskInterrupts();
 
-}//end putrsUSBUSART
+}//end CDCInstancePutrs
+
+#if defined(USB_CDC_TX_BUFFER_SIZE)
+/**************************************************************************
+  Function:
+        size_t CDC_TxWrite(const uint8_t *data, size_t length)
+
+  Summary:
+    Queues data into the CDC transmit ring buffer for sending to the host.
+
+  Description:
+    CDC_TxWrite copies as much of 'data' as currently fits into the
+    USB_CDC_TX_BUFFER_SIZE byte transmit ring buffer and returns the number
+    of bytes accepted.  Unlike putUSBUSART(), the caller does not need to
+    check USBUSARTIsTxTrfReady() first, the length is not limited to 255
+    bytes, and the data buffer may be reused as soon as the function returns.
+
+    CDCTxService() drains the ring buffer in CDC_DATA_IN_EP_SIZE packets
+    and appends a zero length packet when the buffered data ends on a packet
+    boundary.
+
+    Typical Usage:
+    <code>
+        static size_t sent = 0;
+
+        sent += CDC_TxWrite(&logRecord[sent], sizeof(logRecord) - sent);
+        if(sent == sizeof(logRecord))
+        {
+            sent = 0;
+        }
+    </code>
+
+  Conditions:
+    USB_CDC_TX_BUFFER_SIZE must be defined in usb_config.h.  The device
+    should be in the CONFIGURED_STATE.
+
+  Input:
+    const uint8_t *data - pointer to the data to be transferred to the host
+    size_t length - the number of bytes to be transferred
+
+  Return:
+    The number of bytes copied into the transmit ring buffer.  This may be
+    less than 'length' (including 0) when the ring buffer is full.
+
+  Remarks:
+    Data queued with CDC_TxWrite() is only sent while the putUSBUSART()
+    family is idle (USBUSARTIsTxTrfReady() is true).  Applications should
+    not interleave both APIs if byte ordering between them matters.
+  **************************************************************************/
+size_t CDC_TxWrite(const uint8_t *data, size_t length)
+{
+    return CDCInstanceTxWrite(0, data, length);
+}//end CDC_TxWrite
+
+/**************************************************************************
+  Function:
+        size_t CDC_TxFreeSpaceGet(void)
+
+  Summary:
+    Returns the number of bytes CDC_TxWrite() can currently accept.
+
+  Conditions:
+    USB_CDC_TX_BUFFER_SIZE must be defined in usb_config.h.
+
+  Return:
+    The number of free bytes in the CDC transmit ring buffer.
+  **************************************************************************/
+size_t CDC_TxFreeSpaceGet(void)
+{
+    return CDCInstanceTxFreeSpaceGet(0);
+}
+
+/**************************************************************************
+  Function:
+        size_t CDCInstanceTxWrite(uint8_t instance, const uint8_t *data, size_t length)
+
+  Summary:
+    CDC_TxWrite() for the given CDC instance.  Each instance has its own
+    USB_CDC_TX_BUFFER_SIZE byte ring buffer.
+  **************************************************************************/
+size_t CDCInstanceTxWrite(uint8_t instance, const uint8_t *data, size_t length)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+    size_t accepted;
+    size_t chunk;
+
+    USBMaskInterrupts();
+
+    if(length > (USB_CDC_TX_BUFFER_SIZE - cdc->txRingCount))
+    {
+        length = USB_CDC_TX_BUFFER_SIZE - cdc->txRingCount;
+    }
+    accepted = length;
+
+    /*
+     * Copy in at most two pieces: up to the end of the ring buffer, then
+     * the wrapped remainder at the start of the ring buffer.
+     */
+    while(length)
+    {
+        chunk = USB_CDC_TX_BUFFER_SIZE - cdc->txRingHead;
+        if(chunk > length)
+        {
+            chunk = length;
+        }
+
+        memcpy(&cdc_tx_ring[instance][cdc->txRingHead], data, chunk);
+
+        cdc->txRingHead += chunk;
+        if(cdc->txRingHead == USB_CDC_TX_BUFFER_SIZE)
+        {
+            cdc->txRingHead = 0;
+        }
+        data += chunk;
+        length -= chunk;
+    }
+
+    cdc->txRingCount += accepted;
+
+    USBUnmaskInterrupts();
+
+    return accepted;
+}//end CDCInstanceTxWrite
+
+/**************************************************************************
+  Function:
+        size_t CDCInstanceTxFreeSpaceGet(uint8_t instance)
+
+  Summary:
+    CDC_TxFreeSpaceGet() for the given CDC instance.
+  **************************************************************************/
+size_t CDCInstanceTxFreeSpaceGet(uint8_t instance)
+{
+    size_t freeSpace;
+
+    /*
+     * txRingCount is also updated from the USB interrupt, and reading a
+     * multi-byte count is not atomic on the 8-bit parts.
+     */
+    USBMaskInterrupts();
+    freeSpace = USB_CDC_TX_BUFFER_SIZE - cdcInstance[instance].txRingCount;
+    USBUnmaskInterrupts();
+
+    return freeSpace;
+}
+
+/**************************************************************************
+  Function:
+        static void CDCTxRingService(uint8_t instance)
+
+  Summary:
+    Moves the next packet from the transmit ring buffer of an instance to
+    its bulk IN endpoint.
+
+  Conditions:
+    Called from CDCTxServiceInstance() with USB interrupts masked, only when
+    the bulk IN endpoint is not busy and the putUSBUSART() state machine is
+    idle.
+  **************************************************************************/
+static void CDCTxRingService(uint8_t instance)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+    uint8_t byte_to_send;
+    size_t chunk;
+
+    if(cdc->txRingCount == 0)
+    {
+        /*
+         * The last packet of the buffered data was a full sized packet, so
+         * terminate the host's read with a zero length packet.
+         * See explanation in USB Specification 2.0: Section 5.8.3
+         */
+        if(cdc->txRingZlpPending == true)
+        {
+            cdc->txRingZlpPending = false;
+            cdc->dataInHandle = USBTxOnePacket(cdcBinding[instance].dataEP,NULL,0);
+        }
+        return;
+    }
+
+    if(cdc->txRingCount > CDC_DATA_IN_EP_SIZE)
+        byte_to_send = CDC_DATA_IN_EP_SIZE;
+    else
+        byte_to_send = (uint8_t)cdc->txRingCount;
+
+    /*
+     * Copy the packet out of the ring buffer, wrapping at most once.
+     */
+    chunk = USB_CDC_TX_BUFFER_SIZE - cdc->txRingTail;
+    if(chunk > byte_to_send)
+    {
+        chunk = byte_to_send;
+    }
+
+    memcpy((uint8_t*)&cdc_data_tx[instance], &cdc_tx_ring[instance][cdc->txRingTail], chunk);
+    if(chunk < byte_to_send)
+    {
+        memcpy((uint8_t*)&cdc_data_tx[instance][chunk], &cdc_tx_ring[instance][0], byte_to_send - chunk);
+    }
+
+    cdc->txRingTail += byte_to_send;
+    if(cdc->txRingTail >= USB_CDC_TX_BUFFER_SIZE)
+    {
+        cdc->txRingTail -= USB_CDC_TX_BUFFER_SIZE;
+    }
+    cdc->txRingCount -= byte_to_send;
+
+    cdc->txRingZlpPending = (byte_to_send == CDC_DATA_IN_EP_SIZE);
+
+    cdc->dataInHandle = USBTxOnePacket(cdcBinding[instance].dataEP,(uint8_t*)&cdc_data_tx[instance],byte_to_send);
+}//end CDCTxRingService
+#endif //USB_CDC_TX_BUFFER_SIZE
 
 /************************************************************************
   Function:
@@ -830,21 +1417,51 @@ void putrsUSBUSART(const const char *data)
     CDCIniEP() function should have already executed/the device should be
     in the CONFIGURED_STATE.
   Remarks:
-    None                                                                 
+    All CDC instances are serviced in each call, each by
+    CDCTxServiceInstance().  Every instance sends at most one packet per
+    call, so a long transfer on one port does not delay the others.
   ************************************************************************/
  
 void CDCTxService(void)
 {
-    uint8_t byte_to_send;
     uint8_t i;
-    
+
     USBMaskInterrupts();
     
     CDCNotificationHandler();
+
+    /*
+     * Every instance gets at most one packet per call, so a port with a
+     * long transfer queued cannot hold up the others.
+     */
+    for(i = 0; i < USB_MAX_CDC_INSTANCES; i++)
+    {
+        CDCTxServiceInstance(i);
+    }
+
+    USBUnmaskInterrupts();
+}//end CDCTxService
+
+/************************************************************************
+  Function:
+        static void CDCTxServiceInstance(uint8_t instance)
+
+  Summary:
+    Advances the transmit state machine of one CDC instance by at most one
+    bulk IN packet.
+
+  Conditions:
+    Called from CDCTxService() with USB interrupts masked.
+  ************************************************************************/
+static void CDCTxServiceInstance(uint8_t instance)
+{
+    CDC_INSTANCE *cdc = &cdcInstance[instance];
+    uint8_t byte_to_send;
+    uint8_t i;
+    uint8_t *pDst;
     
-    if(USBHandleBusy(CDCDataInHandle)) 
+    if(USBHandleBusy(cdc->dataInHandle)) 
     {
-        USBUnmaskInterrupts();
         return;
     }
 
@@ -853,52 +1470,55 @@ void CDCTxService(void)
      * By having this stage, user can always check cdc_trf_state,
      * and not having to call mCDCUsartTxIsBusy() directly.
      */
-    if(cdc_trf_state == CDC_TX_COMPLETING)
-        cdc_trf_state = CDC_TX_READY;
+    if(cdc->trfState == CDC_TX_COMPLETING)
+        cdc->trfState = CDC_TX_READY;
     
     /*
-     * If CDC_TX_READY state, nothing to do, just return.
+     * If CDC_TX_READY state, nothing to do for the putUSBUSART() family, so
+     * send any data queued through CDC_TxWrite() instead.
      */
-    if(cdc_trf_state == CDC_TX_READY)
+    if(cdc->trfState == CDC_TX_READY)
     {
-        USBUnmaskInterrupts();
+        #if defined(USB_CDC_TX_BUFFER_SIZE)
+            CDCTxRingService(instance);
+        #endif
         return;
     }
     
     /*
      * If CDC_TX_BUSY_ZLP state, send zero length packet
      */
-    if(cdc_trf_state == CDC_TX_BUSY_ZLP)
+    if(cdc->trfState == CDC_TX_BUSY_ZLP)
     {
-        CDCDataInHandle = USBTxOnePacket(CDC_DATA_EP,NULL,0);
+        cdc->dataInHandle = USBTxOnePacket(cdcBinding[instance].dataEP,NULL,0);
         //CDC_DATA_BD_IN.CNT = 0;
-        cdc_trf_state = CDC_TX_COMPLETING;
+        cdc->trfState = CDC_TX_COMPLETING;
     }
-    else if(cdc_trf_state == CDC_TX_BUSY)
+    else if(cdc->trfState == CDC_TX_BUSY)
     {
         /*
          * First, have to figure out how many byte of data to send.
          */
-    	if(cdc_tx_len > sizeof(cdc_data_tx))
-    	    byte_to_send = sizeof(cdc_data_tx);
+    	if(cdc->txLength > CDC_DATA_IN_EP_SIZE)
+    	    byte_to_send = CDC_DATA_IN_EP_SIZE;
     	else
-    	    byte_to_send = cdc_tx_len;
+    	    byte_to_send = cdc->txLength;
 
         /*
          * Subtract the number of bytes just about to be sent from the total.
          */
-    	cdc_tx_len = cdc_tx_len - byte_to_send;
+    	cdc->txLength = cdc->txLength - byte_to_send;
     	  
-        pCDCDst.bRam = (uint8_t*)&cdc_data_tx; // Set destination pointer
+        pDst = (uint8_t*)&cdc_data_tx[instance]; // Set destination pointer
         
         i = byte_to_send;
-        if(cdc_mem_type == USB_EP0_ROM)            // Determine type of memory source
+        if(cdc->memType == USB_EP0_ROM)            // Determine type of memory source
         {
             while(i)
             {
-                *pCDCDst.bRam = *pCDCSrc.bRom;
-                pCDCDst.bRam++;
-                pCDCSrc.bRom++;
+                *pDst = *cdc->pSrc.bRom;
+                pDst++;
+                cdc->pSrc.bRom++;
                 i--;
             }//end while(byte_to_send)
         }
@@ -906,9 +1526,9 @@ void CDCTxService(void)
         {
             while(i)
             {
-                *pCDCDst.bRam = *pCDCSrc.bRam;
-                pCDCDst.bRam++;
-                pCDCSrc.bRam++;
+                *pDst = *cdc->pSrc.bRam;
+                pDst++;
+                cdc->pSrc.bRam++;
                 i--;
             }
         }
@@ -917,19 +1537,17 @@ void CDCTxService(void)
          * Lastly, determine if a zero length packet state is necessary.
          * See explanation in USB Specification 2.0: Section 5.8.3
          */
-        if(cdc_tx_len == 0)
+        if(cdc->txLength == 0)
         {
             if(byte_to_send == CDC_DATA_IN_EP_SIZE)
-                cdc_trf_state = CDC_TX_BUSY_ZLP;
+                cdc->trfState = CDC_TX_BUSY_ZLP;
             else
-                cdc_trf_state = CDC_TX_COMPLETING;
-        }//end if(cdc_tx_len...)
-        CDCDataInHandle = USBTxOnePacket(CDC_DATA_EP,(uint8_t*)&cdc_data_tx,byte_to_send);
+                cdc->trfState = CDC_TX_COMPLETING;
+        }//end if(cdc->txLength...)
+        cdc->dataInHandle = USBTxOnePacket(cdcBinding[instance].dataEP,(uint8_t*)&cdc_data_tx[instance],byte_to_send);
 
-    }//end if(cdc_tx_sate == CDC_TX_BUSY)
-    
-    USBUnmaskInterrupts();
-}//end CDCTxService
+    }//end if(cdc->trfState == CDC_TX_BUSY)
+}//end CDCTxServiceInstance
 
 #endif //USB_USE_CDC
 
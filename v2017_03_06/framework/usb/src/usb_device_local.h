@@ -187,7 +187,11 @@ typedef union
     #define BD(ep,dir,pp) (4u*((2u*ep)+dir+(((ep==0)&&(dir==0))?pp:1)))
 
 #elif (USB_PING_PONG_MODE == USB_PING_PONG__FULL_PING_PONG)
-#if defined (__18CXX) || defined(__C30__) || defined __XC16__ || defined(__XC8)
+    #if defined(USB_HAL_SIMULATOR)
+        #define USB_NEXT_EP0_OUT_PING_PONG 0x0010
+        #define USB_NEXT_EP0_IN_PING_PONG 0x0010
+        #define USB_NEXT_PING_PONG 0x0010
+    #elif defined (__18CXX) || defined(__C30__) || defined __XC16__ || defined(__XC8)
         #if (defined (__dsPIC33E__) || defined (__PIC24E__))
             #define USB_NEXT_EP0_OUT_PING_PONG 0x0008
             #define USB_NEXT_EP0_IN_PING_PONG 0x0008
@@ -271,7 +275,9 @@ typedef union
 
     #define EP(ep,dir,pp) (4*ep+2*dir+pp)
 
-    #if defined (__18CXX) || defined(__C30__) || defined __XC16__ || (__XC8)
+    #if defined(USB_HAL_SIMULATOR)
+        #define BD(ep,dir,pp) (16*(4*ep+2*dir+pp))
+    #elif defined (__18CXX) || defined(__C30__) || defined __XC16__ || (__XC8)
         #if (defined(__dsPIC33E__) || defined (__PIC24E__))
             #define BD(ep,dir,pp) (8*(4*ep+2*dir+pp))
         #else
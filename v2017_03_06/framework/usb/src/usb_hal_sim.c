@@ -0,0 +1,516 @@
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+Copyright 2015 Microchip Technology Inc. (www.microchip.com)
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+To request to license the code under the MLA license (www.microchip.com/mla_license),
+please contact mla_licensing@microchip.com
+*******************************************************************************/
+//DOM-IGNORE-END
+
+/*******************************************************************************
+  USB Simulated Hardware Abstraction Layer
+
+  File Name:
+    usb_hal_sim.c
+
+  Summary:
+    In-memory model of the USB serial interface engine for host (Linux) builds.
+
+  Description:
+    Replaces usb_hal_16bit.c/usb_hal_32bit.c when USB_HAL_SIMULATOR is defined.
+    The special function registers and the buffer descriptor table live in
+    ordinary RAM.  A scripted host drives the bus through the USBSim*Token()
+    functions, which behave like the SIE does for a real token: they check
+    the UOWN bit of the next ping-pong BDT entry, move the data, hand the
+    entry back to the CPU and push the transaction onto the USTAT FIFO.
+    USBDeviceTasks(), USBTransferOnePacket() and the class drivers run
+    unmodified on top of this model.
+*******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "usb.h"
+#include "usb_ch9.h"
+#include "usb_device.h"
+
+#if defined(USB_HAL_SIMULATOR)
+
+/** V A R I A B L E S ********************************************************/
+volatile USB_SIM_SFR USBSimSFR;
+USB_SIM_STATISTICS USBSimStatistics;
+
+static uint8_t usb_sim_ustat_fifo[USB_SIM_USTAT_FIFO_SIZE];
+static uint8_t usb_sim_ustat_head;
+static uint8_t usb_sim_ustat_count;
+
+static uint8_t usb_sim_ping_pong[USB_MAX_EP_NUMBER + 1][2];    //[ep][dir], 0 = even next
+static volatile uint8_t usb_sim_ppbrst;
+
+/* Control transfer state of the scripted host */
+typedef enum
+{
+    USB_SIM_CTRL_IDLE,
+    USB_SIM_CTRL_SETUP,
+    USB_SIM_CTRL_DATA_IN,
+    USB_SIM_CTRL_DATA_OUT,
+    USB_SIM_CTRL_STATUS_IN,
+    USB_SIM_CTRL_STATUS_OUT
+} USB_SIM_CTRL_STATE;
+
+static USB_SIM_CTRL_STATE usb_sim_ctrl_state;
+static uint8_t usb_sim_ctrl_setup[8];
+static uint8_t *usb_sim_ctrl_data;
+static uint16_t usb_sim_ctrl_length;
+static uint16_t usb_sim_ctrl_count;
+
+/* Enumeration state of the scripted host */
+typedef enum
+{
+    USB_SIM_ENUM_RESET,
+    USB_SIM_ENUM_GET_DEVICE_DESCRIPTOR,
+    USB_SIM_ENUM_SET_ADDRESS,
+    USB_SIM_ENUM_GET_CONFIG_DESCRIPTOR,
+    USB_SIM_ENUM_SET_CONFIGURATION,
+    USB_SIM_ENUM_DONE
+} USB_SIM_ENUM_STATE;
+
+static USB_SIM_ENUM_STATE usb_sim_enum_state;
+static bool usb_sim_enum_started;
+static uint8_t usb_sim_enum_buffer[64];
+
+/** P R I V A T E  P R O T O T Y P E S ***************************************/
+static volatile BDT_ENTRY* USBSimBDTEntryGet(uint8_t ep, uint8_t dir);
+static void USBSimTransactionComplete(uint8_t ep, uint8_t dir);
+static void USBSimUSTATFifoReset(void);
+
+/** F U N C T I O N S ********************************************************/
+
+/********************************************************************
+ * Function:        volatile BDT_ENTRY* USBSimBDTEntryGet(uint8_t ep, uint8_t dir)
+ *
+ * Overview:        Returns the BDT entry the SIE would use for the next
+ *                  transaction on the given endpoint and direction.
+ *******************************************************************/
+static volatile BDT_ENTRY* USBSimBDTEntryGet(uint8_t ep, uint8_t dir)
+{
+    volatile BDT_ENTRY* bdt = (volatile BDT_ENTRY*)USBSimSFR.bdtp;
+
+    return &bdt[(4 * ep) + (2 * dir) + usb_sim_ping_pong[ep][dir]];
+}
+
+/********************************************************************
+ * Function:        void USBSimTransactionComplete(uint8_t ep, uint8_t dir)
+ *
+ * Overview:        Pushes the USTAT value for a completed transaction,
+ *                  toggles the hardware ping-pong pointer and sets TRNIF.
+ *******************************************************************/
+static void USBSimTransactionComplete(uint8_t ep, uint8_t dir)
+{
+    uint8_t tail;
+
+    tail = (usb_sim_ustat_head + usb_sim_ustat_count) % USB_SIM_USTAT_FIFO_SIZE;
+    usb_sim_ustat_fifo[tail] = (ep << 4) | (dir << 3) | (usb_sim_ping_pong[ep][dir] << 2);
+    usb_sim_ustat_count++;
+
+    usb_sim_ping_pong[ep][dir] ^= 1;
+
+    if(usb_sim_ustat_count == 1)
+    {
+        U1STAT = usb_sim_ustat_fifo[usb_sim_ustat_head];
+        U1IRbits.TRNIF = 1;
+    }
+
+    USBSimStatistics.transactions++;
+}
+
+/********************************************************************
+ * Function:        void USBSimUSTATFifoReset(void)
+ *
+ * Overview:        Flushes the USTAT FIFO and resets all of the ping-pong
+ *                  pointers to the even buffer.
+ *******************************************************************/
+static void USBSimUSTATFifoReset(void)
+{
+    usb_sim_ustat_head = 0;
+    usb_sim_ustat_count = 0;
+    memset(usb_sim_ping_pong, 0x00, sizeof(usb_sim_ping_pong));
+}
+
+volatile uint8_t* USBSimPingPongBufferReset(void)
+{
+    memset(usb_sim_ping_pong, 0x00, sizeof(usb_sim_ping_pong));
+    return &usb_sim_ppbrst;
+}
+
+void USBSimClearInterruptFlags(volatile uint16_t *reg, uint16_t mask)
+{
+    *reg &= ~mask;
+
+    if((reg != &U1IR) || ((mask & (1 << USBTransactionCompleteIFBitNum)) == 0))
+    {
+        return;
+    }
+
+    //Clearing TRNIF advances the USTAT FIFO.
+    if(usb_sim_ustat_count != 0)
+    {
+        usb_sim_ustat_head = (usb_sim_ustat_head + 1) % USB_SIM_USTAT_FIFO_SIZE;
+        usb_sim_ustat_count--;
+    }
+
+    if(usb_sim_ustat_count != 0)
+    {
+        U1STAT = usb_sim_ustat_fifo[usb_sim_ustat_head];
+        U1IRbits.TRNIF = 1;
+    }
+}
+
+void USBSimBusReset(void)
+{
+    USBSimUSTATFifoReset();
+    U1CONbits.SE0 = 0;
+    U1IRbits.URSTIF = 1;
+}
+
+void USBSimStartOfFrame(void)
+{
+    U1IRbits.SOFIF = 1;
+    U1OTGIRbits.T1MSECIF = 1;
+    USBSimStatistics.frames++;
+}
+
+USB_SIM_RESULT USBSimSetupToken(const uint8_t *setup)
+{
+    volatile BDT_ENTRY* p;
+
+    if(usb_sim_ustat_count >= USB_SIM_USTAT_FIFO_SIZE)
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    p = USBSimBDTEntryGet(0, OUT_FROM_HOST);
+    if(p->STAT.UOWN == 0)
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    memcpy(ConvertToVirtualAddress(p->ADR), setup, 8);
+    p->CNT = 8;
+    p->STAT.Val = 0;
+    p->STAT.PID = PID_SETUP;
+
+    //The module stops processing further tokens until firmware clears PKTDIS.
+    U1CONbits.PKTDIS = 1;
+
+    USBSimTransactionComplete(0, OUT_FROM_HOST);
+    return USB_SIM_ACK;
+}
+
+USB_SIM_RESULT USBSimOutToken(uint8_t ep, const uint8_t *data, uint16_t length)
+{
+    volatile BDT_ENTRY* p;
+    uint8_t dts;
+
+    if((ep > USB_MAX_EP_NUMBER) || ((USBSimSFR.ep[ep].Val & USB_OUT_ENABLED) == 0))
+    {
+        return USB_SIM_DISABLED;
+    }
+
+    if((U1CONbits.PKTDIS == 1) || (usb_sim_ustat_count >= USB_SIM_USTAT_FIFO_SIZE))
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    p = USBSimBDTEntryGet(ep, OUT_FROM_HOST);
+    if(p->STAT.UOWN == 0)
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    if((p->STAT.BSTALL == 1) || (USBSimSFR.ep[ep].EPSTALL == 1))
+    {
+        USBSimStatistics.stalls++;
+        return USB_SIM_STALL;
+    }
+
+    if(length > p->CNT)
+    {
+        length = p->CNT;
+    }
+    if(length != 0)
+    {
+        memcpy(ConvertToVirtualAddress(p->ADR), data, length);
+    }
+
+    dts = p->STAT.DTS;
+    p->CNT = length;
+    p->STAT.Val = 0;
+    p->STAT.DTS = dts;
+    p->STAT.PID = PID_OUT;
+
+    if(ep != 0)
+    {
+        USBSimStatistics.bytesOut += length;
+    }
+
+    USBSimTransactionComplete(ep, OUT_FROM_HOST);
+    return USB_SIM_ACK;
+}
+
+USB_SIM_RESULT USBSimInToken(uint8_t ep, uint8_t *data, uint16_t *length)
+{
+    volatile BDT_ENTRY* p;
+    uint8_t dts;
+
+    *length = 0;
+
+    if((ep > USB_MAX_EP_NUMBER) || ((USBSimSFR.ep[ep].Val & USB_IN_ENABLED) == 0))
+    {
+        return USB_SIM_DISABLED;
+    }
+
+    if((U1CONbits.PKTDIS == 1) || (usb_sim_ustat_count >= USB_SIM_USTAT_FIFO_SIZE))
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    p = USBSimBDTEntryGet(ep, IN_TO_HOST);
+    if(p->STAT.UOWN == 0)
+    {
+        USBSimStatistics.naks++;
+        return USB_SIM_NAK;
+    }
+
+    if((p->STAT.BSTALL == 1) || (USBSimSFR.ep[ep].EPSTALL == 1))
+    {
+        USBSimStatistics.stalls++;
+        return USB_SIM_STALL;
+    }
+
+    *length = p->CNT;
+    if(*length != 0)
+    {
+        memcpy(data, ConvertToVirtualAddress(p->ADR), *length);
+    }
+
+    dts = p->STAT.DTS;
+    p->STAT.Val = 0;
+    p->STAT.DTS = dts;
+    p->STAT.PID = PID_IN;
+
+    if(ep != 0)
+    {
+        USBSimStatistics.bytesIn += *length;
+    }
+
+    USBSimTransactionComplete(ep, IN_TO_HOST);
+    return USB_SIM_ACK;
+}
+
+bool USBSimControlTransferStart(const uint8_t *setup, uint8_t *data)
+{
+    if(usb_sim_ctrl_state != USB_SIM_CTRL_IDLE)
+    {
+        return false;
+    }
+
+    memcpy(usb_sim_ctrl_setup, setup, sizeof(usb_sim_ctrl_setup));
+    usb_sim_ctrl_data = data;
+    usb_sim_ctrl_length = setup[6] | ((uint16_t)setup[7] << 8);
+    usb_sim_ctrl_count = 0;
+    usb_sim_ctrl_state = USB_SIM_CTRL_SETUP;
+    return true;
+}
+
+bool USBSimControlTransferTasks(void)
+{
+    uint8_t packet[USB_EP0_BUFF_SIZE];
+    uint16_t length;
+    uint16_t remaining;
+
+    switch(usb_sim_ctrl_state)
+    {
+        case USB_SIM_CTRL_SETUP:
+            if(USBSimSetupToken(usb_sim_ctrl_setup) == USB_SIM_ACK)
+            {
+                if(usb_sim_ctrl_length == 0)
+                {
+                    usb_sim_ctrl_state = USB_SIM_CTRL_STATUS_IN;
+                }
+                else if(usb_sim_ctrl_setup[0] & 0x80)
+                {
+                    usb_sim_ctrl_state = USB_SIM_CTRL_DATA_IN;
+                }
+                else
+                {
+                    usb_sim_ctrl_state = USB_SIM_CTRL_DATA_OUT;
+                }
+            }
+            break;
+
+        case USB_SIM_CTRL_DATA_IN:
+            if(USBSimInToken(0, packet, &length) == USB_SIM_ACK)
+            {
+                remaining = usb_sim_ctrl_length - usb_sim_ctrl_count;
+                if(length > remaining)
+                {
+                    length = remaining;
+                }
+                memcpy(&usb_sim_ctrl_data[usb_sim_ctrl_count], packet, length);
+                usb_sim_ctrl_count += length;
+
+                //A short packet or the full wLength ends the data stage.
+                if((length < USB_EP0_BUFF_SIZE) || (usb_sim_ctrl_count == usb_sim_ctrl_length))
+                {
+                    usb_sim_ctrl_state = USB_SIM_CTRL_STATUS_OUT;
+                }
+            }
+            break;
+
+        case USB_SIM_CTRL_DATA_OUT:
+            length = usb_sim_ctrl_length - usb_sim_ctrl_count;
+            if(length > USB_EP0_BUFF_SIZE)
+            {
+                length = USB_EP0_BUFF_SIZE;
+            }
+            if(USBSimOutToken(0, &usb_sim_ctrl_data[usb_sim_ctrl_count], length) == USB_SIM_ACK)
+            {
+                usb_sim_ctrl_count += length;
+                if(usb_sim_ctrl_count == usb_sim_ctrl_length)
+                {
+                    usb_sim_ctrl_state = USB_SIM_CTRL_STATUS_IN;
+                }
+            }
+            break;
+
+        case USB_SIM_CTRL_STATUS_IN:
+            if(USBSimInToken(0, packet, &length) == USB_SIM_ACK)
+            {
+                usb_sim_ctrl_state = USB_SIM_CTRL_IDLE;
+            }
+            break;
+
+        case USB_SIM_CTRL_STATUS_OUT:
+            if(USBSimOutToken(0, NULL, 0) == USB_SIM_ACK)
+            {
+                usb_sim_ctrl_state = USB_SIM_CTRL_IDLE;
+            }
+            break;
+
+        case USB_SIM_CTRL_IDLE:
+        default:
+            break;
+    }
+
+    return (usb_sim_ctrl_state != USB_SIM_CTRL_IDLE);
+}
+
+bool USBSimEnumerateTasks(uint8_t configuration)
+{
+    uint8_t setup[8];
+
+    //Wait for the control transfer of the previous step to finish.
+    if(usb_sim_enum_started == true)
+    {
+        if(USBSimControlTransferTasks() == true)
+        {
+            return false;
+        }
+        usb_sim_enum_started = false;
+        usb_sim_enum_state++;
+    }
+
+    memset(setup, 0x00, sizeof(setup));
+
+    switch(usb_sim_enum_state)
+    {
+        case USB_SIM_ENUM_RESET:
+            //Wait for USBDeviceTasks() to unmask the reset interrupt.
+            if(USBGetDeviceState() == POWERED_STATE)
+            {
+                USBSimBusReset();
+            }
+            else if(USBGetDeviceState() == DEFAULT_STATE)
+            {
+                usb_sim_enum_state++;
+            }
+            return false;
+
+        case USB_SIM_ENUM_GET_DEVICE_DESCRIPTOR:
+            setup[0] = 0x80;
+            setup[1] = USB_REQUEST_GET_DESCRIPTOR;
+            setup[3] = USB_DESCRIPTOR_DEVICE;
+            setup[6] = sizeof(USB_DEVICE_DESCRIPTOR);
+            break;
+
+        case USB_SIM_ENUM_SET_ADDRESS:
+            setup[1] = USB_REQUEST_SET_ADDRESS;
+            setup[2] = 1;
+            break;
+
+        case USB_SIM_ENUM_GET_CONFIG_DESCRIPTOR:
+            setup[0] = 0x80;
+            setup[1] = USB_REQUEST_GET_DESCRIPTOR;
+            setup[3] = USB_DESCRIPTOR_CONFIGURATION;
+            setup[6] = sizeof(usb_sim_enum_buffer);
+            break;
+
+        case USB_SIM_ENUM_SET_CONFIGURATION:
+            setup[1] = USB_REQUEST_SET_CONFIGURATION;
+            setup[2] = configuration;
+            break;
+
+        case USB_SIM_ENUM_DONE:
+        default:
+            return (USBGetDeviceState() == CONFIGURED_STATE);
+    }
+
+    USBSimControlTransferStart(setup, usb_sim_enum_buffer);
+    usb_sim_enum_started = true;
+    USBSimControlTransferTasks();
+    return false;
+}
+
+bool USBSleepOnSuspend(void)
+{
+    return false;
+}
+
+bool USBRemoteWakeupAssertBlocking(void)
+{
+    return false;
+}
+
+int8_t USBVBUSSessionValidStateGet(bool AllowInvasiveReads)
+{
+    return 1;
+}
+
+void USBMaskAllUSBInterrupts(void)
+{
+}
+
+void USBRestoreUSBInterrupts(void)
+{
+}
+
+#endif //USB_HAL_SIMULATOR